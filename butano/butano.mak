@@ -138,6 +138,8 @@ endif
 
 export OFILES_BIN       :=  $(addsuffix .o,$(BINFILES))
 
+export OFILES_STREAM	:=  _bn_audio_stream_music.o
+
 export OFILES_DMGMOD	:=  $(DMGMODFILES:.mod=_bn_dmg.o)
 
 export OFILES_DMGS3M	:=  $(DMGS3MFILES:.s3m=_bn_dmg.o)
@@ -146,7 +148,7 @@ export OFILES_GRAPHICS	:=  $(GRAPHICSFILES:.bmp=_bn_gfx.o)
 
 export OFILES_SOURCES   :=  $(CPPFILES:.cpp=.o) $(CFILES:.c=.o) $(SFILES:.s=.o)
  
-export OFILES           :=  $(OFILES_BIN) $(OFILES_DMGMOD) $(OFILES_DMGS3M) $(OFILES_GRAPHICS) $(OFILES_SOURCES)
+export OFILES           :=  $(OFILES_BIN) $(OFILES_STREAM) $(OFILES_DMGMOD) $(OFILES_DMGS3M) $(OFILES_GRAPHICS) $(OFILES_SOURCES)
 
 #---------------------------------------------------------------------------------------------------------------------
 # Don't generate header files from audio soundbank (avoid rebuilding all sources when audio files are updated):
@@ -170,7 +172,8 @@ all:
 #---------------------------------------------------------------------------------
 $(BUILD):
 	@$(PYTHON) -B $(LIBBUTANOABS)/tools/butano_assets_tool.py --audio="$(AUDIO)" --dmg_audio="$(DMGAUDIO)" \
-			--graphics="$(GRAPHICS)" --build=$(BUILD)
+			--graphics="$(GRAPHICS)" --models_3d="$(MODELS3D)" --user_flags="$(USERFLAGS)" \
+			--build=$(BUILD)
 	@$(MAKE) --no-print-directory -C $(BUILD) -f $(CURDIR)/Makefile
 
 #---------------------------------------------------------------------------------------------------------------------
@@ -146,7 +146,9 @@ public:
             return;
         }
         
-        if (isMaster() && isReady() && !isSending())
+        // Don't start a new transfer if the last one has not been processed yet
+        // (for example, if its interrupt has been delayed by a DMA transfer):
+        if (isMaster() && isReady() && !isSending() && !isSerialIRQPending())
             sendPendingData();
     }
     
@@ -211,6 +213,7 @@ private:
     bool isMaster() { return !isBitHigh(LINK_BIT_SLAVE); }
     bool isSending() { return isBitHigh(LINK_BIT_START); }
     bool didTimeout() { return linkState._IRQTimeout >= LINK_DEFAULT_TIMEOUT; }
+    bool isSerialIRQPending() { return REG_IF & IRQ_SERIAL; }
     
     void sendPendingData() {
         sendDataCallback();
@@ -8,11 +8,6 @@
 
 #include "bn_common.h"
 
-extern "C"
-{
-    #include "../3rd_party/gbt-player/include/gbt_player.h"
-}
-
 namespace bn::hw::audio
 {
     void init();
@@ -37,41 +32,31 @@ namespace bn::hw::audio
 
     void set_music_volume(int volume);
 
-    inline void play_dmg_music(const void* song, int speed, bool loop)
-    {
-        gbt_play(song, speed);
-        gbt_loop(loop);
-    }
-
-    inline void stop_dmg_music()
-    {
-        gbt_stop();
-    }
-
-    inline void pause_dmg_music()
-    {
-        gbt_pause(0);
-    }
-
-    inline void resume_dmg_music()
-    {
-        gbt_pause(1);
-    }
-
-    inline void dmg_music_position(int& pattern, int& row)
-    {
-        gbt_get_position(&pattern, &row, nullptr);
-    }
-
-    inline void set_dmg_music_position(int pattern, int row)
-    {
-        gbt_set_position(pattern, row);
-    }
-
-    inline void set_dmg_music_volume(int left_volume, int right_volume)
-    {
-        gbt_volume(unsigned(left_volume), unsigned(right_volume));
-    }
+    void play_dmg_music(const void* song, int speed, bool loop, bool precompiled);
+
+    void stop_dmg_music();
+
+    void pause_dmg_music();
+
+    void resume_dmg_music();
+
+    void dmg_music_position(int& pattern, int& row);
+
+    void set_dmg_music_position(int pattern, int row);
+
+    void set_dmg_music_volume(int left_volume, int right_volume);
+
+    [[nodiscard]] bool stream_music_playing();
+
+    void play_stream_music(const uint8_t* data, int samples_count, bool adpcm, int volume, bool loop);
+
+    void stop_stream_music();
+
+    void pause_stream_music();
+
+    void resume_stream_music();
+
+    void set_stream_music_volume(int volume);
 
     void play_sound(int priority, int id);
 
@@ -89,6 +74,12 @@ namespace bn::hw::audio
 
     void update_sounds_queue();
 
+    [[nodiscard]] int last_direct_sound_ticks();
+
+    [[nodiscard]] int last_dmg_ticks();
+
+    [[nodiscard]] int active_direct_sound_channels();
+
     void commit();
 }
 
@@ -11,6 +11,11 @@
  */
 #define BN_DATA_EWRAM __attribute__((section(".ewram")))
 
+/**
+ * @brief Store uninitialized data in EWRAM.
+ */
+#define BN_DATA_EWRAM_BSS __attribute__((section(".sbss")))
+
 /**
  * @brief Store code in IWRAM.
  */
@@ -6,6 +6,7 @@
 #ifndef BN_HW_DMA_H
 #define BN_HW_DMA_H
 
+#include "bn_config_link.h"
 #include "bn_hw_tonc.h"
 
 namespace bn::hw::dma
@@ -21,19 +22,58 @@ namespace bn::hw::dma
     return 0;
 }
 
+[[nodiscard]] constexpr int max_words_per_transfer()
+{
+    // The CPU is halted during DMA transfers, so interrupts can't be serviced until they finish.
+    // Long copies are split in transfers which take less than half the link send wait period
+    // (BN_CFG_LINK_SEND_WAIT * 1024 cycles), counting up to 8 cycles per word.
+    // They are only split if DMA can be used while link communication is active:
+    return BN_CFG_LINK_SEND_WAIT * 64;
+}
+
 inline void copy_half_words(const void* source, int half_words, void* destination)
 {
+    constexpr int max_half_words = max_words_per_transfer() * 2;
+    auto source_ptr = static_cast<const uint16_t*>(source);
+    auto destination_ptr = static_cast<uint16_t*>(destination);
+
+    while(BN_CFG_LINK_DMA_ENABLED && half_words > max_half_words)
+    {
+        REG_DMA[3].cnt = 0;
+        REG_DMA[3].src = source_ptr;
+        REG_DMA[3].dst = destination_ptr;
+        REG_DMA[3].cnt = max_half_words | DMA_CPY16;
+        source_ptr += max_half_words;
+        destination_ptr += max_half_words;
+        half_words -= max_half_words;
+    }
+
     REG_DMA[3].cnt = 0;
-    REG_DMA[3].src = source;
-    REG_DMA[3].dst = destination;
+    REG_DMA[3].src = source_ptr;
+    REG_DMA[3].dst = destination_ptr;
     REG_DMA[3].cnt = half_words | DMA_CPY16;
 }
 
 inline void copy_words(const void* source, int words, void* destination)
 {
+    constexpr int max_words = max_words_per_transfer();
+    auto source_ptr = static_cast<const uint32_t*>(source);
+    auto destination_ptr = static_cast<uint32_t*>(destination);
+
+    while(BN_CFG_LINK_DMA_ENABLED && words > max_words)
+    {
+        REG_DMA[3].cnt = 0;
+        REG_DMA[3].src = source_ptr;
+        REG_DMA[3].dst = destination_ptr;
+        REG_DMA[3].cnt = max_words | DMA_CPY32;
+        source_ptr += max_words;
+        destination_ptr += max_words;
+        words -= max_words;
+    }
+
     REG_DMA[3].cnt = 0;
-    REG_DMA[3].src = source;
-    REG_DMA[3].dst = destination;
+    REG_DMA[3].src = source_ptr;
+    REG_DMA[3].dst = destination_ptr;
     REG_DMA[3].cnt = words | DMA_CPY32;
 }
 
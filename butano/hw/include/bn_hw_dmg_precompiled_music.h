@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_DMG_PRECOMPILED_MUSIC_H
+#define BN_HW_DMG_PRECOMPILED_MUSIC_H
+
+#include "bn_common.h"
+
+namespace bn::hw::dmg_precompiled_music
+{
+    class player
+    {
+
+    public:
+        const uint16_t* positions = nullptr;
+        const uint16_t* waves = nullptr;
+        const uint16_t* rows = nullptr;
+        const uint16_t* ticks = nullptr;
+        const uint16_t* tick_ptr = nullptr;
+        const uint16_t* next_row_ptr = nullptr;
+        int patterns_count = 0;
+        int rows_count = 0;
+        int loop_row = 0;
+        int end_row = 0;
+        int row_index = 0;
+        int tick = 0;
+        int idle_ticks = 0;
+        uint16_t global_volume = 0;
+        uint16_t pan_volume_mask = 0;
+        uint8_t pan = 0;
+        bool loop = false;
+        bool playing = false;
+    };
+
+    [[nodiscard]] bool valid_position(const uint8_t* data, int pattern, int row);
+
+    void play(player& player, const uint8_t* data, bool loop);
+
+    void stop(player& player);
+
+    void pause(player& player);
+
+    void resume(player& player);
+
+    void position(const player& player, int& pattern, int& row, int& tick);
+
+    void set_position(player& player, int pattern, int row);
+
+    void set_volume(player& player, int left_volume, int right_volume);
+
+    BN_CODE_IWRAM void update(player& player);
+
+    BN_CODE_IWRAM void sync(player& player, int pattern, int row, int tick);
+}
+
+#endif
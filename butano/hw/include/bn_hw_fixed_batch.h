@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_FIXED_BATCH_H
+#define BN_HW_FIXED_BATCH_H
+
+#include "bn_assert.h"
+#include "bn_fixed_point.h"
+
+namespace bn::hw::fixed_batch
+{
+    BN_CODE_IWRAM void transform(int a, int b, int c, int d, int translation_x, int translation_y,
+                                 const fixed_point* points_ptr, int count, fixed_point* output_ptr);
+
+    BN_CODE_IWRAM void transform_3d(const fixed* matrix_ptr, const fixed* vectors_ptr, int count, fixed* output_ptr);
+
+    BN_CODE_IWRAM void project_3d(int focal_length, int center_x, int center_y, const fixed* vectors_ptr,
+                                  int count, fixed_point* output_ptr);
+}
+
+#endif
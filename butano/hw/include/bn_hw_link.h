@@ -33,6 +33,8 @@ namespace bn::hw::link
 
     void send(int data_to_send);
 
+    [[nodiscard]] int pending_messages();
+
     [[nodiscard]] bool receive(LinkResponse& response);
 
     void commit();
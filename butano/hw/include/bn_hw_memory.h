@@ -28,6 +28,10 @@ namespace bn::hw::memory
 
     [[nodiscard]] int used_stack_iwram(int current_stack_address);
 
+    void paint_stack_iwram(int current_stack_address);
+
+    [[nodiscard]] int max_used_stack_iwram();
+
     [[nodiscard]] int used_static_iwram();
 
     [[nodiscard]] int used_static_ewram();
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_STREAM_MUSIC_H
+#define BN_HW_STREAM_MUSIC_H
+
+#include "bn_common.h"
+
+namespace bn::hw::stream_music
+{
+    class decoder
+    {
+
+    public:
+        const uint8_t* data = nullptr;
+        int samples_count = 0;
+        int position = 0;
+        int predictor = 0;
+        int step_index = 0;
+        int volume = 0;
+        bool adpcm = false;
+        bool loop = false;
+        bool finished = true;
+    };
+
+    BN_CODE_IWRAM void decode(decoder& decoder, int8_t* output_ptr, int output_size);
+
+    BN_CODE_IWRAM void mix(decoder& decoder, int8_t* left_output_ptr, int8_t* right_output_ptr, int output_size);
+}
+
+#endif
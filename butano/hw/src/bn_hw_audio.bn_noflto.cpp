@@ -11,6 +11,14 @@
 #include "../include/bn_hw_irq.h"
 #include "../include/bn_hw_link.h"
 #include "../include/bn_hw_tonc.h"
+#include "../include/bn_hw_timer.h"
+#include "../include/bn_hw_stream_music.h"
+#include "../include/bn_hw_dmg_precompiled_music.h"
+
+extern "C"
+{
+    #include "../3rd_party/gbt-player/include/gbt_player.h"
+}
 
 extern const uint8_t _bn_audio_soundbank_bin[];
 
@@ -42,11 +50,22 @@ namespace
 
     public:
         forward_list<sound_type, BN_CFG_AUDIO_MAX_SOUND_CHANNELS> sounds_queue;
+        stream_music::decoder stream_decoder;
+        dmg_precompiled_music::player dmg_player;
+        unsigned direct_sound_ticks = 0;
+        unsigned dmg_ticks = 0;
+        int last_direct_sound_ticks = 0;
+        int last_dmg_ticks = 0;
         uint16_t direct_sound_control_value = 0;
         uint16_t dmg_control_value = 0;
-        bool update_on_vblank = false;
+        int8_t playing_segment = 0;
+        bool stream_output = false;
+        bool stream_paused = false;
+        bool stream_ended = false;
+        bool update_on_vblank = BN_CFG_AUDIO_UPDATE_ON_VBLANK;
         bool delay_commit = true;
         bool dmg_sync = false;
+        bool dmg_precompiled = false;
     };
 
     BN_DATA_EWRAM static_data data;
@@ -93,6 +112,36 @@ namespace
 
     alignas(int) uint8_t maxmod_mixing_buffer[_mix_length()];
 
+    // Maxmod mixes two frames of stereo samples in its mixing buffer (left channel in the first half),
+    // and it restarts the FIFO DMA transfers each two frames.
+    // Stream samples are mono and they are played at the maxmod mixing rate,
+    // so they are added to both channels of the frame mixed by maxmod:
+
+    constexpr int _samples_per_frame = _mix_length() / 4;
+
+
+    void _commit_stream()
+    {
+        if(data.stream_decoder.finished)
+        {
+            // The end of the stream is playing now, so it can be stopped in the next update:
+            data.stream_ended = true;
+            return;
+        }
+
+        if(data.stream_paused)
+        {
+            return;
+        }
+
+        // Maxmod mixes the frame which is not being played:
+
+        int segment = 1 - data.playing_segment;
+        auto left_output_ptr = reinterpret_cast<int8_t*>(maxmod_mixing_buffer) + (segment * _samples_per_frame);
+        int8_t* right_output_ptr = left_output_ptr + (_mix_length() / 2);
+        stream_music::mix(data.stream_decoder, left_output_ptr, right_output_ptr, _samples_per_frame);
+    }
+
 
     void _check_sounds_queue()
     {
@@ -129,9 +178,31 @@ namespace
 
     void _commit()
     {
+        unsigned start_ticks = timer::ticks();
+
         mmFrame();
 
-        if(data.dmg_sync && mmActive() && gbt_is_playing())
+        if(data.stream_output)
+        {
+            _commit_stream();
+        }
+
+        unsigned direct_sound_end_ticks = timer::ticks();
+
+        if(data.dmg_precompiled)
+        {
+            if(data.dmg_sync && mmActive())
+            {
+                // Precompiled DMG music can seek any tick, so it is synchronized in one step:
+                dmg_precompiled_music::sync(data.dmg_player, int(mmGetPosition()), int(mmGetPositionRow()),
+                                            int(mmGetPositionTick()));
+            }
+            else
+            {
+                dmg_precompiled_music::update(data.dmg_player);
+            }
+        }
+        else if(data.dmg_sync && mmActive() && gbt_is_playing())
         {
             auto mmPosition = int(mmGetPosition());
             auto mmRow = int(mmGetPositionRow());
@@ -157,6 +228,9 @@ namespace
         {
             gbt_update();
         }
+
+        data.direct_sound_ticks += direct_sound_end_ticks - start_ticks;
+        data.dmg_ticks += timer::ticks() - direct_sound_end_ticks;
     }
 
     void _enabled_vblank_handler()
@@ -176,12 +250,19 @@ namespace
         core::on_vblank();
         hw::link::commit();
     }
+
+    void _vblank_isr()
+    {
+        // Tracks the frame played by maxmod, which restarts the FIFO DMA transfers each two frames:
+        data.playing_segment = data.playing_segment ? 0 : 1;
+
+        mmVBlank();
+    }
 }
 
 void init()
 {
-    irq::set_isr(irq::id::VBLANK, mmVBlank);
-    irq::enable(irq::id::VBLANK);
+    irq::set_isr(irq::id::VBLANK, _vblank_isr);
 
     mm_gba_system maxmod_info;
     maxmod_info.mixing_mode = mm_mixmode(BN_CFG_AUDIO_MIXING_RATE);
@@ -197,6 +278,10 @@ void init()
     maxmod_info.soundbank = mm_addr(_bn_audio_soundbank_bin);
     mmInit(&maxmod_info);
 
+    // Maxmod starts playing the first frame of its mixing buffer:
+    data.playing_segment = 0;
+    irq::enable(irq::id::VBLANK);
+
     mmSetVBlankHandler(reinterpret_cast<void*>(_enabled_vblank_handler));
 }
 
@@ -265,6 +350,152 @@ void set_music_volume(int volume)
     mmSetModuleVolume(mm_word(volume));
 }
 
+void play_dmg_music(const void* song, int speed, bool loop, bool precompiled)
+{
+    if(precompiled)
+    {
+        gbt_stop();
+        dmg_precompiled_music::play(data.dmg_player, static_cast<const uint8_t*>(song), loop);
+    }
+    else
+    {
+        dmg_precompiled_music::stop(data.dmg_player);
+        gbt_play(song, speed);
+        gbt_loop(loop);
+    }
+
+    data.dmg_precompiled = precompiled;
+}
+
+void stop_dmg_music()
+{
+    if(data.dmg_precompiled)
+    {
+        dmg_precompiled_music::stop(data.dmg_player);
+    }
+    else
+    {
+        gbt_stop();
+    }
+}
+
+void pause_dmg_music()
+{
+    if(data.dmg_precompiled)
+    {
+        dmg_precompiled_music::pause(data.dmg_player);
+    }
+    else
+    {
+        gbt_pause(0);
+    }
+}
+
+void resume_dmg_music()
+{
+    if(data.dmg_precompiled)
+    {
+        dmg_precompiled_music::resume(data.dmg_player);
+    }
+    else
+    {
+        gbt_pause(1);
+    }
+}
+
+void dmg_music_position(int& pattern, int& row)
+{
+    if(data.dmg_precompiled)
+    {
+        int tick;
+        dmg_precompiled_music::position(data.dmg_player, pattern, row, tick);
+    }
+    else
+    {
+        gbt_get_position(&pattern, &row, nullptr);
+    }
+}
+
+void set_dmg_music_position(int pattern, int row)
+{
+    if(data.dmg_precompiled)
+    {
+        dmg_precompiled_music::set_position(data.dmg_player, pattern, row);
+    }
+    else
+    {
+        gbt_set_position(pattern, row);
+    }
+}
+
+void set_dmg_music_volume(int left_volume, int right_volume)
+{
+    if(data.dmg_precompiled)
+    {
+        dmg_precompiled_music::set_volume(data.dmg_player, left_volume, right_volume);
+    }
+    else
+    {
+        gbt_volume(unsigned(left_volume), unsigned(right_volume));
+    }
+}
+
+bool stream_music_playing()
+{
+    return data.stream_output && ! data.stream_ended;
+}
+
+void play_stream_music(const uint8_t* data_ptr, int samples_count, bool adpcm, int volume, bool loop)
+{
+    BN_ASSERT(samples_count > 0, "Invalid samples count: ", samples_count);
+
+    if(mmActive())
+    {
+        mmStop();
+    }
+
+    // Stream output is disabled while the decoder is set up, since it can be committed in the V-Blank ISR:
+
+    data.stream_output = false;
+
+    stream_music::decoder& decoder = data.stream_decoder;
+    decoder.data = data_ptr;
+    decoder.samples_count = samples_count;
+    decoder.position = 0;
+    decoder.predictor = 0;
+    decoder.step_index = 0;
+    decoder.volume = volume;
+    decoder.adpcm = adpcm;
+    decoder.loop = loop;
+    decoder.finished = false;
+    data.stream_paused = false;
+    data.stream_ended = false;
+    data.stream_output = true;
+}
+
+void stop_stream_music()
+{
+    data.stream_output = false;
+    data.stream_decoder.finished = true;
+    data.stream_paused = false;
+    data.stream_ended = false;
+}
+
+void pause_stream_music()
+{
+    data.stream_paused = true;
+}
+
+void resume_stream_music()
+{
+    data.stream_paused = false;
+}
+
+void set_stream_music_volume(int volume)
+{
+    data.stream_decoder.volume = volume;
+}
+
 void play_sound(int priority, int id)
 {
     _check_sounds_queue();
@@ -308,6 +539,15 @@ void update(bool dmg_sync)
 {
     data.dmg_sync = dmg_sync;
     data.delay_commit = ! data.update_on_vblank;
+
+    // Ticks are accumulated by the V-Blank ISR, so they are read and reset with interrupts disabled:
+    uint16_t ime = REG_IME;
+    REG_IME = 0;
+    data.last_direct_sound_ticks = int(data.direct_sound_ticks);
+    data.last_dmg_ticks = int(data.dmg_ticks);
+    data.direct_sound_ticks = 0;
+    data.dmg_ticks = 0;
+    REG_IME = ime;
 }
 
 void update_sounds_queue()
@@ -332,6 +572,35 @@ void update_sounds_queue()
     }
 }
 
+int last_direct_sound_ticks()
+{
+    return data.last_direct_sound_ticks;
+}
+
+int last_dmg_ticks()
+{
+    return data.last_dmg_ticks;
+}
+
+int active_direct_sound_channels()
+{
+    auto mixing_channels = reinterpret_cast<const mm_mixer_channel*>(
+                maxmod_engine_buffer + (_max_channels * (MM_SIZEOF_MODCH + MM_SIZEOF_ACTCH)));
+    int result = data.stream_output ? 1 : 0;
+
+    for(int index = 0; index < _max_channels; ++index)
+    {
+        // Bit 31 of the source address is set when the channel is disabled:
+
+        if(! (mixing_channels[index].src & (1u << 31)))
+        {
+            ++result;
+        }
+    }
+
+    return result;
+}
+
 void commit()
 {
     if(data.delay_commit)
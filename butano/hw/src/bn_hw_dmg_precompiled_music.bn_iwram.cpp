@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_dmg_precompiled_music.h"
+
+#include "../include/bn_hw_tonc.h"
+
+namespace bn::hw::dmg_precompiled_music
+{
+
+namespace
+{
+    // Data format is described in tools/dmg_music_compiler.py.
+
+    constexpr int header_size = 6;
+    constexpr int wave_size = 17;
+    constexpr int row_size = 13;
+    constexpr int max_catch_up_ticks = 16;
+    constexpr unsigned no_index = 0xFFFF;
+    constexpr unsigned pan_mask = 0xFF00;
+    constexpr unsigned wave_pan_mask = SDMG_LWAVE | SDMG_RWAVE;
+    constexpr unsigned wave_64_samples = 1 << 5;
+    constexpr unsigned wave_bank_1 = 1 << 6;
+    constexpr unsigned wave_enable = 1 << 7;
+
+    [[nodiscard]] const uint16_t* _header(const uint8_t* data)
+    {
+        return reinterpret_cast<const uint16_t*>(data);
+    }
+
+    [[nodiscard]] const uint16_t* _row_ticks_ptr(const player& player, int row_index)
+    {
+        const uint16_t* row = player.rows + (row_index * row_size);
+        return player.ticks + (row[2] | (unsigned(row[3]) << 16));
+    }
+
+    void _silence()
+    {
+        REG_SNDDMGCNT = REG_SNDDMGCNT & ~pan_mask;
+
+        REG_SND1SWEEP = 0;
+        REG_SND1CNT = 0;
+        REG_SND1FREQ = SFREQ_RESET;
+
+        REG_SND2CNT = 0;
+        REG_SND2FREQ = SFREQ_RESET;
+
+        REG_SND3FREQ = SFREQ_RESET;
+        REG_SND3CNT = 0;
+        REG_SND3FREQ = SFREQ_RESET;
+
+        REG_SND4CNT = 0;
+        REG_SND4FREQ = SFREQ_RESET;
+    }
+
+    void _load_wave(const uint16_t* wave)
+    {
+        // Channel 3 output is removed before refreshing wave RAM to avoid a loud spike:
+        REG_SNDDMGCNT = REG_SNDDMGCNT & ~wave_pan_mask;
+
+        auto wave_ram = reinterpret_cast<volatile uint16_t*>(REG_WAVE_RAM);
+        unsigned flags = wave[0];
+        REG_SND3SEL = wave_bank_1;
+
+        for(int index = 0; index < 8; ++index)
+        {
+            wave_ram[index] = wave[index + 1];
+        }
+
+        if(flags & 0x80)
+        {
+            REG_SND3SEL = 0;
+
+            for(int index = 0; index < 8; ++index)
+            {
+                wave_ram[index] = wave[index + 9];
+            }
+
+            REG_SND3SEL = wave_64_samples | wave_enable;
+        }
+        else
+        {
+            REG_SND3SEL = wave_enable;
+        }
+    }
+
+    void _set_row(player& player, int row_index)
+    {
+        unsigned wave_index = player.rows[(row_index * row_size) + 1];
+
+        if(wave_index != no_index)
+        {
+            _load_wave(player.waves + (wave_index * wave_size));
+        }
+
+        player.row_index = row_index;
+        player.tick = -1;
+        player.idle_ticks = 0;
+        player.tick_ptr = _row_ticks_ptr(player, row_index);
+        player.next_row_ptr = _row_ticks_ptr(player, row_index + 1);
+    }
+
+    void _restore_channels(const player& player, int row_index)
+    {
+        // Notes started before the given row may still be playing,
+        // so the last values written to the channel registers before it are written again:
+
+        const uint16_t* registers = player.rows + (row_index * row_size) + 4;
+        REG_SND1SWEEP = registers[0];
+        REG_SND1CNT = registers[1];
+        REG_SND1FREQ = registers[2] | SFREQ_RESET;
+
+        REG_SND2CNT = registers[3];
+        REG_SND2FREQ = registers[4] | SFREQ_RESET;
+
+        REG_SND3CNT = registers[5];
+        REG_SND3FREQ = registers[6] | SFREQ_RESET;
+
+        REG_SND4CNT = registers[7];
+        REG_SND4FREQ = registers[8] | SFREQ_RESET;
+    }
+
+    void _seek(player& player, int row_index)
+    {
+        _set_row(player, row_index);
+        _restore_channels(player, row_index);
+    }
+
+    void _commit_pan(const player& player)
+    {
+        REG_SNDDMGCNT = player.global_volume | ((unsigned(player.pan) << 8) & player.pan_volume_mask);
+    }
+
+    [[nodiscard]] bool _row_finished(const player& player)
+    {
+        return ! player.idle_ticks && player.tick_ptr == player.next_row_ptr;
+    }
+
+    BN_CODE_IWRAM void _update(player& player)
+    {
+        if(int idle_ticks = player.idle_ticks)
+        {
+            player.idle_ticks = idle_ticks - 1;
+            ++player.tick;
+            return;
+        }
+
+        if(player.tick_ptr == player.next_row_ptr)
+        {
+            int row_index = player.row_index + 1;
+
+            if(row_index == player.end_row && ! player.loop)
+            {
+                stop(player);
+                return;
+            }
+
+            if(row_index == player.rows_count)
+            {
+                _set_row(player, player.loop_row);
+            }
+            else
+            {
+                player.row_index = row_index;
+                player.tick = -1;
+                player.next_row_ptr = _row_ticks_ptr(player, row_index + 1);
+            }
+        }
+
+        const uint16_t* tick_ptr = player.tick_ptr;
+        unsigned header = tick_ptr[0];
+        unsigned info = tick_ptr[1];
+        int writes = int(header & 0xFF);
+        unsigned mute_mask = info & 0xFF;
+        tick_ptr += 2;
+
+        if(mute_mask)
+        {
+            REG_SNDDMGCNT = REG_SNDDMGCNT & ~(mute_mask << 8);
+        }
+
+        for(int index = 0; index < writes; ++index)
+        {
+            *reinterpret_cast<volatile uint16_t*>(REG_BASE + tick_ptr[0]) = tick_ptr[1];
+            tick_ptr += 2;
+        }
+
+        player.tick_ptr = tick_ptr;
+        player.idle_ticks = int(info >> 8);
+        player.pan = uint8_t(header >> 8);
+        ++player.tick;
+        _commit_pan(player);
+    }
+}
+
+bool valid_position(const uint8_t* data, int pattern, int row)
+{
+    const uint16_t* header = _header(data);
+    int patterns_count = header[0];
+    return pattern >= 0 && pattern < patterns_count && row >= 0 && row < 64 &&
+            header[header_size + (pattern * 64) + row] != no_index;
+}
+
+void play(player& player, const uint8_t* data, bool loop)
+{
+    const uint16_t* header = _header(data);
+    int patterns_count = header[0];
+    int rows_count = header[1];
+    int waves_count = header[4];
+    player.positions = header + header_size;
+    player.waves = player.positions + (patterns_count * 64);
+    player.rows = player.waves + (waves_count * wave_size);
+    player.ticks = player.rows + ((rows_count + 1) * row_size);
+    player.patterns_count = patterns_count;
+    player.rows_count = rows_count;
+    player.loop_row = header[2];
+    player.end_row = header[3] == no_index ? -1 : int(header[3]);
+    player.pan = 0;
+    player.loop = loop;
+    player.playing = false;
+
+    REG_SNDSTAT = SSTAT_ENABLE;
+    _silence();
+    set_volume(player, 8, 8);
+    _set_row(player, 0);
+    player.playing = true;
+}
+
+void stop(player& player)
+{
+    player.rows = nullptr;
+    player.playing = false;
+    REG_SNDDMGCNT = REG_SNDDMGCNT & ~pan_mask;
+}
+
+void pause(player& player)
+{
+    player.playing = false;
+    REG_SNDDMGCNT = REG_SNDDMGCNT & ~pan_mask;
+}
+
+void resume(player& player)
+{
+    if(player.rows)
+    {
+        player.playing = true;
+        _commit_pan(player);
+    }
+}
+
+void position(const player& player, int& pattern, int& row, int& tick)
+{
+    if(player.playing && player.tick >= 0)
+    {
+        unsigned row_position = player.rows[player.row_index * row_size];
+        pattern = int(row_position >> 6);
+        row = int(row_position & 63);
+        tick = player.tick;
+    }
+    else
+    {
+        pattern = -1;
+        row = -1;
+        tick = -1;
+    }
+}
+
+void set_position(player& player, int pattern, int row)
+{
+    if(player.playing)
+    {
+        _silence();
+        _seek(player, player.positions[(pattern * 64) + row]);
+    }
+}
+
+void set_volume(player& player, int left_volume, int right_volume)
+{
+    unsigned global_volume = 0;
+    unsigned pan_volume_mask = 0;
+
+    if(left_volume > 0)
+    {
+        global_volume |= unsigned(left_volume - 1) << 4;
+        pan_volume_mask |= 0xF000;
+    }
+
+    if(right_volume > 0)
+    {
+        global_volume |= unsigned(right_volume - 1);
+        pan_volume_mask |= 0x0F00;
+    }
+
+    player.global_volume = uint16_t(global_volume);
+    player.pan_volume_mask = uint16_t(pan_volume_mask);
+
+    if(player.playing)
+    {
+        _commit_pan(player);
+    }
+}
+
+void update(player& player)
+{
+    if(player.playing)
+    {
+        _update(player);
+    }
+}
+
+void sync(player& player, int pattern, int row, int tick)
+{
+    if(! player.playing)
+    {
+        return;
+    }
+
+    _update(player);
+
+    int current_pattern;
+    int current_row;
+    int current_tick;
+    position(player, current_pattern, current_row, current_tick);
+
+    if(current_pattern == pattern && current_row == row && current_tick == tick)
+    {
+        return;
+    }
+
+    if(pattern < 0 || pattern >= player.patterns_count || row < 0 || row >= 64)
+    {
+        return;
+    }
+
+    unsigned row_index = player.positions[(pattern * 64) + row];
+
+    if(row_index == no_index || ! player.playing)
+    {
+        return;
+    }
+
+    int target_row_index = int(row_index);
+
+    if(target_row_index > player.row_index || (target_row_index == player.row_index && tick > current_tick))
+    {
+        // Small forward drifts are caught up replaying the missing ticks, which is cheaper than seeking:
+
+        for(int index = 0; index < max_catch_up_ticks; ++index)
+        {
+            _update(player);
+
+            if(! player.playing)
+            {
+                return;
+            }
+
+            int current_row_index = player.row_index;
+
+            if(current_row_index == target_row_index && player.tick == tick)
+            {
+                return;
+            }
+
+            if(current_row_index > target_row_index || (current_row_index == target_row_index && player.tick > tick))
+            {
+                break;
+            }
+        }
+    }
+
+    // Seek the requested row and replay its ticks until the requested one is reached:
+
+    _seek(player, target_row_index);
+
+    do
+    {
+        _update(player);
+    }
+    while(player.tick < tick && ! _row_finished(player));
+}
+
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_fixed_batch.h"
+
+namespace bn::hw::fixed_batch
+{
+
+namespace
+{
+    constexpr int precision = fixed::precision();
+}
+
+void transform(int a, int b, int c, int d, int translation_x, int translation_y,
+               const fixed_point* points_ptr, int count, fixed_point* output_ptr)
+{
+    // Translation is added before dropping the fractional part,
+    // so each output component is calculated with one smull and one smlal:
+
+    int64_t initial_x = int64_t(translation_x) << precision;
+    int64_t initial_y = int64_t(translation_y) << precision;
+
+    for(int index = 0; index < count; ++index)
+    {
+        int x = points_ptr[index].x().data();
+        int y = points_ptr[index].y().data();
+        int64_t result_x = initial_x + (int64_t(a) * x) + (int64_t(b) * y);
+        int64_t result_y = initial_y + (int64_t(c) * x) + (int64_t(d) * y);
+        output_ptr[index] = fixed_point(fixed::from_data(int(result_x >> precision)),
+                                        fixed::from_data(int(result_y >> precision)));
+    }
+}
+
+void transform_3d(const fixed* matrix_ptr, const fixed* vectors_ptr, int count, fixed* output_ptr)
+{
+    int m00 = matrix_ptr[0].data();
+    int m01 = matrix_ptr[1].data();
+    int m02 = matrix_ptr[2].data();
+    int m10 = matrix_ptr[3].data();
+    int m11 = matrix_ptr[4].data();
+    int m12 = matrix_ptr[5].data();
+    int m20 = matrix_ptr[6].data();
+    int m21 = matrix_ptr[7].data();
+    int m22 = matrix_ptr[8].data();
+
+    for(int index = 0; index < count; ++index)
+    {
+        int x = vectors_ptr[0].data();
+        int y = vectors_ptr[1].data();
+        int z = vectors_ptr[2].data();
+        int64_t result_x = (int64_t(m00) * x) + (int64_t(m01) * y) + (int64_t(m02) * z);
+        int64_t result_y = (int64_t(m10) * x) + (int64_t(m11) * y) + (int64_t(m12) * z);
+        int64_t result_z = (int64_t(m20) * x) + (int64_t(m21) * y) + (int64_t(m22) * z);
+        output_ptr[0] = fixed::from_data(int(result_x >> precision));
+        output_ptr[1] = fixed::from_data(int(result_y >> precision));
+        output_ptr[2] = fixed::from_data(int(result_z >> precision));
+        vectors_ptr += 3;
+        output_ptr += 3;
+    }
+}
+
+void project_3d(int focal_length, int center_x, int center_y, const fixed* vectors_ptr, int count,
+                fixed_point* output_ptr)
+{
+    // The focal length is shifted left as much as possible and z is reduced to 16 significant bits,
+    // so the scale given by the unsigned division has at least 14 significant bits:
+
+    unsigned focal_length_shift = unsigned(__builtin_clz(unsigned(focal_length))) - 1;
+    unsigned numerator = unsigned(focal_length) << focal_length_shift;
+
+    for(int index = 0; index < count; ++index)
+    {
+        int x = vectors_ptr[0].data();
+        int y = vectors_ptr[1].data();
+        int signed_z = vectors_ptr[2].data();
+        BN_ASSERT(signed_z > 0, "Invalid z: ", index, " - ", signed_z);
+
+        auto z = unsigned(signed_z);
+        unsigned shift = focal_length_shift;
+
+        if(z > 0xFFFF) [[unlikely]]
+        {
+            unsigned z_shift = 16 - unsigned(__builtin_clz(z));
+            z >>= z_shift;
+            shift += z_shift;
+        }
+
+        auto scale = int(numerator / z);
+        output_ptr[index] = fixed_point(fixed::from_data(center_x + int((int64_t(x) * scale) >> shift)),
+                                        fixed::from_data(center_y + int((int64_t(y) * scale) >> shift)));
+        vectors_ptr += 3;
+    }
+}
+
+}
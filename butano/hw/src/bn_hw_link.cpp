@@ -180,6 +180,21 @@ void send(int data_to_send)
     }
 }
 
+int pending_messages()
+{
+    BN_BARRIER;
+    data.blockSendMessages = true;
+    BN_BARRIER;
+
+    int result = data.sendMessages.size() + data.connection.linkState._outgoingMessages.size();
+
+    BN_BARRIER;
+    data.blockSendMessages = false;
+    BN_BARRIER;
+
+    return result;
+}
+
 bool receive(LinkResponse& response)
 {
     _check_active();
@@ -21,6 +21,14 @@ namespace bn::hw::memory
 static_assert(BN_CFG_EWRAM_WAIT_STATE == BN_EWRAM_WAIT_STATE_2 ||
         BN_CFG_EWRAM_WAIT_STATE == BN_EWRAM_WAIT_STATE_1);
 
+namespace
+{
+    constexpr unsigned stack_paint_value = 0xB17A9057;
+
+    // Bytes below the current stack pointer that are not painted (paint_stack_iwram stack frame):
+    constexpr int stack_paint_margin = 512;
+}
+
 #if BN_CFG_EWRAM_WAIT_STATE == BN_EWRAM_WAIT_STATE_1
     namespace
     {
@@ -58,6 +66,32 @@ int used_stack_iwram(int current_stack_address)
     return iwram_top - iwram_stack;
 }
 
+void paint_stack_iwram(int current_stack_address)
+{
+    auto stack_it = reinterpret_cast<unsigned*>(&__fini_array_end);
+    auto stack_end = reinterpret_cast<unsigned*>(current_stack_address - stack_paint_margin);
+
+    while(stack_it < stack_end)
+    {
+        *stack_it = stack_paint_value;
+        ++stack_it;
+    }
+}
+
+int max_used_stack_iwram()
+{
+    auto stack_it = reinterpret_cast<const unsigned*>(&__fini_array_end);
+    auto stack_end = reinterpret_cast<const unsigned*>(&__iwram_top);
+
+    while(stack_it < stack_end && *stack_it == stack_paint_value)
+    {
+        ++stack_it;
+    }
+
+    auto iwram_top = reinterpret_cast<const uint8_t*>(stack_end);
+    return iwram_top - reinterpret_cast<const uint8_t*>(stack_it);
+}
+
 int used_static_iwram()
 {
     auto iwram_start = reinterpret_cast<uint8_t*>(&__iwram_start__);
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_stream_music.h"
+
+namespace bn::hw::stream_music
+{
+
+namespace
+{
+    constexpr int8_t index_table[] = {
+        -1, -1, -1, -1, 2, 4, 6, 8,
+        -1, -1, -1, -1, 2, 4, 6, 8
+    };
+
+    constexpr uint16_t step_table[] = {
+        7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+        19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+        50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+        130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+        337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+        876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+        2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+        5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+        15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+    };
+
+    constexpr int max_step_index = int(sizeof(step_table) / sizeof(uint16_t)) - 1;
+
+    void _decode_pcm(const uint8_t* data, int position, int volume, int8_t* output_ptr, int output_size)
+    {
+        auto input_ptr = reinterpret_cast<const int8_t*>(data) + position;
+
+        for(int index = 0; index < output_size; ++index)
+        {
+            output_ptr[index] = int8_t((input_ptr[index] * volume) >> 8);
+        }
+    }
+
+    void _decode_adpcm(decoder& decoder, int position, int8_t* output_ptr, int output_size)
+    {
+        const uint8_t* data = decoder.data;
+        int predictor = decoder.predictor;
+        int step_index = decoder.step_index;
+        int volume = decoder.volume;
+
+        for(int index = 0; index < output_size; ++index, ++position)
+        {
+            // Low nibble first:
+
+            int nibble = (data[position >> 1] >> ((position & 1) * 4)) & 0xF;
+            int step = step_table[step_index];
+            int difference = step >> 3;
+
+            if(nibble & 4)
+            {
+                difference += step;
+            }
+
+            if(nibble & 2)
+            {
+                difference += step >> 1;
+            }
+
+            if(nibble & 1)
+            {
+                difference += step >> 2;
+            }
+
+            if(nibble & 8)
+            {
+                predictor -= difference;
+
+                if(predictor < -32768)
+                {
+                    predictor = -32768;
+                }
+            }
+            else
+            {
+                predictor += difference;
+
+                if(predictor > 32767)
+                {
+                    predictor = 32767;
+                }
+            }
+
+            step_index += index_table[nibble];
+
+            if(step_index < 0)
+            {
+                step_index = 0;
+            }
+            else if(step_index > max_step_index)
+            {
+                step_index = max_step_index;
+            }
+
+            output_ptr[index] = int8_t((predictor * volume) >> 16);
+        }
+
+        decoder.predictor = predictor;
+        decoder.step_index = step_index;
+    }
+}
+
+void decode(decoder& decoder, int8_t* output_ptr, int output_size)
+{
+    while(output_size)
+    {
+        int position = decoder.position;
+        int available_samples = decoder.samples_count - position;
+
+        if(! available_samples)
+        {
+            // Empty streams can't be looped:
+
+            if(! decoder.loop || ! decoder.samples_count)
+            {
+                decoder.finished = true;
+
+                for(int index = 0; index < output_size; ++index)
+                {
+                    output_ptr[index] = 0;
+                }
+
+                return;
+            }
+
+            // Looping restarts the track with the initial decoder state:
+
+            decoder.position = 0;
+            decoder.predictor = 0;
+            decoder.step_index = 0;
+            continue;
+        }
+
+        int decode_size = available_samples < output_size ? available_samples : output_size;
+
+        if(decoder.adpcm)
+        {
+            _decode_adpcm(decoder, position, output_ptr, decode_size);
+        }
+        else
+        {
+            _decode_pcm(decoder.data, position, decoder.volume, output_ptr, decode_size);
+        }
+
+        decoder.position = position + decode_size;
+        output_ptr += decode_size;
+        output_size -= decode_size;
+    }
+}
+
+void mix(decoder& decoder, int8_t* left_output_ptr, int8_t* right_output_ptr, int output_size)
+{
+    // Samples are decoded in small chunks, since this can be called from an interrupt handler:
+
+    constexpr int chunk_size = 32;
+    alignas(int) int8_t chunk[chunk_size];
+
+    while(output_size)
+    {
+        int mix_size = output_size < chunk_size ? output_size : chunk_size;
+        decode(decoder, chunk, mix_size);
+
+        for(int index = 0; index < mix_size; ++index)
+        {
+            int sample = chunk[index];
+            int left_sample = left_output_ptr[index] + sample;
+            int right_sample = right_output_ptr[index] + sample;
+            left_output_ptr[index] = int8_t(left_sample < -128 ? -128 : left_sample > 127 ? 127 : left_sample);
+            right_output_ptr[index] = int8_t(right_sample < -128 ? -128 : right_sample > 127 ? 127 : right_sample);
+        }
+
+        left_output_ptr += mix_size;
+        right_output_ptr += mix_size;
+        output_size -= mix_size;
+    }
+}
+
+}
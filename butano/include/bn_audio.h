@@ -13,7 +13,7 @@
  * @ingroup audio
  */
 
-#include "bn_common.h"
+#include "bn_fixed.h"
 
 /**
  * @brief Audio related functions.
@@ -35,6 +35,8 @@ namespace bn::audio
      *
      * Updating audio on the V-Blank interrupt helps to reduce audio noise
      * but increases the possibility of visual bugs because of lack of V-Blank time.
+     *
+     * Its default value is specified by @ref BN_CFG_AUDIO_UPDATE_ON_VBLANK.
      */
     void set_update_on_vblank(bool update_on_vblank);
 
@@ -50,6 +52,59 @@ namespace bn::audio
      * in the same position (e.g. pausing and resuming them at the same time).
      */
     void set_dmg_sync_enabled(bool dmg_sync_enabled);
+
+    /**
+     * @brief Returns the CPU usage of the audio update of the last elapsed frame
+     * (Direct Sound mixing plus DMG music player).
+     *
+     * Audio is updated after the V-Blank commit or in the V-Blank interrupt (see audio::update_on_vblank),
+     * so this time is not included in bn::core::last_cpu_usage.
+     */
+    [[nodiscard]] fixed last_cpu_usage();
+
+    /**
+     * @brief Returns the CPU usage of the Direct Sound mixing of the last elapsed frame.
+     */
+    [[nodiscard]] fixed last_direct_sound_cpu_usage();
+
+    /**
+     * @brief Returns the CPU usage of the DMG music player of the last elapsed frame.
+     */
+    [[nodiscard]] fixed last_dmg_cpu_usage();
+
+    /**
+     * @brief Returns the number of active Direct Sound channels (music and sound effects)
+     * after the last elapsed frame.
+     */
+    [[nodiscard]] int last_direct_sound_channels();
+
+    /**
+     * @brief Returns the maximum CPU usage of the audio update of a single frame since the last reset.
+     */
+    [[nodiscard]] fixed max_cpu_usage();
+
+    /**
+     * @brief Returns the maximum CPU usage of the Direct Sound mixing of a single frame since the last reset.
+     */
+    [[nodiscard]] fixed max_direct_sound_cpu_usage();
+
+    /**
+     * @brief Returns the maximum CPU usage of the DMG music player of a single frame since the last reset.
+     */
+    [[nodiscard]] fixed max_dmg_cpu_usage();
+
+    /**
+     * @brief Returns the maximum number of active Direct Sound channels since the last reset.
+     *
+     * It can be used to choose @ref BN_CFG_AUDIO_MAX_MUSIC_CHANNELS
+     * and @ref BN_CFG_AUDIO_MAX_SOUND_CHANNELS values.
+     */
+    [[nodiscard]] int max_direct_sound_channels();
+
+    /**
+     * @brief Resets the maximum CPU usage values and the maximum number of active Direct Sound channels.
+     */
+    void reset_max_usage();
 }
 
 #endif
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CAMERA_3D_H
+#define BN_CAMERA_3D_H
+
+/**
+ * @file
+ * bn::camera_3d header file.
+ *
+ * @ingroup models_3d
+ */
+
+#include "bn_point_3d.h"
+
+namespace bn
+{
+
+/**
+ * @brief Top-down 3D camera which looks down the vertical axis and can rotate around it.
+ *
+ * @ingroup models_3d
+ */
+class camera_3d
+{
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    camera_3d();
+
+    /**
+     * @brief Returns the position in the 3D world.
+     */
+    [[nodiscard]] const point_3d& position() const
+    {
+        return _position;
+    }
+
+    /**
+     * @brief Sets the position in the 3D world.
+     * @param position Position in the 3D world (y >= 2).
+     */
+    void set_position(const point_3d& position);
+
+    /**
+     * @brief Returns the rotation angle around the vertical axis (360 degrees = 65536).
+     */
+    [[nodiscard]] fixed phi() const
+    {
+        return _phi;
+    }
+
+    /**
+     * @brief Sets the rotation angle around the vertical axis.
+     * @param phi Rotation angle around the vertical axis (360 degrees = 65536).
+     */
+    void set_phi(fixed phi);
+
+    /**
+     * @brief Returns the 3D world direction of the screen horizontal axis.
+     */
+    [[nodiscard]] const point_3d& u() const
+    {
+        return _u;
+    }
+
+    /**
+     * @brief Returns the 3D world direction of the screen vertical axis.
+     */
+    [[nodiscard]] const point_3d& v() const
+    {
+        return _v;
+    }
+
+private:
+    point_3d _position;
+    fixed _phi;
+    point_3d _u;
+    point_3d _v;
+};
+
+}
+
+#endif
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_COLLIDER_H
+#define BN_COLLIDER_H
+
+/**
+ * @file
+ * bn::collider header file.
+ *
+ * @ingroup collision
+ */
+
+#include "bn_assert.h"
+#include "bn_fixed_rect.h"
+
+namespace bn
+{
+
+/**
+ * @brief Rectangle or circle used by collision detection modules like bn::collision_grid.
+ *
+ * @ingroup collision
+ */
+class collider
+{
+
+public:
+    /**
+     * @brief Default constructor.
+     *
+     * It creates a rectangle collider with zero size in the origin.
+     */
+    constexpr collider() = default;
+
+    /**
+     * @brief Creates a rectangle collider.
+     * @param rect Rectangle.
+     */
+    constexpr collider(const fixed_rect& rect) :
+        _rect(rect)
+    {
+    }
+
+    /**
+     * @brief Creates a circle collider.
+     * @param center Position of the center point of the circle.
+     * @param radius Radius of the circle (> 0).
+     */
+    constexpr collider(const fixed_point& center, fixed radius) :
+        _rect(center, fixed_size(radius * 2, radius * 2)),
+        _radius(radius)
+    {
+        BN_ASSERT(radius > 0, "Invalid radius: ", radius);
+    }
+
+    /**
+     * @brief Returns the position of the center point of the collider.
+     */
+    [[nodiscard]] constexpr const fixed_point& position() const
+    {
+        return _rect.position();
+    }
+
+    /**
+     * @brief Sets the position of the center point of the collider.
+     */
+    constexpr void set_position(const fixed_point& position)
+    {
+        _rect.set_position(position);
+    }
+
+    /**
+     * @brief Returns the bounding rectangle of the collider.
+     */
+    [[nodiscard]] constexpr const fixed_rect& rect() const
+    {
+        return _rect;
+    }
+
+    /**
+     * @brief Returns the radius of the collider if it is a circle, or 0 if it is a rectangle.
+     */
+    [[nodiscard]] constexpr fixed radius() const
+    {
+        return _radius;
+    }
+
+    /**
+     * @brief Indicates if the collider is a circle or a rectangle.
+     */
+    [[nodiscard]] constexpr bool circle() const
+    {
+        return _radius > 0;
+    }
+
+    /**
+     * @brief Indicates if this collider intersects with the given one or not.
+     *
+     * Like bn::fixed_rect::intersects, colliders which only share an edge don't intersect.
+     */
+    [[nodiscard]] constexpr bool intersects(const collider& other) const
+    {
+        if(! _rect.intersects(other._rect))
+        {
+            return false;
+        }
+
+        if(circle())
+        {
+            if(other.circle())
+            {
+                return _circles_intersect(_rect.position(), _radius + other._radius, other._rect.position());
+            }
+
+            return _circle_intersects_rect(_rect.position(), _radius, other._rect);
+        }
+
+        if(other.circle())
+        {
+            return _circle_intersects_rect(other._rect.position(), other._radius, _rect);
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Default equal operator.
+     */
+    [[nodiscard]] constexpr friend bool operator==(const collider& a, const collider& b) = default;
+
+private:
+    fixed_rect _rect;
+    fixed _radius;
+
+    [[nodiscard]] static constexpr bool _circles_intersect(const fixed_point& center, fixed radius,
+                                                           const fixed_point& point)
+    {
+        int64_t dx = center.x().data() - point.x().data();
+        int64_t dy = center.y().data() - point.y().data();
+        int64_t r = radius.data();
+        return (dx * dx) + (dy * dy) < r * r;
+    }
+
+    [[nodiscard]] static constexpr bool _circle_intersects_rect(const fixed_point& center, fixed radius,
+                                                                const fixed_rect& rect)
+    {
+        fixed closest_x = center.x();
+        fixed closest_y = center.y();
+
+        if(closest_x < rect.left())
+        {
+            closest_x = rect.left();
+        }
+        else if(closest_x > rect.right())
+        {
+            closest_x = rect.right();
+        }
+
+        if(closest_y < rect.top())
+        {
+            closest_y = rect.top();
+        }
+        else if(closest_y > rect.bottom())
+        {
+            closest_y = rect.bottom();
+        }
+
+        return _circles_intersect(center, radius, fixed_point(closest_x, closest_y));
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,588 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_COLLISION_GRID_H
+#define BN_COLLISION_GRID_H
+
+/**
+ * @file
+ * bn::icollision_grid and bn::collision_grid header file.
+ *
+ * @ingroup collision
+ */
+
+#include "bn_collider.h"
+#include "bn_power_of_two.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::collision_grid.
+ *
+ * Can be used as a reference type for all bn::collision_grid objects.
+ *
+ * @ingroup collision
+ */
+class icollision_grid
+{
+
+public:
+    icollision_grid(const icollision_grid& other) = delete;
+
+    icollision_grid& operator=(const icollision_grid& other) = delete;
+
+    /**
+     * @brief Returns the number of colliders.
+     */
+    [[nodiscard]] int size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief Returns the maximum number of colliders.
+     */
+    [[nodiscard]] int max_size() const
+    {
+        return _max_size;
+    }
+
+    /**
+     * @brief Returns the number of colliders that can still be added.
+     */
+    [[nodiscard]] int available() const
+    {
+        return _max_size - _size;
+    }
+
+    /**
+     * @brief Indicates if it doesn't contain any collider.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Indicates if it can't contain any more colliders.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _size == _max_size;
+    }
+
+    /**
+     * @brief Returns the number of columns of the grid.
+     */
+    [[nodiscard]] int columns() const
+    {
+        return _columns;
+    }
+
+    /**
+     * @brief Returns the number of rows of the grid.
+     */
+    [[nodiscard]] int rows() const
+    {
+        return _rows;
+    }
+
+    /**
+     * @brief Returns the width and the height of each cell of the grid.
+     */
+    [[nodiscard]] int cell_size() const
+    {
+        return 1 << (_cell_shift - fixed::precision());
+    }
+
+    /**
+     * @brief Returns the position of the top-left corner of the grid.
+     */
+    [[nodiscard]] fixed_point top_left() const
+    {
+        return fixed_point(fixed::from_data(_left), fixed::from_data(_top));
+    }
+
+    /**
+     * @brief Indicates if the given id references a collider of the grid or not.
+     */
+    [[nodiscard]] bool contains(int id) const
+    {
+        return id >= 0 && id < _max_size && _items[id].cell >= 0;
+    }
+
+    /**
+     * @brief Returns the collider referenced by the given id.
+     */
+    [[nodiscard]] const collider& at(int id) const
+    {
+        return _item(id).item_collider;
+    }
+
+    /**
+     * @brief Returns the layers of the collider referenced by the given id.
+     */
+    [[nodiscard]] unsigned layers(int id) const
+    {
+        return _item(id).layers;
+    }
+
+    /**
+     * @brief Returns the layers that the collider referenced by the given id collides with.
+     */
+    [[nodiscard]] unsigned mask(int id) const
+    {
+        return _item(id).mask;
+    }
+
+    /**
+     * @brief Adds a collider.
+     * @param collider Collider to add.
+     * Its width and height can't be greater than the cell size of the grid.
+     * @param layers Layers of the collider.
+     * @param mask Layers that the collider collides with.
+     * @return Id of the new collider, in the range [0..max_size()).
+     * It remains valid until the collider is removed.
+     */
+    int add(const collider& collider, unsigned layers = 1, unsigned mask = 0xFFFFFFFF)
+    {
+        BN_ASSERT(! full(), "Grid is full");
+
+        int id = _free_id;
+        item_type& item = _items[id];
+        _free_id = item.next;
+        ++_size;
+
+        item.layers = layers;
+        item.mask = mask;
+        _set_collider(item, collider);
+        _link(id, item, _cell(collider.position()));
+        return id;
+    }
+
+    /**
+     * @brief Removes the collider referenced by the given id.
+     */
+    void remove(int id)
+    {
+        item_type& item = _item(id);
+        _unlink(item);
+        item.cell = -1;
+        item.next = int16_t(_free_id);
+        _free_id = id;
+        --_size;
+    }
+
+    /**
+     * @brief Replaces the collider referenced by the given id.
+     *
+     * The collider is moved to another cell only if its position has moved to another cell.
+     *
+     * @param id Id of the collider to replace.
+     * @param collider New collider. Its width and height can't be greater than the cell size of the grid.
+     */
+    void set_collider(int id, const collider& collider)
+    {
+        item_type& item = _item(id);
+        _set_collider(item, collider);
+        _move(id, item);
+    }
+
+    /**
+     * @brief Sets the position of the center point of the collider referenced by the given id.
+     *
+     * The collider is moved to another cell only if its position has moved to another cell.
+     */
+    void set_position(int id, const fixed_point& position)
+    {
+        item_type& item = _item(id);
+        item.item_collider.set_position(position);
+        _move(id, item);
+    }
+
+    /**
+     * @brief Sets the layers of the collider referenced by the given id.
+     */
+    void set_layers(int id, unsigned layers)
+    {
+        _item(id).layers = layers;
+    }
+
+    /**
+     * @brief Sets the layers that the collider referenced by the given id collides with.
+     */
+    void set_mask(int id, unsigned mask)
+    {
+        _item(id).mask = mask;
+    }
+
+    /**
+     * @brief Removes all colliders.
+     */
+    void clear()
+    {
+        for(int index = 0, limit = _columns * _rows; index < limit; ++index)
+        {
+            _cells[index] = -1;
+        }
+
+        for(int id = 0; id < _max_size; ++id)
+        {
+            item_type& item = _items[id];
+            item.cell = -1;
+            item.next = int16_t(id + 1 < _max_size ? id + 1 : -1);
+        }
+
+        _free_id = 0;
+        _size = 0;
+    }
+
+    /**
+     * @brief Calls the given function with the id of each collider which intersects the given area.
+     *
+     * The grid can't be modified by the given function.
+     *
+     * @param area Area to check.
+     * @param mask Only colliders with at least one of these layers are checked.
+     * @param function Function object called with the id of each intersecting collider.
+     */
+    template<typename Function>
+    void for_each_collision(const collider& area, unsigned mask, const Function& function) const
+    {
+        _visit(area, mask, -1, [&function](int id)
+        {
+            function(id);
+            return false;
+        });
+    }
+
+    /**
+     * @brief Calls the given function with the id of each collider
+     * which intersects the collider referenced by the given id.
+     *
+     * The grid can't be modified by the given function.
+     *
+     * @param id Id of the collider to check. Its mask specifies the layers of the colliders to check.
+     * @param function Function object called with the id of each intersecting collider.
+     */
+    template<typename Function>
+    void for_each_collision(int id, const Function& function) const
+    {
+        const item_type& item = _item(id);
+
+        _visit(item.item_collider, item.mask, id, [&function](int other_id)
+        {
+            function(other_id);
+            return false;
+        });
+    }
+
+    /**
+     * @brief Searches a collider which intersects the given area.
+     * @param area Area to check.
+     * @param mask Only colliders with at least one of these layers are checked.
+     * @return Id of the first intersecting collider found, or -1 if there's none.
+     */
+    [[nodiscard]] int find_collision(const collider& area, unsigned mask) const
+    {
+        return _find(area, mask, -1);
+    }
+
+    /**
+     * @brief Searches a collider which intersects the collider referenced by the given id.
+     * @param id Id of the collider to check. Its mask specifies the layers of the colliders to check.
+     * @return Id of the first intersecting collider found, or -1 if there's none.
+     */
+    [[nodiscard]] int find_collision(int id) const
+    {
+        const item_type& item = _item(id);
+        return _find(item.item_collider, item.mask, id);
+    }
+
+    /**
+     * @brief Calls the given function once for each pair of intersecting colliders.
+     *
+     * A pair is reported if the mask of the first collider has at least one of the layers of the second one.
+     * If both colliders collide with each other, the first one is the one with the lowest id.
+     *
+     * The grid can't be modified by the given function.
+     *
+     * @param function Function object called with the ids of both colliders of each intersecting pair.
+     */
+    template<typename Function>
+    void for_each_pair(const Function& function) const
+    {
+        const item_type* items = _items;
+
+        for(int id = 0; id < _max_size; ++id)
+        {
+            const item_type& item = items[id];
+
+            if(item.cell >= 0 && item.mask)
+            {
+                unsigned layers = item.layers;
+
+                _visit(item.item_collider, item.mask, id, [&function, items, id, layers](int other_id)
+                {
+                    if(other_id > id || ! (items[other_id].mask & layers))
+                    {
+                        function(id, other_id);
+                    }
+
+                    return false;
+                });
+            }
+        }
+    }
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    class item_type
+    {
+
+    public:
+        collider item_collider;
+        unsigned layers = 0;
+        unsigned mask = 0;
+        int16_t cell = -1;
+        int16_t previous = -1;
+        int16_t next = -1;
+    };
+
+    icollision_grid(item_type& items, int16_t& cells, int max_size, int columns, int rows, int cell_size,
+                    const fixed_point& top_left) :
+        _items(&items),
+        _cells(&cells),
+        _left(top_left.x().data()),
+        _top(top_left.y().data()),
+        _max_size(max_size),
+        _columns(columns),
+        _rows(rows),
+        _cell_shift(fixed::precision())
+    {
+        BN_ASSERT(power_of_two(cell_size), "Cell size is not a power of two: ", cell_size);
+
+        while(cell_size > 1)
+        {
+            cell_size >>= 1;
+            ++_cell_shift;
+        }
+    }
+
+    /// @endcond
+
+private:
+    item_type* _items;
+    int16_t* _cells;
+    int _left;
+    int _top;
+    int _max_size;
+    int _columns;
+    int _rows;
+    int _cell_shift;
+    int _free_id = 0;
+    int _size = 0;
+
+    [[nodiscard]] const item_type& _item(int id) const
+    {
+        BN_ASSERT(contains(id), "Invalid id: ", id);
+
+        return _items[id];
+    }
+
+    [[nodiscard]] item_type& _item(int id)
+    {
+        BN_ASSERT(contains(id), "Invalid id: ", id);
+
+        return _items[id];
+    }
+
+    [[nodiscard]] int _column(int x_data) const
+    {
+        int column = (x_data - _left) >> _cell_shift;
+        return column < 0 ? 0 : column >= _columns ? _columns - 1 : column;
+    }
+
+    [[nodiscard]] int _row(int y_data) const
+    {
+        int row = (y_data - _top) >> _cell_shift;
+        return row < 0 ? 0 : row >= _rows ? _rows - 1 : row;
+    }
+
+    [[nodiscard]] int _cell(const fixed_point& position) const
+    {
+        return (_row(position.y().data()) * _columns) + _column(position.x().data());
+    }
+
+    void _set_collider(item_type& item, const collider& collider)
+    {
+        [[maybe_unused]] const fixed_size& dimensions = collider.rect().dimensions();
+        BN_ASSERT(dimensions.width() <= cell_size() && dimensions.height() <= cell_size(),
+                  "Collider is bigger than cell size: ", dimensions.width(), " - ", dimensions.height(),
+                  " - ", cell_size());
+
+        item.item_collider = collider;
+    }
+
+    void _link(int id, item_type& item, int cell)
+    {
+        int16_t& cell_head = _cells[cell];
+        item.cell = int16_t(cell);
+        item.previous = -1;
+        item.next = cell_head;
+
+        if(cell_head >= 0)
+        {
+            _items[cell_head].previous = int16_t(id);
+        }
+
+        cell_head = int16_t(id);
+    }
+
+    void _unlink(const item_type& item)
+    {
+        int previous = item.previous;
+        int next = item.next;
+
+        if(previous >= 0)
+        {
+            _items[previous].next = int16_t(next);
+        }
+        else
+        {
+            _cells[item.cell] = int16_t(next);
+        }
+
+        if(next >= 0)
+        {
+            _items[next].previous = int16_t(previous);
+        }
+    }
+
+    void _move(int id, item_type& item)
+    {
+        int cell = _cell(item.item_collider.position());
+
+        if(cell != item.cell)
+        {
+            _unlink(item);
+            _link(id, item, cell);
+        }
+    }
+
+    [[nodiscard]] int _find(const collider& area, unsigned mask, int excluded_id) const
+    {
+        int result = -1;
+
+        _visit(area, mask, excluded_id, [&result](int id)
+        {
+            result = id;
+            return true;
+        });
+
+        return result;
+    }
+
+    template<typename Visitor>
+    void _visit(const collider& area, unsigned mask, int excluded_id, const Visitor& visitor) const
+    {
+        // Colliders are stored in the cell of their center and they can't be bigger than a cell,
+        // so the cells of the colliders which can intersect the area are inside the area extended by half a cell:
+
+        const fixed_rect& area_rect = area.rect();
+        int half_cell_size = 1 << (_cell_shift - 1);
+        int first_column = _column(area_rect.left().data() - half_cell_size);
+        int last_column = _column(area_rect.right().data() + half_cell_size);
+        int first_row = _row(area_rect.top().data() - half_cell_size);
+        int last_row = _row(area_rect.bottom().data() + half_cell_size);
+        const item_type* items = _items;
+        const int16_t* cells_row = _cells + (first_row * _columns);
+
+        for(int row = first_row; row <= last_row; ++row)
+        {
+            for(int column = first_column; column <= last_column; ++column)
+            {
+                int id = cells_row[column];
+
+                while(id >= 0)
+                {
+                    const item_type& item = items[id];
+
+                    if((item.layers & mask) && id != excluded_id && area.intersects(item.item_collider))
+                    {
+                        if(visitor(id))
+                        {
+                            return;
+                        }
+                    }
+
+                    id = item.next;
+                }
+            }
+
+            cells_row += _columns;
+        }
+    }
+};
+
+
+/**
+ * @brief Broadphase collision detection with a fixed capacity uniform grid.
+ *
+ * Each collider is stored in the cell of its center, so moving a collider is an O(1) operation
+ * and queries only check colliders of the cells around the given area.
+ *
+ * Colliders outside the grid are stored in its border cells, so they are still detected, but more slowly.
+ *
+ * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
+ *
+ * @tparam MaxColliders Maximum number of colliders that can be stored.
+ * @tparam Columns Number of columns of the grid.
+ * @tparam Rows Number of rows of the grid.
+ *
+ * @ingroup collision
+ */
+template<int MaxColliders, int Columns, int Rows>
+class collision_grid : public icollision_grid
+{
+    static_assert(MaxColliders > 0 && MaxColliders <= 32767);
+    static_assert(Columns > 0 && Rows > 0 && Columns * Rows <= 32767);
+
+public:
+    /**
+     * @brief Constructor.
+     *
+     * The grid is centered in the origin, like sprites and backgrounds.
+     *
+     * @param cell_size Width and height of each cell of the grid.
+     * It must be a power of two, not smaller than the width and the height of the biggest collider.
+     */
+    explicit collision_grid(int cell_size) :
+        collision_grid(cell_size, fixed_point(-(Columns * cell_size) / 2, -(Rows * cell_size) / 2))
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param cell_size Width and height of each cell of the grid.
+     * It must be a power of two, not smaller than the width and the height of the biggest collider.
+     * @param top_left Position of the top-left corner of the grid.
+     */
+    collision_grid(int cell_size, const fixed_point& top_left) :
+        icollision_grid(*_items_buffer, *_cells_buffer, MaxColliders, Columns, Rows, cell_size, top_left)
+    {
+        clear();
+    }
+
+private:
+    item_type _items_buffer[MaxColliders];
+    int16_t _cells_buffer[Columns * Rows];
+};
+
+}
+
+#endif
@@ -0,0 +1,519 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_COLLISION_SWEEP_H
+#define BN_COLLISION_SWEEP_H
+
+/**
+ * @file
+ * bn::icollision_sweep and bn::collision_sweep header file.
+ *
+ * @ingroup collision
+ */
+
+#include "bn_collider.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::collision_sweep.
+ *
+ * Can be used as a reference type for all bn::collision_sweep objects.
+ *
+ * @ingroup collision
+ */
+class icollision_sweep
+{
+
+public:
+    icollision_sweep(const icollision_sweep& other) = delete;
+
+    icollision_sweep& operator=(const icollision_sweep& other) = delete;
+
+    /**
+     * @brief Returns the number of colliders.
+     */
+    [[nodiscard]] int size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief Returns the maximum number of colliders.
+     */
+    [[nodiscard]] int max_size() const
+    {
+        return _max_size;
+    }
+
+    /**
+     * @brief Returns the number of colliders that can still be added.
+     */
+    [[nodiscard]] int available() const
+    {
+        return _max_size - _size;
+    }
+
+    /**
+     * @brief Indicates if it doesn't contain any collider.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Indicates if it can't contain any more colliders.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _size == _max_size;
+    }
+
+    /**
+     * @brief Indicates if the given id references a collider or not.
+     */
+    [[nodiscard]] bool contains(int id) const
+    {
+        return id >= 0 && id < _max_size && _items[id].entry >= 0;
+    }
+
+    /**
+     * @brief Returns the collider referenced by the given id.
+     */
+    [[nodiscard]] const collider& at(int id) const
+    {
+        return _item(id).item_collider;
+    }
+
+    /**
+     * @brief Returns the layers of the collider referenced by the given id.
+     */
+    [[nodiscard]] unsigned layers(int id) const
+    {
+        return _item(id).layers;
+    }
+
+    /**
+     * @brief Returns the layers that the collider referenced by the given id collides with.
+     */
+    [[nodiscard]] unsigned mask(int id) const
+    {
+        return _item(id).mask;
+    }
+
+    /**
+     * @brief Adds a collider.
+     * @param collider Collider to add.
+     * @param layers Layers of the collider.
+     * @param mask Layers that the collider collides with.
+     * @return Id of the new collider, in the range [0..max_size()).
+     * It remains valid until the collider is removed.
+     */
+    int add(const collider& collider, unsigned layers = 1, unsigned mask = 0xFFFFFFFF)
+    {
+        BN_ASSERT(! full(), "Sweep is full");
+
+        int id = _free_id;
+        item_type& item = _items[id];
+        entry_type& entry = _entries[_size];
+        _free_id = item.next;
+        item.item_collider = collider;
+        item.layers = layers;
+        item.mask = mask;
+        item.entry = int16_t(_size);
+        entry.id = id;
+        ++_size;
+        _sorted = false;
+        return id;
+    }
+
+    /**
+     * @brief Removes the collider referenced by the given id.
+     */
+    void remove(int id)
+    {
+        item_type& item = _item(id);
+        int last_entry_index = _size - 1;
+
+        if(item.entry != last_entry_index)
+        {
+            entry_type& entry = _entries[item.entry];
+            entry = _entries[last_entry_index];
+            _items[entry.id].entry = item.entry;
+        }
+
+        item.entry = -1;
+        item.next = int16_t(_free_id);
+        _free_id = id;
+        _size = last_entry_index;
+        _sorted = false;
+    }
+
+    /**
+     * @brief Replaces the collider referenced by the given id.
+     */
+    void set_collider(int id, const collider& collider)
+    {
+        _item(id).item_collider = collider;
+        _sorted = false;
+    }
+
+    /**
+     * @brief Sets the position of the center point of the collider referenced by the given id.
+     */
+    void set_position(int id, const fixed_point& position)
+    {
+        _item(id).item_collider.set_position(position);
+        _sorted = false;
+    }
+
+    /**
+     * @brief Sets the layers of the collider referenced by the given id.
+     */
+    void set_layers(int id, unsigned layers)
+    {
+        _item(id).layers = layers;
+    }
+
+    /**
+     * @brief Sets the layers that the collider referenced by the given id collides with.
+     */
+    void set_mask(int id, unsigned mask)
+    {
+        _item(id).mask = mask;
+    }
+
+    /**
+     * @brief Removes all colliders.
+     */
+    void clear()
+    {
+        for(int id = 0; id < _max_size; ++id)
+        {
+            item_type& item = _items[id];
+            item.entry = -1;
+            item.next = int16_t(id + 1 < _max_size ? id + 1 : -1);
+        }
+
+        _free_id = 0;
+        _size = 0;
+        _sorted = true;
+    }
+
+    /**
+     * @brief Calls the given function with the id of each collider which intersects the given area.
+     *
+     * Colliders are sorted by their left edge if they have been modified since the last query.
+     *
+     * Colliders can't be modified by the given function.
+     *
+     * @param area Area to check.
+     * @param mask Only colliders with at least one of these layers are checked.
+     * @param function Function object called with the id of each intersecting collider.
+     */
+    template<typename Function>
+    void for_each_collision(const collider& area, unsigned mask, const Function& function)
+    {
+        _visit(area, mask, -1, [&function](int id)
+        {
+            function(id);
+            return false;
+        });
+    }
+
+    /**
+     * @brief Calls the given function with the id of each collider
+     * which intersects the collider referenced by the given id.
+     *
+     * Colliders are sorted by their left edge if they have been modified since the last query.
+     *
+     * Colliders can't be modified by the given function.
+     *
+     * @param id Id of the collider to check. Its mask specifies the layers of the colliders to check.
+     * @param function Function object called with the id of each intersecting collider.
+     */
+    template<typename Function>
+    void for_each_collision(int id, const Function& function)
+    {
+        const item_type& item = _item(id);
+
+        _visit(item.item_collider, item.mask, id, [&function](int other_id)
+        {
+            function(other_id);
+            return false;
+        });
+    }
+
+    /**
+     * @brief Searches a collider which intersects the given area.
+     *
+     * Colliders are sorted by their left edge if they have been modified since the last query.
+     *
+     * @param area Area to check.
+     * @param mask Only colliders with at least one of these layers are checked.
+     * @return Id of the first intersecting collider found, or -1 if there's none.
+     */
+    [[nodiscard]] int find_collision(const collider& area, unsigned mask)
+    {
+        return _find(area, mask, -1);
+    }
+
+    /**
+     * @brief Searches a collider which intersects the collider referenced by the given id.
+     *
+     * Colliders are sorted by their left edge if they have been modified since the last query.
+     *
+     * @param id Id of the collider to check. Its mask specifies the layers of the colliders to check.
+     * @return Id of the first intersecting collider found, or -1 if there's none.
+     */
+    [[nodiscard]] int find_collision(int id)
+    {
+        const item_type& item = _item(id);
+        return _find(item.item_collider, item.mask, id);
+    }
+
+    /**
+     * @brief Calls the given function once for each pair of intersecting colliders.
+     *
+     * A pair is reported if the mask of the first collider has at least one of the layers of the second one.
+     * If both colliders collide with each other, the first one is the one with the lowest id.
+     *
+     * Colliders are sorted by their left edge if they have been modified since the last query.
+     *
+     * Colliders can't be modified by the given function.
+     *
+     * @param function Function object called with the ids of both colliders of each intersecting pair.
+     */
+    template<typename Function>
+    void for_each_pair(const Function& function)
+    {
+        _sort();
+
+        const item_type* items = _items;
+        const entry_type* entries = _entries;
+        int size = _size;
+
+        for(int index = 0; index < size; ++index)
+        {
+            const entry_type& entry = entries[index];
+            const item_type& item = items[entry.id];
+            int right = entry.right;
+
+            for(int other_index = index + 1; other_index < size; ++other_index)
+            {
+                const entry_type& other_entry = entries[other_index];
+
+                if(other_entry.left >= right)
+                {
+                    break;
+                }
+
+                const item_type& other_item = items[other_entry.id];
+                bool collides = item.mask & other_item.layers;
+                bool other_collides = other_item.mask & item.layers;
+
+                if((collides || other_collides) && item.item_collider.intersects(other_item.item_collider))
+                {
+                    if(collides && (! other_collides || entry.id < other_entry.id))
+                    {
+                        function(entry.id, other_entry.id);
+                    }
+                    else
+                    {
+                        function(other_entry.id, entry.id);
+                    }
+                }
+            }
+        }
+    }
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    class item_type
+    {
+
+    public:
+        collider item_collider;
+        unsigned layers = 0;
+        unsigned mask = 0;
+        int16_t entry = -1;
+        int16_t next = -1;
+    };
+
+    class entry_type
+    {
+
+    public:
+        int left = 0;
+        int right = 0;
+        int id = 0;
+    };
+
+    icollision_sweep(item_type& items, entry_type& entries, int max_size) :
+        _items(&items),
+        _entries(&entries),
+        _max_size(max_size)
+    {
+    }
+
+    /// @endcond
+
+private:
+    item_type* _items;
+    entry_type* _entries;
+    int _max_size;
+    int _free_id = 0;
+    int _size = 0;
+    bool _sorted = true;
+
+    [[nodiscard]] const item_type& _item(int id) const
+    {
+        BN_ASSERT(contains(id), "Invalid id: ", id);
+
+        return _items[id];
+    }
+
+    [[nodiscard]] item_type& _item(int id)
+    {
+        BN_ASSERT(contains(id), "Invalid id: ", id);
+
+        return _items[id];
+    }
+
+    void _sort()
+    {
+        if(_sorted)
+        {
+            return;
+        }
+
+        _sorted = true;
+
+        item_type* items = _items;
+        entry_type* entries = _entries;
+        int size = _size;
+
+        for(int index = 0; index < size; ++index)
+        {
+            entry_type& entry = entries[index];
+            const fixed_rect& rect = items[entry.id].item_collider.rect();
+            entry.left = rect.left().data();
+            entry.right = rect.right().data();
+        }
+
+        // Colliders usually move a little between frames, so an insertion sort is almost linear:
+
+        for(int index = 1; index < size; ++index)
+        {
+            entry_type entry = entries[index];
+            int other_index = index - 1;
+
+            while(other_index >= 0 && entries[other_index].left > entry.left)
+            {
+                entries[other_index + 1] = entries[other_index];
+                --other_index;
+            }
+
+            entries[other_index + 1] = entry;
+        }
+
+        for(int index = 0; index < size; ++index)
+        {
+            items[entries[index].id].entry = int16_t(index);
+        }
+    }
+
+    [[nodiscard]] int _find(const collider& area, unsigned mask, int excluded_id)
+    {
+        int result = -1;
+
+        _visit(area, mask, excluded_id, [&result](int id)
+        {
+            result = id;
+            return true;
+        });
+
+        return result;
+    }
+
+    template<typename Visitor>
+    void _visit(const collider& area, unsigned mask, int excluded_id, const Visitor& visitor)
+    {
+        _sort();
+
+        const fixed_rect& area_rect = area.rect();
+        int area_left = area_rect.left().data();
+        int area_right = area_rect.right().data();
+        const item_type* items = _items;
+        const entry_type* entries = _entries;
+
+        for(int index = 0, size = _size; index < size; ++index)
+        {
+            const entry_type& entry = entries[index];
+
+            if(entry.left >= area_right)
+            {
+                return;
+            }
+
+            if(entry.right > area_left)
+            {
+                int id = entry.id;
+                const item_type& item = items[id];
+
+                if((item.layers & mask) && id != excluded_id && area.intersects(item.item_collider))
+                {
+                    if(visitor(id))
+                    {
+                        return;
+                    }
+                }
+            }
+        }
+    }
+};
+
+
+/**
+ * @brief Broadphase collision detection with the sort and sweep algorithm.
+ *
+ * Colliders are sorted by their left edge before each query, so only colliders which overlap horizontally
+ * are checked against each other.
+ *
+ * Unlike bn::collision_grid, colliders can have any size and position,
+ * but moving colliders doesn't come for free, since they must be sorted again.
+ *
+ * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
+ *
+ * @tparam MaxColliders Maximum number of colliders that can be stored.
+ *
+ * @ingroup collision
+ */
+template<int MaxColliders>
+class collision_sweep : public icollision_sweep
+{
+    static_assert(MaxColliders > 0 && MaxColliders <= 32767);
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    collision_sweep() :
+        icollision_sweep(*_items_buffer, *_entries_buffer, MaxColliders)
+    {
+        clear();
+    }
+
+private:
+    item_type _items_buffer[MaxColliders];
+    entry_type _entries_buffer[MaxColliders];
+};
+
+}
+
+#endif
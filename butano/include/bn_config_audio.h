@@ -50,6 +50,18 @@
     #define BN_CFG_AUDIO_MAX_SOUND_CHANNELS 4
 #endif
 
+/**
+ * @def BN_CFG_AUDIO_UPDATE_ON_VBLANK
+ *
+ * Specifies if audio must be updated on the V-Blank interrupt or not by default
+ * (see bn::audio::set_update_on_vblank).
+ *
+ * @ingroup audio
+ */
+#ifndef BN_CFG_AUDIO_UPDATE_ON_VBLANK
+    #define BN_CFG_AUDIO_UPDATE_ON_VBLANK false
+#endif
+
 /**
  * @def BN_CFG_AUDIO_MAX_COMMANDS
  *
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_FRAME_ALLOCATOR_H
+#define BN_CONFIG_FRAME_ALLOCATOR_H
+
+/**
+ * @file
+ * Frame allocator configuration header file.
+ *
+ * @ingroup memory
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_FRAME_ALLOCATOR_BYTES
+ *
+ * Specifies the size in bytes of the memory arena managed by the frame allocator.
+ *
+ * It must be a multiple of 4.
+ *
+ * @ingroup memory
+ */
+#ifndef BN_CFG_FRAME_ALLOCATOR_BYTES
+    #define BN_CFG_FRAME_ALLOCATOR_BYTES 4096
+#endif
+
+/**
+ * @def BN_CFG_FRAME_ALLOCATOR_IWRAM
+ *
+ * Specifies if the memory arena managed by the frame allocator must be placed in IWRAM instead of EWRAM.
+ *
+ * IWRAM is faster than EWRAM, but it is also much smaller and shared with the stack.
+ *
+ * @ingroup memory
+ */
+#ifndef BN_CFG_FRAME_ALLOCATOR_IWRAM
+    #define BN_CFG_FRAME_ALLOCATOR_IWRAM false
+#endif
+
+#endif
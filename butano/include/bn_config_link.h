@@ -64,4 +64,41 @@
     #define BN_CFG_LINK_MAX_MISSING_MESSAGES 4
 #endif
 
+/**
+ * @def BN_CFG_LINK_DMA_ENABLED
+ * Specifies if DMA must be used to commit graphics data while link communication is active.
+ *
+ * This is an experimental, opt-in option: it is disabled by default,
+ * so graphics data is committed with the CPU while link communication is active, which is much slower.
+ *
+ * The CPU is halted during DMA transfers, so link interrupts can be delayed and messages can be lost.
+ * Long DMA transfers are split so link interrupts are not delayed more than half the send wait period
+ * (see @ref BN_CFG_LINK_SEND_WAIT), but lost messages are not retransmitted by bn::link,
+ * so if it is enabled, games should be able to recover from lost messages (bn::link_packets resends
+ * game state until it is acknowledged, for example).
+ *
+ * @ingroup link
+ */
+#ifndef BN_CFG_LINK_DMA_ENABLED
+    #define BN_CFG_LINK_DMA_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_LINK_PACKETS_MAX_STATE_SIZE
+ * Specifies the maximum size in bytes of the game state sent by bn::link_packets (up to 128 bytes).
+ * @ingroup link
+ */
+#ifndef BN_CFG_LINK_PACKETS_MAX_STATE_SIZE
+    #define BN_CFG_LINK_PACKETS_MAX_STATE_SIZE 32
+#endif
+
+/**
+ * @def BN_CFG_LINK_PACKETS_BUFFER_SIZE
+ * Specifies the size in bytes of the buffers used by bn::link_packets to store messages to send and received messages.
+ * @ingroup link
+ */
+#ifndef BN_CFG_LINK_PACKETS_BUFFER_SIZE
+    #define BN_CFG_LINK_PACKETS_BUFFER_SIZE 256
+#endif
+
 #endif
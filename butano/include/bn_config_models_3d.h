@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_MODELS_3D_H
+#define BN_CONFIG_MODELS_3D_H
+
+/**
+ * @file
+ * 3D models configuration header file.
+ *
+ * @ingroup models_3d
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_MODELS_3D_MAX_STATIC_MODELS
+ *
+ * Specifies the maximum number of static 3D models that can be rendered by a bn::models_3d.
+ *
+ * @ingroup models_3d
+ */
+#ifndef BN_CFG_MODELS_3D_MAX_STATIC_MODELS
+    #define BN_CFG_MODELS_3D_MAX_STATIC_MODELS 28
+#endif
+
+/**
+ * @def BN_CFG_MODELS_3D_MAX_DYNAMIC_MODELS
+ *
+ * Specifies the maximum number of dynamic 3D models that can be created with a bn::models_3d.
+ *
+ * @ingroup models_3d
+ */
+#ifndef BN_CFG_MODELS_3D_MAX_DYNAMIC_MODELS
+    #define BN_CFG_MODELS_3D_MAX_DYNAMIC_MODELS 4
+#endif
+
+/**
+ * @def BN_CFG_MODELS_3D_MAX_SPRITES
+ *
+ * Specifies the maximum number of 3D sprites that can be created with a bn::models_3d.
+ *
+ * @ingroup models_3d
+ */
+#ifndef BN_CFG_MODELS_3D_MAX_SPRITES
+    #define BN_CFG_MODELS_3D_MAX_SPRITES 8
+#endif
+
+/**
+ * @def BN_CFG_MODELS_3D_MAX_VERTICES
+ *
+ * Specifies the maximum number of vertices of all models rendered by a bn::models_3d.
+ *
+ * @ingroup models_3d
+ */
+#ifndef BN_CFG_MODELS_3D_MAX_VERTICES
+    #define BN_CFG_MODELS_3D_MAX_VERTICES 256
+#endif
+
+/**
+ * @def BN_CFG_MODELS_3D_MAX_FACES
+ *
+ * Specifies the maximum number of faces of all models and sprites rendered by a bn::models_3d.
+ *
+ * It can't be greater than 255.
+ *
+ * @ingroup models_3d
+ */
+#ifndef BN_CFG_MODELS_3D_MAX_FACES
+    #define BN_CFG_MODELS_3D_MAX_FACES 176
+#endif
+
+/**
+ * @def BN_CFG_MODELS_3D_MAX_SCANLINE_SPRITES
+ *
+ * Specifies the maximum number of hardware sprites used by a bn::models_3d to draw each screen line.
+ *
+ * The last BN_CFG_MODELS_3D_MAX_SCANLINE_SPRITES hardware sprites (and the sprite affine matrices
+ * which share memory with them) are overwritten with H-Blank DMA while 3D models are being rendered,
+ * so they can't be used by other sprites.
+ *
+ * Increasing it allows more overlapping faces per screen line, but it increases the CPU usage
+ * and the required RAM.
+ *
+ * @ingroup models_3d
+ */
+#ifndef BN_CFG_MODELS_3D_MAX_SCANLINE_SPRITES
+    #define BN_CFG_MODELS_3D_MAX_SCANLINE_SPRITES 23
+#endif
+
+#endif
@@ -28,4 +28,30 @@
     #define BN_CFG_SRAM_WAIT_STATE BN_SRAM_WAIT_STATE_8
 #endif
 
+/**
+ * @def BN_CFG_SRAM_SLOT_BLOCK_SIZE
+ *
+ * Specifies the size in bytes of the blocks in which bn::sram_slot splits its data.
+ *
+ * Only modified blocks are written to SRAM, and each one of them has its own CRC.
+ *
+ * @ingroup sram
+ */
+#ifndef BN_CFG_SRAM_SLOT_BLOCK_SIZE
+    #define BN_CFG_SRAM_SLOT_BLOCK_SIZE 64
+#endif
+
+/**
+ * @def BN_CFG_SRAM_SLOT_UPDATE_BYTES
+ *
+ * Specifies the maximum number of bytes written to SRAM by bn::sram_slot::update.
+ *
+ * At least one block is written per update, even if its size is greater than this value.
+ *
+ * @ingroup sram
+ */
+#ifndef BN_CFG_SRAM_SLOT_UPDATE_BYTES
+    #define BN_CFG_SRAM_SLOT_UPDATE_BYTES 1024
+#endif
+
 #endif
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_TELEMETRY_H
+#define BN_CONFIG_TELEMETRY_H
+
+/**
+ * @file
+ * Telemetry configuration header file.
+ *
+ * @ingroup telemetry
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_TELEMETRY_ENABLED
+ *
+ * Specifies if resource usage telemetry is enabled or not.
+ *
+ * @ingroup telemetry
+ */
+#ifndef BN_CFG_TELEMETRY_ENABLED
+    #define BN_CFG_TELEMETRY_ENABLED false
+#endif
+
+#endif
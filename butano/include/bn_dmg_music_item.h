@@ -15,6 +15,7 @@
  */
 
 #include "bn_functional.h"
+#include "bn_dmg_music_type.h"
 
 namespace bn
 {
@@ -41,7 +42,22 @@ public:
      * to avoid dangling references.
      */
     constexpr explicit dmg_music_item(const uint8_t& data_ref) :
-        _data_ptr(&data_ref)
+        _data_ptr(&data_ref),
+        _type(dmg_music_type::GBT_PLAYER)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param data_ref Reference to the song data.
+     * @param type Song data type.
+     *
+     * Song data is not copied but referenced, so it should outlive the dmg_music_item
+     * to avoid dangling references.
+     */
+    constexpr dmg_music_item(const uint8_t& data_ref, dmg_music_type type) :
+        _data_ptr(&data_ref),
+        _type(type)
     {
     }
 
@@ -61,6 +77,14 @@ public:
         return *_data_ptr;
     }
 
+    /**
+     * @brief Returns the song data type.
+     */
+    [[nodiscard]] constexpr dmg_music_type type() const
+    {
+        return _type;
+    }
+
     /**
      * @brief Plays the DMG music specified by this item with default settings.
      *
@@ -71,12 +95,17 @@ public:
     /**
      * @brief Plays the DMG music specified by this item.
      * @param speed Playback speed, in the range [1..256].
+     *
+     * Precompiled DMG music only supports speed = 1.
      */
     void play(int speed) const;
 
     /**
      * @brief Plays the DMG music specified by this item.
      * @param speed Playback speed, in the range [1..256].
+     *
+     * Precompiled DMG music only supports speed = 1.
+     *
      * @param loop Indicates if it must be played until it is stopped manually or until end.
      */
     void play(int speed, bool loop) const;
@@ -88,6 +117,7 @@ public:
 
 private:
     const uint8_t* _data_ptr;
+    dmg_music_type _type;
 };
 
 
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_DMG_MUSIC_TYPE_H
+#define BN_DMG_MUSIC_TYPE_H
+
+/**
+ * @file
+ * bn::dmg_music_type header file.
+ *
+ * @ingroup dmg_music
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+
+/**
+ * @brief Available DMG music data types.
+ *
+ * @ingroup dmg_music
+ */
+enum class dmg_music_type : uint8_t
+{
+    GBT_PLAYER, //!< Song patterns decoded by GBT Player on each tick.
+    PRECOMPILED //!< Sound register writes generated at build time, which are much cheaper to play.
+};
+
+}
+
+#endif
@@ -188,6 +188,15 @@
  * @ingroup audio
  */
 
+/**
+ * @defgroup stream_music Stream music
+ *
+ * Pre-rendered waveform audio files (files with `*.wav` extension) decoded from ROM in ARM code from IWRAM
+ * and added to the output of Maxmod, so sound effects can be played with them.
+ *
+ * @ingroup audio
+ */
+
 /**
  * @defgroup sound Sound effects
  *
@@ -210,7 +219,7 @@
 /**
  * @defgroup text Text
  *
- * Butano text system, based on sprites.
+ * Butano text system, based on sprites and regular backgrounds.
  *
  * Currently, it supports 4 bits per pixel (16 colors) fixed width AND variable width characters.
  *
@@ -273,6 +282,8 @@
  * provided by <a href="https://github.com/rodri042/gba-link-connection">gba-link-connection</a>.
  *
  * Keep in mind that some messages will be lost between players.
+ *
+ * bn::link_packets sends variable-length messages and a delta encoded game state on top of it.
  */
 
 /**
@@ -309,6 +320,30 @@
  * @ingroup display
  */
 
+/**
+ * @defgroup mode_7 Mode 7
+ *
+ * Perspective projected floors made with affine backgrounds.
+ *
+ * @ingroup display
+ */
+
+/**
+ * @defgroup polygon_rasterizer Polygon rasterizer
+ *
+ * Per scanline span tables of convex polygons, useful to draw them with H-Blank effects or HDMA.
+ *
+ * @ingroup display
+ */
+
+/**
+ * @defgroup models_3d 3D models
+ *
+ * Flat shaded 3D models and 3D sprites rendered with hardware sprites.
+ *
+ * @ingroup display
+ */
+
 /**
  * @defgroup memory Memory
  *
@@ -348,6 +383,16 @@
  * It can be enabled or disabled by overloading the definition of @a BN_CFG_PROFILER_ENABLED @a .
  */
 
+/**
+ * @defgroup telemetry Telemetry
+ *
+ * Butano resource telemetry system.
+ *
+ * It tracks peak usage, per frame churn and failed creations of engine resources.
+ *
+ * It can be enabled or disabled by overloading the definition of @a BN_CFG_TELEMETRY_ENABLED @a .
+ */
+
 /**
  * @defgroup std Standard library
  *
@@ -451,6 +496,39 @@
  * @ingroup container
  */
 
+/**
+ * @defgroup flat_map Flat map
+ *
+ * `std::map` like container with the capacity defined at compile time,
+ * which stores its elements sorted by key in a bn::vector.
+ *
+ * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
+ *
+ * @ingroup container
+ */
+
+/**
+ * @defgroup flat_set Flat set
+ *
+ * `std::set` like container with the capacity defined at compile time,
+ * which stores its elements sorted in a bn::vector.
+ *
+ * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
+ *
+ * @ingroup container
+ */
+
+/**
+ * @defgroup slot_map Slot map
+ *
+ * Container with the capacity defined at compile time which stores its elements contiguously
+ * and references them with stable handles.
+ *
+ * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
+ *
+ * @ingroup container
+ */
+
 /**
  * @defgroup string Strings
  *
@@ -589,12 +667,26 @@
  * Stuff generated by the assets conversion tools to use your assets with Butano.
  */
 
+/**
+ * @defgroup sort Sorting
+ *
+ * Sorting algorithms which don't compare elements,
+ * faster than bn::sort for elements with small integer keys.
+ */
+
 /**
  * @defgroup math Math
  *
  * Math related stuff.
  */
 
+/**
+ * @defgroup collision Collision
+ *
+ * Broadphase collision detection of rectangles and circles,
+ * faster than checking every collider against each other.
+ */
+
 /**
  * @defgroup other Other
  *
@@ -1468,13 +1560,81 @@
  * bn::dmg_music_items::module.play();
  * @endcode
  *
+ * DMG music can also be precompiled: the module is played with a port of GBT Player at build time,
+ * and the sound registers written on each tick are stored in ROM, so playing it takes much less CPU.
+ * To precompile a module, place a `*.json` file with the same name next to it:
+ *
+ * @code{.json}
+ * {
+ *     "precompiled": true
+ * }
+ * @endcode
+ *
+ * Precompiled DMG music has some limitations:
+ * * It takes much more ROM than GBT Player DMG music (usually between 4 and 8 times more).
+ * * Its speed can't be changed (only speed = 1 is supported).
+ * * Only positions reached when the song is played can be set with bn::dmg_music::set_position.
+ * * When the position is changed, the notes which are still playing are triggered again,
+ *   so their volume envelopes start again. Setting the position takes more CPU for later positions.
+ *
+ *
+ * @subsection import_stream_music Stream music
+ *
+ * Stream music is pre-rendered audio which is decoded and added to the output of Maxmod each frame,
+ * so it takes much less CPU than Direct Sound music and sound effects can still be played with it.
+ *
+ * The required format for stream music is waveform audio files (files with `*.wav` extension)
+ * with 8-bit or 16-bit samples, placed in the `audio` folder with a `*.json` file with the same name
+ * which specifies `stream_music` as its type:
+ *
+ * @code{.json}
+ * {
+ *     "type": "stream_music",
+ *     "format": "adpcm",
+ *     "mixing_rate": 16
+ * }
+ * @endcode
+ *
+ * The fields supported by stream music `*.json` files are the following:
+ * * `"type"`: must be `"stream_music"`.
+ * * `"format"`: optional field which specifies the sample format: `"adpcm"` (IMA-ADPCM, 4 bits per sample)
+ * or `"pcm8"` (8 bits per sample). By default it is `"adpcm"`.
+ * * `"mixing_rate"`: optional field which specifies the mixing rate in KHz (8, 10, 13, 16, 18, 21, 27 or 31).
+ * It must be the same as @ref BN_CFG_AUDIO_MIXING_RATE, which is used by default.
+ *
+ * Stereo files are converted to mono.
+ *
+ * If the conversion process has finished successfully,
+ * a bn::stream_music_item should have been generated in the `build` folder.
+ *
+ * For example, from a file named `song.wav`,
+ * a header file named `bn_stream_music_items_song.h` is generated in the `build` folder.
+ *
+ * You can use this header to play the waveform audio file with only one line of C++ code:
+ *
+ * @code{.cpp}
+ * #include "bn_stream_music_items_song.h"
+ *
+ * bn::stream_music_items::song.play();
+ * @endcode
+ *
  *
  * @subsection import_sound Sound effects
  *
  * The required format for sound effects is waveform audio files (files with `*.wav` extension)
- * without compression or anything weird. Besides, *I think* stereo files are not allowed.
+ * with 8-bit or 16-bit samples, without compression or anything weird. Stereo files are converted to mono.
  *
- * The recommended quality for sound effects is 8-bits 22050 Hz.
+ * At build time, sound effects are resampled to the mixing rate specified by @ref BN_CFG_AUDIO_MIXING_RATE
+ * in the `USERFLAGS` variable of your project's `Makefile`,
+ * so Maxmod doesn't skip nor repeat samples when they are played with the default speed.
+ *
+ * Sound effects can have a `*.json` file with the same name with the following optional fields:
+ * * `"resample"`: indicates if the sound effect must be resampled to the mixing rate or not.
+ * By default it is `true`.
+ * * `"speeds"`: list of playback speeds to generate resampled copies of the sound effect for.
+ * A copy is named after the original file and the speed in hundredths:
+ * for example, from a file named `sfx.wav` with `"speeds": [0.5, 1.5]`,
+ * `sfx_speed_50` and `sfx_speed_150` sound items are generated.
  *
  * If the conversion process has finished successfully,
  * a bunch of bn::sound_item objects under the `bn::sound_items` namespace
@@ -1486,6 +1646,42 @@
  *
  * bn::sound_items::sfx.play();
  * @endcode
+ *
+ * Playing a resampled copy costs the same CPU as playing the original sound effect
+ * with a speed different than 1, but it sounds better since the copy is filtered at build time:
+ *
+ * @code{.cpp}
+ * #include "bn_sound_items.h"
+ *
+ * bn::sound_items::sfx_speed_150.play();
+ * @endcode
+ *
+ *
+ * @section import_models_3d 3D models
+ *
+ * 3D models go into the folders specified in the `MODELS3D` variable of your project's `Makefile`.
+ *
+ * The required format for 3D models is Wavefront files (files with `*.obj` extension) with triangle and quad faces.
+ *
+ * Face colors are read from the diffuse color (`Kd`) of the materials
+ * of the material library referenced with `mtllib` (a `*.mtl` file in the same folder).
+ * Color indexes follow the order of the materials in the library,
+ * so models which share a material library share their color indexes too.
+ *
+ * If the conversion process has finished successfully,
+ * a bn::model_3d_item should have been generated in the `build` folder.
+ *
+ * For example, from a file named `cube.obj`,
+ * a header file named `bn_model_3d_items_cube.h` is generated in the `build` folder.
+ *
+ * You can use this header to render the model with bn::models_3d:
+ *
+ * @code{.cpp}
+ * #include "bn_model_3d_items_cube.h"
+ *
+ * models.load_colors(bn::model_3d_items::cube_colors);
+ * bn::model_3d& cube = models.create_dynamic_model(bn::model_3d_items::cube);
+ * @endcode
  */
 
 
@@ -2029,6 +2225,52 @@
  * * Disabled asserts indicate the compiler that if the condition is false the code is unreachable.
  * * bn::blending_transparency_attributes missing header inclusions fixed.
  * * SRAM is cleared when formatting in the `sram` example.
+ * * bn::frame_allocator and bn::frame_vector added: short-lived allocations released by bn::core::update.
+ * * bn::telemetry added: peak usage, per frame churn and failed creations of engine resources
+ *   and IWRAM stack watermark (enable it with @ref BN_CFG_TELEMETRY_ENABLED).
+ * * bn::regular_bg_text_generator added: prints text from a bn::sprite_font in the tiles and the map
+ *   of a regular background.
+ * * bn::retained_sprite_text added: keeps text sprites alive and only paints again the characters which have changed.
+ * * bn::sprite_glyph_atlas added: bn::sprite_text_generator can reference resident character tiles
+ *   instead of copying them (see bn::sprite_text_generator::set_glyph_atlas).
+ * * bn::fixed_batch added: transforms and projects arrays of fixed point vectors in ARM code from IWRAM.
+ * * bn::fixed_divider added: divides fixed point values by the same divisor with a multiplication and a shift.
+ * * bn::fast_reciprocal added: reciprocal of any fixed point value without doing an integer division.
+ * * bn::fast_sin, bn::fast_cos, bn::fast_atan2, bn::fast_reciprocal_sqrt, bn::fast_exp2 and bn::fast_log2 added:
+ *   approximate math functions with compile-time selectable accuracy (bn::fast_math_accuracy).
+ * * bn::unordered_map and bn::unordered_set use robin hood hashing with 16-bit hash fingerprints
+ *   and backward shift deletion, reducing the number of key comparisons and probe lengths.
+ * * bn::flat_map and bn::flat_set added: ordered associative containers stored in a sorted bn::vector.
+ * * bn::slot_map added: contiguous container which references its elements with generational handles.
+ * * bn::radix_sort and bn::counting_sort added: stable sorting algorithms for elements with small integer keys.
+ * * bn::models_3d added: flat shaded 3D models and 3D sprites rendered with hardware sprites,
+ *   extracted from Varooom 3D. 3D models can be imported from Wavefront files (see @ref import_models_3d).
+ * * bn::polygon_rasterizer added: fills per scanline span tables of convex polygons with sub-pixel precision.
+ *   `polygons` and `hdma_polygons` examples use it instead of their own edge walking code.
+ * * bn::mode_7 added: perspective projected floor with per line affine registers copied with HDMA,
+ *   world to screen projection and horizon fog. `mode_7` example uses it.
+ * * bn::collision_grid and bn::collision_sweep added: broadphase collision detection of bn::collider objects
+ *   (rectangles and circles) with layer masks, area queries and pair queries.
+ * * bn::audio::last_cpu_usage, bn::audio::max_cpu_usage and bn::audio::max_direct_sound_channels added:
+ *   CPU usage of Direct Sound mixing and DMG music player and number of active Direct Sound channels.
+ * * bn::stream_music added: plays IMA-ADPCM or 8-bit PCM waveform audio files from ROM
+ *   with much less CPU than Direct Sound music (see @ref import_stream_music).
+ * * Sound effects are resampled to the mixing rate at build time, and resampled copies for different speeds
+ *   can be generated too (see @ref import_sound).
+ * * Default audio update mode can be specified with @ref BN_CFG_AUDIO_UPDATE_ON_VBLANK.
+ * * Precompiled DMG music added: modules are converted to sound register writes at build time,
+ *   reducing the CPU usage of the DMG music player (see @ref import_dmg_music).
+ * * Experimental option to commit graphics data with DMA while link communication is active
+ *   added. It is disabled by default (see @ref BN_CFG_LINK_DMA_ENABLED).
+ * * bn::link_packets added: batches variable-length messages in packets with loss detection,
+ *   delta encodes game state against the last acknowledged one and reports throughput and latency stats.
+ * * bn::sram_slot added: stores a value in two SRAM banks with per block CRC,
+ *   writing only the modified blocks and spreading the writes over multiple frames.
+ * * bn::easing::apply added: easing curves precalculated in LUTs (see bn::easing_type).
+ * * bn::sprite_move_tweens added: moves multiple sprites with easing curves in one pass,
+ *   setting their positions in a single batch.
+ * * Sprite affine mats interning added (see bn::sprite_affine_mats::set_interning_enabled
+ *   and bn::sprite_affine_mat_ptr::create_interned): sprites with equal affine attributes share one matrix.
  *
  *
  * @section changelog_13_1_1 13.1.1
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_EASING_H
+#define BN_EASING_H
+
+/**
+ * @file
+ * bn::easing header file.
+ *
+ * @ingroup math
+ */
+
+#include "bn_fixed.h"
+#include "bn_easing_type.h"
+
+/**
+ * @brief Easing curves functions.
+ *
+ * Curves are precalculated at build time in LUTs of lut_size() entries,
+ * and they are linearly interpolated between entries.
+ *
+ * @ingroup math
+ */
+namespace bn::easing
+{
+    /**
+     * @brief Returns the number of entries of each easing curve LUT.
+     */
+    [[nodiscard]] constexpr int lut_size()
+    {
+        return 257;
+    }
+
+    /**
+     * @brief Applies the given easing curve.
+     * @param easing Easing curve to apply.
+     * @param progress Linear progress in the range [0..1]. Values out of range are clamped.
+     * @return Eased progress: 0 at the start and 1 at the end.
+     * Some curves go slightly out of the [0..1] range before the end.
+     */
+    [[nodiscard]] fixed apply(easing_type easing, fixed progress);
+}
+
+#endif
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_EASING_TYPE_H
+#define BN_EASING_TYPE_H
+
+/**
+ * @file
+ * bn::easing_type header file.
+ *
+ * @ingroup math
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+
+/**
+ * @brief Available easing curves.
+ *
+ * @ingroup math
+ */
+enum class easing_type : uint8_t
+{
+    LINEAR, //!< Constant speed.
+    QUAD_IN, //!< Quadratic, accelerating from zero speed.
+    QUAD_OUT, //!< Quadratic, decelerating to zero speed.
+    QUAD_IN_OUT, //!< Quadratic, accelerating until halfway and then decelerating.
+    CUBIC_IN, //!< Cubic, accelerating from zero speed.
+    CUBIC_OUT, //!< Cubic, decelerating to zero speed.
+    CUBIC_IN_OUT, //!< Cubic, accelerating until halfway and then decelerating.
+    SINE_IN, //!< Sinusoidal, accelerating from zero speed.
+    SINE_OUT, //!< Sinusoidal, decelerating to zero speed.
+    SINE_IN_OUT, //!< Sinusoidal, accelerating until halfway and then decelerating.
+    BACK_IN, //!< Goes slightly below the start before accelerating.
+    BACK_OUT, //!< Goes slightly past the end before coming back.
+    BOUNCE_OUT //!< Bounces at the end like a falling ball.
+};
+
+}
+
+#endif
@@ -0,0 +1,431 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FAST_MATH_H
+#define BN_FAST_MATH_H
+
+/**
+ * @file
+ * Fast approximate math functions header file.
+ *
+ * Each function has a compile-time selectable accuracy (see bn::fast_math_accuracy).
+ *
+ * Maximum errors (relative errors don't include the rounding to the precision of the result):
+ *
+ * | Function                      | fast_math_accuracy::LOW       | fast_math_accuracy::HIGH         |
+ * |-------------------------------|-------------------------------|----------------------------------|
+ * | bn::fast_sin, bn::fast_cos    | 0.0018 (8 units)              | 0.0006 (3 units)                 |
+ * | bn::fast_atan2                | 0.00083 turns (0.3 degrees)   | 0.00003 turns (0.011 degrees)    |
+ * | bn::fast_reciprocal_sqrt      | 0.04% of the result           | 0.0004% of the result            |
+ * | bn::fast_exp2                 | 0.31% of the result           | 0.025% of the result             |
+ * | bn::fast_log2                 | 0.0084 (35 units)             | 0.00035 (2 units)                |
+ *
+ * CPU cycles per call are logged by the `fast_math` tests of the `general_tests` project.
+ *
+ * @ingroup math
+ */
+
+#include "bn_array.h"
+#include "bn_fixed.h"
+#include "bn_utility.h"
+#include "bn_algorithm.h"
+#include "bn_sin_lut.h"
+#include "bn_reciprocal_lut.h"
+
+namespace bn
+{
+
+/**
+ * @brief Specifies the accuracy of a fast approximate math function.
+ *
+ * @ingroup math
+ */
+enum class fast_math_accuracy : uint8_t
+{
+    LOW, //!< Lower accuracy and CPU usage.
+    HIGH //!< Higher accuracy and CPU usage.
+};
+
+}
+
+/// @cond DO_NOT_DOCUMENT
+
+namespace _bn
+{
+    [[nodiscard]] constexpr bn::array<uint16_t, 48> calculate_fast_reciprocal_sqrt_seeds()
+    {
+        // 1 / sqrt(x) for the center of each x range of 1/64 in [0.25, 1) in 2.14 format:
+
+        bn::array<uint16_t, 48> result;
+
+        for(int index = 0; index < 48; ++index)
+        {
+            double x = (index + 16 + 0.5) / 64;
+            double sqrt_x = x;
+
+            for(int iteration = 0; iteration < 16; ++iteration)
+            {
+                sqrt_x = (sqrt_x + (x / sqrt_x)) / 2;
+            }
+
+            result[index] = uint16_t(((1 << 14) / sqrt_x) + 0.5);
+        }
+
+        return result;
+    }
+
+    inline constexpr bn::array<uint16_t, 48> fast_reciprocal_sqrt_seeds = calculate_fast_reciprocal_sqrt_seeds();
+
+    [[nodiscard]] constexpr int fast_sin_lut_value(int lut_angle)
+    {
+        if(bn::is_constant_evaluated())
+        {
+            return bn::calculate_sin_lut_value(lut_angle * 32);
+        }
+        else
+        {
+            return bn::sin_lut._data[lut_angle];
+        }
+    }
+
+    template<bn::fast_math_accuracy Accuracy>
+    [[nodiscard]] constexpr int fast_sin_data(int angle_data)
+    {
+        // 2048 LUT entries per turn, so each one covers 32 angle units:
+
+        auto angle = unsigned(angle_data) & 0xFFFF;
+
+        if constexpr(Accuracy == bn::fast_math_accuracy::LOW)
+        {
+            return fast_sin_lut_value(int(((angle + 16) >> 5) & 2047));
+        }
+        else
+        {
+            int lut_angle = int(angle >> 5);
+            int fraction = int(angle & 31);
+            int first_value = fast_sin_lut_value(lut_angle);
+            int second_value = fast_sin_lut_value(lut_angle + 1);
+            return first_value + ((((second_value - first_value) * fraction) + 16) >> 5);
+        }
+    }
+}
+
+/// @endcond
+
+
+namespace bn
+{
+    /**
+     * @brief Calculates an approximation of the sine value of an angle
+     * using linear interpolation between sin_lut entries.
+     * @tparam Accuracy With fast_math_accuracy::LOW the nearest sin_lut entry is returned instead.
+     * @param angle Angle (2π = 1).
+     * @return Sine value in the range [-1, 1].
+     *
+     * @ingroup math
+     */
+    template<fast_math_accuracy Accuracy = fast_math_accuracy::HIGH>
+    [[nodiscard]] constexpr fixed fast_sin(fixed_t<16> angle)
+    {
+        return fixed::from_data(_bn::fast_sin_data<Accuracy>(angle.data()));
+    }
+
+    /**
+     * @brief Calculates an approximation of the cosine value of an angle
+     * using linear interpolation between sin_lut entries.
+     * @tparam Accuracy With fast_math_accuracy::LOW the nearest sin_lut entry is returned instead.
+     * @param angle Angle (2π = 1).
+     * @return Cosine value in the range [-1, 1].
+     *
+     * @ingroup math
+     */
+    template<fast_math_accuracy Accuracy = fast_math_accuracy::HIGH>
+    [[nodiscard]] constexpr fixed fast_cos(fixed_t<16> angle)
+    {
+        return fixed::from_data(_bn::fast_sin_data<Accuracy>(angle.data() + 16384));
+    }
+
+    /**
+     * @brief Calculates an approximation of the sine and the cosine values of an angle
+     * using linear interpolation between sin_lut entries.
+     * @tparam Accuracy With fast_math_accuracy::LOW the nearest sin_lut entries are returned instead.
+     * @param angle Angle (2π = 1).
+     * @return Sine and cosine values in the range [-1, 1].
+     *
+     * @ingroup math
+     */
+    template<fast_math_accuracy Accuracy = fast_math_accuracy::HIGH>
+    [[nodiscard]] constexpr pair<fixed, fixed> fast_sin_and_cos(fixed_t<16> angle)
+    {
+        int angle_data = angle.data();
+        return { fixed::from_data(_bn::fast_sin_data<Accuracy>(angle_data)),
+                 fixed::from_data(_bn::fast_sin_data<Accuracy>(angle_data + 16384)) };
+    }
+
+    /**
+     * @brief Computes an approximation of the arc tangent of y/x
+     * using the signs of arguments to determine the correct quadrant.
+     *
+     * The arc tangent of each octant is approximated with a polynomial.
+     *
+     * @tparam Accuracy With fast_math_accuracy::LOW a second order polynomial is used
+     * and the division is replaced by a reciprocal_lut multiplication.
+     * With fast_math_accuracy::HIGH a ninth order polynomial and an integer division are used.
+     * @param y Vertical value.
+     * @param x Horizontal value.
+     * @return Arc tangent of y/x in the range [-0.5, 0.5] (2π = 1).
+     *
+     * @ingroup math
+     */
+    template<fast_math_accuracy Accuracy = fast_math_accuracy::HIGH>
+    [[nodiscard]] constexpr fixed_t<16> fast_atan2(int y, int x)
+    {
+        unsigned abs_x = x >= 0 ? unsigned(x) : 0U - unsigned(x);
+        unsigned abs_y = y >= 0 ? unsigned(y) : 0U - unsigned(y);
+
+        if(! abs_x && ! abs_y)
+        {
+            return 0;
+        }
+
+        bool swapped = abs_y > abs_x;
+        unsigned maximum = swapped ? abs_y : abs_x;
+        unsigned minimum = swapped ? abs_x : abs_y;
+        auto leading_zeros = int(__builtin_clz(maximum));
+        int atan;
+
+        if constexpr(Accuracy == fast_math_accuracy::LOW)
+        {
+            // The ratio is calculated with the reciprocal of the 10 most significant bits of the maximum,
+            // and atan(r) is approximated with r * (1.0584 - 0.273 * r) in 1.15 format:
+
+            int shift = max(22 - leading_zeros, 0);
+            unsigned lut_value = maximum >> shift;
+            unsigned reciprocal;
+
+            if(is_constant_evaluated())
+            {
+                reciprocal = unsigned(calculate_reciprocal_lut_value(int(lut_value)).data());
+            }
+            else
+            {
+                reciprocal = unsigned(reciprocal_lut._data[lut_value].data());
+            }
+
+            auto ratio = int(((minimum >> shift) * reciprocal) >> 5);
+            atan = (ratio * (34681 - ((8946 * ratio) >> 15))) >> 15;
+        }
+        else
+        {
+            // Abramowitz and Stegun 4.4.49 in 1.15 format:
+
+            int shift = max(16 - leading_zeros, 0);
+            auto ratio = int(((minimum >> shift) << 15) / (maximum >> shift));
+            int square = (ratio * ratio) >> 15;
+            int polynomial = 683;
+            polynomial = -2790 + ((polynomial * square) >> 15);
+            polynomial = 5903 + ((polynomial * square) >> 15);
+            polynomial = -10823 + ((polynomial * square) >> 15);
+            polynomial = 32763 + ((polynomial * square) >> 15);
+            atan = (polynomial * ratio) >> 15;
+        }
+
+        // From radians in 1.15 format to turns in 0.16 format:
+
+        int result = ((atan * 20861) + 32768) >> 16;
+
+        if(swapped)
+        {
+            result = 16384 - result;
+        }
+
+        if(x < 0)
+        {
+            result = 32768 - result;
+        }
+
+        if(y < 0)
+        {
+            result = -result;
+        }
+
+        return fixed_t<16>::from_data(result);
+    }
+
+    /**
+     * @brief Calculates an approximation of the reciprocal of the square root of a value (1 / sqrt(value)),
+     * useful to normalize vectors without doing divisions.
+     *
+     * A LUT seed is refined with Newton-Raphson iterations.
+     *
+     * @tparam Accuracy With fast_math_accuracy::LOW one iteration is done. With fast_math_accuracy::HIGH two.
+     * @param value Fixed point value (> 0).
+     * @return Reciprocal of the square root of the given value.
+     *
+     * @ingroup math
+     */
+    template<fast_math_accuracy Accuracy = fast_math_accuracy::HIGH>
+    [[nodiscard]] constexpr fixed_t<20> fast_reciprocal_sqrt(fixed value)
+    {
+        int data = value.data();
+        BN_ASSERT(data > 0, "Invalid value: ", value);
+
+        // normalized is in the range [2^30, 2^32) and it is shifted an even number of bits,
+        // so its square root can be shifted back by half of them:
+
+        auto leading_zeros = int(__builtin_clz(unsigned(data)) & ~1U);
+        unsigned normalized = unsigned(data) << leading_zeros;
+        unsigned reciprocal_sqrt = unsigned(_bn::fast_reciprocal_sqrt_seeds[int(normalized >> 26) - 16]) << 16;
+        constexpr int iterations = Accuracy == fast_math_accuracy::LOW ? 1 : 2;
+
+        for(int iteration = 0; iteration < iterations; ++iteration)
+        {
+            // r = r * (3 - normalized * r * r) / 2 in 2.30 format:
+
+            uint64_t square = (uint64_t(reciprocal_sqrt) * reciprocal_sqrt) >> 30;
+            uint64_t product = (uint64_t(normalized) * square) >> 32;
+            auto error = unsigned((uint64_t(3) << 30) - product);
+            reciprocal_sqrt = unsigned((uint64_t(reciprocal_sqrt) * error) >> 31);
+        }
+
+        return fixed_t<20>::from_data(int(reciprocal_sqrt >> (20 - (leading_zeros / 2))));
+    }
+
+    /**
+     * @brief Calculates an approximation of 2 raised to the given power.
+     *
+     * The fractional part of the power is approximated with a polynomial.
+     *
+     * @tparam Accuracy With fast_math_accuracy::LOW a second order polynomial is used.
+     * With fast_math_accuracy::HIGH a fourth order one.
+     * @param value Power (< 19).
+     * @return 2 raised to the given power.
+     *
+     * @ingroup math
+     */
+    template<fast_math_accuracy Accuracy = fast_math_accuracy::HIGH>
+    [[nodiscard]] constexpr fixed fast_exp2(fixed value)
+    {
+        int data = value.data();
+        BN_ASSERT(data < 19 * fixed::scale(), "Invalid value: ", value);
+
+        int integer = data >> fixed::precision();
+        int fraction = (data & (fixed::scale() - 1)) << (14 - fixed::precision());
+        int polynomial;
+
+        // 2^fraction - 1 in 2.14 format:
+
+        if constexpr(Accuracy == fast_math_accuracy::LOW)
+        {
+            polynomial = 10809 + ((5529 * fraction) >> 14);
+        }
+        else
+        {
+            polynomial = 223;
+            polynomial = 850 + ((polynomial * fraction) >> 14);
+            polynomial = 3957 + ((polynomial * fraction) >> 14);
+            polynomial = 11354 + ((polynomial * fraction) >> 14);
+        }
+
+        int mantissa = min((1 << 14) + ((polynomial * fraction) >> 14), (1 << 15) - 1);
+        int shift = integer + fixed::precision() - 14;
+
+        if(shift >= 0)
+        {
+            return fixed::from_data(mantissa << shift);
+        }
+
+        if(shift > -31)
+        {
+            return fixed::from_data(mantissa >> -shift);
+        }
+
+        return 0;
+    }
+
+    /**
+     * @brief Calculates an approximation of the base 2 logarithm of the given value.
+     *
+     * The logarithm of the mantissa of the value is approximated with a polynomial.
+     *
+     * @tparam Accuracy With fast_math_accuracy::LOW a second order polynomial is used.
+     * With fast_math_accuracy::HIGH a fifth order one.
+     * @param value Fixed point value (> 0).
+     * @return Base 2 logarithm of the given value.
+     *
+     * @ingroup math
+     */
+    template<fast_math_accuracy Accuracy = fast_math_accuracy::HIGH>
+    [[nodiscard]] constexpr fixed fast_log2(fixed value)
+    {
+        int data = value.data();
+        BN_ASSERT(data > 0, "Invalid value: ", value);
+
+        int most_significant_bit = 31 - int(__builtin_clz(unsigned(data)));
+        int mantissa;
+
+        if(most_significant_bit >= 14)
+        {
+            mantissa = (data >> (most_significant_bit - 14)) - (1 << 14);
+        }
+        else
+        {
+            mantissa = (data << (14 - most_significant_bit)) - (1 << 14);
+        }
+
+        // log2(1 + mantissa) in 2.14 format:
+
+        int polynomial;
+
+        if constexpr(Accuracy == fast_math_accuracy::LOW)
+        {
+            polynomial = 22021 - ((5706 * mantissa) >> 14);
+        }
+        else
+        {
+            polynomial = 714;
+            polynomial = -3100 + ((polynomial * mantissa) >> 14);
+            polynomial = 6740 + ((polynomial * mantissa) >> 14);
+            polynomial = -11591 + ((polynomial * mantissa) >> 14);
+            polynomial = 23621 + ((polynomial * mantissa) >> 14);
+        }
+
+        int logarithm = (polynomial * mantissa) >> 14;
+        constexpr int logarithm_shift = 14 - fixed::precision();
+        int integer = most_significant_bit - fixed::precision();
+        return fixed::from_data((integer * fixed::scale()) +
+                                ((logarithm + (1 << (logarithm_shift - 1))) >> logarithm_shift));
+    }
+
+    /**
+     * @brief Calculates an approximation of e raised to the given power with fast_exp2.
+     * @param value Power (< 13).
+     * @return e raised to the given power.
+     *
+     * @ingroup math
+     */
+    template<fast_math_accuracy Accuracy = fast_math_accuracy::HIGH>
+    [[nodiscard]] constexpr fixed fast_exp(fixed value)
+    {
+        BN_ASSERT(value < 13, "Invalid value: ", value);
+
+        return fast_exp2<Accuracy>(value.safe_multiplication(fixed(1.4426950408889634)));
+    }
+
+    /**
+     * @brief Calculates an approximation of the natural logarithm of the given value with fast_log2.
+     * @param value Fixed point value (> 0).
+     * @return Natural logarithm of the given value.
+     *
+     * @ingroup math
+     */
+    template<fast_math_accuracy Accuracy = fast_math_accuracy::HIGH>
+    [[nodiscard]] constexpr fixed fast_log(fixed value)
+    {
+        return fast_log2<Accuracy>(value).unsafe_multiplication(fixed(0.6931471805599453));
+    }
+}
+
+#endif
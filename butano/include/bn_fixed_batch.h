@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FIXED_BATCH_H
+#define BN_FIXED_BATCH_H
+
+/**
+ * @file
+ * bn::fixed_batch header file.
+ *
+ * @ingroup math
+ */
+
+#include "bn_span.h"
+#include "bn_array.h"
+#include "bn_fixed_point.h"
+
+/**
+ * @brief Batch transformations of fixed point vectors.
+ *
+ * Functions in this namespace are executed in ARM mode from IWRAM
+ * and they accumulate each output component in 64 bits before dropping the fractional part of the products,
+ * so they are faster and more precise than transforming each vector with bn::fixed operators.
+ *
+ * 3D vectors are stored as packed bn::fixed values, x, y and z for each vector.
+ *
+ * @ingroup math
+ */
+namespace bn::fixed_batch
+{
+    /**
+     * @brief Multiplies the given points by the given 2x2 matrix:
+     *
+     * output.x = a * point.x + b * point.y
+     *
+     * output.y = c * point.x + d * point.y
+     *
+     * @param a First row, first column of the matrix.
+     * @param b First row, second column of the matrix.
+     * @param c Second row, first column of the matrix.
+     * @param d Second row, second column of the matrix.
+     * @param points Points to transform.
+     * @param output Destination of the transformed points.
+     * It must have the same size as points, and it can reference the same memory.
+     */
+    void transform(fixed a, fixed b, fixed c, fixed d, const span<const fixed_point>& points,
+                   span<fixed_point> output);
+
+    /**
+     * @brief Multiplies the given points by the given 2x3 affine matrix:
+     *
+     * output.x = a * point.x + b * point.y + translation.x
+     *
+     * output.y = c * point.x + d * point.y + translation.y
+     *
+     * @param a First row, first column of the matrix.
+     * @param b First row, second column of the matrix.
+     * @param c Second row, first column of the matrix.
+     * @param d Second row, second column of the matrix.
+     * @param translation Third column of the matrix.
+     * @param points Points to transform.
+     * @param output Destination of the transformed points.
+     * It must have the same size as points, and it can reference the same memory.
+     */
+    void transform(fixed a, fixed b, fixed c, fixed d, const fixed_point& translation,
+                   const span<const fixed_point>& points, span<fixed_point> output);
+
+    /**
+     * @brief Multiplies the given 3D vectors by the given 3x3 matrix (a rotation matrix for example).
+     * @param matrix Row-major 3x3 matrix.
+     * @param vectors Packed 3D vectors to transform (x, y and z for each vector).
+     * @param output Destination of the transformed 3D vectors.
+     * It must have the same size as vectors, and it can reference the same memory.
+     */
+    void transform_3d(const array<fixed, 9>& matrix, const span<const fixed>& vectors, span<fixed> output);
+
+    /**
+     * @brief Projects the given 3D vectors in a 2D plane:
+     *
+     * output.x = center.x + vector.x * focal_length / vector.z
+     *
+     * output.y = center.y + vector.y * focal_length / vector.z
+     *
+     * Only one division is done per vector.
+     *
+     * @param focal_length Distance from the camera to the projection plane (> 0).
+     * @param center Position of the camera axis in the projection plane.
+     * @param vectors Packed 3D vectors to project (x, y and z for each vector).
+     * The z component of each vector must be greater than 0.
+     * @param output Destination of the projected points.
+     * It must have a size equal to the number of 3D vectors.
+     */
+    void project_3d(fixed focal_length, const fixed_point& center, const span<const fixed>& vectors,
+                    span<fixed_point> output);
+}
+
+#endif
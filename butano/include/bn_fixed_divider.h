@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FIXED_DIVIDER_H
+#define BN_FIXED_DIVIDER_H
+
+/**
+ * @file
+ * bn::fixed_divider_t and bn::fixed_divider header file.
+ *
+ * @ingroup math
+ */
+
+#include "bn_array.h"
+#include "bn_reciprocal_lut.h"
+
+namespace bn
+{
+
+/**
+ * @brief Divides fixed point values by the same divisor without doing integer divisions.
+ *
+ * The reciprocal of the divisor is calculated once from a LUT seed refined with Newton-Raphson iterations,
+ * so each division is replaced by a multiplication and a shift.
+ *
+ * The result of each division is truncated towards zero like in fixed_t::safe_division,
+ * but its absolute value can be one unit higher.
+ *
+ * @tparam Precision Number of bits used for the fractional part of the fixed point values.
+ *
+ * @ingroup math
+ */
+template<int Precision>
+class fixed_divider_t
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param divisor Valid divisor (!= 0).
+     */
+    constexpr explicit fixed_divider_t(fixed_t<Precision> divisor) :
+        _divisor(divisor)
+    {
+        int divisor_data = divisor.data();
+        BN_ASSERT(divisor_data, "Divisor is zero");
+
+        unsigned magnitude = _magnitude(divisor_data);
+        auto leading_zeros = int(__builtin_clz(magnitude));
+        unsigned normalized = magnitude << leading_zeros;
+
+        if(normalized == 1U << 31)
+        {
+            // Powers of two are divided with a shift only:
+
+            _reciprocal = normalized;
+            _shift = int8_t(62 - Precision - leading_zeros);
+        }
+        else
+        {
+            // normalized is in the range (2^31, 2^32), so its 10 most significant bits give a LUT index
+            // in the range [512, 1024) and the seed is approximately 2^62 / normalized with 10 bits of precision:
+
+            unsigned lut_index = normalized >> 22;
+            unsigned reciprocal;
+
+            if(is_constant_evaluated())
+            {
+                reciprocal = unsigned(calculate_reciprocal_lut_value(int(lut_index)).data()) << 20;
+            }
+            else
+            {
+                reciprocal = unsigned(reciprocal_lut._data[lut_index].data()) << 20;
+            }
+
+            // Each Newton-Raphson iteration (r = r * (2 - normalized * r)) doubles the number of precise bits:
+
+            for(int iteration = 0; iteration < 2; ++iteration)
+            {
+                uint64_t product = uint64_t(normalized) * reciprocal;
+                auto error = unsigned(((uint64_t(1) << 63) - product) >> 31);
+                reciprocal = unsigned((uint64_t(reciprocal) * error) >> 31);
+            }
+
+            // One more bit is added and the last ones are fixed, so the reciprocal is 2^63 / normalized rounded up
+            // (exact quotients are not truncated to the previous value).
+            // Newton-Raphson iterations never overestimate it, so it only needs to be incremented (up to 5 times):
+
+            reciprocal <<= 1;
+
+            while(uint64_t(normalized) * reciprocal < uint64_t(1) << 63)
+            {
+                ++reciprocal;
+            }
+
+            _reciprocal = reciprocal;
+            _shift = int8_t(63 - Precision - leading_zeros);
+        }
+
+        _negative = divisor_data < 0;
+    }
+
+    /**
+     * @brief Returns the divisor.
+     */
+    [[nodiscard]] constexpr fixed_t<Precision> divisor() const
+    {
+        return _divisor;
+    }
+
+    /**
+     * @brief Returns the reciprocal of the divisor (1 / divisor).
+     *
+     * Its absolute value must fit in a fixed_t<Precision>.
+     */
+    [[nodiscard]] constexpr fixed_t<Precision> reciprocal() const
+    {
+        int shift = _shift - Precision;
+        BN_ASSERT(shift > 0, "Reciprocal overflow: ", _divisor);
+
+        return _signed_result(_reciprocal >> shift, _negative);
+    }
+
+    /**
+     * @brief Returns the division of the given fixed point value by the divisor.
+     *
+     * The absolute value of the result must fit in a fixed_t<Precision>.
+     */
+    [[nodiscard]] constexpr fixed_t<Precision> divide(fixed_t<Precision> dividend) const
+    {
+        int dividend_data = dividend.data();
+        auto quotient = unsigned((uint64_t(_magnitude(dividend_data)) * _reciprocal) >> _shift);
+        return _signed_result(quotient, _negative != (dividend_data < 0));
+    }
+
+    /**
+     * @brief Returns the division of the given fixed point value by the given fixed_divider_t.
+     */
+    [[nodiscard]] constexpr friend fixed_t<Precision> operator/(fixed_t<Precision> dividend,
+                                                                const fixed_divider_t& divider)
+    {
+        return divider.divide(dividend);
+    }
+
+private:
+    fixed_t<Precision> _divisor;
+    unsigned _reciprocal = 0;
+    int8_t _shift = 0;
+    bool _negative = false;
+
+    [[nodiscard]] static constexpr unsigned _magnitude(int value)
+    {
+        return value >= 0 ? unsigned(value) : 0U - unsigned(value);
+    }
+
+    [[nodiscard]] static constexpr fixed_t<Precision> _signed_result(unsigned magnitude, bool negative)
+    {
+        int data = int(magnitude);
+        return fixed_t<Precision>::from_data(negative ? -data : data);
+    }
+};
+
+
+using fixed_divider = fixed_divider_t<12>; //!< Default precision fixed_divider_t alias.
+
+}
+
+#endif
@@ -0,0 +1,857 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FLAT_MAP_H
+#define BN_FLAT_MAP_H
+
+/**
+ * @file
+ * bn::iflat_map and bn::flat_map implementation header file.
+ *
+ * @ingroup flat_map
+ */
+
+#include "bn_vector.h"
+#include "bn_flat_map_fwd.h"
+
+namespace bn
+{
+
+template<typename Key, typename Value, typename KeyCompare>
+class iflat_map
+{
+
+public:
+    using key_type = Key; //!< Key type alias.
+    using mapped_type = Value; //!< Value type alias.
+    using value_type = pair<key_type, mapped_type>; //!< (Key, Value) pair type alias.
+    using size_type = int; //!< Size type alias.
+    using difference_type = int; //!< Difference type alias.
+    using key_compare = KeyCompare; //!< Key comparison functor alias.
+    using reference = value_type&; //!< (Key, Value) pair reference alias.
+    using const_reference = const value_type&; //!< (Key, Value) pair const reference alias.
+    using pointer = value_type*; //!< (Key, Value) pair pointer alias.
+    using const_pointer = const value_type*; //!< (Key, Value) pair const pointer alias.
+    using iterator = value_type*; //!< Iterator alias.
+    using const_iterator = const value_type*; //!< Const iterator alias.
+    using reverse_iterator = bn::reverse_iterator<iterator>; //!< Reverse iterator alias.
+    using const_reverse_iterator = bn::reverse_iterator<const_iterator>; //!< Const reverse iterator alias.
+
+    iflat_map(const iflat_map& other) = delete;
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other iflat_map to copy.
+     * @return Reference to this.
+     */
+    iflat_map& operator=(const iflat_map& other)
+    {
+        if(this != &other)
+        {
+            *_values_ref = *other._values_ref;
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     * @param other iflat_map to move.
+     * @return Reference to this.
+     */
+    iflat_map& operator=(iflat_map&& other) noexcept
+    {
+        if(this != &other)
+        {
+            *_values_ref = move(*other._values_ref);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Returns the current size.
+     */
+    [[nodiscard]] size_type size() const
+    {
+        return _values_ref->size();
+    }
+
+    /**
+     * @brief Returns the maximum possible size.
+     */
+    [[nodiscard]] size_type max_size() const
+    {
+        return _values_ref->max_size();
+    }
+
+    /**
+     * @brief Returns the remaining capacity.
+     */
+    [[nodiscard]] size_type available() const
+    {
+        return _values_ref->available();
+    }
+
+    /**
+     * @brief Indicates if it doesn't contain any element.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _values_ref->empty();
+    }
+
+    /**
+     * @brief Indicates if it can't contain any more elements.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _values_ref->full();
+    }
+
+    /**
+     * @brief Returns a const iterator to the beginning of the iflat_map.
+     */
+    [[nodiscard]] const_iterator begin() const
+    {
+        return _values_ref->begin();
+    }
+
+    /**
+     * @brief Returns an iterator to the beginning of the iflat_map.
+     *
+     * Keys must not be modified through it.
+     */
+    [[nodiscard]] iterator begin()
+    {
+        return _values_ref->begin();
+    }
+
+    /**
+     * @brief Returns a const iterator to the end of the iflat_map.
+     */
+    [[nodiscard]] const_iterator end() const
+    {
+        return _values_ref->end();
+    }
+
+    /**
+     * @brief Returns an iterator to the end of the iflat_map.
+     */
+    [[nodiscard]] iterator end()
+    {
+        return _values_ref->end();
+    }
+
+    /**
+     * @brief Returns a const iterator to the beginning of the iflat_map.
+     */
+    [[nodiscard]] const_iterator cbegin() const
+    {
+        return _values_ref->cbegin();
+    }
+
+    /**
+     * @brief Returns a const iterator to the end of the iflat_map.
+     */
+    [[nodiscard]] const_iterator cend() const
+    {
+        return _values_ref->cend();
+    }
+
+    /**
+     * @brief Returns a const reverse iterator to the end of the iflat_map.
+     */
+    [[nodiscard]] const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    /**
+     * @brief Returns a reverse iterator to the end of the iflat_map.
+     */
+    [[nodiscard]] reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @brief Returns a const reverse iterator to the beginning of the iflat_map.
+     */
+    [[nodiscard]] const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    /**
+     * @brief Returns a reverse iterator to the beginning of the iflat_map.
+     */
+    [[nodiscard]] reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+
+    /**
+     * @brief Returns a const reverse iterator to the end of the iflat_map.
+     */
+    [[nodiscard]] const_reverse_iterator crbegin() const
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    /**
+     * @brief Returns a const reverse iterator to the beginning of the iflat_map.
+     */
+    [[nodiscard]] const_reverse_iterator crend() const
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    /**
+     * @brief Indicates if the specified key is contained in this iflat_map.
+     * @param key Key to search for.
+     * @return `true` if the specified key is contained in this iflat_map, otherwise `false`.
+     */
+    [[nodiscard]] bool contains(const key_type& key) const
+    {
+        return find(key) != end();
+    }
+
+    /**
+     * @brief Counts the number of keys stored in this iflat_map are equal to the given one.
+     * @param key Key to search for.
+     * @return 1 if the specified key is contained in this iflat_map, otherwise 0.
+     */
+    [[nodiscard]] size_type count(const key_type& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key Key to search for.
+     * @return Const iterator to the (Key, Value) pair if it exists, otherwise end().
+     */
+    [[nodiscard]] const_iterator find(const key_type& key) const
+    {
+        return const_cast<iflat_map&>(*this).find(key);
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key Key to search for.
+     * @return Iterator to the (Key, Value) pair if it exists, otherwise end().
+     */
+    [[nodiscard]] iterator find(const key_type& key)
+    {
+        iterator it = lower_bound(key);
+        iterator end_it = end();
+        return it != end_it && ! key_compare()(key, it->first) ? it : end_it;
+    }
+
+    /**
+     * @brief Returns a const iterator pointing to the first (Key, Value) pair
+     * whose key is not less than the given one, or end() if no such pair is found.
+     */
+    [[nodiscard]] const_iterator lower_bound(const key_type& key) const
+    {
+        return const_cast<iflat_map&>(*this).lower_bound(key);
+    }
+
+    /**
+     * @brief Returns an iterator pointing to the first (Key, Value) pair
+     * whose key is not less than the given one, or end() if no such pair is found.
+     */
+    [[nodiscard]] iterator lower_bound(const key_type& key)
+    {
+        return _lower_bound(begin(), size(), key);
+    }
+
+    /**
+     * @brief Returns a const iterator pointing to the first (Key, Value) pair
+     * whose key is greater than the given one, or end() if no such pair is found.
+     */
+    [[nodiscard]] const_iterator upper_bound(const key_type& key) const
+    {
+        return const_cast<iflat_map&>(*this).upper_bound(key);
+    }
+
+    /**
+     * @brief Returns an iterator pointing to the first (Key, Value) pair
+     * whose key is greater than the given one, or end() if no such pair is found.
+     */
+    [[nodiscard]] iterator upper_bound(const key_type& key)
+    {
+        iterator it = lower_bound(key);
+
+        if(it != end() && ! key_compare()(key, it->first))
+        {
+            ++it;
+        }
+
+        return it;
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key Key to search for.
+     * @return Const reference to the value stored with the specified key.
+     */
+    [[nodiscard]] const mapped_type& at(const key_type& key) const
+    {
+        return const_cast<iflat_map&>(*this).at(key);
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key Key to search for.
+     * @return Reference to the value stored with the specified key.
+     */
+    [[nodiscard]] mapped_type& at(const key_type& key)
+    {
+        iterator it = find(key);
+        BN_ASSERT(it != end(), "Key not found");
+
+        return it->second;
+    }
+
+    /**
+     * @brief Inserts a copy of the given (Key, Value) pair.
+     * @param value (Key, Value) pair to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    iterator insert(const value_type& value)
+    {
+        return insert(value_type(value));
+    }
+
+    /**
+     * @brief Inserts a moved (Key, Value) pair.
+     * @param value (Key, Value) pair to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    iterator insert(value_type&& value)
+    {
+        iterator it = lower_bound(value.first);
+
+        if(it != end() && ! key_compare()(value.first, it->first))
+        {
+            return end();
+        }
+
+        return _values_ref->insert(it, move(value));
+    }
+
+    /**
+     * @brief Inserts a copy of the given (Key, Value) pair.
+     * @param key Key to insert.
+     * @param mapped_value Value to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    iterator insert(const key_type& key, const mapped_type& mapped_value)
+    {
+        return insert(value_type(key, mapped_value));
+    }
+
+    /**
+     * @brief Inserts a moved (Key, Value) pair.
+     * @param key Key to insert.
+     * @param mapped_value Value to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    iterator insert(const key_type& key, mapped_type&& mapped_value)
+    {
+        return insert(value_type(key, move(mapped_value)));
+    }
+
+    /**
+     * @brief Inserts copies of the (Key, Value) pairs of the given range.
+     *
+     * Pairs are appended at the end and then all of them are sorted at once,
+     * so it is faster than inserting them one by one.
+     *
+     * Pairs with keys already contained in this iflat_map are not inserted.
+     * If the range contains more than one pair with the same key, only one of them is inserted.
+     *
+     * @param first Iterator to the first (Key, Value) pair to insert.
+     * @param last Iterator following the last (Key, Value) pair to insert.
+     */
+    template<typename Iterator>
+    void insert(Iterator first, Iterator last)
+    {
+        ivector<value_type>& values = *_values_ref;
+        size_type old_size = values.size();
+        key_compare key_compare_functor;
+
+        for(; first != last; ++first)
+        {
+            if(values.full() && values.size() > old_size)
+            {
+                _sort_and_remove_duplicates();
+                old_size = values.size();
+            }
+
+            const value_type& value = *first;
+            iterator it = _lower_bound(values.begin(), old_size, value.first);
+
+            if(it == values.begin() + old_size || key_compare_functor(value.first, it->first))
+            {
+                values.push_back(value);
+            }
+        }
+
+        if(values.size() > old_size)
+        {
+            _sort_and_remove_duplicates();
+        }
+    }
+
+    /**
+     * @brief Inserts a copy of the given (Key, Value) pair
+     * or replaces the value with the given one if the key is found.
+     * @param value (Key, Value) pair to insert or assign.
+     * @return Iterator pointing to the inserted or assigned (Key, Value) pair.
+     */
+    iterator insert_or_assign(const value_type& value)
+    {
+        return insert_or_assign(value_type(value));
+    }
+
+    /**
+     * @brief Inserts a moved (Key, Value) pair
+     * or replaces the value with the given one if the key is found.
+     * @param value (Key, Value) pair to insert or assign.
+     * @return Iterator pointing to the inserted or assigned (Key, Value) pair.
+     */
+    iterator insert_or_assign(value_type&& value)
+    {
+        iterator it = lower_bound(value.first);
+
+        if(it != end() && ! key_compare()(value.first, it->first))
+        {
+            it->second = move(value.second);
+            return it;
+        }
+
+        return _values_ref->insert(it, move(value));
+    }
+
+    /**
+     * @brief Inserts a copy of the given (Key, Value) pair
+     * or replaces the value with the given one if the key is found.
+     * @param key Key to insert or assign.
+     * @param mapped_value Value to insert or assign.
+     * @return Iterator pointing to the inserted or assigned (Key, Value) pair.
+     */
+    iterator insert_or_assign(const key_type& key, const mapped_type& mapped_value)
+    {
+        return insert_or_assign(value_type(key, mapped_value));
+    }
+
+    /**
+     * @brief Inserts a moved (Key, Value) pair
+     * or replaces the value with the given one if the key is found.
+     * @param key Key to insert or assign.
+     * @param mapped_value Value to insert or assign.
+     * @return Iterator pointing to the inserted or assigned (Key, Value) pair.
+     */
+    iterator insert_or_assign(const key_type& key, mapped_type&& mapped_value)
+    {
+        return insert_or_assign(value_type(key, move(mapped_value)));
+    }
+
+    /**
+     * @brief Inserts in-place a (Key, Value) pair if the given key does not exist.
+     * @param key Key to insert.
+     * @param args Parameters of the value to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    template<typename... Args>
+    iterator try_emplace(const key_type& key, Args&&... args)
+    {
+        iterator it = lower_bound(key);
+
+        if(it != end() && ! key_compare()(key, it->first))
+        {
+            return end();
+        }
+
+        return _values_ref->emplace(it, key, mapped_type(forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Erases an element.
+     *
+     * Unlike `std::map`, it doesn't offer pointer stability.
+     *
+     * @param position Iterator to the element to erase.
+     * @return Iterator following the erased element.
+     */
+    iterator erase(const_iterator position)
+    {
+        return _values_ref->erase(position);
+    }
+
+    /**
+     * @brief Erases an element.
+     *
+     * Unlike `std::map`, it doesn't offer pointer stability.
+     *
+     * @param key Key to erase.
+     * @return `true` if the elements was erased, otherwise `false`.
+     */
+    bool erase(const key_type& key)
+    {
+        iterator it = find(key);
+
+        if(it != end())
+        {
+            _values_ref->erase(it);
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Erases all elements that satisfy the specified predicate.
+     *
+     * Unlike `std::map`, it doesn't offer pointer stability.
+     *
+     * @param map iflat_map from which to erase.
+     * @param pred Unary predicate which returns ​true if the element should be erased.
+     * @return Number of erased elements.
+     */
+    template<class Pred>
+    friend size_type erase_if(iflat_map& map, const Pred& pred)
+    {
+        return erase_if(*map._values_ref, pred);
+    }
+
+    /**
+     * @brief Removes all elements.
+     */
+    void clear()
+    {
+        _values_ref->clear();
+    }
+
+    /**
+     * @brief Returns a reference to the value that is mapped to the given key,
+     * performing an insertion if such key does not already exist.
+     * @param key Key to search for.
+     * @return Reference to the value that is mapped to the given key.
+     */
+    [[nodiscard]] mapped_type& operator[](const key_type& key)
+    {
+        iterator it = lower_bound(key);
+
+        if(it == end() || key_compare()(key, it->first))
+        {
+            it = _values_ref->insert(it, value_type(key, mapped_type()));
+        }
+
+        return it->second;
+    }
+
+    /**
+     * @brief Exchanges the contents of this iflat_map with those of the other one.
+     *
+     * Unlike `std::map`, it doesn't offer pointer stability.
+     *
+     * @param other iflat_map to exchange the contents with.
+     */
+    void swap(iflat_map& other)
+    {
+        if(this != &other)
+        {
+            ivector<value_type>& values = *_values_ref;
+            ivector<value_type>& other_values = *other._values_ref;
+            BN_ASSERT(values.size() <= other_values.max_size(),
+                      "Not enough space: ", other_values.max_size(), " - ", values.size());
+            BN_ASSERT(other_values.size() <= values.max_size(),
+                      "Not enough space: ", values.max_size(), " - ", other_values.size());
+
+            bool other_is_bigger = other_values.size() > values.size();
+            ivector<value_type>& min_values = other_is_bigger ? values : other_values;
+            ivector<value_type>& max_values = other_is_bigger ? other_values : values;
+            size_type min_size = min_values.size();
+            size_type max_size = max_values.size();
+
+            for(size_type index = 0; index < min_size; ++index)
+            {
+                bn::swap(min_values[index], max_values[index]);
+            }
+
+            for(size_type index = min_size; index < max_size; ++index)
+            {
+                min_values.push_back(move(max_values[index]));
+            }
+
+            max_values.erase(max_values.begin() + min_size, max_values.end());
+        }
+    }
+
+    /**
+     * @brief Exchanges the contents of a iflat_map with those of another one.
+     *
+     * Unlike `std::map`, it doesn't offer pointer stability.
+     *
+     * @param a First iflat_map to exchange the contents with.
+     * @param b Second iflat_map to exchange the contents with.
+     */
+    friend void swap(iflat_map& a, iflat_map& b)
+    {
+        a.swap(b);
+    }
+
+    /**
+     * @brief Equal operator.
+     * @param a First iflat_map to compare.
+     * @param b Second iflat_map to compare.
+     * @return `true` if the first iflat_map is equal to the second one, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator==(const iflat_map& a, const iflat_map& b)
+    {
+        return *a._values_ref == *b._values_ref;
+    }
+
+    /**
+     * @brief Not equal operator.
+     * @param a First iflat_map to compare.
+     * @param b Second iflat_map to compare.
+     * @return `true` if the first iflat_map is not equal to the second one, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator!=(const iflat_map& a, const iflat_map& b)
+    {
+        return ! (a == b);
+    }
+
+    /**
+     * @brief Less than operator.
+     * @param a First iflat_map to compare.
+     * @param b Second iflat_map to compare.
+     * @return `true` if the first iflat_map is lexicographically less than the second one, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator<(const iflat_map& a, const iflat_map& b)
+    {
+        return lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+    /**
+     * @brief Greater than operator.
+     * @param a First iflat_map to compare.
+     * @param b Second iflat_map to compare.
+     * @return `true` if the first iflat_map is lexicographically greater than the second one, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator>(const iflat_map& a, const iflat_map& b)
+    {
+        return b < a;
+    }
+
+    /**
+     * @brief Less than or equal operator.
+     * @param a First iflat_map to compare.
+     * @param b Second iflat_map to compare.
+     * @return `true` if the first iflat_map is lexicographically less than or equal to the second one,
+     * otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator<=(const iflat_map& a, const iflat_map& b)
+    {
+        return ! (a > b);
+    }
+
+    /**
+     * @brief Greater than or equal operator.
+     * @param a First iflat_map to compare.
+     * @param b Second iflat_map to compare.
+     * @return `true` if the first iflat_map is lexicographically greater than or equal to the second one,
+     * otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator>=(const iflat_map& a, const iflat_map& b)
+    {
+        return ! (a < b);
+    }
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    explicit iflat_map(ivector<value_type>& values) :
+        _values_ref(&values)
+    {
+    }
+
+    /// @endcond
+
+private:
+    ivector<value_type>* _values_ref;
+
+    [[nodiscard]] static iterator _lower_bound(iterator first, size_type size, const key_type& key)
+    {
+        if(! size)
+        {
+            return first;
+        }
+
+        // The search range is halved without branches until only one element remains:
+
+        key_compare key_compare_functor;
+
+        while(size > 1)
+        {
+            size_type half = size / 2;
+            first = key_compare_functor(first[half].first, key) ? first + half : first;
+            size -= half;
+        }
+
+        return first + key_compare_functor(first->first, key);
+    }
+
+    void _sort_and_remove_duplicates()
+    {
+        ivector<value_type>& values = *_values_ref;
+        key_compare key_compare_functor;
+
+        sort(values.begin(), values.end(), [&key_compare_functor](const value_type& a, const value_type& b)
+        {
+            return key_compare_functor(a.first, b.first);
+        });
+
+        iterator last_unique = values.begin();
+
+        for(iterator it = last_unique + 1, end = values.end(); it != end; ++it)
+        {
+            if(key_compare_functor(last_unique->first, it->first))
+            {
+                ++last_unique;
+
+                if(last_unique != it)
+                {
+                    *last_unique = move(*it);
+                }
+            }
+        }
+
+        values.erase(last_unique + 1, values.end());
+    }
+};
+
+
+template<typename Key, typename Value, int MaxSize, typename KeyCompare>
+class flat_map : public iflat_map<Key, Value, KeyCompare>
+{
+    static_assert(MaxSize > 0);
+
+public:
+    using key_type = Key; //!< Key type alias.
+    using mapped_type = Value; //!< Value type alias.
+    using value_type = pair<key_type, mapped_type>; //!< (Key, Value) pair type alias.
+    using size_type = int; //!< Size type alias.
+    using difference_type = int; //!< Difference type alias.
+    using key_compare = KeyCompare; //!< Key comparison functor alias.
+    using reference = value_type&; //!< (Key, Value) pair reference alias.
+    using const_reference = const value_type&; //!< (Key, Value) pair const reference alias.
+    using pointer = value_type*; //!< (Key, Value) pair pointer alias.
+    using const_pointer = const value_type*; //!< (Key, Value) pair const pointer alias.
+
+    /**
+     * @brief Default constructor.
+     */
+    flat_map() :
+        iflat_map<Key, Value, KeyCompare>(_values)
+    {
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param other flat_map to copy.
+     */
+    flat_map(const flat_map& other) :
+        flat_map()
+    {
+        _values = other._values;
+    }
+
+    /**
+     * @brief Move constructor.
+     * @param other flat_map to move.
+     */
+    flat_map(flat_map&& other) noexcept :
+        flat_map()
+    {
+        _values = move(other._values);
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param other iflat_map to copy.
+     */
+    flat_map(const iflat_map<Key, Value, KeyCompare>& other) :
+        flat_map()
+    {
+        iflat_map<Key, Value, KeyCompare>::operator=(other);
+    }
+
+    /**
+     * @brief Move constructor.
+     * @param other iflat_map to move.
+     */
+    flat_map(iflat_map<Key, Value, KeyCompare>&& other) noexcept :
+        flat_map()
+    {
+        iflat_map<Key, Value, KeyCompare>::operator=(move(other));
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other flat_map to copy.
+     * @return Reference to this.
+     */
+    flat_map& operator=(const flat_map& other)
+    {
+        _values = other._values;
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     * @param other flat_map to move.
+     * @return Reference to this.
+     */
+    flat_map& operator=(flat_map&& other) noexcept
+    {
+        _values = move(other._values);
+        return *this;
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other iflat_map to copy.
+     * @return Reference to this.
+     */
+    flat_map& operator=(const iflat_map<Key, Value, KeyCompare>& other)
+    {
+        iflat_map<Key, Value, KeyCompare>::operator=(other);
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     * @param other iflat_map to move.
+     * @return Reference to this.
+     */
+    flat_map& operator=(iflat_map<Key, Value, KeyCompare>&& other) noexcept
+    {
+        iflat_map<Key, Value, KeyCompare>::operator=(move(other));
+        return *this;
+    }
+
+private:
+    vector<value_type, MaxSize> _values;
+};
+
+}
+
+#endif
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FLAT_MAP_FWD_H
+#define BN_FLAT_MAP_FWD_H
+
+/**
+ * @file
+ * bn::iflat_map and bn::flat_map declaration header file.
+ *
+ * @ingroup flat_map
+ */
+
+#include "bn_functional.h"
+
+namespace bn
+{
+    /**
+     * @brief Base class of bn::flat_map.
+     *
+     * Can be used as a reference type for all bn::flat_map containers containing a specific type.
+     *
+     * Unlike `std::map`, it doesn't offer pointer stability when inserting, moving or erasing elements.
+     *
+     * @tparam Key Key type.
+     * @tparam Value Value type.
+     * @tparam KeyCompare Functor used to sort the keys.
+     *
+     * @ingroup flat_map
+     */
+    template<typename Key, typename Value, typename KeyCompare = less<Key>>
+    class iflat_map;
+
+    /**
+     * @brief `std::map` like container with a fixed size buffer.
+     *
+     * (Key, Value) pairs are stored sorted by key in a bn::vector,
+     * so searches are binary searches over contiguous memory and iteration is as fast as iterating a bn::vector.
+     *
+     * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
+     *
+     * Unlike `std::map`, it doesn't offer pointer stability when inserting, moving or erasing elements.
+     *
+     * @tparam Key Key type.
+     * @tparam Value Value type.
+     * @tparam MaxSize Maximum number of elements that can be stored.
+     * @tparam KeyCompare Functor used to sort the keys.
+     *
+     * @ingroup flat_map
+     */
+    template<typename Key, typename Value, int MaxSize, typename KeyCompare = less<Key>>
+    class flat_map;
+}
+
+#endif
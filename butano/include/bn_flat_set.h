@@ -0,0 +1,717 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FLAT_SET_H
+#define BN_FLAT_SET_H
+
+/**
+ * @file
+ * bn::iflat_set and bn::flat_set implementation header file.
+ *
+ * @ingroup flat_set
+ */
+
+#include "bn_vector.h"
+#include "bn_flat_set_fwd.h"
+
+namespace bn
+{
+
+template<typename Key, typename KeyCompare>
+class iflat_set
+{
+
+public:
+    using key_type = Key; //!< Key type alias.
+    using value_type = Key; //!< Value type alias.
+    using size_type = int; //!< Size type alias.
+    using difference_type = int; //!< Difference type alias.
+    using key_compare = KeyCompare; //!< Key comparison functor alias.
+    using reference = value_type&; //!< Reference alias.
+    using const_reference = const value_type&; //!< Const reference alias.
+    using pointer = value_type*; //!< Pointer alias.
+    using const_pointer = const value_type*; //!< Const pointer alias.
+    using iterator = const value_type*; //!< Iterator alias (values can't be modified through it).
+    using const_iterator = const value_type*; //!< Const iterator alias.
+    using reverse_iterator = bn::reverse_iterator<iterator>; //!< Reverse iterator alias.
+    using const_reverse_iterator = bn::reverse_iterator<const_iterator>; //!< Const reverse iterator alias.
+
+    iflat_set(const iflat_set& other) = delete;
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other iflat_set to copy.
+     * @return Reference to this.
+     */
+    iflat_set& operator=(const iflat_set& other)
+    {
+        if(this != &other)
+        {
+            *_values_ref = *other._values_ref;
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     * @param other iflat_set to move.
+     * @return Reference to this.
+     */
+    iflat_set& operator=(iflat_set&& other) noexcept
+    {
+        if(this != &other)
+        {
+            *_values_ref = move(*other._values_ref);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Returns the current size.
+     */
+    [[nodiscard]] size_type size() const
+    {
+        return _values_ref->size();
+    }
+
+    /**
+     * @brief Returns the maximum possible size.
+     */
+    [[nodiscard]] size_type max_size() const
+    {
+        return _values_ref->max_size();
+    }
+
+    /**
+     * @brief Returns the remaining capacity.
+     */
+    [[nodiscard]] size_type available() const
+    {
+        return _values_ref->available();
+    }
+
+    /**
+     * @brief Indicates if it doesn't contain any element.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _values_ref->empty();
+    }
+
+    /**
+     * @brief Indicates if it can't contain any more elements.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _values_ref->full();
+    }
+
+    /**
+     * @brief Returns a const iterator to the beginning of the iflat_set.
+     */
+    [[nodiscard]] const_iterator begin() const
+    {
+        return _values_ref->begin();
+    }
+
+    /**
+     * @brief Returns an iterator to the beginning of the iflat_set.
+     */
+    [[nodiscard]] iterator begin()
+    {
+        return _values_ref->begin();
+    }
+
+    /**
+     * @brief Returns a const iterator to the end of the iflat_set.
+     */
+    [[nodiscard]] const_iterator end() const
+    {
+        return _values_ref->end();
+    }
+
+    /**
+     * @brief Returns an iterator to the end of the iflat_set.
+     */
+    [[nodiscard]] iterator end()
+    {
+        return _values_ref->end();
+    }
+
+    /**
+     * @brief Returns a const iterator to the beginning of the iflat_set.
+     */
+    [[nodiscard]] const_iterator cbegin() const
+    {
+        return _values_ref->cbegin();
+    }
+
+    /**
+     * @brief Returns a const iterator to the end of the iflat_set.
+     */
+    [[nodiscard]] const_iterator cend() const
+    {
+        return _values_ref->cend();
+    }
+
+    /**
+     * @brief Returns a const reverse iterator to the end of the iflat_set.
+     */
+    [[nodiscard]] const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    /**
+     * @brief Returns a reverse iterator to the end of the iflat_set.
+     */
+    [[nodiscard]] reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @brief Returns a const reverse iterator to the beginning of the iflat_set.
+     */
+    [[nodiscard]] const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    /**
+     * @brief Returns a reverse iterator to the beginning of the iflat_set.
+     */
+    [[nodiscard]] reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+
+    /**
+     * @brief Returns a const reverse iterator to the end of the iflat_set.
+     */
+    [[nodiscard]] const_reverse_iterator crbegin() const
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    /**
+     * @brief Returns a const reverse iterator to the beginning of the iflat_set.
+     */
+    [[nodiscard]] const_reverse_iterator crend() const
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    /**
+     * @brief Indicates if the specified key is contained in this iflat_set.
+     * @param key Key to search for.
+     * @return `true` if the specified key is contained in this iflat_set, otherwise `false`.
+     */
+    [[nodiscard]] bool contains(const key_type& key) const
+    {
+        return find(key) != end();
+    }
+
+    /**
+     * @brief Counts the number of keys stored in this iflat_set are equal to the given one.
+     * @param key Key to search for.
+     * @return 1 if the specified key is contained in this iflat_set, otherwise 0.
+     */
+    [[nodiscard]] size_type count(const key_type& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key Key to search for.
+     * @return Const iterator to the value if it exists, otherwise end().
+     */
+    [[nodiscard]] const_iterator find(const key_type& key) const
+    {
+        return const_cast<iflat_set&>(*this).find(key);
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key Key to search for.
+     * @return Iterator to the value if it exists, otherwise end().
+     */
+    [[nodiscard]] iterator find(const key_type& key)
+    {
+        iterator it = lower_bound(key);
+        iterator end_it = end();
+        return it != end_it && ! key_compare()(key, *it) ? it : end_it;
+    }
+
+    /**
+     * @brief Returns a const iterator pointing to the first value
+     * whose key is not less than the given one, or end() if no such value is found.
+     */
+    [[nodiscard]] const_iterator lower_bound(const key_type& key) const
+    {
+        return const_cast<iflat_set&>(*this).lower_bound(key);
+    }
+
+    /**
+     * @brief Returns an iterator pointing to the first value
+     * whose key is not less than the given one, or end() if no such value is found.
+     */
+    [[nodiscard]] iterator lower_bound(const key_type& key)
+    {
+        return _lower_bound(begin(), size(), key);
+    }
+
+    /**
+     * @brief Returns a const iterator pointing to the first value
+     * whose key is greater than the given one, or end() if no such value is found.
+     */
+    [[nodiscard]] const_iterator upper_bound(const key_type& key) const
+    {
+        return const_cast<iflat_set&>(*this).upper_bound(key);
+    }
+
+    /**
+     * @brief Returns an iterator pointing to the first value
+     * whose key is greater than the given one, or end() if no such value is found.
+     */
+    [[nodiscard]] iterator upper_bound(const key_type& key)
+    {
+        iterator it = lower_bound(key);
+
+        if(it != end() && ! key_compare()(key, *it))
+        {
+            ++it;
+        }
+
+        return it;
+    }
+
+    /**
+     * @brief Inserts a copy of the given value.
+     * @param value Value to insert.
+     * @return Iterator pointing to the inserted value if the key does not exist, otherwise end().
+     */
+    iterator insert(const value_type& value)
+    {
+        return insert(value_type(value));
+    }
+
+    /**
+     * @brief Inserts a moved value.
+     * @param value Value to insert.
+     * @return Iterator pointing to the inserted value if the key does not exist, otherwise end().
+     */
+    iterator insert(value_type&& value)
+    {
+        iterator it = lower_bound(value);
+
+        if(it != end() && ! key_compare()(value, *it))
+        {
+            return end();
+        }
+
+        return _values_ref->insert(it, move(value));
+    }
+
+    /**
+     * @brief Inserts copies of the values of the given range.
+     *
+     * Values are appended at the end and then all of them are sorted at once,
+     * so it is faster than inserting them one by one.
+     *
+     * Values already contained in this iflat_set are not inserted.
+     * If the range contains equivalent values, only one of them is inserted.
+     *
+     * @param first Iterator to the first value to insert.
+     * @param last Iterator following the last value to insert.
+     */
+    template<typename Iterator>
+    void insert(Iterator first, Iterator last)
+    {
+        ivector<value_type>& values = *_values_ref;
+        size_type old_size = values.size();
+        key_compare key_compare_functor;
+
+        for(; first != last; ++first)
+        {
+            if(values.full() && values.size() > old_size)
+            {
+                _sort_and_remove_duplicates();
+                old_size = values.size();
+            }
+
+            const value_type& value = *first;
+            iterator it = _lower_bound(values.begin(), old_size, value);
+
+            if(it == values.begin() + old_size || key_compare_functor(value, *it))
+            {
+                values.push_back(value);
+            }
+        }
+
+        if(values.size() > old_size)
+        {
+            _sort_and_remove_duplicates();
+        }
+    }
+
+    /**
+     * @brief Erases an element.
+     *
+     * Unlike `std::set`, it doesn't offer pointer stability.
+     *
+     * @param position Iterator to the element to erase.
+     * @return Iterator following the erased element.
+     */
+    iterator erase(const_iterator position)
+    {
+        return _values_ref->erase(position);
+    }
+
+    /**
+     * @brief Erases an element.
+     *
+     * Unlike `std::set`, it doesn't offer pointer stability.
+     *
+     * @param key Key to erase.
+     * @return `true` if the elements was erased, otherwise `false`.
+     */
+    bool erase(const key_type& key)
+    {
+        iterator it = find(key);
+
+        if(it != end())
+        {
+            _values_ref->erase(it);
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Erases all elements that satisfy the specified predicate.
+     *
+     * Unlike `std::set`, it doesn't offer pointer stability.
+     *
+     * @param set iflat_set from which to erase.
+     * @param pred Unary predicate which returns ​true if the element should be erased.
+     * @return Number of erased elements.
+     */
+    template<class Pred>
+    friend size_type erase_if(iflat_set& set, const Pred& pred)
+    {
+        return erase_if(*set._values_ref, pred);
+    }
+
+    /**
+     * @brief Removes all elements.
+     */
+    void clear()
+    {
+        _values_ref->clear();
+    }
+
+    /**
+     * @brief Exchanges the contents of this iflat_set with those of the other one.
+     *
+     * Unlike `std::set`, it doesn't offer pointer stability.
+     *
+     * @param other iflat_set to exchange the contents with.
+     */
+    void swap(iflat_set& other)
+    {
+        if(this != &other)
+        {
+            ivector<value_type>& values = *_values_ref;
+            ivector<value_type>& other_values = *other._values_ref;
+            BN_ASSERT(values.size() <= other_values.max_size(),
+                      "Not enough space: ", other_values.max_size(), " - ", values.size());
+            BN_ASSERT(other_values.size() <= values.max_size(),
+                      "Not enough space: ", values.max_size(), " - ", other_values.size());
+
+            bool other_is_bigger = other_values.size() > values.size();
+            ivector<value_type>& min_values = other_is_bigger ? values : other_values;
+            ivector<value_type>& max_values = other_is_bigger ? other_values : values;
+            size_type min_size = min_values.size();
+            size_type max_size = max_values.size();
+
+            for(size_type index = 0; index < min_size; ++index)
+            {
+                bn::swap(min_values[index], max_values[index]);
+            }
+
+            for(size_type index = min_size; index < max_size; ++index)
+            {
+                min_values.push_back(move(max_values[index]));
+            }
+
+            max_values.erase(max_values.begin() + min_size, max_values.end());
+        }
+    }
+
+    /**
+     * @brief Exchanges the contents of a iflat_set with those of another one.
+     *
+     * Unlike `std::set`, it doesn't offer pointer stability.
+     *
+     * @param a First iflat_set to exchange the contents with.
+     * @param b Second iflat_set to exchange the contents with.
+     */
+    friend void swap(iflat_set& a, iflat_set& b)
+    {
+        a.swap(b);
+    }
+
+    /**
+     * @brief Equal operator.
+     * @param a First iflat_set to compare.
+     * @param b Second iflat_set to compare.
+     * @return `true` if the first iflat_set is equal to the second one, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator==(const iflat_set& a, const iflat_set& b)
+    {
+        return *a._values_ref == *b._values_ref;
+    }
+
+    /**
+     * @brief Not equal operator.
+     * @param a First iflat_set to compare.
+     * @param b Second iflat_set to compare.
+     * @return `true` if the first iflat_set is not equal to the second one, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator!=(const iflat_set& a, const iflat_set& b)
+    {
+        return ! (a == b);
+    }
+
+    /**
+     * @brief Less than operator.
+     * @param a First iflat_set to compare.
+     * @param b Second iflat_set to compare.
+     * @return `true` if the first iflat_set is lexicographically less than the second one, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator<(const iflat_set& a, const iflat_set& b)
+    {
+        return lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+    /**
+     * @brief Greater than operator.
+     * @param a First iflat_set to compare.
+     * @param b Second iflat_set to compare.
+     * @return `true` if the first iflat_set is lexicographically greater than the second one, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator>(const iflat_set& a, const iflat_set& b)
+    {
+        return b < a;
+    }
+
+    /**
+     * @brief Less than or equal operator.
+     * @param a First iflat_set to compare.
+     * @param b Second iflat_set to compare.
+     * @return `true` if the first iflat_set is lexicographically less than or equal to the second one,
+     * otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator<=(const iflat_set& a, const iflat_set& b)
+    {
+        return ! (a > b);
+    }
+
+    /**
+     * @brief Greater than or equal operator.
+     * @param a First iflat_set to compare.
+     * @param b Second iflat_set to compare.
+     * @return `true` if the first iflat_set is lexicographically greater than or equal to the second one,
+     * otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator>=(const iflat_set& a, const iflat_set& b)
+    {
+        return ! (a < b);
+    }
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    explicit iflat_set(ivector<value_type>& values) :
+        _values_ref(&values)
+    {
+    }
+
+    /// @endcond
+
+private:
+    ivector<value_type>* _values_ref;
+
+    [[nodiscard]] static iterator _lower_bound(iterator first, size_type size, const key_type& key)
+    {
+        if(! size)
+        {
+            return first;
+        }
+
+        // The search range is halved without branches until only one element remains:
+
+        key_compare key_compare_functor;
+
+        while(size > 1)
+        {
+            size_type half = size / 2;
+            first = key_compare_functor(first[half], key) ? first + half : first;
+            size -= half;
+        }
+
+        return first + key_compare_functor(*first, key);
+    }
+
+    void _sort_and_remove_duplicates()
+    {
+        ivector<value_type>& values = *_values_ref;
+        key_compare key_compare_functor;
+
+        sort(values.begin(), values.end(), [&key_compare_functor](const value_type& a, const value_type& b)
+        {
+            return key_compare_functor(a, b);
+        });
+
+        pointer last_unique = values.begin();
+
+        for(pointer it = last_unique + 1, end = values.end(); it != end; ++it)
+        {
+            if(key_compare_functor(*last_unique, *it))
+            {
+                ++last_unique;
+
+                if(last_unique != it)
+                {
+                    *last_unique = move(*it);
+                }
+            }
+        }
+
+        values.erase(last_unique + 1, values.end());
+    }
+};
+
+
+template<typename Key, int MaxSize, typename KeyCompare>
+class flat_set : public iflat_set<Key, KeyCompare>
+{
+    static_assert(MaxSize > 0);
+
+public:
+    using key_type = Key; //!< Key type alias.
+    using value_type = Key; //!< Value type alias.
+    using size_type = int; //!< Size type alias.
+    using difference_type = int; //!< Difference type alias.
+    using key_compare = KeyCompare; //!< Key comparison functor alias.
+    using reference = value_type&; //!< Reference alias.
+    using const_reference = const value_type&; //!< Const reference alias.
+    using pointer = value_type*; //!< Pointer alias.
+    using const_pointer = const value_type*; //!< Const pointer alias.
+
+    /**
+     * @brief Default constructor.
+     */
+    flat_set() :
+        iflat_set<Key, KeyCompare>(_values)
+    {
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param other flat_set to copy.
+     */
+    flat_set(const flat_set& other) :
+        flat_set()
+    {
+        _values = other._values;
+    }
+
+    /**
+     * @brief Move constructor.
+     * @param other flat_set to move.
+     */
+    flat_set(flat_set&& other) noexcept :
+        flat_set()
+    {
+        _values = move(other._values);
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param other iflat_set to copy.
+     */
+    flat_set(const iflat_set<Key, KeyCompare>& other) :
+        flat_set()
+    {
+        iflat_set<Key, KeyCompare>::operator=(other);
+    }
+
+    /**
+     * @brief Move constructor.
+     * @param other iflat_set to move.
+     */
+    flat_set(iflat_set<Key, KeyCompare>&& other) noexcept :
+        flat_set()
+    {
+        iflat_set<Key, KeyCompare>::operator=(move(other));
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other flat_set to copy.
+     * @return Reference to this.
+     */
+    flat_set& operator=(const flat_set& other)
+    {
+        _values = other._values;
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     * @param other flat_set to move.
+     * @return Reference to this.
+     */
+    flat_set& operator=(flat_set&& other) noexcept
+    {
+        _values = move(other._values);
+        return *this;
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other iflat_set to copy.
+     * @return Reference to this.
+     */
+    flat_set& operator=(const iflat_set<Key, KeyCompare>& other)
+    {
+        iflat_set<Key, KeyCompare>::operator=(other);
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     * @param other iflat_set to move.
+     * @return Reference to this.
+     */
+    flat_set& operator=(iflat_set<Key, KeyCompare>&& other) noexcept
+    {
+        iflat_set<Key, KeyCompare>::operator=(move(other));
+        return *this;
+    }
+
+private:
+    vector<value_type, MaxSize> _values;
+};
+
+}
+
+#endif
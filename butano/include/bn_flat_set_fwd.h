@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FLAT_SET_FWD_H
+#define BN_FLAT_SET_FWD_H
+
+/**
+ * @file
+ * bn::iflat_set and bn::flat_set declaration header file.
+ *
+ * @ingroup flat_set
+ */
+
+#include "bn_functional.h"
+
+namespace bn
+{
+    /**
+     * @brief Base class of bn::flat_set.
+     *
+     * Can be used as a reference type for all bn::flat_set containers containing a specific type.
+     *
+     * Unlike `std::set`, it doesn't offer pointer stability when inserting, moving or erasing elements.
+     *
+     * @tparam Key Key type.
+     * @tparam KeyCompare Functor used to sort the keys.
+     *
+     * @ingroup flat_set
+     */
+    template<typename Key, typename KeyCompare = less<Key>>
+    class iflat_set;
+
+    /**
+     * @brief `std::set` like container with a fixed size buffer.
+     *
+     * Keys are stored sorted in a bn::vector,
+     * so searches are binary searches over contiguous memory and iteration is as fast as iterating a bn::vector.
+     *
+     * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
+     *
+     * Unlike `std::set`, it doesn't offer pointer stability when inserting, moving or erasing elements.
+     *
+     * @tparam Key Key type.
+     * @tparam MaxSize Maximum number of elements that can be stored.
+     * @tparam KeyCompare Functor used to sort the keys.
+     *
+     * @ingroup flat_set
+     */
+    template<typename Key, int MaxSize, typename KeyCompare = less<Key>>
+    class flat_set;
+}
+
+#endif
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FRAME_ALLOCATOR_H
+#define BN_FRAME_ALLOCATOR_H
+
+/**
+ * @file
+ * bn::frame_allocator header file.
+ *
+ * @ingroup memory
+ */
+
+#include <new>
+#include "bn_assert.h"
+#include "bn_utility.h"
+#include "bn_config_log.h"
+#include "bn_config_doxygen.h"
+#include "bn_config_frame_allocator.h"
+
+/**
+ * @brief Bump pointer allocator for short-lived objects.
+ *
+ * All allocations are released at once by bn::core::update, so memory allocated with these functions
+ * must not be used after the next bn::core::update call.
+ *
+ * Allocating is just a pointer increment and releasing is free, so it is much faster than the heap
+ * and it doesn't fragment it.
+ *
+ * @ingroup memory
+ */
+namespace bn::frame_allocator
+{
+    /**
+     * @brief Allocates uninitialized storage.
+     * @param bytes Bytes to allocate.
+     * @param alignment Alignment in bytes of the allocated storage (it must be a power of two).
+     * @return On success, returns the pointer to the beginning of newly allocated memory.
+     * On failure, returns `nullptr`.
+     *
+     * The returned pointer is invalidated by the next bn::core::update call.
+     */
+    [[nodiscard]] void* alloc(int bytes, int alignment = alignof(int));
+
+    /**
+     * @brief Constructs a value inside of the frame allocator.
+     *
+     * Its destructor is not called when the frame allocator is reset,
+     * so it should be trivially destructible or destroyed manually.
+     *
+     * @param args Parameters of the value to construct.
+     * @return Reference to the new value, invalidated by the next bn::core::update call.
+     */
+    template<typename Type, typename... Args>
+    [[nodiscard]] Type& create(Args&&... args)
+    {
+        auto result = static_cast<Type*>(alloc(int(sizeof(Type)), int(alignof(Type))));
+        BN_ASSERT(result, "Allocation failed. Size in bytes: ", int(sizeof(Type)));
+
+        ::new(result) Type(forward<Args>(args)...);
+        return *result;
+    }
+
+    /**
+     * @brief Returns the size in bytes of all allocated items since the last bn::core::update call.
+     */
+    [[nodiscard]] int used_bytes();
+
+    /**
+     * @brief Returns the number of bytes that still can be allocated before the next bn::core::update call.
+     */
+    [[nodiscard]] int available_bytes();
+
+    /**
+     * @brief Returns the maximum number of bytes used in a single frame since bn::core::init
+     * or since the last bn::frame_allocator::reset_max_used_bytes call.
+     */
+    [[nodiscard]] int max_used_bytes();
+
+    /**
+     * @brief Resets the value returned by bn::frame_allocator::max_used_bytes.
+     */
+    void reset_max_used_bytes();
+
+    #if BN_CFG_LOG_ENABLED || BN_DOXYGEN
+        /**
+         * @brief Logs the current status of the frame allocator.
+         */
+        void log_status();
+    #endif
+}
+
+#endif
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FRAME_VECTOR_H
+#define BN_FRAME_VECTOR_H
+
+/**
+ * @file
+ * bn::frame_vector implementation header file.
+ *
+ * @ingroup vector
+ */
+
+#include "bn_vector.h"
+#include "bn_frame_allocator.h"
+
+namespace bn
+{
+
+/**
+ * @brief bn::ivector which elements are stored in the frame allocator.
+ *
+ * Its capacity is specified at construction time and its storage is released by the next bn::core::update call,
+ * so it must be destroyed before that.
+ *
+ * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
+ *
+ * @tparam Type Element type.
+ *
+ * @ingroup vector
+ */
+template<typename Type>
+class frame_vector : public ivector<Type>
+{
+
+public:
+    using value_type = Type; //!< Value type alias.
+    using size_type = int; //!< Size type alias.
+    using difference_type = int; //!< Difference type alias.
+    using reference = Type&; //!< Reference alias.
+    using const_reference = const Type&; //!< Const reference alias.
+    using pointer = Type*; //!< Pointer alias.
+    using const_pointer = const Type*; //!< Const pointer alias.
+    using iterator = Type*; //!< Iterator alias.
+    using const_iterator = const Type*; //!< Const iterator alias.
+    using reverse_iterator = bn::reverse_iterator<iterator>; //!< Reverse iterator alias.
+    using const_reverse_iterator = bn::reverse_iterator<const_iterator>; //!< Const reverse iterator alias.
+
+    /**
+     * @brief Constructor.
+     * @param max_size Maximum number of elements that can be stored.
+     */
+    explicit frame_vector(size_type max_size) :
+        ivector<Type>(_allocate(max_size), max_size)
+    {
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param other ivector to copy.
+     * @param max_size Maximum number of elements that can be stored.
+     */
+    frame_vector(const ivector<Type>& other, size_type max_size) :
+        frame_vector(max_size)
+    {
+        BN_ASSERT(other.size() <= max_size, "Not enough space: ", max_size, " - ", other.size());
+
+        this->_assign(other);
+    }
+
+    frame_vector(const frame_vector& other) = delete;
+
+    frame_vector& operator=(const frame_vector& other) = delete;
+
+    /**
+     * @brief Destructor.
+     */
+    ~frame_vector() noexcept = default;
+
+    /**
+     * @brief Destructor.
+     */
+    ~frame_vector() noexcept
+    requires(! is_trivially_destructible_v<Type>)
+    {
+        this->clear();
+    }
+
+private:
+    [[nodiscard]] static reference _allocate(size_type max_size)
+    {
+        BN_ASSERT(max_size > 0, "Invalid max size: ", max_size);
+
+        void* data = frame_allocator::alloc(max_size * int(sizeof(Type)), int(alignof(Type)));
+        BN_ASSERT(data, "Allocation failed. Size in bytes: ", max_size * int(sizeof(Type)));
+
+        return *static_cast<pointer>(data);
+    }
+};
+
+}
+
+#endif
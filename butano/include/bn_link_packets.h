@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_LINK_PACKETS_H
+#define BN_LINK_PACKETS_H
+
+/**
+ * @file
+ * bn::link_packets header file.
+ *
+ * @ingroup link
+ */
+
+#include "bn_span.h"
+#include "bn_vector.h"
+#include "bn_optional.h"
+#include "bn_config_link.h"
+
+namespace bn
+{
+
+/**
+ * @brief Sends variable-length messages and a shared game state to the other players through the link cable.
+ *
+ * Messages and state sent in the same frame are batched in one packet, which is split in 16-bit link messages
+ * with bn::link::send.
+ *
+ * Game state is delta encoded against the last state acknowledged by all the other players,
+ * so only the modified bytes are usually sent.
+ *
+ * Lost link messages are detected and the packets which contain them are discarded:
+ * game state is sent again until it is acknowledged, but discarded messages are not.
+ *
+ * update() must be called once per frame, and bn::link::send and bn::link::receive must not be called
+ * while this object is being updated.
+ *
+ * This is a big object (about 3KB with the default configuration), so it should be allocated in EWRAM.
+ *
+ * @ingroup link
+ */
+class link_packets
+{
+
+public:
+    /**
+     * @brief Returns the maximum size in bytes of a message.
+     */
+    [[nodiscard]] static constexpr int max_message_size()
+    {
+        return 192;
+    }
+
+    /**
+     * @brief Returns the maximum size in bytes of the game state.
+     */
+    [[nodiscard]] static constexpr int max_state_size()
+    {
+        return BN_CFG_LINK_PACKETS_MAX_STATE_SIZE;
+    }
+
+    /**
+     * @brief Returns the maximum number of 16-bit link messages of a packet.
+     */
+    [[nodiscard]] static constexpr int max_packet_words()
+    {
+        return _max_packet_words;
+    }
+
+    /**
+     * @brief Default constructor.
+     */
+    link_packets();
+
+    link_packets(const link_packets& other) = delete;
+
+    link_packets& operator=(const link_packets& other) = delete;
+
+    /**
+     * @brief Returns the ID of this player in the range [0..3], or -1 if it is not known yet.
+     */
+    [[nodiscard]] int current_player_id() const
+    {
+        return _current_player_id;
+    }
+
+    /**
+     * @brief Queues a message to be sent to the other players in the next packet.
+     * @param message Message to send. Its size must be in the range [1..max_message_size()].
+     * @return `true` if the message has been queued, otherwise `false` (there's no space left to store it).
+     */
+    [[nodiscard]] bool send(const span<const uint8_t>& message);
+
+    /**
+     * @brief Retrieves the oldest received message.
+     * @param player_id Returns the ID of the player who sent the message.
+     * @param message Returns the received message. Its capacity must be >= max_message_size().
+     * @return `true` if a message has been retrieved, otherwise `false`.
+     */
+    [[nodiscard]] bool receive(int& player_id, ivector<uint8_t>& message);
+
+    /**
+     * @brief Returns the game state of this player.
+     */
+    [[nodiscard]] span<const uint8_t> state() const
+    {
+        return span<const uint8_t>(_state, _state_size);
+    }
+
+    /**
+     * @brief Sets the game state of this player.
+     * @param state Game state. Its size must be in the range [1..max_state_size()].
+     */
+    void set_state(const span<const uint8_t>& state);
+
+    /**
+     * @brief Returns the last game state received from the given player, or an empty span if there's none.
+     *
+     * The returned span is valid until this object is updated.
+     *
+     * @param player_id Player ID, in the range [0..3].
+     */
+    [[nodiscard]] span<const uint8_t> player_state(int player_id) const;
+
+    /**
+     * @brief Sends and receives packets with bn::link::send and bn::link::receive.
+     *
+     * It must be called once per frame.
+     */
+    void update();
+
+    /**
+     * @brief Builds a new packet if the previous one has been sent.
+     *
+     * It is called by update(), so it should only be called once per frame to send packets
+     * through a custom transport.
+     */
+    void flush();
+
+    /**
+     * @brief Returns the next 16-bit message of the packets to send, or an empty optional if there's none.
+     *
+     * It should only be called to send packets through a custom transport.
+     */
+    [[nodiscard]] optional<int> pop_word();
+
+    /**
+     * @brief Processes a received 16-bit message.
+     *
+     * It should only be called to receive packets through a custom transport.
+     *
+     * @param current_player_id ID of this player, in the range [0..3].
+     * @param player_id ID of the player who sent the message, in the range [0..3].
+     * @param word Received message, in the range [0..65533].
+     */
+    void push_word(int current_player_id, int player_id, int word);
+
+    /**
+     * @brief Returns the number of updated frames (calls to flush()).
+     */
+    [[nodiscard]] int frames() const
+    {
+        return _frames;
+    }
+
+    /**
+     * @brief Returns the number of sent packets.
+     */
+    [[nodiscard]] int sent_packets() const
+    {
+        return _sent_packets;
+    }
+
+    /**
+     * @brief Returns the number of sent 16-bit link messages.
+     */
+    [[nodiscard]] int sent_words() const
+    {
+        return _sent_words;
+    }
+
+    /**
+     * @brief Returns the number of received packets.
+     */
+    [[nodiscard]] int received_packets() const
+    {
+        return _received_packets;
+    }
+
+    /**
+     * @brief Returns the number of received 16-bit link messages.
+     */
+    [[nodiscard]] int received_words() const
+    {
+        return _received_words;
+    }
+
+    /**
+     * @brief Returns the number of packets which have been lost or discarded because they were incomplete.
+     */
+    [[nodiscard]] int lost_packets() const
+    {
+        return _lost_packets;
+    }
+
+    /**
+     * @brief Returns the number of received messages discarded because there was no space left to store them.
+     */
+    [[nodiscard]] int dropped_messages() const
+    {
+        return _dropped_messages;
+    }
+
+    /**
+     * @brief Returns the number of frames elapsed between sending the last acknowledged game state
+     * and receiving its acknowledgement, or -1 if no game state has been acknowledged yet.
+     */
+    [[nodiscard]] int round_trip_frames() const
+    {
+        return _round_trip_frames;
+    }
+
+    /**
+     * @brief Resets the number of sent, received, lost and dropped packets, messages and words.
+     */
+    void reset_stats();
+
+private:
+    static constexpr int _max_packet_words = 127;
+    static constexpr int _history_size = 8;
+
+    class peer_type
+    {
+
+    public:
+        uint8_t states[_history_size][BN_CFG_LINK_PACKETS_MAX_STATE_SIZE];
+        uint16_t words[_max_packet_words - 1];
+        int16_t state_seqs[_history_size];
+        uint8_t state_sizes[_history_size];
+        int last_frame = -1;
+        int16_t state_seq = -1;
+        int16_t ack = -1;
+        int16_t last_packet_seq = -1;
+        int16_t packet_seq = -1;
+        uint8_t packet_words = 0;
+        uint8_t received_words = 0;
+        bool in_packet = false;
+        bool need_full_state = false;
+    };
+
+    peer_type _peers[4];
+    uint8_t _sent_states[_history_size][BN_CFG_LINK_PACKETS_MAX_STATE_SIZE];
+    uint8_t _state[BN_CFG_LINK_PACKETS_MAX_STATE_SIZE];
+    int _sent_state_frames[_history_size];
+    int16_t _sent_state_seqs[_history_size];
+    uint8_t _sent_state_sizes[_history_size];
+    vector<uint8_t, BN_CFG_LINK_PACKETS_BUFFER_SIZE> _pending_messages;
+    vector<uint8_t, BN_CFG_LINK_PACKETS_BUFFER_SIZE> _received_messages;
+    vector<uint16_t, _max_packet_words> _output_words;
+    int _output_word_index = 0;
+    int _frames = 0;
+    int _sent_packets = 0;
+    int _sent_words = 0;
+    int _received_packets = 0;
+    int _received_words = 0;
+    int _lost_packets = 0;
+    int _dropped_messages = 0;
+    int _round_trip_frames = -1;
+    int _current_player_id = -1;
+    int _last_state_frame = 0;
+    int16_t _state_seq = -1;
+    uint8_t _state_size = 0;
+    uint8_t _seq = 0;
+    bool _state_changed = false;
+    bool _acks_changed = false;
+    bool _message_delayed = false;
+
+    [[nodiscard]] bool _connected(const peer_type& peer) const;
+
+    [[nodiscard]] int _baseline_seq() const;
+
+    void _process_packet(int player_id);
+};
+
+}
+
+#endif
@@ -16,6 +16,7 @@
 #include "bn_array.h"
 #include "bn_fixed.h"
 #include "bn_sin_lut.h"
+#include "bn_fixed_divider.h"
 #include "bn_reciprocal_lut.h"
 #include "bn_rule_of_three_approximation.h"
 
@@ -468,6 +469,27 @@ namespace bn
             return reciprocal_lut._data[lut_value];
         }
     }
+
+    /**
+     * @brief Calculates the reciprocal of a value without doing an integer division.
+     *
+     * Unlike lut_reciprocal, it supports any fixed point value different than zero,
+     * as long as the absolute value of its reciprocal fits in a fixed_t<Precision>.
+     *
+     * The result is truncated towards zero like in fixed_t::safe_division, but its absolute value can be one unit higher.
+     *
+     * If a value is going to be used as divisor multiple times, a fixed_divider_t should be used instead.
+     *
+     * @param value Fixed point value (!= 0).
+     * @return Reciprocal of the given value (1 / value).
+     *
+     * @ingroup math
+     */
+    template<int Precision>
+    [[nodiscard]] constexpr fixed_t<Precision> fast_reciprocal(fixed_t<Precision> value)
+    {
+        return fixed_divider_t<Precision>(value).reciprocal();
+    }
 }
 
 #endif
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_MATH_3D_H
+#define BN_MATH_3D_H
+
+/**
+ * @file
+ * 3D math functions and LUTs header file.
+ *
+ * @ingroup models_3d
+ */
+
+#include "bn_fixed.h"
+#include "bn_sin_lut.h"
+#include "bn_array.h"
+#include "bn_type_traits.h"
+
+namespace bn
+{
+
+/**
+ * @brief 3D sine LUT size.
+ *
+ * @ingroup models_3d
+ */
+constexpr int sin_3d_lut_size = 65536;
+
+/**
+ * @brief 3D sine LUT (one entry for each angle, 360 degrees = 65536).
+ *
+ * @ingroup models_3d
+ */
+extern const array<int16_t, sin_3d_lut_size>& sin_3d_lut;
+
+/**
+ * @brief Calculates the sine value of an angle using bn::sin_3d_lut.
+ * @param angle Angle (360 degrees = 65536).
+ * @return Sine value in the range [-1, 1].
+ *
+ * @ingroup models_3d
+ */
+[[nodiscard]] constexpr fixed sin_3d(int angle)
+{
+    if(is_constant_evaluated())
+    {
+        return fixed::from_data(calculate_sin_lut_value(angle));
+    }
+
+    return fixed::from_data(sin_3d_lut._data[angle % sin_3d_lut_size]);
+}
+
+/**
+ * @brief Calculates the cosine value of an angle using bn::sin_3d_lut.
+ * @param angle Angle (360 degrees = 65536).
+ * @return Cosine value in the range [-1, 1].
+ *
+ * @ingroup models_3d
+ */
+[[nodiscard]] constexpr fixed cos_3d(int angle)
+{
+    return sin_3d(angle + 16384);
+}
+
+/**
+ * @brief 3D division LUT precision (number of bits used for the fractional part of its values).
+ *
+ * @ingroup models_3d
+ */
+constexpr int division_3d_lut_precision = 24;
+
+/**
+ * @brief 3D division LUT size.
+ *
+ * @ingroup models_3d
+ */
+constexpr int division_3d_lut_size = 1024 * 4;
+
+/**
+ * @brief Calculates the value to store in bn::division_3d_lut for the given denominator.
+ * @param denominator Denominator in the range [0, division_3d_lut_size).
+ * @return Reciprocal of the given denominator with division_3d_lut_precision bits of precision,
+ * or 1 if the given denominator is lower than 2.
+ *
+ * @ingroup models_3d
+ */
+[[nodiscard]] constexpr uint32_t calculate_division_3d_lut_value(int denominator)
+{
+    if(denominator < 2)
+    {
+        return 1 << division_3d_lut_precision;
+    }
+
+    return uint32_t((1 << division_3d_lut_precision) / denominator);
+}
+
+/**
+ * @brief 3D division LUT.
+ *
+ * @ingroup models_3d
+ */
+extern const array<uint32_t, division_3d_lut_size>& division_3d_lut;
+
+/**
+ * @brief Divides the given numerator by the given unsigned denominator using bn::division_3d_lut.
+ * @tparam Precision Number of bits used for the fractional part of the result.
+ * @param numerator Numerator.
+ * @param denominator Denominator in the range [0, division_3d_lut_size).
+ * @return Division result, or the numerator if the given denominator is lower than 2.
+ *
+ * @ingroup models_3d
+ */
+template<int Precision>
+[[nodiscard]] constexpr fixed_t<Precision> unsafe_unsigned_lut_division_3d(int numerator, int denominator)
+{
+    static_assert(Precision > 0 && Precision <= division_3d_lut_precision, "Invalid precision");
+
+    uint32_t division_lut_value = is_constant_evaluated() ?
+                calculate_division_3d_lut_value(denominator) : division_3d_lut._data[denominator];
+
+    return fixed_t<Precision>::from_data(
+                numerator * int(division_lut_value >> (division_3d_lut_precision - Precision)));
+}
+
+}
+
+#endif
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_MODE_7_H
+#define BN_MODE_7_H
+
+/**
+ * @file
+ * bn::mode_7 header file.
+ *
+ * @ingroup mode_7
+ */
+
+#include "bn_display.h"
+#include "bn_optional.h"
+#include "bn_point_3d.h"
+#include "bn_fixed_point.h"
+#include "bn_affine_bg_ptr.h"
+#include "bn_blending_fade_alpha.h"
+#include "bn_blending_fade_alpha_hbe_ptr.h"
+
+namespace bn
+{
+
+/**
+ * @brief Renders an affine background as a perspective projected floor.
+ *
+ * The affine registers of each screen line are calculated in one pass from IWRAM without divisions
+ * and they are copied to the affine background with one HDMA transfer per line,
+ * so bn::hdma can't be used while this object is alive.
+ *
+ * Lines above the horizon are moved outside the affine background,
+ * so they are transparent if the affine background doesn't wrap around.
+ *
+ * This is a big object (more than 5KB), so it should be allocated in EWRAM.
+ *
+ * @ingroup mode_7
+ */
+class mode_7
+{
+
+public:
+    /**
+     * @brief World-to-screen projection of a point of the floor.
+     */
+    class projection
+    {
+
+    public:
+        fixed_point position; //!< Screen position, with the origin at the center of the screen like sprites.
+        fixed scale; //!< Scale that a sprite placed in this position should have.
+    };
+
+    /**
+     * @brief Constructor.
+     * @param bg Affine background to render as a floor.
+     */
+    explicit mode_7(affine_bg_ptr bg);
+
+    /**
+     * @brief Destructor.
+     *
+     * It stops the HDMA transfer if it was started by this object.
+     */
+    ~mode_7();
+
+    mode_7(const mode_7& other) = delete;
+
+    mode_7& operator=(const mode_7& other) = delete;
+
+    /**
+     * @brief Returns the affine background rendered as a floor.
+     */
+    [[nodiscard]] const affine_bg_ptr& bg() const
+    {
+        return _bg;
+    }
+
+    /**
+     * @brief Returns the camera position, with the y axis as the height over the floor.
+     *
+     * x and z coordinates are affine background pixels.
+     */
+    [[nodiscard]] const point_3d& camera_position() const
+    {
+        return _camera_position;
+    }
+
+    /**
+     * @brief Sets the camera position.
+     * @param camera_position Camera position, with the y axis as the height over the floor (y > 0).
+     *
+     * x and z coordinates are affine background pixels.
+     */
+    void set_camera_position(const point_3d& camera_position);
+
+    /**
+     * @brief Returns the camera rotation angle around the vertical axis in degrees.
+     */
+    [[nodiscard]] fixed camera_phi() const
+    {
+        return _camera_phi;
+    }
+
+    /**
+     * @brief Sets the camera rotation angle around the vertical axis.
+     * @param camera_phi Camera rotation angle around the vertical axis in degrees, in the range [0..360].
+     */
+    void set_camera_phi(fixed camera_phi);
+
+    /**
+     * @brief Returns the screen line of the horizon.
+     */
+    [[nodiscard]] int horizon_y() const
+    {
+        return _horizon_y;
+    }
+
+    /**
+     * @brief Sets the screen line of the horizon.
+     * @param horizon_y Screen line of the horizon, in the range [0..display::height()).
+     */
+    void set_horizon_y(int horizon_y);
+
+    /**
+     * @brief Returns the distance from the camera to the projection plane in pixels.
+     */
+    [[nodiscard]] fixed focal_length() const
+    {
+        return _focal_length;
+    }
+
+    /**
+     * @brief Sets the distance from the camera to the projection plane in pixels.
+     * @param focal_length Distance from the camera to the projection plane in pixels (> 0).
+     */
+    void set_focal_length(fixed focal_length);
+
+    /**
+     * @brief Returns the fade intensity of the horizon fog.
+     */
+    [[nodiscard]] fixed fog_intensity() const
+    {
+        return _fog_intensity;
+    }
+
+    /**
+     * @brief Sets the fade intensity of the horizon fog.
+     *
+     * The fog is drawn with a blending fade H-Blank effect,
+     * so its color is set with bn::blending::set_fade_color.
+     *
+     * @param fog_intensity Fade intensity of the horizon fog, in the range [0..1].
+     * If it is 0, the fog is disabled.
+     */
+    void set_fog_intensity(fixed fog_intensity);
+
+    /**
+     * @brief Returns the number of screen lines below the horizon covered by the fog.
+     */
+    [[nodiscard]] int fog_lines() const
+    {
+        return _fog_lines;
+    }
+
+    /**
+     * @brief Sets the number of screen lines below the horizon covered by the fog.
+     * @param fog_lines Number of screen lines below the horizon covered by the fog (> 0).
+     */
+    void set_fog_lines(int fog_lines);
+
+    /**
+     * @brief Projects the given floor point in the screen.
+     * @param world_position Floor point to project (x and z coordinates in affine background pixels).
+     * @return Screen projection of the given floor point if it is in front of the camera; bn::nullopt otherwise.
+     */
+    [[nodiscard]] optional<projection> project(const fixed_point& world_position) const;
+
+    /**
+     * @brief Calculates the affine registers of each screen line and the horizon fog.
+     *
+     * It should be called once per frame, before bn::core::update.
+     */
+    void update();
+
+private:
+    class line_attributes
+    {
+
+    public:
+        int16_t pa;
+        int16_t pb;
+        int16_t pc;
+        int16_t pd;
+        int dx;
+        int dy;
+    };
+
+    static_assert(sizeof(line_attributes) == 16);
+
+    alignas(int) line_attributes _lines_a[display::height()];
+    alignas(int) line_attributes _lines_b[display::height()];
+    blending_fade_alpha _fog_alphas[display::height()];
+    affine_bg_ptr _bg;
+    point_3d _camera_position;
+    fixed _camera_phi;
+    fixed _focal_length = display::height();
+    fixed _fog_intensity;
+    optional<blending_fade_alpha_hbe_ptr> _fog_hbe;
+    int _horizon_y = 0;
+    int _fog_lines = display::height() / 2;
+    bool _lines_a_active = false;
+    bool _fog_updated = false;
+    bool _hdma_started = false;
+
+    void _update_fog();
+
+    BN_CODE_IWRAM static void _fill_lines(int camera_x, int camera_y, int camera_z, int cos, int sin,
+                                          int focal_length, int horizon_y, line_attributes* lines);
+};
+
+}
+
+#endif
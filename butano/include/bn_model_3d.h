@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_MODEL_3D_H
+#define BN_MODEL_3D_H
+
+/**
+ * @file
+ * bn::model_3d header file.
+ *
+ * @ingroup models_3d
+ */
+
+#include "bn_intrusive_list.h"
+
+#include "bn_math_3d.h"
+#include "bn_model_3d_item.h"
+
+namespace bn
+{
+
+/**
+ * @brief Dynamic 3D model which can be moved, scaled and rotated.
+ *
+ * It must be created with bn::models_3d::create_dynamic_model.
+ *
+ * @ingroup models_3d
+ */
+class model_3d : public intrusive_list_node_type
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param item model_3d_item to render.
+     */
+    constexpr explicit model_3d(const model_3d_item& item) :
+        _item(item)
+    {
+    }
+
+    /**
+     * @brief Returns the model_3d_item to render.
+     */
+    [[nodiscard]] constexpr const model_3d_item& item() const
+    {
+        return _item;
+    }
+
+    /**
+     * @brief Returns the position in the 3D world.
+     */
+    [[nodiscard]] constexpr const point_3d& position() const
+    {
+        return _position;
+    }
+
+    /**
+     * @brief Sets the position in the 3D world.
+     */
+    constexpr void set_position(const point_3d& position)
+    {
+        _position = position;
+    }
+
+    /**
+     * @brief Returns the scale.
+     */
+    [[nodiscard]] constexpr fixed scale() const
+    {
+        return _scale;
+    }
+
+    /**
+     * @brief Sets the scale.
+     * @param scale Scale (> 0).
+     */
+    constexpr void set_scale(fixed scale)
+    {
+        BN_ASSERT(scale > 0, "Invalid scale: ", scale);
+
+        _scale = scale;
+    }
+
+    /**
+     * @brief Returns the phi rotation angle (360 degrees = 65536).
+     */
+    [[nodiscard]] constexpr fixed phi() const
+    {
+        return _phi;
+    }
+
+    /**
+     * @brief Sets the phi rotation angle.
+     * @param phi Phi rotation angle (360 degrees = 65536).
+     */
+    constexpr void set_phi(fixed phi)
+    {
+        if(phi > 0xFFFF)
+        {
+            phi -= 0xFFFF;
+        }
+        else if(phi < 0)
+        {
+            phi += 0xFFFF;
+        }
+
+        BN_ASSERT(phi >= 0 && phi <= 0xFFFF, "Invalid phi: ", phi);
+
+        int old_angle = _phi.right_shift_integer();
+        int new_angle = phi.right_shift_integer();
+        _phi = phi;
+
+        if(old_angle != new_angle)
+        {
+            _phi_sin = sin_3d(new_angle);
+            _phi_cos = cos_3d(new_angle);
+            _update = true;
+        }
+    }
+
+    /**
+     * @brief Returns the theta rotation angle (360 degrees = 65536).
+     */
+    [[nodiscard]] constexpr fixed theta() const
+    {
+        return _theta;
+    }
+
+    /**
+     * @brief Sets the theta rotation angle.
+     * @param theta Theta rotation angle (360 degrees = 65536).
+     */
+    constexpr void set_theta(fixed theta)
+    {
+        if(theta > 0xFFFF)
+        {
+            theta -= 0xFFFF;
+        }
+        else if(theta < 0)
+        {
+            theta += 0xFFFF;
+        }
+
+        BN_ASSERT(theta >= 0 && theta <= 0xFFFF, "Invalid theta: ", theta);
+
+        int old_angle = _theta.right_shift_integer();
+        int new_angle = theta.right_shift_integer();
+        _theta = theta;
+
+        if(old_angle != new_angle)
+        {
+            _theta_sin = sin_3d(new_angle);
+            _theta_cos = cos_3d(new_angle);
+            _update = true;
+        }
+    }
+
+    /**
+     * @brief Returns the psi rotation angle (360 degrees = 65536).
+     */
+    [[nodiscard]] constexpr fixed psi() const
+    {
+        return _psi;
+    }
+
+    /**
+     * @brief Sets the psi rotation angle.
+     * @param psi Psi rotation angle (360 degrees = 65536).
+     */
+    constexpr void set_psi(fixed psi)
+    {
+        if(psi > 0xFFFF)
+        {
+            psi -= 0xFFFF;
+        }
+        else if(psi < 0)
+        {
+            psi += 0xFFFF;
+        }
+
+        BN_ASSERT(psi >= 0 && psi <= 0xFFFF, "Invalid psi: ", psi);
+
+        int old_angle = _psi.right_shift_integer();
+        int new_angle = psi.right_shift_integer();
+        _psi = psi;
+
+        if(old_angle != new_angle)
+        {
+            _psi_sin = sin_3d(new_angle);
+            _psi_cos = cos_3d(new_angle);
+            _update = true;
+        }
+    }
+
+    /**
+     * @brief Returns the given vertex rotated with the current rotation angles.
+     *
+     * update() must be called before if the rotation angles have been modified.
+     */
+    [[nodiscard]] constexpr point_3d rotate(const vertex_3d& vertex) const
+    {
+        fixed vx = vertex.point().x();
+        fixed vy = vertex.point().y();
+        fixed vz = vertex.point().z();
+        fixed vxy = vertex.xy();
+        fixed rx = (_xx + vy).safe_multiplication(_xy + vx) + vz.unsafe_multiplication(_xz) - _xx_xy - vxy;
+        fixed ry = (_yx + vy).safe_multiplication(_yy + vx) + vz.unsafe_multiplication(_yz) - _yx_yy - vxy;
+        fixed rz = (_zx + vy).safe_multiplication(_zy + vx) + vz.unsafe_multiplication(_zz) - _zx_zy - vxy;
+
+        return point_3d(rx, ry, rz);
+    }
+
+    /**
+     * @brief Returns the given vertex rotated, scaled and translated to the 3D world.
+     *
+     * update() must be called before if the rotation angles have been modified.
+     */
+    [[nodiscard]] constexpr point_3d transform(const vertex_3d& vertex) const
+    {
+        point_3d result = rotate(vertex);
+        fixed scale = _scale;
+
+        if(scale != 1)
+        {
+            result.set_x(result.x().unsafe_multiplication(scale));
+            result.set_y(result.y().unsafe_multiplication(scale));
+            result.set_z(result.z().unsafe_multiplication(scale));
+        }
+
+        return result + _position;
+    }
+
+    /**
+     * @brief Updates the rotation matrix if the rotation angles have been modified.
+     */
+    constexpr void update()
+    {
+        if(! _update)
+        {
+            return;
+        }
+
+        fixed phi_sin = _phi_sin;
+        fixed phi_cos = _phi_cos;
+        fixed theta_sin = _theta_sin;
+        fixed theta_cos = _theta_cos;
+        fixed psi_sin = _psi_sin;
+        fixed psi_cos = _psi_cos;
+        _update = false;
+
+        fixed phi_cos_theta_sin = phi_cos.unsafe_multiplication(theta_sin);
+        _xx = phi_cos.unsafe_multiplication(theta_cos);
+        _xy = phi_cos_theta_sin.unsafe_multiplication(psi_sin) - phi_sin.unsafe_multiplication(psi_cos);
+        _xz = phi_cos_theta_sin.unsafe_multiplication(psi_cos) + phi_sin.unsafe_multiplication(psi_sin);
+
+        fixed phi_sin_theta_sin = phi_sin.unsafe_multiplication(theta_sin);
+        _yx = phi_sin.unsafe_multiplication(theta_cos);
+        _yy = phi_sin_theta_sin.unsafe_multiplication(psi_sin) + phi_cos.unsafe_multiplication(psi_cos);
+        _yz = phi_sin_theta_sin.unsafe_multiplication(psi_cos) - phi_cos.unsafe_multiplication(psi_sin);
+
+        _zx = -theta_sin;
+        _zy = theta_cos.unsafe_multiplication(psi_sin);
+        _zz = theta_cos.unsafe_multiplication(psi_cos);
+
+        _xx_xy = _xx.unsafe_multiplication(_xy);
+        _yx_yy = _yx.unsafe_multiplication(_yy);
+        _zx_zy = _zx.unsafe_multiplication(_zy);
+    }
+
+private:
+    const model_3d_item& _item;
+    point_3d _position;
+    fixed _scale = 1;
+    fixed _phi;
+    fixed _phi_sin;
+    fixed _phi_cos = 1;
+    fixed _theta;
+    fixed _theta_sin;
+    fixed _theta_cos = 1;
+    fixed _psi;
+    fixed _psi_sin;
+    fixed _psi_cos = 1;
+    fixed _xx;
+    fixed _xy;
+    fixed _xz;
+    fixed _yx;
+    fixed _yy;
+    fixed _yz;
+    fixed _zx;
+    fixed _zy;
+    fixed _zz;
+    fixed _xx_xy;
+    fixed _yx_yy;
+    fixed _zx_zy;
+    bool _update = true;
+};
+
+}
+
+#endif
@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_MODEL_3D_ITEM_H
+#define BN_MODEL_3D_ITEM_H
+
+/**
+ * @file
+ * bn::face_3d, bn::model_3d_vertical_cylinder and bn::model_3d_item header file.
+ *
+ * @ingroup models_3d
+ * @ingroup tool
+ */
+
+#include "bn_math.h"
+#include "bn_span.h"
+#include "bn_point_3d.h"
+
+namespace bn
+{
+
+/**
+ * @brief Flat shaded triangle or quad of a 3D model.
+ *
+ * @ingroup models_3d
+ */
+class face_3d
+{
+
+public:
+    /**
+     * @brief Shading value which indicates that the shading of the face must be calculated from its normal.
+     */
+    static constexpr int directional_shading = -1;
+
+    /**
+     * @brief Maximum number of colors that can be referenced by a face.
+     */
+    static constexpr int max_colors = 10;
+
+    /**
+     * @brief Triangle constructor.
+     * @param vertices Vertices of the 3D model.
+     * @param normal Normal vector of the face.
+     * @param first_vertex_index Index of the first vertex of the face.
+     * @param second_vertex_index Index of the second vertex of the face.
+     * @param third_vertex_index Index of the third vertex of the face.
+     * @param color_index Index of the color of the face in the range [0, max_colors).
+     * @param shading Shading of the face in the range [0, 7], or directional_shading.
+     */
+    constexpr face_3d(const span<const vertex_3d>& vertices, const vertex_3d& normal, int first_vertex_index,
+                      int second_vertex_index, int third_vertex_index, int color_index, int shading) :
+        _centroid(_calculate_centroid(vertices, first_vertex_index, second_vertex_index, third_vertex_index)),
+        _normal(normal),
+        _first_vertex_index(int16_t(first_vertex_index)),
+        _second_vertex_index(int16_t(second_vertex_index)),
+        _third_vertex_index(int16_t(third_vertex_index)),
+        _fourth_vertex_index(int16_t(first_vertex_index)),
+        _color_index(int8_t(color_index)),
+        _shading(int8_t(_calculate_shading(shading, normal.point().y()))),
+        _triangle(true)
+    {
+        BN_ASSERT(color_index >= 0 && color_index < max_colors, "Invalid color index: ", color_index);
+    }
+
+    /**
+     * @brief Quad constructor.
+     * @param vertices Vertices of the 3D model.
+     * @param normal Normal vector of the face.
+     * @param first_vertex_index Index of the first vertex of the face.
+     * @param second_vertex_index Index of the second vertex of the face.
+     * @param third_vertex_index Index of the third vertex of the face.
+     * @param fourth_vertex_index Index of the fourth vertex of the face.
+     * @param color_index Index of the color of the face in the range [0, max_colors).
+     * @param shading Shading of the face in the range [0, 7], or directional_shading.
+     */
+    constexpr face_3d(const span<const vertex_3d>& vertices, const vertex_3d& normal, int first_vertex_index,
+                      int second_vertex_index, int third_vertex_index, int fourth_vertex_index, int color_index,
+                      int shading) :
+        _centroid(_calculate_centroid(vertices, first_vertex_index, second_vertex_index, third_vertex_index,
+                                      fourth_vertex_index)),
+        _normal(normal),
+        _first_vertex_index(int16_t(first_vertex_index)),
+        _second_vertex_index(int16_t(second_vertex_index)),
+        _third_vertex_index(int16_t(third_vertex_index)),
+        _fourth_vertex_index(int16_t(fourth_vertex_index)),
+        _color_index(int8_t(color_index)),
+        _shading(int8_t(_calculate_shading(shading, normal.point().y()))),
+        _triangle(false)
+    {
+        BN_ASSERT(color_index >= 0 && color_index < max_colors, "Invalid color index: ", color_index);
+    }
+
+    /**
+     * @brief Returns the centroid of the face.
+     */
+    [[nodiscard]] constexpr const vertex_3d& centroid() const
+    {
+        return _centroid;
+    }
+
+    /**
+     * @brief Returns the normal vector of the face.
+     */
+    [[nodiscard]] constexpr const vertex_3d& normal() const
+    {
+        return _normal;
+    }
+
+    /**
+     * @brief Returns the index of the first vertex of the face.
+     */
+    [[nodiscard]] constexpr int first_vertex_index() const
+    {
+        return _first_vertex_index;
+    }
+
+    /**
+     * @brief Returns the index of the second vertex of the face.
+     */
+    [[nodiscard]] constexpr int second_vertex_index() const
+    {
+        return _second_vertex_index;
+    }
+
+    /**
+     * @brief Returns the index of the third vertex of the face.
+     */
+    [[nodiscard]] constexpr int third_vertex_index() const
+    {
+        return _third_vertex_index;
+    }
+
+    /**
+     * @brief Returns the index of the fourth vertex of the face
+     * (the index of the first vertex if it is a triangle).
+     */
+    [[nodiscard]] constexpr int fourth_vertex_index() const
+    {
+        return _fourth_vertex_index;
+    }
+
+    /**
+     * @brief Returns the index of the color of the face.
+     */
+    [[nodiscard]] constexpr int color_index() const
+    {
+        return _color_index;
+    }
+
+    /**
+     * @brief Sets the index of the color of the face.
+     * @param color_index Color index in the range [0, max_colors).
+     */
+    constexpr void set_color_index(int color_index)
+    {
+        BN_ASSERT(color_index >= 0 && color_index < max_colors, "Invalid color index: ", color_index);
+
+        _color_index = int8_t(color_index);
+    }
+
+    /**
+     * @brief Returns the shading of the face in the range [0, 7].
+     */
+    [[nodiscard]] constexpr int shading() const
+    {
+        return _shading;
+    }
+
+    /**
+     * @brief Sets the shading of the face.
+     * @param shading Shading in the range [0, 7], or directional_shading.
+     */
+    constexpr void set_shading(int shading)
+    {
+        _shading = int8_t(_calculate_shading(shading, _normal.point().y()));
+    }
+
+    /**
+     * @brief Indicates if this face is a triangle or a quad.
+     */
+    [[nodiscard]] constexpr bool triangle() const
+    {
+        return _triangle;
+    }
+
+private:
+    vertex_3d _centroid;
+    vertex_3d _normal;
+    int16_t _first_vertex_index;
+    int16_t _second_vertex_index;
+    int16_t _third_vertex_index;
+    int16_t _fourth_vertex_index;
+    int8_t _color_index;
+    int8_t _shading;
+    bool _triangle;
+
+    [[nodiscard]] constexpr static vertex_3d _calculate_centroid(
+            const span<const vertex_3d>& vertices, int first_vertex_index, int second_vertex_index,
+            int third_vertex_index)
+    {
+        BN_ASSERT(vertices.size() > 0 && vertices.size() < 32768, "Invalid vertices count: ", vertices.size());
+        BN_ASSERT(first_vertex_index >= 0 && first_vertex_index < vertices.size(),
+                  "Invalid first vertex index: ", first_vertex_index, " - ", vertices.size());
+        BN_ASSERT(second_vertex_index >= 0 && second_vertex_index < vertices.size(),
+                  "Invalid second vertex index: ", second_vertex_index, " - ", vertices.size());
+        BN_ASSERT(third_vertex_index >= 0 && third_vertex_index < vertices.size(),
+                  "Invalid third vertex index: ", third_vertex_index, " - ", vertices.size());
+
+        const point_3d& first_point = vertices.data()[first_vertex_index].point();
+        const point_3d& second_point = vertices.data()[second_vertex_index].point();
+        const point_3d& third_point = vertices.data()[third_vertex_index].point();
+        BN_ASSERT(first_point != second_point, "Vertices are the same");
+        BN_ASSERT(first_point != third_point, "Vertices are the same");
+        BN_ASSERT(second_point != third_point, "Vertices are the same");
+
+        return vertex_3d((first_point + second_point + third_point) / 3);
+    }
+
+    [[nodiscard]] constexpr static vertex_3d _calculate_centroid(
+            const span<const vertex_3d>& vertices, int first_vertex_index, int second_vertex_index,
+            int third_vertex_index, int fourth_vertex_index)
+    {
+        BN_ASSERT(vertices.size() > 0 && vertices.size() < 32768, "Invalid vertices count: ", vertices.size());
+        BN_ASSERT(first_vertex_index >= 0 && first_vertex_index < vertices.size(),
+                  "Invalid first vertex index: ", first_vertex_index, " - ", vertices.size());
+        BN_ASSERT(second_vertex_index >= 0 && second_vertex_index < vertices.size(),
+                  "Invalid second vertex index: ", second_vertex_index, " - ", vertices.size());
+        BN_ASSERT(third_vertex_index >= 0 && third_vertex_index < vertices.size(),
+                  "Invalid third vertex index: ", third_vertex_index, " - ", vertices.size());
+        BN_ASSERT(fourth_vertex_index >= 0 && fourth_vertex_index < vertices.size(),
+                  "Invalid fourth vertex index: ", fourth_vertex_index, " - ", vertices.size());
+
+        const point_3d& first_point = vertices.data()[first_vertex_index].point();
+        const point_3d& second_point = vertices.data()[second_vertex_index].point();
+        const point_3d& third_point = vertices.data()[third_vertex_index].point();
+        const point_3d& fourth_point = vertices.data()[fourth_vertex_index].point();
+        BN_ASSERT(first_point != second_point, "Vertices are the same");
+        BN_ASSERT(first_point != third_point, "Vertices are the same");
+        BN_ASSERT(second_point != third_point, "Vertices are the same");
+        BN_ASSERT(fourth_point != first_point, "Vertices are the same");
+        BN_ASSERT(fourth_point != second_point, "Vertices are the same");
+        BN_ASSERT(fourth_point != third_point, "Vertices are the same");
+
+        return vertex_3d((first_point + second_point + third_point + fourth_point) / 4);
+    }
+
+    [[nodiscard]] constexpr static int _calculate_shading(int input_shading, fixed normal_y)
+    {
+        if(input_shading == directional_shading)
+        {
+            fixed light_vector_dot_normal = abs(normal_y);
+            int result = light_vector_dot_normal.data() >> (12 - 3);
+            return min(result, 7);
+        }
+
+        BN_ASSERT(input_shading >= 0 && input_shading <= 7, "Invalid shading: ", input_shading);
+
+        return input_shading;
+    }
+};
+
+
+/**
+ * @brief Vertical cylinder which bounds a 3D model in the x and z axes.
+ *
+ * It is not used to render 3D models, but it can be used for collision detection.
+ *
+ * @ingroup models_3d
+ */
+class model_3d_vertical_cylinder
+{
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    constexpr model_3d_vertical_cylinder() = default;
+
+    /**
+     * @brief Constructor.
+     * @param centroid_x Horizontal position of the center of the cylinder.
+     * @param centroid_z Horizontal position of the center of the cylinder.
+     * @param integer_radius Radius of the cylinder (>= 0).
+     */
+    constexpr model_3d_vertical_cylinder(fixed centroid_x, fixed centroid_z, int integer_radius) :
+        _centroid_x(centroid_x),
+        _centroid_z(centroid_z),
+        _integer_radius(integer_radius)
+    {
+        BN_ASSERT(integer_radius >= 0, "Invalid integer radius: ", integer_radius);
+    }
+
+    /**
+     * @brief Returns the x coordinate of the center of the cylinder.
+     */
+    [[nodiscard]] constexpr fixed centroid_x() const
+    {
+        return _centroid_x;
+    }
+
+    /**
+     * @brief Returns the z coordinate of the center of the cylinder.
+     */
+    [[nodiscard]] constexpr fixed centroid_z() const
+    {
+        return _centroid_z;
+    }
+
+    /**
+     * @brief Returns the radius of the cylinder.
+     */
+    [[nodiscard]] constexpr int integer_radius() const
+    {
+        return _integer_radius;
+    }
+
+private:
+    fixed _centroid_x;
+    fixed _centroid_z;
+    int _integer_radius = 0;
+};
+
+
+/**
+ * @brief Contains the required information to render a 3D model.
+ *
+ * The assets conversion tools generate an object of this type in the build folder for each *.obj file.
+ *
+ * @ingroup models_3d
+ * @ingroup tool
+ */
+class model_3d_item
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param vertices Vertices of the 3D model.
+     * @param faces Faces of the 3D model.
+     */
+    constexpr model_3d_item(const span<const vertex_3d>& vertices, const span<const face_3d>& faces) :
+        model_3d_item(vertices, faces, nullptr, nullptr)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param vertices Vertices of the 3D model.
+     * @param faces Faces of the 3D model.
+     * @param collision_face Optional face used for collision detection (not rendered).
+     */
+    constexpr model_3d_item(const span<const vertex_3d>& vertices, const span<const face_3d>& faces,
+                            const face_3d* collision_face) :
+        model_3d_item(vertices, faces, collision_face, nullptr)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param vertices Vertices of the 3D model.
+     * @param faces Faces of the 3D model.
+     * @param collision_face Optional face used for collision detection (not rendered).
+     * @param vertical_cylinder Optional vertical cylinder used for collision detection.
+     */
+    constexpr model_3d_item(const span<const vertex_3d>& vertices, const span<const face_3d>& faces,
+                            const face_3d* collision_face, const model_3d_vertical_cylinder* vertical_cylinder) :
+        _vertices(vertices),
+        _faces(faces),
+        _collision_face(collision_face),
+        _vertical_cylinder(vertical_cylinder)
+    {
+        BN_ASSERT(vertices.size() > 0 && vertices.size() < 32768, "Invalid vertices count: ", vertices.size());
+        BN_ASSERT(! faces.empty(), "There's no faces");
+    }
+
+    /**
+     * @brief Returns the vertices of the 3D model.
+     */
+    [[nodiscard]] constexpr const span<const vertex_3d>& vertices() const
+    {
+        return _vertices;
+    }
+
+    /**
+     * @brief Returns the faces of the 3D model.
+     */
+    [[nodiscard]] constexpr const span<const face_3d>& faces() const
+    {
+        return _faces;
+    }
+
+    /**
+     * @brief Returns the optional face used for collision detection.
+     */
+    [[nodiscard]] constexpr const face_3d* collision_face() const
+    {
+        return _collision_face;
+    }
+
+    /**
+     * @brief Returns the optional vertical cylinder used for collision detection.
+     */
+    [[nodiscard]] constexpr const model_3d_vertical_cylinder* vertical_cylinder() const
+    {
+        return _vertical_cylinder;
+    }
+
+private:
+    span<const vertex_3d> _vertices;
+    span<const face_3d> _faces;
+    const face_3d* _collision_face;
+    const model_3d_vertical_cylinder* _vertical_cylinder;
+};
+
+}
+
+#endif
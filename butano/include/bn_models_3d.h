@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_MODELS_3D_H
+#define BN_MODELS_3D_H
+
+/**
+ * @file
+ * bn::models_3d header file.
+ *
+ * @ingroup models_3d
+ */
+
+#include "bn_pool.h"
+#include "bn_color.h"
+#include "bn_vector.h"
+#include "bn_limits.h"
+#include "bn_display.h"
+#include "bn_model_3d.h"
+#include "bn_sprite_3d.h"
+#include "bn_intrusive_list.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_config_models_3d.h"
+
+namespace bn
+{
+
+class camera_3d;
+
+/**
+ * @brief Renders flat shaded 3D models and 3D sprites with hardware sprites updated with H-Blank DMA.
+ *
+ * Each visible face is projected, depth sorted and split in horizontal lines,
+ * which are drawn with one hardware sprite per line.
+ *
+ * Static models are provided by the user each frame with set_static_model_items,
+ * while dynamic models and 3D sprites are created and destroyed with this class.
+ *
+ * The last BN_CFG_MODELS_3D_MAX_SCANLINE_SPRITES hardware sprites are overwritten with H-Blank DMA,
+ * so H-Blank effects can't be used while 3D models are being rendered.
+ *
+ * This is a big object (more than 60KB with the default settings), so it should be allocated in EWRAM.
+ *
+ * @ingroup models_3d
+ */
+class models_3d
+{
+
+public:
+    /**
+     * @brief Number of bits to shift to calculate the focal length.
+     */
+    static constexpr int focal_length_shift = 8;
+
+    /**
+     * @brief Returns the maximum number of static 3D models that can be rendered.
+     */
+    [[nodiscard]] static constexpr int max_static_models()
+    {
+        return BN_CFG_MODELS_3D_MAX_STATIC_MODELS;
+    }
+
+    /**
+     * @brief Returns the maximum number of dynamic 3D models that can be created.
+     */
+    [[nodiscard]] static constexpr int max_dynamic_models()
+    {
+        return BN_CFG_MODELS_3D_MAX_DYNAMIC_MODELS;
+    }
+
+    /**
+     * @brief Returns the maximum number of 3D sprites that can be created.
+     */
+    [[nodiscard]] static constexpr int max_sprites()
+    {
+        return BN_CFG_MODELS_3D_MAX_SPRITES;
+    }
+
+    /**
+     * @brief Returns the maximum number of vertices of all models.
+     */
+    [[nodiscard]] static constexpr int max_vertices()
+    {
+        return BN_CFG_MODELS_3D_MAX_VERTICES;
+    }
+
+    /**
+     * @brief Returns the maximum number of faces of all models and sprites.
+     */
+    [[nodiscard]] static constexpr int max_faces()
+    {
+        return BN_CFG_MODELS_3D_MAX_FACES;
+    }
+
+    /**
+     * @brief Returns the maximum number of hardware sprites used to draw each screen line.
+     */
+    [[nodiscard]] static constexpr int max_scanline_sprites()
+    {
+        return BN_CFG_MODELS_3D_MAX_SCANLINE_SPRITES;
+    }
+
+    /**
+     * @brief Loads the colors referenced by the faces of the 3D models.
+     * @param colors Colors referenced by the faces of the 3D models (face_3d::max_colors at most).
+     */
+    void load_colors(const span<const color>& colors)
+    {
+        _shape_groups.load_colors(colors);
+    }
+
+    /**
+     * @brief Releases the resources allocated by load_colors.
+     */
+    void clear_colors()
+    {
+        _shape_groups.load_colors(span<const color>());
+    }
+
+    /**
+     * @brief Sets the fade applied to the colors of the 3D models.
+     * @param color Fade color.
+     * @param intensity Fade intensity in the range [0..1].
+     */
+    void set_fade(color color, fixed intensity)
+    {
+        _shape_groups.set_fade(color, intensity);
+    }
+
+    /**
+     * @brief Sets the static 3D models to render.
+     *
+     * The referenced items are not copied, so they must outlive this object or until this method is called again.
+     *
+     * @param static_model_items_ptr Pointer to the first static model_3d_item to render.
+     * @param static_models_count Number of static models to render.
+     */
+    void set_static_model_items(const model_3d_item** static_model_items_ptr, int static_models_count);
+
+    /**
+     * @brief Creates a dynamic 3D model.
+     * @param model_item model_3d_item to render.
+     * @return Reference to the new model_3d.
+     */
+    [[nodiscard]] model_3d& create_dynamic_model(const model_3d_item& model_item);
+
+    /**
+     * @brief Destroys the given dynamic 3D model.
+     */
+    void destroy_dynamic_model(model_3d& model);
+
+    /**
+     * @brief Creates a 3D sprite.
+     * @param sprite_item sprite_3d_item to render.
+     * @return Reference to the new sprite_3d.
+     */
+    [[nodiscard]] sprite_3d& create_sprite(sprite_3d_item& sprite_item);
+
+    /**
+     * @brief Destroys the given 3D sprite.
+     */
+    void destroy_sprite(sprite_3d& sprite);
+
+    /**
+     * @brief Returns the number of vertices of all models.
+     */
+    [[nodiscard]] int vertices_count() const
+    {
+        return _vertices_count;
+    }
+
+    /**
+     * @brief Returns the number of faces of all models and sprites.
+     */
+    [[nodiscard]] int faces_count() const
+    {
+        return _faces_count;
+    }
+
+    /**
+     * @brief Returns the number of faces and sprites drawn in the last update.
+     */
+    [[nodiscard]] int visible_faces_count() const
+    {
+        return _visible_faces_count;
+    }
+
+    /**
+     * @brief Projects, sorts and draws all 3D models and sprites.
+     *
+     * It should be called once per frame, before bn::core::update.
+     *
+     * @param camera camera_3d used to project the 3D models and sprites.
+     */
+    void update(const camera_3d& camera);
+
+private:
+    static_assert(BN_CFG_MODELS_3D_MAX_STATIC_MODELS >= 0);
+    static_assert(BN_CFG_MODELS_3D_MAX_DYNAMIC_MODELS > 0);
+    static_assert(BN_CFG_MODELS_3D_MAX_SPRITES > 0);
+    static_assert(BN_CFG_MODELS_3D_MAX_VERTICES > 0);
+    static_assert(BN_CFG_MODELS_3D_MAX_FACES > 0 && BN_CFG_MODELS_3D_MAX_FACES <= numeric_limits<uint8_t>::max());
+    static_assert(BN_CFG_MODELS_3D_MAX_SCANLINE_SPRITES > 0 && BN_CFG_MODELS_3D_MAX_SCANLINE_SPRITES <= 128);
+
+    struct point_2d
+    {
+        int16_t x;
+        int16_t y;
+    };
+
+    struct vertex_2d
+    {
+        int x;
+        int y;
+        vertex_2d* prev;
+        vertex_2d* next;
+    };
+
+    struct valid_face_info
+    {
+        const face_3d* face;
+        const point_2d* projected_vertices;
+        int projected_z;
+    };
+
+    struct visible_face_info
+    {
+        const valid_face_info* valid_face;
+        int top_index;
+        int16_t minimum_x;
+        int16_t maximum_x;
+        int16_t minimum_y;
+        int16_t maximum_y;
+    };
+
+    class shape_groups
+    {
+
+    public:
+        class hline
+        {
+
+        public:
+            int xl;
+            int xr;
+        };
+
+        shape_groups();
+
+        ~shape_groups()
+        {
+            _clear();
+        }
+
+        void load_colors(const span<const color>& colors);
+
+        void set_fade(color color, fixed intensity);
+
+        void enable_drawing()
+        {
+            _draw_enabled = true;
+        }
+
+        BN_CODE_IWRAM void add_hlines(unsigned minimum_y, unsigned maximum_y, int width, bool x_outside,
+                                      int color_index, unsigned shading, const hline* hlines);
+
+        BN_CODE_IWRAM void add_sprite(unsigned minimum_y, unsigned maximum_y,
+                                      uint16_t attr0, uint16_t attr1, uint16_t attr2);
+
+        void update();
+
+    private:
+        static constexpr int _max_palettes = 8;
+        static constexpr int _max_hdma_sprites = BN_CFG_MODELS_3D_MAX_SCANLINE_SPRITES;
+        static constexpr int _hdma_source_size = (display::height() + 1) * 4 * _max_hdma_sprites;
+
+        class color_tiles
+        {
+
+        public:
+            sprite_tiles_ptr small_tiles;
+            sprite_tiles_ptr normal_tiles;
+            sprite_tiles_ptr big_tiles;
+            sprite_tiles_ptr huge_tiles;
+
+            explicit color_tiles(int color_index);
+        };
+
+        class color_tiles_ids
+        {
+
+        public:
+            uint16_t small_tiles_id;
+            uint16_t normal_tiles_id;
+            uint16_t big_tiles_id;
+            uint16_t huge_tiles_id;
+
+            void load(const color_tiles& color_tiles);
+        };
+
+        alignas(int) vector<color_tiles, face_3d::max_colors> _color_tiles;
+        alignas(int) color_tiles_ids _color_tiles_ids[face_3d::max_colors];
+        alignas(int) color _colors[face_3d::max_colors];
+
+        alignas(int) vector<sprite_palette_ptr, _max_palettes> _palettes;
+        alignas(int) uint8_t _palette_ids[_max_palettes];
+
+        alignas(int) uint8_t _hlines_count[display::height()] = {};
+        alignas(int) uint8_t _previous_hlines_count_a[display::height()] = {};
+        alignas(int) uint8_t _previous_hlines_count_b[display::height()] = {};
+
+        alignas(int) uint16_t _hdma_source_a[_hdma_source_size];
+        alignas(int) uint16_t _hdma_source_b[_hdma_source_size];
+        uint16_t* _hdma_source = _hdma_source_a;
+
+        bool _draw_enabled = false;
+
+        BN_CODE_IWRAM void _hide_left_hlines(const uint8_t* previous_hlines_count);
+
+        void _clear();
+    };
+
+    const model_3d_item** _static_model_items_ptr = nullptr;
+    int _static_models_count = 0;
+    int _static_vertices_count = 0;
+    int _static_faces_count = 0;
+
+    pool<model_3d, BN_CFG_MODELS_3D_MAX_DYNAMIC_MODELS> _dynamic_models_pool;
+    intrusive_list<model_3d> _dynamic_models_list;
+    pool<sprite_3d, BN_CFG_MODELS_3D_MAX_SPRITES> _sprites_pool;
+    intrusive_list<sprite_3d> _sprites_list;
+
+    visible_face_info _visible_faces_info[BN_CFG_MODELS_3D_MAX_FACES];
+    shape_groups _shape_groups;
+    int _vertices_count = 0;
+    int _faces_count = 0;
+    int _visible_faces_count = 0;
+
+    BN_CODE_IWRAM void _process_models(const camera_3d& camera);
+};
+
+}
+
+#endif
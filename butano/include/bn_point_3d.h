@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_POINT_3D_H
+#define BN_POINT_3D_H
+
+/**
+ * @file
+ * bn::point_3d and bn::vertex_3d header file.
+ *
+ * @ingroup models_3d
+ */
+
+#include "bn_fixed.h"
+
+namespace bn
+{
+
+/**
+ * @brief Defines a three-dimensional point using fixed point precision.
+ *
+ * @ingroup models_3d
+ */
+class point_3d
+{
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    constexpr point_3d() = default;
+
+    /**
+     * @brief Constructor.
+     * @param x Horizontal coordinate.
+     * @param y Vertical coordinate.
+     * @param z Horizontal coordinate.
+     */
+    constexpr point_3d(fixed x, fixed y, fixed z) :
+        _x(x),
+        _y(y),
+        _z(z)
+    {
+    }
+
+    /**
+     * @brief Returns the x coordinate.
+     */
+    [[nodiscard]] constexpr fixed x() const
+    {
+        return _x;
+    }
+
+    /**
+     * @brief Sets the x coordinate.
+     */
+    constexpr void set_x(fixed x)
+    {
+        _x = x;
+    }
+
+    /**
+     * @brief Returns the y coordinate.
+     */
+    [[nodiscard]] constexpr fixed y() const
+    {
+        return _y;
+    }
+
+    /**
+     * @brief Sets the y coordinate.
+     */
+    constexpr void set_y(fixed y)
+    {
+        _y = y;
+    }
+
+    /**
+     * @brief Returns the z coordinate.
+     */
+    [[nodiscard]] constexpr fixed z() const
+    {
+        return _z;
+    }
+
+    /**
+     * @brief Sets the z coordinate.
+     */
+    constexpr void set_z(fixed z)
+    {
+        _z = z;
+    }
+
+    /**
+     * @brief Returns the dot product of this point and the given one.
+     */
+    [[nodiscard]] constexpr fixed dot_product(const point_3d& other) const
+    {
+        return _x.multiplication(other._x) + _y.multiplication(other._y) +
+                _z.multiplication(other._z);
+    }
+
+    /**
+     * @brief Returns the dot product of this point and the given one using bn::fixed::unsafe_multiplication.
+     */
+    [[nodiscard]] constexpr fixed unsafe_dot_product(const point_3d& other) const
+    {
+        return _x.unsafe_multiplication(other._x) + _y.unsafe_multiplication(other._y) +
+                _z.unsafe_multiplication(other._z);
+    }
+
+    /**
+     * @brief Returns the dot product of this point and the given one using bn::fixed::safe_multiplication.
+     */
+    [[nodiscard]] constexpr fixed safe_dot_product(const point_3d& other) const
+    {
+        return _x.safe_multiplication(other._x) + _y.safe_multiplication(other._y) +
+                _z.safe_multiplication(other._z);
+    }
+
+    /**
+     * @brief Returns the dot product of the x and z coordinates of this point and the given one.
+     */
+    [[nodiscard]] constexpr fixed vertical_dot_product(const point_3d& other) const
+    {
+        return _x.multiplication(other._x) + _z.multiplication(other._z);
+    }
+
+    /**
+     * @brief Returns the dot product of the x and z coordinates of this point and the given one
+     * using bn::fixed::unsafe_multiplication.
+     */
+    [[nodiscard]] constexpr fixed unsafe_vertical_dot_product(const point_3d& other) const
+    {
+        return _x.unsafe_multiplication(other._x) + _z.unsafe_multiplication(other._z);
+    }
+
+    /**
+     * @brief Returns the dot product of the x and z coordinates of this point and the given one
+     * using bn::fixed::safe_multiplication.
+     */
+    [[nodiscard]] constexpr fixed safe_vertical_dot_product(const point_3d& other) const
+    {
+        return _x.safe_multiplication(other._x) + _z.safe_multiplication(other._z);
+    }
+
+    /**
+     * @brief Returns the cross product of this point and the given one.
+     */
+    [[nodiscard]] constexpr point_3d cross_product(const point_3d& other) const
+    {
+        return point_3d(_y.multiplication(other._z) - _z.multiplication(other._y),
+                _z.multiplication(other._x) - _x.multiplication(other._z),
+                _x.multiplication(other._y) - _y.multiplication(other._x));
+    }
+
+    /**
+     * @brief Returns the cross product of this point and the given one using bn::fixed::unsafe_multiplication.
+     */
+    [[nodiscard]] constexpr point_3d unsafe_cross_product(const point_3d& other) const
+    {
+        return point_3d(_y.unsafe_multiplication(other._z) - _z.unsafe_multiplication(other._y),
+                _z.unsafe_multiplication(other._x) - _x.unsafe_multiplication(other._z),
+                _x.unsafe_multiplication(other._y) - _y.unsafe_multiplication(other._x));
+    }
+
+    /**
+     * @brief Returns the cross product of this point and the given one using bn::fixed::safe_multiplication.
+     */
+    [[nodiscard]] constexpr point_3d safe_cross_product(const point_3d& other) const
+    {
+        return point_3d(_y.safe_multiplication(other._z) - _z.safe_multiplication(other._y),
+                _z.safe_multiplication(other._x) - _x.safe_multiplication(other._z),
+                _x.safe_multiplication(other._y) - _y.safe_multiplication(other._x));
+    }
+
+    /**
+     * @brief Returns a point_3d that is formed by changing the sign of all coordinates of this point_3d.
+     */
+    [[nodiscard]] constexpr point_3d operator-() const
+    {
+        return point_3d(-_x, -_y, -_z);
+    }
+
+    /**
+     * @brief Adds the given point_3d to this one.
+     * @param other point_3d to add.
+     * @return Reference to this.
+     */
+    constexpr point_3d& operator+=(const point_3d& other)
+    {
+        _x += other._x;
+        _y += other._y;
+        _z += other._z;
+        return *this;
+    }
+
+    /**
+     * @brief Subtracts the given point_3d to this one.
+     * @param other point_3d to subtract.
+     * @return Reference to this.
+     */
+    constexpr point_3d& operator-=(const point_3d& other)
+    {
+        _x -= other._x;
+        _y -= other._y;
+        _z -= other._z;
+        return *this;
+    }
+
+    /**
+     * @brief Multiplies all coordinates of this point_3d by the given factor.
+     * @param value Integer multiplication factor.
+     * @return Reference to this.
+     */
+    constexpr point_3d& operator*=(int value)
+    {
+        _x *= value;
+        _y *= value;
+        _z *= value;
+        return *this;
+    }
+
+    /**
+     * @brief Multiplies all coordinates of this point_3d by the given factor.
+     * @param value Unsigned integer multiplication factor.
+     * @return Reference to this.
+     */
+    constexpr point_3d& operator*=(unsigned value)
+    {
+        _x *= value;
+        _y *= value;
+        _z *= value;
+        return *this;
+    }
+
+    /**
+     * @brief Multiplies all coordinates of this point_3d by the given factor.
+     * @param value Fixed point multiplication factor.
+     * @return Reference to this.
+     */
+    constexpr point_3d& operator*=(fixed value)
+    {
+        _x *= value;
+        _y *= value;
+        _z *= value;
+        return *this;
+    }
+
+    /**
+     * @brief Divides all coordinates of this point_3d by the given divisor.
+     * @param value Valid integer divisor (!= 0).
+     * @return Reference to this.
+     */
+    constexpr point_3d& operator/=(int value)
+    {
+        _x /= value;
+        _y /= value;
+        _z /= value;
+        return *this;
+    }
+
+    /**
+     * @brief Divides all coordinates of this point_3d by the given divisor.
+     * @param value Valid unsigned integer divisor (!= 0).
+     * @return Reference to this.
+     */
+    constexpr point_3d& operator/=(unsigned value)
+    {
+        _x /= value;
+        _y /= value;
+        _z /= value;
+        return *this;
+    }
+
+    /**
+     * @brief Divides all coordinates of this point_3d by the given divisor.
+     * @param value Valid fixed point divisor (!= 0).
+     * @return Reference to this.
+     */
+    constexpr point_3d& operator/=(fixed value)
+    {
+        _x /= value;
+        _y /= value;
+        _z /= value;
+        return *this;
+    }
+
+    /**
+     * @brief Returns the sum of a and b.
+     */
+    [[nodiscard]] constexpr friend point_3d operator+(const point_3d& a, const point_3d& b)
+    {
+        return point_3d(a._x + b._x, a._y + b._y, a._z + b._z);
+    }
+
+    /**
+     * @brief Returns b subtracted from a.
+     */
+    [[nodiscard]] constexpr friend point_3d operator-(const point_3d& a, const point_3d& b)
+    {
+        return point_3d(a._x - b._x, a._y - b._y, a._z - b._z);
+    }
+
+    /**
+     * @brief Returns a multiplied by b.
+     */
+    [[nodiscard]] constexpr friend point_3d operator*(const point_3d& a, int b)
+    {
+        return point_3d(a._x * b, a._y * b, a._z * b);
+    }
+
+    /**
+     * @brief Returns a multiplied by b.
+     */
+    [[nodiscard]] constexpr friend point_3d operator*(const point_3d& a, unsigned b)
+    {
+        return point_3d(a._x * b, a._y * b, a._z * b);
+    }
+
+    /**
+     * @brief Returns a multiplied by b.
+     */
+    [[nodiscard]] constexpr friend point_3d operator*(const point_3d& a, fixed b)
+    {
+        return point_3d(a._x * b, a._y * b, a._z * b);
+    }
+
+    /**
+     * @brief Returns a divided by b.
+     */
+    [[nodiscard]] constexpr friend point_3d operator/(const point_3d& a, int b)
+    {
+        return point_3d(a._x / b, a._y / b, a._z / b);
+    }
+
+    /**
+     * @brief Returns a divided by b.
+     */
+    [[nodiscard]] constexpr friend point_3d operator/(const point_3d& a, unsigned b)
+    {
+        return point_3d(a._x / b, a._y / b, a._z / b);
+    }
+
+    /**
+     * @brief Returns a divided by b.
+     */
+    [[nodiscard]] constexpr friend point_3d operator/(const point_3d& a, fixed b)
+    {
+        return point_3d(a._x / b, a._y / b, a._z / b);
+    }
+
+    /**
+     * @brief Default equal operator.
+     */
+    [[nodiscard]] constexpr friend bool operator==(const point_3d& a, const point_3d& b) = default;
+
+private:
+    fixed _x = 0;
+    fixed _y = 0;
+    fixed _z = 0;
+};
+
+
+/**
+ * @brief point_3d with a precalculated x * y product, used to rotate it with fewer multiplications.
+ *
+ * @ingroup models_3d
+ */
+class vertex_3d
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param x Horizontal coordinate.
+     * @param y Vertical coordinate.
+     * @param z Horizontal coordinate.
+     */
+    constexpr vertex_3d(fixed x, fixed y, fixed z) :
+        _point(x, y, z),
+        _xy(x.safe_multiplication(y))
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param point Coordinates of the vertex.
+     */
+    constexpr explicit vertex_3d(const point_3d& point) :
+        _point(point),
+        _xy(point.x().safe_multiplication(point.y()))
+    {
+    }
+
+    /**
+     * @brief Returns the coordinates of the vertex.
+     */
+    [[nodiscard]] constexpr const point_3d& point() const
+    {
+        return _point;
+    }
+
+    /**
+     * @brief Returns the product of the x and y coordinates of the vertex.
+     */
+    [[nodiscard]] constexpr fixed xy() const
+    {
+        return _xy;
+    }
+
+private:
+    point_3d _point;
+    fixed _xy;
+};
+
+}
+
+#endif
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_POLYGON_RASTERIZER_H
+#define BN_POLYGON_RASTERIZER_H
+
+/**
+ * @file
+ * bn::polygon_rasterizer header file.
+ *
+ * @ingroup polygon_rasterizer
+ */
+
+#include "bn_span.h"
+#include "bn_utility.h"
+#include "bn_display.h"
+#include "bn_fixed_point.h"
+
+namespace bn
+{
+
+/**
+ * @brief Fills a per scanline span table with convex polygons.
+ *
+ * Polygon vertices are specified in screen coordinates, with the origin at the top left corner of the screen.
+ *
+ * Edges are walked with sub-pixel precision and pixel centers are sampled with a top-left fill rule,
+ * so adjacent polygons don't overlap nor leave gaps between them.
+ *
+ * Spans are clipped to the display, and the spans of different polygons in the same scanline are merged.
+ *
+ * The span table can be used to generate H-Blank effects values or HDMA tables
+ * (sprite strips, window boundaries, etc).
+ *
+ * @ingroup polygon_rasterizer
+ */
+class polygon_rasterizer
+{
+
+public:
+    /**
+     * @brief Horizontal span of a scanline.
+     */
+    class hline
+    {
+
+    public:
+        int16_t xl; //!< First pixel of the span.
+        int16_t xr; //!< Pixel after the last pixel of the span.
+
+        /**
+         * @brief Indicates if the span doesn't have any pixel or not.
+         */
+        [[nodiscard]] constexpr bool empty() const
+        {
+            return xl >= xr;
+        }
+
+        /**
+         * @brief Returns the number of pixels of the span.
+         */
+        [[nodiscard]] constexpr int size() const
+        {
+            return empty() ? 0 : xr - xl;
+        }
+    };
+
+    /**
+     * @brief Default constructor.
+     */
+    polygon_rasterizer();
+
+    /**
+     * @brief Returns the span of each scanline of the display.
+     */
+    [[nodiscard]] span<const hline> hlines() const
+    {
+        return span<const hline>(_hlines, display::height());
+    }
+
+    /**
+     * @brief Returns the first scanline which can have a not empty span,
+     * or display::height() if all scanlines are empty.
+     */
+    [[nodiscard]] int minimum_y() const
+    {
+        return _minimum_y;
+    }
+
+    /**
+     * @brief Returns the last scanline which can have a not empty span, or -1 if all scanlines are empty.
+     */
+    [[nodiscard]] int maximum_y() const
+    {
+        return _maximum_y;
+    }
+
+    /**
+     * @brief Indicates if all scanlines are empty or not.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _minimum_y > _maximum_y;
+    }
+
+    /**
+     * @brief Adds a convex polygon to the span table.
+     * @param vertices Vertices of the polygon (at least 3) in clockwise or counterclockwise order.
+     */
+    void add_polygon(const span<const fixed_point>& vertices);
+
+    /**
+     * @brief Empties all scanlines.
+     *
+     * Only the scanlines touched since the last call are cleared.
+     */
+    void clear();
+
+    /**
+     * @brief Fills the values of a pair of sprite_position_hbe_ptr (vertical and horizontal)
+     * to draw the span table with one sprite with a staircase shape (row N is N + 1 pixels wide).
+     * @param vertical_values Destination of the vertical position of the sprite for each scanline.
+     * @param horizontal_values Destination of the horizontal position of the sprite for each scanline.
+     */
+    void fill_sprite_position_values(span<fixed> vertical_values, span<fixed> horizontal_values) const;
+
+    /**
+     * @brief Fills the values of a rect_window_boundaries_hbe_ptr created with create_horizontal.
+     *
+     * The left and right boundaries of the rect_window must be -display::width() / 2.
+     *
+     * @param values Destination of the horizontal boundaries of the window for each scanline.
+     */
+    void fill_window_horizontal_boundaries(span<pair<fixed, fixed>> values) const;
+
+    /**
+     * @brief Fills an HDMA source table for a window horizontal boundaries register.
+     * @param values Destination of the window horizontal boundaries register value for each scanline.
+     */
+    void fill_window_horizontal_boundaries_hdma_values(span<uint16_t> values) const;
+
+private:
+    hline _hlines[display::height()];
+    int _minimum_y;
+    int _maximum_y;
+
+    BN_CODE_IWRAM void _add_edge(int x0, int y0, int x1, int y1);
+};
+
+}
+
+#endif
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_RADIX_SORT_H
+#define BN_RADIX_SORT_H
+
+/**
+ * @file
+ * bn::radix_sort and bn::counting_sort header file.
+ *
+ * @ingroup sort
+ */
+
+#include "bn_assert.h"
+#include "bn_utility.h"
+#include "bn_type_traits.h"
+
+/// @cond DO_NOT_DOCUMENT
+
+namespace _bn::radix_sort
+{
+    template<typename Type, typename KeyFunction>
+    [[nodiscard]] bool sort_pass(Type* first, Type* last, Type* output,
+                                 const KeyFunction& key_function, int shift)
+    {
+        int counts[256] = {};
+        int size = last - first;
+
+        for(Type* it = first; it != last; ++it)
+        {
+            ++counts[(unsigned(key_function(*it)) >> shift) & 0xFF];
+        }
+
+        if(counts[(unsigned(key_function(*first)) >> shift) & 0xFF] == size)
+        {
+            return false;
+        }
+
+        int offset = 0;
+
+        for(int& count : counts)
+        {
+            int next_offset = offset + count;
+            count = offset;
+            offset = next_offset;
+        }
+
+        for(Type* it = first; it != last; ++it)
+        {
+            Type& value = *it;
+            output[counts[(unsigned(key_function(value)) >> shift) & 0xFF]++] = bn::move(value);
+        }
+
+        return true;
+    }
+}
+
+/// @endcond
+
+
+namespace bn
+{
+
+/**
+ * @brief Sorts the elements in the range [first, last) in ascending key order with a LSD radix sort.
+ *
+ * It is stable and it doesn't compare elements, so it is usually faster than bn::sort for more than a few dozens of
+ * elements with small keys, like sprite or polygon depths. It runs from IWRAM if it is called from IWRAM code.
+ *
+ * @param first Pointer to the first element to sort.
+ * @param last Pointer following the last element to sort.
+ * @param scratch Pointer to a buffer with at least last - first elements,
+ * which is used as temporary storage. It can't overlap the range to sort.
+ * @param key_function Function object which returns the key of the given element,
+ * which must be an 8-bit or a 16-bit unsigned integer.
+ *
+ * @ingroup sort
+ */
+template<typename Type, typename KeyFunction>
+void radix_sort(Type* first, Type* last, Type* scratch, const KeyFunction& key_function)
+{
+    using key_type = decay_t<decltype(key_function(*first))>;
+    static_assert(is_unsigned_v<key_type> && sizeof(key_type) <= 2, "Key must be an 8-bit or 16-bit unsigned integer");
+
+    if(last - first < 2)
+    {
+        return;
+    }
+
+    Type* input = first;
+    Type* output = scratch;
+
+    for(int shift = 0; shift < int(sizeof(key_type) * 8); shift += 8)
+    {
+        Type* input_last = input + (last - first);
+
+        if(_bn::radix_sort::sort_pass(input, input_last, output, key_function, shift))
+        {
+            swap(input, output);
+        }
+    }
+
+    if(input != first)
+    {
+        for(Type* it = input, *it_last = input + (last - first); it != it_last; ++it, ++first)
+        {
+            *first = move(*it);
+        }
+    }
+}
+
+/**
+ * @brief Sorts the elements in the range [first, last) in ascending key order with a counting sort
+ * and stores them in the given output buffer.
+ *
+ * It is stable and it doesn't compare elements, so it is usually faster than bn::radix_sort
+ * when there are only a few different keys, like sprite layers or tile map rows. It runs from IWRAM if it is called from IWRAM code.
+ *
+ * @tparam KeysCount Number of different keys.
+ * @param first Pointer to the first element to sort.
+ * @param last Pointer following the last element to sort.
+ * @param output Pointer to a buffer with at least last - first elements,
+ * where the sorted elements are stored. It can't overlap the range to sort.
+ * @param key_function Function object which returns the key of the given element,
+ * which must be in the range [0, KeysCount).
+ *
+ * @ingroup sort
+ */
+template<int KeysCount, typename Type, typename KeyFunction>
+void counting_sort(const Type* first, const Type* last, Type* output, const KeyFunction& key_function)
+{
+    static_assert(KeysCount > 0 && KeysCount <= 1024, "Invalid keys count");
+
+    int counts[KeysCount] = {};
+
+    for(const Type* it = first; it != last; ++it)
+    {
+        int key = int(key_function(*it));
+        BN_ASSERT(key >= 0 && key < KeysCount, "Invalid key: ", key);
+
+        ++counts[key];
+    }
+
+    int offset = 0;
+
+    for(int& count : counts)
+    {
+        int next_offset = offset + count;
+        count = offset;
+        offset = next_offset;
+    }
+
+    for(const Type* it = first; it != last; ++it)
+    {
+        const Type& value = *it;
+        output[counts[int(key_function(value))]++] = value;
+    }
+}
+
+}
+
+#endif
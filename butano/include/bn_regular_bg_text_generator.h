@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_REGULAR_BG_TEXT_GENERATOR_H
+#define BN_REGULAR_BG_TEXT_GENERATOR_H
+
+/**
+ * @file
+ * bn::regular_bg_text_generator header file.
+ *
+ * @ingroup regular_bg
+ * @ingroup text
+ */
+
+#include "bn_sprite_font.h"
+#include "bn_string_view.h"
+#include "bn_bg_palette_item.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_regular_bg_tiles_ptr.h"
+
+namespace bn
+{
+
+/**
+ * @brief Prints text from a given sprite_font in the tiles and the map of a regular background.
+ *
+ * Unlike sprite_text_generator, it doesn't generate sprites, so it allows to show large amounts of text
+ * without running out of sprites.
+ *
+ * It allocates a 32x32 regular background map and a fixed number of 4 bits per pixel (16 colors) tiles.
+ * The first tile is always empty, and the rest of them are assigned to map cells the first time
+ * a character is printed in them, so variable width characters are packed across tile boundaries.
+ *
+ * Only the tiles and the map cells touched by the printed characters are written in VRAM.
+ *
+ * Currently, it supports 4 bits per pixel (16 colors) fixed width AND variable width characters.
+ *
+ * Also, UTF-8 characters are supported.
+ *
+ * @ingroup regular_bg
+ * @ingroup text
+ */
+class regular_bg_text_generator
+{
+
+public:
+    static constexpr int columns = 32; //!< Number of cells in each row of the generated map.
+    static constexpr int rows = 32; //!< Number of cells in each column of the generated map.
+
+    /**
+     * @brief Available horizontal alignment types.
+     */
+    enum class alignment_type : uint8_t
+    {
+        LEFT, //!< Aligns with the left text edge.
+        CENTER, //!< Aligns with the middle of the text.
+        RIGHT //!< Aligns with the right text edge.
+    };
+
+    /**
+     * @brief Constructor.
+     * @param font Sprite font for drawing text.
+     * @param max_tiles Number of tiles to allocate (including the empty one) in the range [2..1024].
+     */
+    regular_bg_text_generator(const sprite_font& font, int max_tiles);
+
+    /**
+     * @brief Constructor.
+     * @param font Sprite font for drawing text.
+     * @param palette_item 16 colors (4 bits per pixel) bg_palette_item
+     * that generates the color palette used by the generated map.
+     * @param max_tiles Number of tiles to allocate (including the empty one) in the range [2..1024].
+     */
+    regular_bg_text_generator(const sprite_font& font, const bg_palette_item& palette_item, int max_tiles);
+
+    /**
+     * @brief Returns the sprite font for drawing text.
+     */
+    [[nodiscard]] const sprite_font& font() const
+    {
+        return _font;
+    }
+
+    /**
+     * @brief Returns the generated map.
+     *
+     * It can be shown on the screen with regular_bg_ptr::create.
+     */
+    [[nodiscard]] const regular_bg_map_ptr& map() const
+    {
+        return _map;
+    }
+
+    /**
+     * @brief Returns the number of allocated tiles (including the empty one).
+     */
+    [[nodiscard]] int max_tiles() const
+    {
+        return _max_tiles;
+    }
+
+    /**
+     * @brief Returns the number of tiles assigned to map cells (including the empty one).
+     */
+    [[nodiscard]] int used_tiles() const
+    {
+        return _used_tiles;
+    }
+
+    /**
+     * @brief Returns the horizontal alignment of the printed text.
+     */
+    [[nodiscard]] alignment_type alignment() const
+    {
+        return _alignment;
+    }
+
+    /**
+     * @brief Sets the horizontal alignment of the printed text.
+     */
+    void set_alignment(alignment_type alignment)
+    {
+        _alignment = alignment;
+    }
+
+    /**
+     * @brief Sets the horizontal alignment of the printed text to the left.
+     */
+    void set_left_alignment()
+    {
+        _alignment = alignment_type::LEFT;
+    }
+
+    /**
+     * @brief Sets the horizontal alignment of the printed text to the center.
+     */
+    void set_center_alignment()
+    {
+        _alignment = alignment_type::CENTER;
+    }
+
+    /**
+     * @brief Sets the horizontal alignment of the printed text to the right.
+     */
+    void set_right_alignment()
+    {
+        _alignment = alignment_type::RIGHT;
+    }
+
+    /**
+     * @brief Returns the width in pixels of the given text.
+     */
+    [[nodiscard]] int width(const string_view& text) const;
+
+    /**
+     * @brief Prints the given single line of text.
+     *
+     * Pixels outside of the generated map are discarded.
+     *
+     * @param x Horizontal position in pixels relative to the left edge of the generated map,
+     * considering the current alignment.
+     * @param y Vertical position in pixels of the top edge of the text relative to the top edge of the generated map.
+     * @param text Single line of text to print.
+     */
+    void generate(int x, int y, const string_view& text);
+
+    /**
+     * @brief Prints the given single line of text.
+     *
+     * Pixels outside of the generated map are discarded.
+     *
+     * @param x Horizontal position in pixels relative to the left edge of the generated map,
+     * considering the current alignment.
+     * @param y Vertical position in pixels of the top edge of the text relative to the top edge of the generated map.
+     * @param text Single line of text to print.
+     * @return `true` if the text was printed successfully, or `false` if there were no more tiles available
+     * (in that case, the text can be printed partially).
+     */
+    [[nodiscard]] bool generate_optional(int x, int y, const string_view& text);
+
+    /**
+     * @brief Removes all printed text, releasing all used tiles except the empty one.
+     */
+    void clear();
+
+private:
+    sprite_font _font;
+    regular_bg_tiles_ptr _tiles;
+    regular_bg_map_ptr _map;
+    int16_t _max_tiles;
+    int16_t _used_tiles = 1;
+    int8_t _max_character_width;
+    alignment_type _alignment = alignment_type::LEFT;
+
+    [[nodiscard]] bool _generate(int x, int y, const string_view& text);
+};
+
+}
+
+#endif
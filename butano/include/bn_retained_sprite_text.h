@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_RETAINED_SPRITE_TEXT_H
+#define BN_RETAINED_SPRITE_TEXT_H
+
+/**
+ * @file
+ * bn::retained_sprite_text header file.
+ *
+ * @ingroup sprite
+ * @ingroup text
+ */
+
+#include "bn_sprite_ptr.h"
+#include "bn_fixed_point.h"
+#include "bn_sprite_text_generator.h"
+
+namespace bn
+{
+
+/**
+ * @brief Single line of text printed in sprites which are kept alive when the text changes.
+ *
+ * When a new text is set, it is compared against the previous one
+ * and only the characters which have changed are painted again in the existing sprite tiles,
+ * so it is well suited for text which changes frequently, like scores or counters.
+ *
+ * Currently, it supports 4 bits per pixel (16 colors) fixed width AND variable width characters
+ * with a height of 8, 16 or 32 pixels.
+ *
+ * Also, UTF-8 characters are supported.
+ *
+ * @ingroup sprite
+ * @ingroup text
+ */
+class retained_sprite_text
+{
+
+public:
+    static constexpr int max_sprites = 8; //!< Maximum number of sprites used to print the text.
+    static constexpr int max_characters = 32; //!< Maximum number of visible characters of the text.
+
+    /**
+     * @brief Constructor.
+     * @param generator Provides the font, the color palette, the alignment,
+     * the priority relative to backgrounds and the z order of the text sprites.
+     * @param x Horizontal position of the text, considering the alignment of the given generator.
+     * @param y Vertical position of the text.
+     * @param max_width Maximum width in pixels of the text.
+     */
+    retained_sprite_text(const sprite_text_generator& generator, fixed x, fixed y, int max_width);
+
+    /**
+     * @brief Constructor.
+     * @param generator Provides the font, the color palette, the alignment,
+     * the priority relative to backgrounds and the z order of the text sprites.
+     * @param position Position of the text, considering the alignment of the given generator.
+     * @param max_width Maximum width in pixels of the text.
+     */
+    retained_sprite_text(const sprite_text_generator& generator, const fixed_point& position, int max_width);
+
+    /**
+     * @brief Returns the sprite font for drawing text.
+     */
+    [[nodiscard]] const sprite_font& font() const
+    {
+        return _font;
+    }
+
+    /**
+     * @brief Returns the horizontal alignment of the text.
+     */
+    [[nodiscard]] sprite_text_generator::alignment_type alignment() const
+    {
+        return _alignment;
+    }
+
+    /**
+     * @brief Returns the position of the text, considering its alignment.
+     */
+    [[nodiscard]] const fixed_point& position() const
+    {
+        return _position;
+    }
+
+    /**
+     * @brief Sets the position of the text, considering its alignment.
+     * @param x Horizontal position of the text.
+     * @param y Vertical position of the text.
+     */
+    void set_position(fixed x, fixed y)
+    {
+        set_position(fixed_point(x, y));
+    }
+
+    /**
+     * @brief Sets the position of the text, considering its alignment.
+     */
+    void set_position(const fixed_point& position);
+
+    /**
+     * @brief Indicates if the text must be committed to the GBA or not.
+     */
+    [[nodiscard]] bool visible() const
+    {
+        return _visible;
+    }
+
+    /**
+     * @brief Sets if the text must be committed to the GBA or not.
+     */
+    void set_visible(bool visible);
+
+    /**
+     * @brief Returns the maximum width in pixels of the text.
+     */
+    [[nodiscard]] int max_width() const
+    {
+        return _max_width;
+    }
+
+    /**
+     * @brief Returns the width in pixels of the current text.
+     */
+    [[nodiscard]] int width() const
+    {
+        return _width;
+    }
+
+    /**
+     * @brief Returns the sprites used to print the text.
+     */
+    [[nodiscard]] const ivector<sprite_ptr>& sprites() const
+    {
+        return _sprites;
+    }
+
+    /**
+     * @brief Replaces the current text with the given single line of text,
+     * painting again only the characters which have changed.
+     */
+    void set_text(const string_view& text);
+
+private:
+    class character_type
+    {
+
+    public:
+        int16_t x;
+        int16_t graphics_index;
+        int16_t width;
+
+        [[nodiscard]] friend bool operator==(const character_type& a, const character_type& b) = default;
+    };
+
+    sprite_font _font;
+    vector<sprite_ptr, max_sprites> _sprites;
+    vector<character_type, max_characters> _characters;
+    fixed_point _position;
+    int16_t _max_width;
+    int16_t _width = 0;
+    sprite_text_generator::alignment_type _alignment;
+    bool _visible = true;
+
+    void _update_sprites();
+};
+
+}
+
+#endif
@@ -0,0 +1,629 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SLOT_MAP_H
+#define BN_SLOT_MAP_H
+
+/**
+ * @file
+ * bn::islot_map and bn::slot_map implementation header file.
+ *
+ * @ingroup slot_map
+ */
+
+#include "bn_memory.h"
+#include "bn_vector.h"
+#include "bn_slot_map_fwd.h"
+
+namespace bn
+{
+
+template<typename Type>
+class islot_map
+{
+
+public:
+    using value_type = Type; //!< Value type alias.
+    using size_type = int; //!< Size type alias.
+    using difference_type = int; //!< Difference type alias.
+    using reference = Type&; //!< Reference alias.
+    using const_reference = const Type&; //!< Const reference alias.
+    using pointer = Type*; //!< Pointer alias.
+    using const_pointer = const Type*; //!< Const pointer alias.
+    using iterator = Type*; //!< Iterator alias.
+    using const_iterator = const Type*; //!< Const iterator alias.
+    using reverse_iterator = bn::reverse_iterator<iterator>; //!< Reverse iterator alias.
+    using const_reverse_iterator = bn::reverse_iterator<const_iterator>; //!< Const reverse iterator alias.
+
+    /**
+     * @brief References an element of an islot_map.
+     *
+     * It remains valid until its element is erased, even if other elements are inserted or erased.
+     *
+     * Generation counters are 16 bits long, so a handle of an erased element could be considered valid again
+     * after its slot has been reused 65536 times.
+     */
+    class handle_type
+    {
+
+    public:
+        /**
+         * @brief Default constructor.
+         *
+         * It doesn't reference any element.
+         */
+        constexpr handle_type() = default;
+
+        /**
+         * @brief Returns the index of the slot of the referenced element, or -1 if it doesn't reference any.
+         */
+        [[nodiscard]] constexpr int slot_index() const
+        {
+            return _slot_index;
+        }
+
+        /**
+         * @brief Returns the generation of the slot of the referenced element when the handle was created.
+         */
+        [[nodiscard]] constexpr int generation() const
+        {
+            return _generation;
+        }
+
+        /**
+         * @brief Default equal operator.
+         */
+        [[nodiscard]] constexpr friend bool operator==(const handle_type& a, const handle_type& b) = default;
+
+    private:
+        friend class islot_map;
+
+        int16_t _slot_index = -1;
+        uint16_t _generation = 0;
+
+        constexpr handle_type(int slot_index, unsigned generation) :
+            _slot_index(int16_t(slot_index)),
+            _generation(uint16_t(generation))
+        {
+        }
+    };
+
+    islot_map(const islot_map& other) = delete;
+
+    islot_map& operator=(const islot_map& other) = delete;
+
+    /**
+     * @brief Returns the current size.
+     */
+    [[nodiscard]] size_type size() const
+    {
+        return _values_ref->size();
+    }
+
+    /**
+     * @brief Returns the maximum possible size.
+     */
+    [[nodiscard]] size_type max_size() const
+    {
+        return _values_ref->max_size();
+    }
+
+    /**
+     * @brief Returns the remaining capacity.
+     */
+    [[nodiscard]] size_type available() const
+    {
+        return _values_ref->available();
+    }
+
+    /**
+     * @brief Indicates if it doesn't contain any element.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _values_ref->empty();
+    }
+
+    /**
+     * @brief Indicates if it can't contain any more elements.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _values_ref->full();
+    }
+
+    /**
+     * @brief Returns a const iterator to the beginning of the islot_map.
+     */
+    [[nodiscard]] const_iterator begin() const
+    {
+        return _values_ref->begin();
+    }
+
+    /**
+     * @brief Returns an iterator to the beginning of the islot_map.
+     */
+    [[nodiscard]] iterator begin()
+    {
+        return _values_ref->begin();
+    }
+
+    /**
+     * @brief Returns a const iterator to the end of the islot_map.
+     */
+    [[nodiscard]] const_iterator end() const
+    {
+        return _values_ref->end();
+    }
+
+    /**
+     * @brief Returns an iterator to the end of the islot_map.
+     */
+    [[nodiscard]] iterator end()
+    {
+        return _values_ref->end();
+    }
+
+    /**
+     * @brief Returns a const iterator to the beginning of the islot_map.
+     */
+    [[nodiscard]] const_iterator cbegin() const
+    {
+        return _values_ref->cbegin();
+    }
+
+    /**
+     * @brief Returns a const iterator to the end of the islot_map.
+     */
+    [[nodiscard]] const_iterator cend() const
+    {
+        return _values_ref->cend();
+    }
+
+    /**
+     * @brief Returns a const reverse iterator to the end of the islot_map.
+     */
+    [[nodiscard]] const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    /**
+     * @brief Returns a reverse iterator to the end of the islot_map.
+     */
+    [[nodiscard]] reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @brief Returns a const reverse iterator to the beginning of the islot_map.
+     */
+    [[nodiscard]] const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    /**
+     * @brief Returns a reverse iterator to the beginning of the islot_map.
+     */
+    [[nodiscard]] reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+
+    /**
+     * @brief Returns a const reverse iterator to the end of the islot_map.
+     */
+    [[nodiscard]] const_reverse_iterator crbegin() const
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    /**
+     * @brief Returns a const reverse iterator to the beginning of the islot_map.
+     */
+    [[nodiscard]] const_reverse_iterator crend() const
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    /**
+     * @brief Indicates if the element referenced by the given handle is contained in this islot_map.
+     */
+    [[nodiscard]] bool contains(const handle_type& handle) const
+    {
+        int slot_index = handle._slot_index;
+
+        if(unsigned(slot_index) >= unsigned(_used_slots))
+        {
+            return false;
+        }
+
+        const _slot& slot = _slots[slot_index];
+        return slot.generation == handle._generation;
+    }
+
+    /**
+     * @brief Returns a const pointer to the element referenced by the given handle,
+     * or `nullptr` if it is not contained in this islot_map.
+     */
+    [[nodiscard]] const_pointer get(const handle_type& handle) const
+    {
+        return const_cast<islot_map&>(*this).get(handle);
+    }
+
+    /**
+     * @brief Returns a pointer to the element referenced by the given handle,
+     * or `nullptr` if it is not contained in this islot_map.
+     */
+    [[nodiscard]] pointer get(const handle_type& handle)
+    {
+        if(! contains(handle))
+        {
+            return nullptr;
+        }
+
+        return _values_ref->data() + _slots[handle._slot_index].index;
+    }
+
+    /**
+     * @brief Returns a const reference to the element referenced by the given handle.
+     */
+    [[nodiscard]] const_reference at(const handle_type& handle) const
+    {
+        return const_cast<islot_map&>(*this).at(handle);
+    }
+
+    /**
+     * @brief Returns a reference to the element referenced by the given handle.
+     */
+    [[nodiscard]] reference at(const handle_type& handle)
+    {
+        BN_ASSERT(contains(handle), "Invalid handle: ", handle._slot_index, " - ", handle._generation);
+
+        return (*_values_ref)[_slots[handle._slot_index].index];
+    }
+
+    /**
+     * @brief Returns the handle of the element pointed by the given iterator.
+     */
+    [[nodiscard]] handle_type handle(const_iterator position) const
+    {
+        int index = position - begin();
+        BN_ASSERT(index >= 0 && index < size(), "Invalid position: ", index, " - ", size());
+
+        int slot_index = _dense_slots[index];
+        return handle_type(slot_index, _slots[slot_index].generation);
+    }
+
+    /**
+     * @brief Inserts a copy of a value at the end of the islot_map.
+     * @param value Value to insert.
+     * @return Handle of the inserted value.
+     */
+    handle_type insert(const_reference value)
+    {
+        return emplace(value);
+    }
+
+    /**
+     * @brief Inserts a moved value at the end of the islot_map.
+     * @param value Value to insert.
+     * @return Handle of the inserted value.
+     */
+    handle_type insert(value_type&& value)
+    {
+        return emplace(move(value));
+    }
+
+    /**
+     * @brief Constructs and inserts a value at the end of the islot_map.
+     * @param args Parameters of the value to insert.
+     * @return Handle of the inserted value.
+     */
+    template<typename... Args>
+    handle_type emplace(Args&&... args)
+    {
+        ivector<Type>& values = *_values_ref;
+        BN_ASSERT(! values.full(), "Slot map is full");
+
+        int slot_index = _first_free_slot;
+
+        if(slot_index >= 0)
+        {
+            _first_free_slot = _slots[slot_index].index;
+        }
+        else
+        {
+            slot_index = _used_slots;
+            _slots[slot_index].generation = 0;
+            ++_used_slots;
+        }
+
+        int index = values.size();
+        values.emplace_back(forward<Args>(args)...);
+        _dense_slots[index] = int16_t(slot_index);
+
+        _slot& slot = _slots[slot_index];
+        slot.index = int16_t(index);
+        return handle_type(slot_index, slot.generation);
+    }
+
+    /**
+     * @brief Erases the element referenced by the given handle.
+     *
+     * The last element is moved to the position of the erased one.
+     *
+     * @param handle Handle of the element to erase.
+     * @return `true` if the element was erased, otherwise `false`.
+     */
+    bool erase(const handle_type& handle)
+    {
+        if(! contains(handle))
+        {
+            return false;
+        }
+
+        _erase(_slots[handle._slot_index].index);
+        return true;
+    }
+
+    /**
+     * @brief Erases an element.
+     *
+     * The last element is moved to the position of the erased one.
+     *
+     * @param position Iterator to the element to erase.
+     * @return Iterator to the element moved to the position of the erased one,
+     * or end() if the erased element was the last one.
+     */
+    iterator erase(const_iterator position)
+    {
+        int index = position - begin();
+        BN_ASSERT(index >= 0 && index < size(), "Invalid position: ", index, " - ", size());
+
+        _erase(index);
+        return begin() + index;
+    }
+
+    /**
+     * @brief Erases all elements that satisfy the specified predicate.
+     * @param slot_map islot_map from which to erase.
+     * @param pred Unary predicate which returns ​true if the element should be erased.
+     * @return Number of erased elements.
+     */
+    template<class Pred>
+    friend size_type erase_if(islot_map& slot_map, const Pred& pred)
+    {
+        ivector<Type>& values = *slot_map._values_ref;
+        size_type erased_count = 0;
+        int index = 0;
+
+        // Erased elements are replaced by the last one, so the same index is checked again:
+
+        while(index < values.size())
+        {
+            if(pred(values[index]))
+            {
+                slot_map._erase(index);
+                ++erased_count;
+            }
+            else
+            {
+                ++index;
+            }
+        }
+
+        return erased_count;
+    }
+
+    /**
+     * @brief Removes all elements.
+     */
+    void clear()
+    {
+        ivector<Type>& values = *_values_ref;
+
+        for(int index = 0, size = values.size(); index < size; ++index)
+        {
+            _release_slot(_dense_slots[index]);
+        }
+
+        values.clear();
+    }
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    struct _slot
+    {
+        int16_t index;
+        uint16_t generation;
+    };
+
+    islot_map(ivector<Type>& values, int16_t& dense_slots, _slot& slots) :
+        _values_ref(&values),
+        _dense_slots(&dense_slots),
+        _slots(&slots)
+    {
+    }
+
+    void _assign(const islot_map& other)
+    {
+        BN_ASSERT(other._used_slots <= max_size(), "Not enough space: ", max_size(), " - ", other._used_slots);
+
+        *_values_ref = *other._values_ref;
+        _assign_slots(other);
+    }
+
+    void _assign(islot_map&& other)
+    {
+        BN_ASSERT(other._used_slots <= max_size(), "Not enough space: ", max_size(), " - ", other._used_slots);
+
+        // Slots are copied before moving the values, since their count is the size of the given islot_map:
+        _assign_slots(other);
+        *_values_ref = move(*other._values_ref);
+        other._values_ref->clear();
+        other._release_all_slots();
+    }
+
+    /// @endcond
+
+private:
+    ivector<Type>* _values_ref;
+    int16_t* _dense_slots;
+    _slot* _slots;
+    int _first_free_slot = -1;
+    int _used_slots = 0;
+
+    void _erase(int index)
+    {
+        ivector<Type>& values = *_values_ref;
+        int slot_index = _dense_slots[index];
+        int last_index = values.size() - 1;
+
+        if(index != last_index)
+        {
+            int last_slot_index = _dense_slots[last_index];
+            values[index] = move(values[last_index]);
+            _dense_slots[index] = int16_t(last_slot_index);
+            _slots[last_slot_index].index = int16_t(index);
+        }
+
+        values.pop_back();
+        _release_slot(slot_index);
+    }
+
+    void _release_slot(int slot_index)
+    {
+        _slot& slot = _slots[slot_index];
+        ++slot.generation;
+        slot.index = int16_t(_first_free_slot);
+        _first_free_slot = slot_index;
+    }
+
+    void _release_all_slots()
+    {
+        // Generations are increased to invalidate the handles of the released elements:
+
+        _first_free_slot = -1;
+
+        for(int slot_index = _used_slots - 1; slot_index >= 0; --slot_index)
+        {
+            _release_slot(slot_index);
+        }
+    }
+
+    void _assign_slots(const islot_map& other)
+    {
+        memory::copy(*other._dense_slots, other.size(), *_dense_slots);
+        memory::copy(*other._slots, other._used_slots, *_slots);
+        _first_free_slot = other._first_free_slot;
+        _used_slots = other._used_slots;
+    }
+};
+
+
+template<typename Type, int MaxSize>
+class slot_map : public islot_map<Type>
+{
+    static_assert(MaxSize > 0 && MaxSize <= 32767);
+
+public:
+    using value_type = Type; //!< Value type alias.
+    using size_type = int; //!< Size type alias.
+    using difference_type = int; //!< Difference type alias.
+    using reference = Type&; //!< Reference alias.
+    using const_reference = const Type&; //!< Const reference alias.
+    using pointer = Type*; //!< Pointer alias.
+    using const_pointer = const Type*; //!< Const pointer alias.
+    using iterator = Type*; //!< Iterator alias.
+    using const_iterator = const Type*; //!< Const iterator alias.
+    using reverse_iterator = bn::reverse_iterator<iterator>; //!< Reverse iterator alias.
+    using const_reverse_iterator = bn::reverse_iterator<const_iterator>; //!< Const reverse iterator alias.
+    using handle_type = typename islot_map<Type>::handle_type; //!< Handle type alias.
+
+    /**
+     * @brief Default constructor.
+     */
+    slot_map() :
+        islot_map<Type>(_values, *_dense_slots_buffer, *_slots_buffer)
+    {
+    }
+
+    /**
+     * @brief Copy constructor.
+     *
+     * Handles of the given slot_map reference the copied elements too.
+     *
+     * @param other slot_map to copy.
+     */
+    slot_map(const slot_map& other) :
+        slot_map()
+    {
+        this->_assign(other);
+    }
+
+    /**
+     * @brief Move constructor.
+     *
+     * Handles of the given slot_map reference the moved elements too.
+     *
+     * @param other slot_map to move.
+     */
+    slot_map(slot_map&& other) noexcept :
+        slot_map()
+    {
+        this->_assign(move(other));
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     *
+     * Handles of the given slot_map reference the copied elements too.
+     *
+     * @param other slot_map to copy.
+     * @return Reference to this.
+     */
+    slot_map& operator=(const slot_map& other)
+    {
+        if(this != &other)
+        {
+            this->clear();
+            this->_assign(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     *
+     * Handles of the given slot_map reference the moved elements too.
+     *
+     * @param other slot_map to move.
+     * @return Reference to this.
+     */
+    slot_map& operator=(slot_map&& other) noexcept
+    {
+        if(this != &other)
+        {
+            this->clear();
+            this->_assign(move(other));
+        }
+
+        return *this;
+    }
+
+private:
+    vector<Type, MaxSize> _values;
+    int16_t _dense_slots_buffer[MaxSize];
+    typename islot_map<Type>::_slot _slots_buffer[MaxSize];
+};
+
+}
+
+#endif
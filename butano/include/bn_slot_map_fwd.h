@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SLOT_MAP_FWD_H
+#define BN_SLOT_MAP_FWD_H
+
+/**
+ * @file
+ * bn::islot_map and bn::slot_map declaration header file.
+ *
+ * @ingroup slot_map
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+    /**
+     * @brief Base class of bn::slot_map.
+     *
+     * Can be used as a reference type for all bn::slot_map containers containing a specific type.
+     *
+     * @tparam Type Element type.
+     *
+     * @ingroup slot_map
+     */
+    template<typename Type>
+    class islot_map;
+
+    /**
+     * @brief Container with a fixed size buffer which references its elements with stable handles.
+     *
+     * Elements are stored contiguously in a bn::vector, so they can be iterated as fast as a bn::vector,
+     * and handles remain valid until their element is erased, even if other elements are moved.
+     *
+     * Each handle stores a generation counter, so handles of erased elements are detected
+     * even if their slot is being used by another element.
+     *
+     * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
+     *
+     * @tparam Type Element type.
+     * @tparam MaxSize Maximum number of elements that can be stored.
+     *
+     * @ingroup slot_map
+     */
+    template<typename Type, int MaxSize>
+    class slot_map;
+}
+
+#endif
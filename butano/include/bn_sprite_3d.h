@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_3D_H
+#define BN_SPRITE_3D_H
+
+/**
+ * @file
+ * bn::sprite_3d header file.
+ *
+ * @ingroup models_3d
+ */
+
+#include "bn_math.h"
+#include "bn_intrusive_list.h"
+
+#include "bn_math_3d.h"
+#include "bn_point_3d.h"
+
+namespace bn
+{
+
+class sprite_3d_item;
+
+/**
+ * @brief 64x64 affine sprite placed in the 3D world.
+ *
+ * It must be created with bn::models_3d::create_sprite.
+ *
+ * @ingroup models_3d
+ */
+class sprite_3d : public intrusive_list_node_type
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param item sprite_3d_item to render.
+     */
+    explicit sprite_3d(sprite_3d_item& item) :
+        _item(item)
+    {
+    }
+
+    /**
+     * @brief Returns the sprite_3d_item to render.
+     */
+    [[nodiscard]] const sprite_3d_item& item() const
+    {
+        return _item;
+    }
+
+    /**
+     * @brief Returns the sprite_3d_item to render.
+     */
+    [[nodiscard]] sprite_3d_item& item()
+    {
+        return _item;
+    }
+
+    /**
+     * @brief Returns the position in the 3D world.
+     */
+    [[nodiscard]] constexpr const point_3d& position() const
+    {
+        return _position;
+    }
+
+    /**
+     * @brief Sets the position in the 3D world.
+     */
+    constexpr void set_position(const point_3d& position)
+    {
+        _position = position;
+    }
+
+    /**
+     * @brief Returns the scale.
+     */
+    [[nodiscard]] constexpr fixed scale() const
+    {
+        return _scale;
+    }
+
+    /**
+     * @brief Sets the scale.
+     * @param scale Scale (> 0).
+     */
+    constexpr void set_scale(fixed scale)
+    {
+        BN_ASSERT(scale > 0, "Invalid scale: ", scale);
+
+        _scale = scale;
+    }
+
+    /**
+     * @brief Returns the theta rotation angle (360 degrees = 65536).
+     */
+    [[nodiscard]] constexpr fixed theta() const
+    {
+        return _theta;
+    }
+
+    /**
+     * @brief Sets the theta rotation angle.
+     * @param theta Theta rotation angle (360 degrees = 65536).
+     */
+    constexpr void set_theta(fixed theta)
+    {
+        if(theta > 0xFFFF)
+        {
+            theta -= 0xFFFF;
+        }
+        else if(theta < 0)
+        {
+            theta += 0xFFFF;
+        }
+
+        BN_ASSERT(theta >= 0 && theta <= 0xFFFF, "Invalid theta: ", theta);
+
+        int old_angle = _theta.right_shift_integer();
+        int new_angle = theta.right_shift_integer();
+        _theta = theta;
+
+        if(old_angle != new_angle)
+        {
+            _theta_sin = sin_3d(new_angle);
+            _theta_cos = cos_3d(new_angle);
+        }
+    }
+
+    /**
+     * @brief Returns the given vertex rotated with the current rotation angle.
+     */
+    [[nodiscard]] constexpr point_3d rotate(const vertex_3d& vertex) const
+    {
+        fixed theta_sin = _theta_sin;
+        fixed theta_cos = _theta_cos;
+        fixed vx = vertex.point().x();
+        fixed vy = vertex.point().y();
+        fixed vz = vertex.point().z();
+        fixed vxy = vertex.xy();
+        fixed rx = (theta_cos + vy).safe_multiplication(vx) + vz.unsafe_multiplication(theta_sin) - vxy;
+        fixed ry = vy.safe_multiplication(1 + vx) - vxy;
+        fixed rz = (-theta_sin + vy).safe_multiplication(vx) + vz.unsafe_multiplication(theta_cos) - vxy;
+
+        return point_3d(rx, ry, rz);
+    }
+
+    /**
+     * @brief Returns the given vertex rotated, scaled and translated to the 3D world.
+     */
+    [[nodiscard]] constexpr point_3d transform(const vertex_3d& vertex) const
+    {
+        point_3d result = rotate(vertex);
+        fixed scale = _scale;
+
+        if(scale != 1)
+        {
+            result.set_x(result.x().unsafe_multiplication(scale));
+            result.set_y(result.y().unsafe_multiplication(scale));
+            result.set_z(result.z().unsafe_multiplication(scale));
+        }
+
+        return result + _position;
+    }
+
+private:
+    sprite_3d_item& _item;
+    point_3d _position;
+    fixed _scale = 1;
+    fixed _theta;
+    fixed _theta_sin;
+    fixed _theta_cos = 1;
+};
+
+}
+
+#endif
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_3D_ITEM_H
+#define BN_SPRITE_3D_ITEM_H
+
+/**
+ * @file
+ * bn::sprite_3d_item header file.
+ *
+ * @ingroup models_3d
+ */
+
+#include "bn_sprite_item.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_sprite_affine_mat_ptr.h"
+
+namespace bn
+{
+
+/**
+ * @brief Owns the sprite resources required to render a bn::sprite_3d.
+ *
+ * @ingroup models_3d
+ */
+class sprite_3d_item
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param item 64x64 sprite_item used to create the sprite resources.
+     * @param graphics_index Index of the tile set to reference in item.tiles_item().
+     */
+    sprite_3d_item(const sprite_item& item, int graphics_index) :
+        _tiles(item.tiles_item().create_tiles(graphics_index)),
+        _palette(item.palette_item().create_palette()),
+        _affine_mat(sprite_affine_mat_ptr::create())
+    {
+        BN_ASSERT(item.shape_size().width() == 64 && item.shape_size().height() == 64, "Invalid shape size");
+
+        _tiles_id = _tiles.id();
+        _palette_id = _palette.id();
+        _affine_mat_id = _affine_mat.id();
+    }
+
+    /**
+     * @brief Returns the sprite tiles used to render the sprite.
+     */
+    [[nodiscard]] const sprite_tiles_ptr& tiles() const
+    {
+        return _tiles;
+    }
+
+    /**
+     * @brief Returns the sprite tiles used to render the sprite.
+     */
+    [[nodiscard]] sprite_tiles_ptr& tiles()
+    {
+        return _tiles;
+    }
+
+    /**
+     * @brief Returns the internal ID of the sprite tiles.
+     */
+    [[nodiscard]] int tiles_id() const
+    {
+        return _tiles_id;
+    }
+
+    /**
+     * @brief Returns the sprite palette used to render the sprite.
+     */
+    [[nodiscard]] const sprite_palette_ptr& palette() const
+    {
+        return _palette;
+    }
+
+    /**
+     * @brief Returns the sprite palette used to render the sprite.
+     */
+    [[nodiscard]] sprite_palette_ptr& palette()
+    {
+        return _palette;
+    }
+
+    /**
+     * @brief Returns the internal ID of the sprite palette.
+     */
+    [[nodiscard]] int palette_id() const
+    {
+        return _palette_id;
+    }
+
+    /**
+     * @brief Returns the sprite affine matrix used to render the sprite.
+     */
+    [[nodiscard]] const sprite_affine_mat_ptr& affine_mat() const
+    {
+        return _affine_mat;
+    }
+
+    /**
+     * @brief Returns the sprite affine matrix used to render the sprite.
+     */
+    [[nodiscard]] sprite_affine_mat_ptr& affine_mat()
+    {
+        return _affine_mat;
+    }
+
+    /**
+     * @brief Returns the internal ID of the sprite affine matrix.
+     */
+    [[nodiscard]] int affine_mat_id() const
+    {
+        return _affine_mat_id;
+    }
+
+private:
+    int _tiles_id;
+    int _palette_id;
+    int _affine_mat_id;
+    sprite_tiles_ptr _tiles;
+    sprite_palette_ptr _palette;
+    sprite_affine_mat_ptr _affine_mat;
+};
+
+}
+
+#endif
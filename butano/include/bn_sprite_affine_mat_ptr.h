@@ -63,6 +63,27 @@ public:
      */
     [[nodiscard]] static optional<sprite_affine_mat_ptr> create_optional(const affine_mat_attributes& attributes);
 
+    /**
+     * @brief Returns an interned affine transformation matrix with the specified attributes.
+     *
+     * Interned matrices with the same attributes share the same hardware matrix, and they can't be modified.
+     *
+     * @param attributes affine_mat_attributes of the output matrix.
+     * @return The requested sprite_affine_mat_ptr.
+     */
+    [[nodiscard]] static sprite_affine_mat_ptr create_interned(const affine_mat_attributes& attributes);
+
+    /**
+     * @brief Returns an interned affine transformation matrix with the specified attributes.
+     *
+     * Interned matrices with the same attributes share the same hardware matrix, and they can't be modified.
+     *
+     * @param attributes affine_mat_attributes of the output matrix.
+     * @return The requested sprite_affine_mat_ptr if it could be allocated; bn::nullopt otherwise.
+     */
+    [[nodiscard]] static optional<sprite_affine_mat_ptr> create_interned_optional(
+            const affine_mat_attributes& attributes);
+
     /**
      * @brief Copy constructor.
      * @param other sprite_affine_mat_ptr to copy.
@@ -111,6 +132,11 @@ public:
         return _id;
     }
 
+    /**
+     * @brief Indicates if this matrix is interned (shared by value and not modifiable) or not.
+     */
+    [[nodiscard]] bool interned() const;
+
     /**
      * @brief Returns the rotation angle in degrees.
      */
@@ -35,6 +35,28 @@ namespace bn::sprite_affine_mats
      * that can be managed with sprite_affine_mat_ptr objects.
      */
     [[nodiscard]] int available_count();
+
+    /**
+     * @brief Indicates if the affine transformation matrices created by sprites are interned or not.
+     *
+     * If interning is enabled, sprites with the same affine attributes share the same hardware matrix
+     * (see sprite_affine_mat_ptr::create_interned).
+     *
+     * It only affects matrices created by the sprites themselves
+     * (by calling sprite_ptr::set_rotation_angle for example), not the ones provided with sprite_ptr::set_affine_mat.
+     */
+    [[nodiscard]] bool interning_enabled();
+
+    /**
+     * @brief Sets if the affine transformation matrices created by sprites must be interned or not.
+     *
+     * If interning is enabled, sprites with the same affine attributes share the same hardware matrix
+     * (see sprite_affine_mat_ptr::create_interned).
+     *
+     * It only affects matrices created by the sprites themselves
+     * (by calling sprite_ptr::set_rotation_angle for example), not the ones provided with sprite_ptr::set_affine_mat.
+     */
+    void set_interning_enabled(bool enabled);
 }
 
 #endif
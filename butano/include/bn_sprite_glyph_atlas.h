@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_GLYPH_ATLAS_H
+#define BN_SPRITE_GLYPH_ATLAS_H
+
+/**
+ * @file
+ * bn::isprite_glyph_atlas and bn::sprite_glyph_atlas implementation header file.
+ *
+ * @ingroup sprite
+ * @ingroup text
+ */
+
+#include "bn_vector.h"
+#include "bn_sprite_font.h"
+#include "bn_sprite_tiles_ptr.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of sprite_glyph_atlas.
+ *
+ * It keeps the sprite tiles of the most recently used characters of a sprite_font resident in VRAM,
+ * so text sprites can reference them directly instead of copying them in new sprite tiles.
+ *
+ * When it is full, the least recently used character is released.
+ * Its sprite tiles are removed from VRAM only when they are not referenced by any sprite.
+ *
+ * @ingroup sprite
+ * @ingroup text
+ */
+class isprite_glyph_atlas
+{
+
+public:
+    isprite_glyph_atlas(const isprite_glyph_atlas& other) = delete;
+
+    isprite_glyph_atlas& operator=(const isprite_glyph_atlas& other) = delete;
+
+    /**
+     * @brief Returns the sprite font of the stored characters.
+     */
+    [[nodiscard]] const sprite_font& font() const
+    {
+        return _font;
+    }
+
+    /**
+     * @brief Returns the number of resident characters.
+     */
+    [[nodiscard]] int size() const
+    {
+        return _glyphs_ref->size();
+    }
+
+    /**
+     * @brief Returns the maximum number of resident characters.
+     */
+    [[nodiscard]] int max_size() const
+    {
+        return _glyphs_ref->max_size();
+    }
+
+    /**
+     * @brief Indicates if it doesn't contain any resident character.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _glyphs_ref->empty();
+    }
+
+    /**
+     * @brief Indicates if it can't contain any more resident characters.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _glyphs_ref->full();
+    }
+
+    /**
+     * @brief Returns the sprite tiles of the given character, making them resident if they weren't.
+     * @param graphics_index Index of the tile set of the character in the sprite_font tiles.
+     * @return sprite_tiles_ptr which references the tiles of the given character.
+     */
+    [[nodiscard]] sprite_tiles_ptr glyph_tiles(int graphics_index);
+
+    /**
+     * @brief Returns the sprite tiles of the given character, making them resident if they weren't.
+     * @param graphics_index Index of the tile set of the character in the sprite_font tiles.
+     * @return sprite_tiles_ptr which references the tiles of the given character if it could be created;
+     * bn::nullopt otherwise.
+     */
+    [[nodiscard]] optional<sprite_tiles_ptr> glyph_tiles_optional(int graphics_index);
+
+    /**
+     * @brief Releases all resident characters.
+     */
+    void clear()
+    {
+        _glyphs_ref->clear();
+    }
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    class glyph_type
+    {
+
+    public:
+        sprite_tiles_ptr tiles;
+        unsigned last_use;
+        int graphics_index;
+    };
+
+    explicit isprite_glyph_atlas(const sprite_font& font) :
+        _font(font)
+    {
+    }
+
+    void _set_refs(ivector<glyph_type>& glyphs)
+    {
+        _glyphs_ref = &glyphs;
+    }
+
+    /// @endcond
+
+private:
+    sprite_font _font;
+    ivector<glyph_type>* _glyphs_ref = nullptr;
+    unsigned _uses = 0;
+
+    [[nodiscard]] sprite_tiles_ptr* _find(int graphics_index);
+
+    void _release_least_recently_used();
+};
+
+
+/**
+ * @brief Keeps the sprite tiles of up to MaxSize recently used characters of a sprite_font resident in VRAM.
+ *
+ * @tparam MaxSize Maximum number of resident characters.
+ *
+ * @ingroup sprite
+ * @ingroup text
+ */
+template<int MaxSize>
+class sprite_glyph_atlas : public isprite_glyph_atlas
+{
+    static_assert(MaxSize > 0);
+
+public:
+    /**
+     * @brief Constructor.
+     * @param font Sprite font of the characters to store.
+     */
+    explicit sprite_glyph_atlas(const sprite_font& font) :
+        isprite_glyph_atlas(font)
+    {
+        this->_set_refs(_glyphs);
+    }
+
+private:
+    vector<glyph_type, MaxSize> _glyphs;
+};
+
+}
+
+#endif
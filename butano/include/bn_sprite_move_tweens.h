@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_MOVE_TWEENS_H
+#define BN_SPRITE_MOVE_TWEENS_H
+
+/**
+ * @file
+ * bn::isprite_move_tweens and bn::sprite_move_tweens implementation header file.
+ *
+ * @ingroup sprite
+ * @ingroup action
+ */
+
+#include "bn_vector.h"
+#include "bn_sprite_ptr.h"
+#include "bn_fixed_point.h"
+#include "bn_easing_type.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::sprite_move_tweens.
+ *
+ * Moves multiple sprites to given positions with easing curves,
+ * updating all of them in one pass and setting the new positions in a single batch.
+ *
+ * It is much faster than updating a sprite_move_to_action for each sprite.
+ *
+ * @ingroup sprite
+ * @ingroup action
+ */
+class isprite_move_tweens
+{
+
+public:
+    isprite_move_tweens(const isprite_move_tweens& other) = delete;
+
+    isprite_move_tweens& operator=(const isprite_move_tweens& other) = delete;
+
+    /**
+     * @brief Returns the number of active tweens.
+     */
+    [[nodiscard]] int size() const
+    {
+        return _sprites.size();
+    }
+
+    /**
+     * @brief Returns the maximum number of active tweens.
+     */
+    [[nodiscard]] int max_size() const
+    {
+        return _sprites.max_size();
+    }
+
+    /**
+     * @brief Indicates if there's no active tweens.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _sprites.empty();
+    }
+
+    /**
+     * @brief Indicates if no more tweens can be added.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _sprites.full();
+    }
+
+    /**
+     * @brief Indicates if the given sprite is being moved by a tween or not.
+     */
+    [[nodiscard]] bool contains(const sprite_ptr& sprite) const;
+
+    /**
+     * @brief Starts moving the given sprite from its current position to the given one.
+     *
+     * If the sprite is already being moved by a tween, it is replaced by the new one.
+     *
+     * @param sprite sprite_ptr to move.
+     * @param final_position Position of the sprite when the tween is finished.
+     * @param duration_updates Number of times that update() must be called to finish the tween.
+     * @param easing Easing curve of the movement.
+     * @param loop If `true`, the sprite goes back and forth until the tween is removed;
+     * otherwise the tween is removed when it is finished.
+     * @return `true` if the tween has been added, otherwise `false` (there's no space left to store it).
+     */
+    [[nodiscard]] bool add(const sprite_ptr& sprite, const fixed_point& final_position, int duration_updates,
+                           easing_type easing = easing_type::LINEAR, bool loop = false);
+
+    /**
+     * @brief Stops moving the given sprite, leaving it at its current position.
+     * @return `true` if the sprite was being moved by a tween, otherwise `false`.
+     */
+    bool remove(const sprite_ptr& sprite);
+
+    /**
+     * @brief Stops moving all sprites, leaving them at their current position.
+     */
+    void clear();
+
+    /**
+     * @brief Updates all tweens, and removes the finished ones.
+     *
+     * It should be called once per frame.
+     */
+    void update();
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    class tween_type
+    {
+
+    public:
+        fixed_point initial_position;
+        fixed_point delta_position;
+        unsigned progress;
+        unsigned progress_step;
+        easing_type easing;
+        bool loop;
+    };
+
+    isprite_move_tweens(ivector<sprite_ptr>& sprites, tween_type* tweens, void** ids, fixed_point* positions) :
+        _sprites(sprites),
+        _tweens(tweens),
+        _ids(ids),
+        _positions(positions)
+    {
+    }
+
+    /// @endcond
+
+private:
+    ivector<sprite_ptr>& _sprites;
+    tween_type* _tweens;
+    void** _ids;
+    fixed_point* _positions;
+
+    [[nodiscard]] int _index(const sprite_ptr& sprite) const;
+
+    void _erase(int index);
+};
+
+
+/**
+ * @brief Moves up to MaxSize sprites to given positions with easing curves,
+ * updating all of them in one pass and setting the new positions in a single batch.
+ *
+ * Example:
+ *
+ * @code{.cpp}
+ * bn::sprite_move_tweens<64> tweens;
+ *
+ * for(bn::sprite_ptr& sprite : menu_sprites)
+ * {
+ *     bool added = tweens.add(sprite, bn::fixed_point(sprite.x(), 0), 30, bn::easing_type::BACK_OUT);
+ *     BN_ASSERT(added);
+ * }
+ *
+ * while(! tweens.empty())
+ * {
+ *     tweens.update();
+ *     bn::core::update();
+ * }
+ * @endcode
+ *
+ * @tparam MaxSize Maximum number of active tweens.
+ *
+ * @ingroup sprite
+ * @ingroup action
+ */
+template<int MaxSize>
+class sprite_move_tweens : public isprite_move_tweens
+{
+    static_assert(MaxSize > 0);
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    sprite_move_tweens() :
+        isprite_move_tweens(_sprites_data, _tweens_data, _ids_data, _positions_data)
+    {
+    }
+
+private:
+    vector<sprite_ptr, MaxSize> _sprites_data;
+    tween_type _tweens_data[MaxSize];
+    void* _ids_data[MaxSize];
+    fixed_point _positions_data[MaxSize];
+};
+
+}
+
+#endif
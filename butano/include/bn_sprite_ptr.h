@@ -723,6 +723,9 @@ public:
 
     /**
      * @brief Returns the sprite_affine_mat_ptr attached to this sprite (if any).
+     *
+     * If the attached sprite_affine_mat_ptr is interned, it is replaced with a non-interned copy
+     * so it can be modified, and set_remove_affine_mat_when_not_needed(false) is called.
      */
     [[nodiscard]] const optional<sprite_affine_mat_ptr>& affine_mat() const;
 
@@ -24,6 +24,7 @@ namespace bn
 
 class sprite_ptr;
 class fixed_point;
+class isprite_glyph_atlas;
 
 /**
  * @brief Generates sprites containing text from a given sprite_font.
@@ -185,6 +186,27 @@ public:
         _one_sprite_per_character = one_sprite_per_character;
     }
 
+    /**
+     * @brief Returns the glyph atlas used to reference the sprite tiles of each character, if any.
+     */
+    [[nodiscard]] isprite_glyph_atlas* glyph_atlas() const
+    {
+        return _glyph_atlas;
+    }
+
+    /**
+     * @brief Sets the glyph atlas used to reference the sprite tiles of each character.
+     *
+     * If a glyph atlas is set, one sprite per character is generated and each of them references
+     * the resident tiles of its character instead of copying them, so multiple texts share the same sprite tiles.
+     *
+     * The glyph atlas is not copied but referenced, so it should outlive the sprite_text_generator
+     * to avoid dangling references.
+     *
+     * @param glyph_atlas Glyph atlas of the font of this sprite_text_generator, or nullptr to disable it.
+     */
+    void set_glyph_atlas(isprite_glyph_atlas* glyph_atlas);
+
     /**
      * @brief Returns the width in pixels of the given text.
      */
@@ -272,6 +294,7 @@ public:
 private:
     sprite_font _font;
     sprite_palette_item _palette_item;
+    isprite_glyph_atlas* _glyph_atlas = nullptr;
     int8_t _bg_priority = 3;
     int8_t _z_order = 0;
     alignment_type _alignment = alignment_type::LEFT;
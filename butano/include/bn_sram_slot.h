@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SRAM_SLOT_H
+#define BN_SRAM_SLOT_H
+
+/**
+ * @file
+ * bn::isram_slot and bn::sram_slot implementation header file.
+ *
+ * @ingroup sram
+ */
+
+#include "bn_sram.h"
+#include "bn_config_sram.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::sram_slot.
+ *
+ * Data is stored in two SRAM banks which are written alternately,
+ * so if the GBA is turned off while saving, the previous save can still be loaded.
+ *
+ * Each bank splits its data in blocks of @ref BN_CFG_SRAM_SLOT_BLOCK_SIZE bytes with their own CRC,
+ * and only the blocks which are different from the ones already stored in the bank are written.
+ *
+ * Writes are queued and they can be spread over multiple frames with update().
+ *
+ * @ingroup sram
+ */
+class isram_slot
+{
+
+public:
+    isram_slot(const isram_slot& other) = delete;
+
+    isram_slot& operator=(const isram_slot& other) = delete;
+
+    /**
+     * @brief Returns the size in bytes of the data blocks.
+     */
+    [[nodiscard]] static constexpr int block_size()
+    {
+        return BN_CFG_SRAM_SLOT_BLOCK_SIZE;
+    }
+
+    /**
+     * @brief Returns the number of data blocks needed to store the given number of bytes.
+     */
+    [[nodiscard]] static constexpr int blocks_count(int data_size)
+    {
+        return (data_size + block_size() - 1) / block_size();
+    }
+
+    /**
+     * @brief Returns the number of SRAM bytes used by a slot which stores the given number of bytes.
+     */
+    [[nodiscard]] static constexpr int sram_size(int data_size)
+    {
+        return (_header_size + (blocks_count(data_size) * int(sizeof(uint32_t))) + data_size) * 2;
+    }
+
+    /**
+     * @brief Returns the SRAM offset in bytes of this slot.
+     */
+    [[nodiscard]] int offset() const
+    {
+        return _offset;
+    }
+
+    /**
+     * @brief Returns the size in bytes of the stored data.
+     */
+    [[nodiscard]] int data_size() const
+    {
+        return _data_size;
+    }
+
+    /**
+     * @brief Returns the number of data blocks.
+     */
+    [[nodiscard]] int blocks_count() const
+    {
+        return _blocks_count;
+    }
+
+    /**
+     * @brief Returns the number of SRAM bytes used by this slot.
+     */
+    [[nodiscard]] int sram_size() const
+    {
+        return sram_size(_data_size);
+    }
+
+    /**
+     * @brief Indicates if SRAM has been read with load() or not.
+     */
+    [[nodiscard]] bool loaded() const
+    {
+        return _loaded;
+    }
+
+    /**
+     * @brief Returns the number of completed saves, or 0 if there's no valid data in SRAM.
+     */
+    [[nodiscard]] unsigned generation() const
+    {
+        return _generation;
+    }
+
+    /**
+     * @brief Indicates if there's a save in progress or not.
+     */
+    [[nodiscard]] bool saving() const
+    {
+        return _saving;
+    }
+
+    /**
+     * @brief Returns the number of data blocks pending to be written to SRAM.
+     */
+    [[nodiscard]] int pending_blocks() const;
+
+    /**
+     * @brief Returns the number of data blocks written to SRAM by the last completed save.
+     */
+    [[nodiscard]] int last_written_blocks() const
+    {
+        return _last_written_blocks;
+    }
+
+    /**
+     * @brief Writes up to @ref BN_CFG_SRAM_SLOT_UPDATE_BYTES pending bytes to SRAM.
+     *
+     * It should be called once per frame while saving() returns `true`.
+     *
+     * @return `true` if there's no save in progress after the update, otherwise `false`.
+     */
+    bool update()
+    {
+        return update(BN_CFG_SRAM_SLOT_UPDATE_BYTES);
+    }
+
+    /**
+     * @brief Writes pending bytes to SRAM.
+     *
+     * At least one data block is written, even if its size is greater than the given number of bytes.
+     *
+     * @param max_bytes Maximum number of bytes to write.
+     * @return `true` if there's no save in progress after the update, otherwise `false`.
+     */
+    bool update(int max_bytes);
+
+    /**
+     * @brief Writes all pending bytes to SRAM, completing the save in progress if there's one.
+     */
+    void flush();
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    static constexpr int _header_size = 16;
+
+    [[nodiscard]] static constexpr int _masks_count_of(int data_size)
+    {
+        return (blocks_count(data_size) + 31) / 32;
+    }
+
+    isram_slot(uint8_t* image, uint32_t* crcs, uint32_t* masks, int offset, int data_size);
+
+    [[nodiscard]] bool _load(void* destination);
+
+    void _save(const void* source);
+
+    /// @endcond
+
+private:
+    uint8_t* _image;
+    uint32_t* _crcs;
+    uint32_t* _dirty_masks;
+    uint32_t* _stale_masks;
+    uint32_t* _next_stale_masks;
+    int _offset;
+    int _data_size;
+    int _blocks_count;
+    int _masks_count;
+    int _written_blocks = 0;
+    int _last_written_blocks = 0;
+    unsigned _generation = 0;
+    int8_t _active_bank = -1;
+    bool _loaded = false;
+    bool _saving = false;
+
+    [[nodiscard]] int _bank_size() const;
+
+    [[nodiscard]] int _bank_offset(int bank) const;
+
+    [[nodiscard]] int _block_size(int block) const;
+
+    [[nodiscard]] bool _read_header(int bank, unsigned& generation) const;
+
+    [[nodiscard]] bool _read_bank(int bank);
+
+    void _update_stale_masks(int bank);
+
+    void _write_block(int bank, int block);
+
+    void _commit();
+};
+
+
+/**
+ * @brief Stores a value in SRAM with double-banked journaling, per block CRC and incremental writes.
+ *
+ * Example:
+ *
+ * @code{.cpp}
+ * bn::sram_slot<save_data> slot(0);
+ * save_data data;
+ *
+ * if(! slot.load(data))
+ * {
+ *     data = save_data();
+ * }
+ *
+ * slot.save(data); // Only the modified blocks are written, spread over multiple frames.
+ *
+ * while(true)
+ * {
+ *     slot.update();
+ *     bn::core::update();
+ * }
+ * @endcode
+ *
+ * @tparam Type Type of the stored value. It must be trivially copyable.
+ *
+ * @ingroup sram
+ */
+template<typename Type>
+class sram_slot : public isram_slot
+{
+    static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+    static_assert(isram_slot::sram_size(int(sizeof(Type))) <= sram::size(), "Type size is too high");
+
+public:
+    /**
+     * @brief Constructor.
+     * @param offset SRAM offset in bytes of the slot.
+     *
+     * The slot uses sram_size() bytes of SRAM from this offset.
+     */
+    explicit sram_slot(int offset) :
+        isram_slot(_image_data, _crcs_data, _masks_data, offset, int(sizeof(Type)))
+    {
+    }
+
+    /**
+     * @brief Reads the last valid save from SRAM.
+     *
+     * It must be called before saving data with this slot.
+     *
+     * @param destination Valid data is copied into this value.
+     * @return `true` if valid data has been found in SRAM, otherwise `false` (destination is not modified).
+     */
+    [[nodiscard]] bool load(Type& destination)
+    {
+        return _load(&destination);
+    }
+
+    /**
+     * @brief Starts saving the given value.
+     *
+     * The value is copied, so it can be modified after calling this method.
+     *
+     * Data is written to SRAM by update() and flush().
+     * If a save is already in progress, it is replaced by this one.
+     *
+     * @param source Value to save.
+     */
+    void save(const Type& source)
+    {
+        _save(&source);
+    }
+
+private:
+    alignas(int) uint8_t _image_data[sizeof(Type)];
+    uint32_t _crcs_data[blocks_count(int(sizeof(Type)))];
+    uint32_t _masks_data[_masks_count_of(int(sizeof(Type))) * 3];
+};
+
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_STREAM_MUSIC_H
+#define BN_STREAM_MUSIC_H
+
+/**
+ * @file
+ * bn::stream_music header file.
+ *
+ * @ingroup stream_music
+ */
+
+#include "bn_fixed.h"
+#include "bn_optional.h"
+
+namespace bn
+{
+    class stream_music_item;
+}
+
+/**
+ * @brief Stream music related functions.
+ *
+ * Stream music is pre-rendered audio decoded each frame, so it takes much less CPU than Direct Sound music.
+ *
+ * Stream music is added to the output of the Direct Sound mixer, so sound effects can be played with it,
+ * but playing stream music stops Direct Sound music.
+ *
+ * @ingroup stream_music
+ */
+namespace bn::stream_music
+{
+    /**
+     * @brief Indicates if currently there's any stream music playing or not.
+     */
+    [[nodiscard]] bool playing();
+
+    /**
+     * @brief Returns the active stream_music_item if there's any stream music playing; bn::nullopt otherwise.
+     */
+    [[nodiscard]] optional<stream_music_item> playing_item();
+
+    /**
+     * @brief Plays the stream music specified by the given stream_music_item with default settings.
+     *
+     * Default settings are volume = 1 and loop enabled.
+     *
+     * The mixing rate of the given stream_music_item must be equal to BN_CFG_AUDIO_MIXING_RATE.
+     */
+    void play(const stream_music_item& item);
+
+    /**
+     * @brief Plays the stream music specified by the given stream_music_item.
+     * @param item Specifies the stream music to play.
+     * Its mixing rate must be equal to BN_CFG_AUDIO_MIXING_RATE.
+     * @param volume Volume level, in the range [0..1].
+     */
+    void play(const stream_music_item& item, fixed volume);
+
+    /**
+     * @brief Plays the stream music specified by the given stream_music_item.
+     * @param item Specifies the stream music to play.
+     * Its mixing rate must be equal to BN_CFG_AUDIO_MIXING_RATE.
+     * @param volume Volume level, in the range [0..1].
+     * @param loop Indicates if it must be played until it is stopped manually or until end.
+     */
+    void play(const stream_music_item& item, fixed volume, bool loop);
+
+    /**
+     * @brief Stops playback of the active stream music.
+     */
+    void stop();
+
+    /**
+     * @brief Indicates if the active stream music has been paused or not.
+     */
+    [[nodiscard]] bool paused();
+
+    /**
+     * @brief Pauses playback of the active stream music.
+     */
+    void pause();
+
+    /**
+     * @brief Resumes playback of the paused stream music.
+     */
+    void resume();
+
+    /**
+     * @brief Returns the volume of the active stream music.
+     */
+    [[nodiscard]] fixed volume();
+
+    /**
+     * @brief Sets the volume of the active stream music.
+     * @param volume Volume level, in the range [0..1].
+     */
+    void set_volume(fixed volume);
+}
+
+#endif
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_STREAM_MUSIC_FORMAT_H
+#define BN_STREAM_MUSIC_FORMAT_H
+
+/**
+ * @file
+ * bn::stream_music_format header file.
+ *
+ * @ingroup stream_music
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+
+/**
+ * @brief Available stream music sample formats.
+ *
+ * @ingroup stream_music
+ */
+enum class stream_music_format : uint8_t
+{
+    PCM_8, //!< Signed 8-bit PCM, one byte per sample.
+    IMA_ADPCM //!< IMA-ADPCM, four bits per sample.
+};
+
+}
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_STREAM_MUSIC_ITEM_H
+#define BN_STREAM_MUSIC_ITEM_H
+
+/**
+ * @file
+ * bn::stream_music_item header file.
+ *
+ * @ingroup stream_music
+ * @ingroup tool
+ */
+
+#include "bn_fixed.h"
+#include "bn_assert.h"
+#include "bn_functional.h"
+#include "bn_stream_music_format.h"
+
+namespace bn
+{
+
+/**
+ * @brief Contains the required information to play stream music.
+ *
+ * The assets conversion tools generate an object of this type in the build folder
+ * for each `*.wav` file with a `*.json` file which specifies `stream_music` as its type.
+ *
+ * @ingroup stream_music
+ * @ingroup tool
+ */
+class stream_music_item
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param data_ref Reference to the sample data.
+     * @param samples_count Number of samples of the sample data.
+     * @param mixing_rate Mixing rate of the sample data (one of the BN_AUDIO_MIXING_RATE_* values).
+     * @param format Format of the sample data.
+     *
+     * Sample data is not copied but referenced, so it should outlive the stream_music_item
+     * to avoid dangling references.
+     */
+    constexpr stream_music_item(const uint8_t& data_ref, int samples_count, int mixing_rate,
+                                stream_music_format format) :
+        _data_ptr(&data_ref),
+        _samples_count(samples_count),
+        _mixing_rate(uint8_t(mixing_rate)),
+        _format(format)
+    {
+        BN_ASSERT(samples_count > 0, "Invalid samples count: ", samples_count);
+        BN_ASSERT(mixing_rate >= 0 && mixing_rate <= 7, "Invalid mixing rate: ", mixing_rate);
+    }
+
+    /**
+     * @brief Returns a pointer to the referenced sample data.
+     */
+    [[nodiscard]] constexpr const uint8_t* data_ptr() const
+    {
+        return _data_ptr;
+    }
+
+    /**
+     * @brief Returns the referenced sample data.
+     */
+    [[nodiscard]] constexpr const uint8_t& data_ref() const
+    {
+        return *_data_ptr;
+    }
+
+    /**
+     * @brief Returns the number of samples of the referenced sample data.
+     */
+    [[nodiscard]] constexpr int samples_count() const
+    {
+        return _samples_count;
+    }
+
+    /**
+     * @brief Returns the mixing rate of the referenced sample data (one of the BN_AUDIO_MIXING_RATE_* values).
+     */
+    [[nodiscard]] constexpr int mixing_rate() const
+    {
+        return _mixing_rate;
+    }
+
+    /**
+     * @brief Returns the format of the referenced sample data.
+     */
+    [[nodiscard]] constexpr stream_music_format format() const
+    {
+        return _format;
+    }
+
+    /**
+     * @brief Plays the stream music specified by this item with default settings.
+     *
+     * Default settings are volume = 1 and loop enabled.
+     */
+    void play() const;
+
+    /**
+     * @brief Plays the stream music specified by this item.
+     * @param volume Volume level, in the range [0..1].
+     */
+    void play(fixed volume) const;
+
+    /**
+     * @brief Plays the stream music specified by this item.
+     * @param volume Volume level, in the range [0..1].
+     * @param loop Indicates if it must be played until it is stopped manually or until end.
+     */
+    void play(fixed volume, bool loop) const;
+
+    /**
+     * @brief Default equal operator.
+     */
+    [[nodiscard]] constexpr friend bool operator==(const stream_music_item& a, const stream_music_item& b) = default;
+
+private:
+    const uint8_t* _data_ptr;
+    int _samples_count;
+    uint8_t _mixing_rate;
+    stream_music_format _format;
+};
+
+
+/**
+ * @brief Hash support for stream_music_item.
+ *
+ * @ingroup stream_music
+ * @ingroup functional
+ */
+template<>
+struct hash<stream_music_item>
+{
+    /**
+     * @brief Returns the hash of the given stream_music_item.
+     */
+    [[nodiscard]] constexpr unsigned operator()(const stream_music_item& value) const
+    {
+        return make_hash(value.data_ptr());
+    }
+};
+
+}
+
+#endif
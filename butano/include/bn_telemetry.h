@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_TELEMETRY_H
+#define BN_TELEMETRY_H
+
+/**
+ * @file
+ * Telemetry header file.
+ *
+ * @ingroup telemetry
+ */
+
+#include "bn_common.h"
+#include "bn_config_log.h"
+#include "bn_config_doxygen.h"
+#include "bn_config_telemetry.h"
+
+/**
+ * @brief Resource usage telemetry related functions.
+ *
+ * @ingroup telemetry
+ */
+namespace bn::telemetry
+{
+    /**
+     * @brief Available resource types.
+     */
+    enum class resource_type : uint8_t
+    {
+        SPRITES, //!< Sprite items.
+        SPRITE_TILES, //!< Sprite tiles (usage in tiles, creations and destructions in items).
+        SPRITE_AFFINE_MATS, //!< Sprite affine matrices.
+        SPRITE_PALETTE_COLORS, //!< Sprite palette colors (only usage is tracked).
+        BGS, //!< Background items.
+        BG_TILES, //!< Background tiles (usage in tiles, creations and destructions in items).
+        BG_MAP_CELLS, //!< Background map cells (usage in cells, creations and destructions in items).
+        BG_PALETTE_COLORS, //!< Background palette colors (only usage is tracked).
+        HBES, //!< H-Blank effects.
+        CAMERAS, //!< Cameras.
+        EWRAM_HEAP_BYTES, //!< EWRAM heap (usage in bytes, creations and destructions in allocations).
+        FRAME_ALLOCATOR_BYTES, //!< bn::frame_allocator (usage in bytes, creations in allocations).
+    };
+
+    #if BN_CFG_TELEMETRY_ENABLED || BN_DOXYGEN
+        /**
+         * @brief Returns the maximum usage of the given resource sampled in each bn::core::update call.
+         */
+        [[nodiscard]] int max_used(resource_type resource);
+
+        /**
+         * @brief Returns the maximum number of items of the given resource created in a single frame.
+         */
+        [[nodiscard]] int max_created_per_frame(resource_type resource);
+
+        /**
+         * @brief Returns the maximum number of items of the given resource destroyed in a single frame.
+         */
+        [[nodiscard]] int max_destroyed_per_frame(resource_type resource);
+
+        /**
+         * @brief Returns the number of items of the given resource which creation failed
+         * (usually from `create_optional` calls).
+         */
+        [[nodiscard]] int failed_creations(resource_type resource);
+
+        /**
+         * @brief Returns the maximum IWRAM used by the stack in bytes since bn::core::init.
+         *
+         * The stack is painted with a known pattern in bn::core::init, so this method is slow
+         * (it must find the first modified word).
+         */
+        [[nodiscard]] int max_used_stack_iwram();
+
+        /**
+         * @brief Forgets all telemetry records (except the stack watermark).
+         */
+        void reset();
+
+        #if BN_CFG_LOG_ENABLED || BN_DOXYGEN
+            /**
+             * @brief Logs all telemetry records, including static IWRAM and EWRAM usage.
+             */
+            void log();
+        #endif
+    #endif
+}
+
+#endif
@@ -70,10 +70,10 @@ public:
         {
             size_type index = _index;
             size_type last_valid_index = _set->_last_valid_index;
-            const bool* allocated = _set->_allocated;
+            const _slot* slots = _set->_slots;
             ++index;
 
-            while(index <= last_valid_index && ! allocated[index])
+            while(index <= last_valid_index && ! slots[index].distance)
             {
                 ++index;
             }
@@ -95,10 +95,10 @@ public:
         {
             int index = _index;
             int first_valid_index = _set->_first_valid_index;
-            const bool* allocated = _set->_allocated;
+            const _slot* slots = _set->_slots;
             --index;
 
-            while(index >= first_valid_index && ! allocated[index])
+            while(index >= first_valid_index && ! slots[index].distance)
             {
                 --index;
             }
@@ -214,10 +214,10 @@ public:
         {
             size_type index = _index;
             size_type last_valid_index = _set->_last_valid_index;
-            const bool* allocated = _set->_allocated;
+            const _slot* slots = _set->_slots;
             ++index;
 
-            while(index <= last_valid_index && ! allocated[index])
+            while(index <= last_valid_index && ! slots[index].distance)
             {
                 ++index;
             }
@@ -239,10 +239,10 @@ public:
         {
             int index = _index;
             int first_valid_index = _set->_first_valid_index;
-            const bool* allocated = _set->_allocated;
+            const _slot* slots = _set->_slots;
             --index;
 
-            while(index >= first_valid_index && ! allocated[index])
+            while(index >= first_valid_index && ! slots[index].distance)
             {
                 --index;
             }
@@ -580,21 +580,24 @@ public:
         }
 
         const_pointer storage = _storage;
-        const bool* allocated = _allocated;
+        const _slot* slots = _slots;
         key_equal key_equal_functor;
+        unsigned fingerprint = _fingerprint(key_hash);
         size_type index = _index(key_hash);
-        size_type max_size = _max_size_minus_one + 1;
-        size_type its = 0;
+        unsigned distance = 1;
 
-        while(its < max_size && allocated[index])
+        // Elements are sorted by their desired index, so the search stops
+        // when an element closer to its desired index than the given key is found:
+
+        while(slots[index].distance >= distance)
         {
-            if(key_equal_functor(key, storage[index]))
+            if(slots[index].fingerprint == fingerprint && key_equal_functor(key, storage[index]))
             {
                 return iterator(index, *this);
             }
 
             index = _index(index + 1);
-            ++its;
+            ++distance;
         }
 
         return end();
@@ -639,29 +642,33 @@ public:
      */
     iterator insert_hash(hash_type value_hash, value_type&& value)
     {
-        size_type index = _index(value_hash);
         pointer storage = _storage;
-        bool* allocated = _allocated;
+        _slot* slots = _slots;
         key_equal key_equal_functor;
-        size_type current_index = index;
+        unsigned fingerprint = _fingerprint(value_hash);
+        size_type index = _index(value_hash);
+        unsigned distance = 1;
 
-        while(allocated[current_index])
+        while(slots[index].distance >= distance)
         {
-            if(key_equal_functor(value, storage[current_index]))
+            if(slots[index].fingerprint == fingerprint && key_equal_functor(value, storage[index]))
             {
                 return end();
             }
 
-            current_index = _index(current_index + 1);
-            BN_ASSERT(current_index != index, "All indices are allocated");
+            index = _index(index + 1);
+            ++distance;
         }
 
-        ::new(storage + current_index) value_type(move(value));
-        allocated[current_index] = true;
-        _first_valid_index = min(_first_valid_index, current_index);
-        _last_valid_index = max(_last_valid_index, current_index);
+        BN_ASSERT(! full(), "All indices are allocated");
+
+        size_type empty_index = _shift_forward(index);
+        ::new(storage + index) value_type(move(value));
+        slots[index] = _slot{ uint16_t(fingerprint), uint16_t(distance) };
+        _first_valid_index = min(_first_valid_index, empty_index);
+        _last_valid_index = max(_last_valid_index, empty_index);
         ++_size;
-        return iterator(current_index, *this);
+        return iterator(index, *this);
     }
 
     /**
@@ -674,72 +681,17 @@ public:
      */
     iterator erase(const const_iterator& position)
     {
-        bool* allocated = _allocated;
         size_type index = position._index;
-        BN_ASSERT(allocated[index], "Index is not allocated: ", index);
-
-        pointer storage = _storage;
-        storage[index].~value_type();
-        allocated[index] = false;
-        --_size;
+        BN_ASSERT(_slots[index].distance, "Index is not allocated: ", index);
 
-        if(! _size)
-        {
-            _first_valid_index = max_size();
-            _last_valid_index = 0;
-            return end();
-        }
-
-        size_type first_valid_index = _first_valid_index;
-
-        if(index == first_valid_index)
-        {
-            while(! allocated[first_valid_index])
-            {
-                ++first_valid_index;
-            }
-
-            _first_valid_index = first_valid_index;
-        }
+        _shift_backward(index);
 
+        const _slot* slots = _slots;
         size_type last_valid_index = _last_valid_index;
 
-        if(index == last_valid_index)
-        {
-            while(! allocated[last_valid_index])
-            {
-                --last_valid_index;
-            }
-
-            _last_valid_index = last_valid_index;
-        }
-
-        size_type next_index = _index(index + 1);
-        int reinsert_count = 0;
-
-        while(allocated[next_index])
-        {
-            ++reinsert_count;
-            next_index = _index(next_index + 1);
-        }
-
-        next_index = _index(index + 1);
-        _size -= reinsert_count;
-
-        for(int reinsert_index = 0; reinsert_index < reinsert_count; ++reinsert_index)
-        {
-            value_type temp_value(move(storage[next_index]));
-            storage[next_index].~value_type();
-            allocated[next_index] = false;
-            insert(move(temp_value));
-            next_index = _index(next_index + 1);
-        }
-
-        last_valid_index = _last_valid_index;
-
         while(index <= last_valid_index)
         {
-            if(allocated[index])
+            if(slots[index].distance)
             {
                 return iterator(index, *this);
             }
@@ -799,31 +751,24 @@ public:
     {
         size_type erased_count = 0;
         pointer storage = set._storage;
-        bool* allocated = set._allocated;
-        size_type first_valid_index = set.max_size();
-        size_type last_valid_index = 0;
+        const _slot* slots = set._slots;
+        size_type index = set._first_valid_index;
 
-        for(size_type index = set._first_valid_index, last = set._last_valid_index; index <= last; ++index)
+        // Erased elements are replaced by the following ones, so the same index is checked again:
+
+        while(index <= set._last_valid_index)
         {
-            if(allocated[index])
+            if(slots[index].distance && pred(storage[index]))
             {
-                if(allocated[index] && pred(storage[index]))
-                {
-                    storage[index].~value_type();
-                    allocated[index] = false;
-                    ++erased_count;
-                }
-                else
-                {
-                    first_valid_index = min(index, first_valid_index);
-                    last_valid_index = max(index, last_valid_index);
-                }
+                set._shift_backward(index);
+                ++erased_count;
+            }
+            else
+            {
+                ++index;
             }
         }
 
-        set._size -= erased_count;
-        set._first_valid_index = first_valid_index;
-        set._last_valid_index = last_valid_index;
         return erased_count;
     }
 
@@ -839,33 +784,18 @@ public:
             BN_ASSERT(_max_size_minus_one == other._max_size_minus_one,
                        "Invalid max size: ", max_size(), " - ", other.max_size());
 
-            pointer storage = _storage;
             pointer other_storage = other._storage;
-            bool* allocated = _allocated;
-            bool* other_allocated = other._allocated;
-            size_type size = _size;
-            size_type first_valid_index = min(_first_valid_index, other._first_valid_index);
-            size_type last_valid_index = max(_last_valid_index, other._last_valid_index);
+            const _slot* other_slots = other._slots;
 
-            for(size_type index = first_valid_index; index <= last_valid_index; ++index)
+            for(size_type index = other._first_valid_index, last = other._last_valid_index; index <= last; ++index)
             {
-                if(other_allocated[index])
+                if(other_slots[index].distance)
                 {
-                    if(allocated[index])
-                    {
-                        storage[index] = move(other_storage[index]);
-                    }
-                    else
-                    {
-                        ::new(storage + index) value_type(move(other_storage[index]));
-                        ++size;
-                    }
+                    value_type& other_value = other_storage[index];
+                    insert_hash(hasher()(other_value), move(other_value));
                 }
             }
 
-            _size = size;
-            _first_valid_index = first_valid_index;
-            _last_valid_index = last_valid_index;
             other.clear();
         }
     }
@@ -878,7 +808,7 @@ public:
         if(_size)
         {
             size_type max_size = _max_size_minus_one + 1;
-            memory::clear(max_size, *_allocated);
+            memory::clear(max_size, *_slots);
             _first_valid_index = max_size;
             _last_valid_index = 0;
             _size = 0;
@@ -894,20 +824,20 @@ public:
         if(_size)
         {
             pointer storage = _storage;
-            bool* allocated = _allocated;
+            _slot* slots = _slots;
             size_type first_valid_index = _first_valid_index;
             size_type last_valid_index = _last_valid_index;
 
             for(size_type index = first_valid_index; index <= last_valid_index; ++index)
             {
-                if(allocated[index])
+                if(slots[index].distance)
                 {
                     storage[index].~value_type();
                 }
             }
 
             size_type max_size = _max_size_minus_one + 1;
-            memory::clear(max_size, *allocated);
+            memory::clear(max_size, *slots);
             _first_valid_index = max_size;
             _last_valid_index = 0;
             _size = 0;
@@ -930,16 +860,16 @@ public:
 
             pointer storage = _storage;
             pointer other_storage = other._storage;
-            bool* allocated = _allocated;
-            bool* other_allocated = other._allocated;
+            _slot* slots = _slots;
+            _slot* other_slots = other._slots;
             size_type first_valid_index = min(_first_valid_index, other._first_valid_index);
             size_type last_valid_index = max(_last_valid_index, other._last_valid_index);
 
             for(size_type index = first_valid_index; index <= last_valid_index; ++index)
             {
-                if(other_allocated[index])
+                if(other_slots[index].distance)
                 {
-                    if(allocated[index])
+                    if(slots[index].distance)
                     {
                         bn::swap(storage[index], other_storage[index]);
                     }
@@ -947,20 +877,18 @@ public:
                     {
                         ::new(storage + index) value_type(move(other_storage[index]));
                         other_storage[index].~value_type();
-                        other_allocated[index] = false;
-                        allocated[index] = true;
                     }
                 }
                 else
                 {
-                    if(allocated[index])
+                    if(slots[index].distance)
                     {
                         ::new(other_storage + index) value_type(move(storage[index]));
                         storage[index].~value_type();
-                        allocated[index] = false;
-                        other_allocated[index] = true;
                     }
                 }
+
+                bn::swap(slots[index], other_slots[index]);
             }
 
             bn::swap(_size, other._size);
@@ -1000,17 +928,17 @@ public:
 
         const_pointer a_storage = a._storage;
         const_pointer b_storage = b._storage;
-        const bool* a_allocated = a._allocated;
-        const bool* b_allocated = b._allocated;
+        const _slot* a_slots = a._slots;
+        const _slot* b_slots = b._slots;
 
         for(size_type index = first_valid_index; index <= last_valid_index; ++index)
         {
-            if(a_allocated[index] != b_allocated[index])
+            if(a_slots[index].distance != b_slots[index].distance)
             {
                 return false;
             }
 
-            if(a_allocated[index] && a_storage[index] != b_storage[index])
+            if(a_slots[index].distance && a_storage[index] != b_storage[index])
             {
                 return false;
             }
@@ -1082,9 +1010,15 @@ public:
 protected:
     /// @cond DO_NOT_DOCUMENT
 
-    iunordered_set(reference storage, bool& allocated, size_type max_size) :
+    struct _slot
+    {
+        uint16_t fingerprint;
+        uint16_t distance;
+    };
+
+    iunordered_set(reference storage, _slot& slots, size_type max_size) :
         _storage(&storage),
-        _allocated(&allocated),
+        _slots(&slots),
         _max_size_minus_one(max_size - 1),
         _first_valid_index(max_size)
     {
@@ -1094,14 +1028,14 @@ protected:
     {
         const_pointer other_storage = other._storage;
         pointer storage = _storage;
-        bool* allocated = _allocated;
+        _slot* slots = _slots;
         size_type first_valid_index = other._first_valid_index;
         size_type last_valid_index = other._last_valid_index;
-        memory::copy(*other._allocated, other.max_size(), *allocated);
+        memory::copy(*other._slots, other.max_size(), *slots);
 
         for(size_type index = first_valid_index; index <= last_valid_index; ++index)
         {
-            if(allocated[index])
+            if(slots[index].distance)
             {
                 ::new(storage + index) value_type(other_storage[index]);
             }
@@ -1116,15 +1050,15 @@ protected:
     {
         pointer other_storage = other._storage;
         pointer storage = _storage;
-        bool* allocated = _allocated;
+        _slot* slots = _slots;
         size_type first_valid_index = other._first_valid_index;
         size_type last_valid_index = other._last_valid_index;
         int other_max_size = other.max_size();
-        memory::copy(*other._allocated, other_max_size, *allocated);
+        memory::copy(*other._slots, other_max_size, *slots);
 
         for(size_type index = first_valid_index; index <= last_valid_index; ++index)
         {
-            if(allocated[index])
+            if(slots[index].distance)
             {
                 ::new(storage + index) value_type(move(other_storage[index]));
             }
@@ -1140,7 +1074,7 @@ protected:
 
 private:
     pointer _storage;
-    bool* _allocated;
+    _slot* _slots;
     size_type _max_size_minus_one;
     size_type _first_valid_index;
     size_type _last_valid_index = 0;
@@ -1150,6 +1084,94 @@ private:
     {
         return key_hash & _max_size_minus_one;
     }
+
+    [[nodiscard]] static unsigned _fingerprint(hash_type key_hash)
+    {
+        return uint16_t(key_hash ^ (key_hash >> 16));
+    }
+
+    size_type _shift_forward(size_type index)
+    {
+        pointer storage = _storage;
+        _slot* slots = _slots;
+        size_type empty_index = index;
+
+        while(slots[empty_index].distance)
+        {
+            empty_index = _index(empty_index + 1);
+        }
+
+        size_type current_index = empty_index;
+
+        while(current_index != index)
+        {
+            size_type previous_index = _index(current_index - 1);
+            ::new(storage + current_index) value_type(move(storage[previous_index]));
+            storage[previous_index].~value_type();
+
+            _slot& slot = slots[current_index];
+            slot = slots[previous_index];
+            ++slot.distance;
+            current_index = previous_index;
+        }
+
+        return empty_index;
+    }
+
+    void _shift_backward(size_type index)
+    {
+        pointer storage = _storage;
+        _slot* slots = _slots;
+        storage[index].~value_type();
+
+        size_type next_index = _index(index + 1);
+
+        while(slots[next_index].distance > 1)
+        {
+            ::new(storage + index) value_type(move(storage[next_index]));
+            storage[next_index].~value_type();
+
+            _slot& slot = slots[index];
+            slot = slots[next_index];
+            --slot.distance;
+            index = next_index;
+            next_index = _index(next_index + 1);
+        }
+
+        slots[index].distance = 0;
+        --_size;
+
+        if(! _size)
+        {
+            _first_valid_index = max_size();
+            _last_valid_index = 0;
+            return;
+        }
+
+        size_type first_valid_index = _first_valid_index;
+
+        if(index == first_valid_index)
+        {
+            while(! slots[first_valid_index].distance)
+            {
+                ++first_valid_index;
+            }
+
+            _first_valid_index = first_valid_index;
+        }
+
+        size_type last_valid_index = _last_valid_index;
+
+        if(index == last_valid_index)
+        {
+            while(! slots[last_valid_index].distance)
+            {
+                --last_valid_index;
+            }
+
+            _last_valid_index = last_valid_index;
+        }
+    }
 };
 
 
@@ -1157,6 +1179,7 @@ template<typename Key, int MaxSize, typename KeyHash, typename KeyEqual>
 class unordered_set : public iunordered_set<Key, KeyHash, KeyEqual>
 {
     static_assert(power_of_two(MaxSize));
+    static_assert(MaxSize <= 32768);
 
 public:
     using key_type = Key; //!< Key type alias.
@@ -1175,7 +1198,7 @@ public:
      * @brief Default constructor.
      */
     unordered_set() :
-        iunordered_set<Key, KeyHash, KeyEqual>(*reinterpret_cast<pointer>(_storage_buffer), *_allocated_buffer, MaxSize)
+        iunordered_set<Key, KeyHash, KeyEqual>(*reinterpret_cast<pointer>(_storage_buffer), *_slots_buffer, MaxSize)
     {
     }
 
@@ -1321,7 +1344,7 @@ private:
     static constexpr unsigned _alignment = alignof(value_type) > alignof(int) ? alignof(value_type) : alignof(int);
 
     alignas(_alignment) char _storage_buffer[sizeof(value_type) * MaxSize];
-    bool _allocated_buffer[MaxSize] = {};
+    typename iunordered_set<Key, KeyHash, KeyEqual>::_slot _slots_buffer[MaxSize] = {};
 };
 
 }
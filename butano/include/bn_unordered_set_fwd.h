@@ -22,7 +22,12 @@ namespace bn
      *
      * Can be used as a reference type for all bn::unordered_set containers containing a specific type.
      *
-     * Unlike `std::unordered_set`, it doesn't offer pointer stability when moving or erasing elements.
+     * Unlike `std::unordered_set`, it doesn't offer pointer stability when inserting, moving or erasing elements.
+     *
+     * Elements are stored with open addressing and robin hood hashing:
+     * each slot keeps a 16-bit fingerprint of the hash of its key, so most keys are discarded without comparing them,
+     * and elements are kept sorted by their desired index, so searches stop at the first element closer to its
+     * desired index than the given key.
      *
      * @tparam Key Element type.
      * @tparam KeyHash Functor used to calculate the hash of a given key.
@@ -38,7 +43,12 @@ namespace bn
      *
      * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
      *
-     * Unlike `std::unordered_set`, it doesn't offer pointer stability when moving or erasing elements.
+     * Unlike `std::unordered_set`, it doesn't offer pointer stability when inserting, moving or erasing elements.
+     *
+     * Elements are stored with open addressing and robin hood hashing:
+     * each slot keeps a 16-bit fingerprint of the hash of its key, so most keys are discarded without comparing them,
+     * and elements are kept sorted by their desired index, so searches stop at the first element closer to its
+     * desired index than the given key.
      *
      * @tparam Key Element type.
      * @tparam MaxSize Maximum number of elements that can be stored.
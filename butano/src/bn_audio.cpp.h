@@ -5,6 +5,7 @@
 
 #include "bn_audio.h"
 
+#include "bn_timers.h"
 #include "bn_audio_manager.h"
 
 namespace bn::audio
@@ -30,4 +31,50 @@ void set_dmg_sync_enabled(bool dmg_sync_enabled)
     return audio_manager::set_dmg_sync_enabled(dmg_sync_enabled);
 }
 
+fixed last_cpu_usage()
+{
+    int ticks = audio_manager::last_direct_sound_ticks() + audio_manager::last_dmg_ticks();
+    return fixed(ticks) / timers::ticks_per_frame();
+}
+
+fixed last_direct_sound_cpu_usage()
+{
+    return fixed(audio_manager::last_direct_sound_ticks()) / timers::ticks_per_frame();
+}
+
+fixed last_dmg_cpu_usage()
+{
+    return fixed(audio_manager::last_dmg_ticks()) / timers::ticks_per_frame();
+}
+
+int last_direct_sound_channels()
+{
+    return audio_manager::last_direct_sound_channels();
+}
+
+fixed max_cpu_usage()
+{
+    return fixed(audio_manager::max_ticks()) / timers::ticks_per_frame();
+}
+
+fixed max_direct_sound_cpu_usage()
+{
+    return fixed(audio_manager::max_direct_sound_ticks()) / timers::ticks_per_frame();
+}
+
+fixed max_dmg_cpu_usage()
+{
+    return fixed(audio_manager::max_dmg_ticks()) / timers::ticks_per_frame();
+}
+
+int max_direct_sound_channels()
+{
+    return audio_manager::max_direct_sound_channels();
+}
+
+void reset_max_usage()
+{
+    audio_manager::reset_max_usage();
+}
+
 }
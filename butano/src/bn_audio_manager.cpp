@@ -8,15 +8,19 @@
 #include "bn_math.h"
 #include "bn_config_audio.h"
 #include "bn_dmg_music_position.h"
+#include "bn_audio_mixing_rate.h"
 #include "../hw/include/bn_hw_audio.h"
+#include "../hw/include/bn_hw_dmg_precompiled_music.h"
 
 #include "bn_audio.cpp.h"
 #include "bn_music.cpp.h"
 #include "bn_sound.cpp.h"
 #include "bn_dmg_music.cpp.h"
+#include "bn_stream_music.cpp.h"
 #include "bn_music_item.cpp.h"
 #include "bn_sound_item.cpp.h"
 #include "bn_dmg_music_item.cpp.h"
+#include "bn_stream_music_item.cpp.h"
 
 namespace bn::audio_manager
 {
@@ -92,22 +96,24 @@ namespace
     {
 
     public:
-        play_dmg_music_command(const void* song, bool loop, int speed) :
+        play_dmg_music_command(const void* song, bool loop, int speed, bool precompiled) :
             _song(song),
             _speed(speed),
-            _loop(loop)
+            _loop(loop),
+            _precompiled(precompiled)
         {
         }
 
         void execute() const
         {
-            hw::audio::play_dmg_music(_song, _speed, _loop);
+            hw::audio::play_dmg_music(_song, _speed, _loop, _precompiled);
         }
 
     private:
         const void* _song;
         int _speed;
         bool _loop;
+        bool _precompiled;
     };
 
 
@@ -153,6 +159,52 @@ namespace
     };
 
 
+    class play_stream_music_command
+    {
+
+    public:
+        play_stream_music_command(const uint8_t* data, int samples_count, bool adpcm, int volume, bool loop) :
+            _data(data),
+            _samples_count(samples_count),
+            _volume(uint16_t(volume)),
+            _adpcm(adpcm),
+            _loop(loop)
+        {
+        }
+
+        void execute() const
+        {
+            hw::audio::play_stream_music(_data, _samples_count, _adpcm, _volume, _loop);
+        }
+
+    private:
+        const uint8_t* _data;
+        int _samples_count;
+        uint16_t _volume;
+        bool _adpcm;
+        bool _loop;
+    };
+
+
+    class set_stream_music_volume_command
+    {
+
+    public:
+        explicit set_stream_music_volume_command(int volume) :
+            _volume(volume)
+        {
+        }
+
+        void execute() const
+        {
+            hw::audio::set_stream_music_volume(_volume);
+        }
+
+    private:
+        int _volume;
+    };
+
+
     class play_sound_command
     {
 
@@ -215,6 +267,11 @@ namespace
         DMG_MUSIC_RESUME,
         DMG_MUSIC_SET_POSITION,
         DMG_MUSIC_SET_VOLUME,
+        STREAM_MUSIC_PLAY,
+        STREAM_MUSIC_STOP,
+        STREAM_MUSIC_PAUSE,
+        STREAM_MUSIC_RESUME,
+        STREAM_MUSIC_SET_VOLUME,
         SOUND_PLAY,
         SOUND_PLAY_EX,
         SOUND_STOP_ALL
@@ -229,6 +286,7 @@ namespace
 
     static_assert(sizeof(play_sound_ex_command) == sizeof(command_data));
     static_assert(alignof(play_sound_ex_command) == alignof(command_data));
+    static_assert(sizeof(play_stream_music_command) <= sizeof(command_data));
 
 
     class static_data
@@ -240,14 +298,23 @@ namespace
         bn::dmg_music_position dmg_music_position;
         fixed dmg_music_left_volume;
         fixed dmg_music_right_volume;
+        optional<bn::stream_music_item> stream_music;
+        fixed stream_music_volume;
         int commands_count = 0;
+        int last_direct_sound_channels = 0;
+        int max_direct_sound_ticks = 0;
+        int max_dmg_ticks = 0;
+        int max_ticks = 0;
+        int max_direct_sound_channels = 0;
         int music_item_id = 0;
         int music_position = 0;
         const uint8_t* dmg_music_data = nullptr;
         command_code command_codes[max_commands];
+        bn::dmg_music_type dmg_music_type = bn::dmg_music_type::GBT_PLAYER;
         bool music_playing = false;
         bool music_paused = false;
         bool dmg_music_paused = false;
+        bool stream_music_paused = false;
         bool dmg_sync_enabled = false;
     };
 
@@ -259,6 +326,11 @@ namespace
         return fixed_t<10>(volume).data();
     }
 
+    int _hw_stream_music_volume(fixed volume)
+    {
+        return fixed_t<8>(volume).data();
+    }
+
     int _hw_sound_volume(fixed volume)
     {
         return min(fixed_t<8>(volume).data(), 255);
@@ -314,6 +386,11 @@ optional<music_item> playing_music_item()
 
 void play_music(music_item item, fixed volume, bool loop)
 {
+    if(data.stream_music)
+    {
+        stop_stream_music();
+    }
+
     int commands = data.commands_count;
     BN_ASSERT(commands < max_commands, "No more audio commands available");
 
@@ -430,7 +507,7 @@ optional<dmg_music_item> playing_dmg_music_item()
 
     if(const uint8_t* dmg_music_data = data.dmg_music_data)
     {
-        result = dmg_music_item(*dmg_music_data);
+        result = dmg_music_item(*dmg_music_data, data.dmg_music_type);
     }
 
     return result;
@@ -442,13 +519,15 @@ void play_dmg_music(dmg_music_item item, int speed, bool loop)
     BN_ASSERT(commands < max_commands, "No more audio commands available");
 
     data.command_codes[commands] = DMG_MUSIC_PLAY;
-    new(data.command_datas + commands) play_dmg_music_command(item.data_ptr(), loop, speed);
+    new(data.command_datas + commands) play_dmg_music_command(
+                item.data_ptr(), loop, speed, item.type() == bn::dmg_music_type::PRECOMPILED);
     data.commands_count = commands + 1;
 
     data.dmg_music_position = bn::dmg_music_position();
     data.dmg_music_left_volume = 1;
     data.dmg_music_right_volume = 1;
     data.dmg_music_data = item.data_ptr();
+    data.dmg_music_type = item.type();
     data.dmg_music_paused = false;
 }
 
@@ -508,6 +587,9 @@ const bn::dmg_music_position& dmg_music_position()
 void set_dmg_music_position(const bn::dmg_music_position& position)
 {
     BN_ASSERT(data.dmg_music_data, "There's no DMG music playing");
+    BN_ASSERT(data.dmg_music_type != bn::dmg_music_type::PRECOMPILED ||
+              hw::dmg_precompiled_music::valid_position(data.dmg_music_data, position.pattern(), position.row()),
+              "Position is never reached by precompiled DMG music: ", position.pattern(), " - ", position.row());
 
     int commands = data.commands_count;
     BN_ASSERT(commands < max_commands, "No more audio commands available");
@@ -572,6 +654,111 @@ void set_dmg_sync_enabled(bool enabled)
     data.dmg_sync_enabled = enabled;
 }
 
+bool stream_music_playing()
+{
+    return data.stream_music.has_value();
+}
+
+optional<stream_music_item> playing_stream_music_item()
+{
+    return data.stream_music;
+}
+
+void play_stream_music(const stream_music_item& item, fixed volume, bool loop)
+{
+    BN_ASSERT(item.mixing_rate() == BN_CFG_AUDIO_MIXING_RATE,
+              "Stream music mixing rate doesn't match the audio mixing rate: ",
+              item.mixing_rate(), " - ", BN_CFG_AUDIO_MIXING_RATE);
+
+    if(data.music_playing)
+    {
+        stop_music();
+    }
+
+    int commands = data.commands_count;
+    BN_ASSERT(commands < max_commands, "No more audio commands available");
+
+    data.command_codes[commands] = STREAM_MUSIC_PLAY;
+    new(data.command_datas + commands) play_stream_music_command(
+                item.data_ptr(), item.samples_count(), item.format() == stream_music_format::IMA_ADPCM,
+                _hw_stream_music_volume(volume), loop);
+    data.commands_count = commands + 1;
+
+    data.stream_music = item;
+    data.stream_music_volume = volume;
+    data.stream_music_paused = false;
+}
+
+void stop_stream_music()
+{
+    BN_ASSERT(data.stream_music, "There's no stream music playing");
+
+    int commands = data.commands_count;
+    BN_ASSERT(commands < max_commands, "No more audio commands available");
+
+    data.command_codes[commands] = STREAM_MUSIC_STOP;
+    data.commands_count = commands + 1;
+
+    data.stream_music.reset();
+    data.stream_music_paused = false;
+}
+
+bool stream_music_paused()
+{
+    return data.stream_music_paused;
+}
+
+void pause_stream_music()
+{
+    BN_ASSERT(data.stream_music, "There's no stream music playing");
+    BN_ASSERT(! data.stream_music_paused, "Stream music is already paused");
+
+    int commands = data.commands_count;
+    BN_ASSERT(commands < max_commands, "No more audio commands available");
+
+    data.command_codes[commands] = STREAM_MUSIC_PAUSE;
+    data.commands_count = commands + 1;
+
+    data.stream_music_paused = true;
+}
+
+void resume_stream_music()
+{
+    BN_ASSERT(data.stream_music_paused, "Stream music is not paused");
+
+    int commands = data.commands_count;
+    BN_ASSERT(commands < max_commands, "No more audio commands available");
+
+    data.command_codes[commands] = STREAM_MUSIC_RESUME;
+    data.commands_count = commands + 1;
+
+    data.stream_music_paused = false;
+}
+
+fixed stream_music_volume()
+{
+    BN_ASSERT(data.stream_music, "There's no stream music playing");
+
+    return data.stream_music_volume;
+}
+
+void set_stream_music_volume(fixed volume)
+{
+    if(volume != data.stream_music_volume)
+    {
+        BN_ASSERT(data.stream_music, "There's no stream music playing");
+
+        int commands = data.commands_count;
+        BN_ASSERT(commands < max_commands, "No more audio commands available");
+
+        data.command_codes[commands] = STREAM_MUSIC_SET_VOLUME;
+        new(data.command_datas + commands) set_stream_music_volume_command(_hw_stream_music_volume(volume));
+        data.commands_count = commands + 1;
+
+        data.stream_music_volume = volume;
+    }
+}
+
 void play_sound(int priority, sound_item item)
 {
     int commands = data.commands_count;
@@ -617,9 +804,61 @@ void disable_vblank_handler()
     hw::audio::disable_vblank_handler();
 }
 
+int last_direct_sound_ticks()
+{
+    return hw::audio::last_direct_sound_ticks();
+}
+
+int last_dmg_ticks()
+{
+    return hw::audio::last_dmg_ticks();
+}
+
+int last_direct_sound_channels()
+{
+    return data.last_direct_sound_channels;
+}
+
+int max_direct_sound_ticks()
+{
+    return data.max_direct_sound_ticks;
+}
+
+int max_dmg_ticks()
+{
+    return data.max_dmg_ticks;
+}
+
+int max_ticks()
+{
+    return data.max_ticks;
+}
+
+int max_direct_sound_channels()
+{
+    return data.max_direct_sound_channels;
+}
+
+void reset_max_usage()
+{
+    data.max_direct_sound_ticks = 0;
+    data.max_dmg_ticks = 0;
+    data.max_ticks = 0;
+    data.max_direct_sound_channels = 0;
+}
+
 void update()
 {
     hw::audio::update(data.dmg_sync_enabled);
+
+    int direct_sound_ticks = hw::audio::last_direct_sound_ticks();
+    int dmg_ticks = hw::audio::last_dmg_ticks();
+    int direct_sound_channels = hw::audio::active_direct_sound_channels();
+    data.last_direct_sound_channels = direct_sound_channels;
+    data.max_direct_sound_ticks = max(data.max_direct_sound_ticks, direct_sound_ticks);
+    data.max_dmg_ticks = max(data.max_dmg_ticks, dmg_ticks);
+    data.max_ticks = max(data.max_ticks, direct_sound_ticks + dmg_ticks);
+    data.max_direct_sound_channels = max(data.max_direct_sound_channels, direct_sound_channels);
 }
 
 void execute_commands()
@@ -679,6 +918,26 @@ void execute_commands()
             reinterpret_cast<const set_dmg_music_volume_command&>(data.command_datas[index].data).execute();
             break;
 
+        case STREAM_MUSIC_PLAY:
+            reinterpret_cast<const play_stream_music_command&>(data.command_datas[index].data).execute();
+            break;
+
+        case STREAM_MUSIC_STOP:
+            hw::audio::stop_stream_music();
+            break;
+
+        case STREAM_MUSIC_PAUSE:
+            hw::audio::pause_stream_music();
+            break;
+
+        case STREAM_MUSIC_RESUME:
+            hw::audio::resume_stream_music();
+            break;
+
+        case STREAM_MUSIC_SET_VOLUME:
+            reinterpret_cast<const set_stream_music_volume_command&>(data.command_datas[index].data).execute();
+            break;
+
         case SOUND_PLAY:
             reinterpret_cast<const play_sound_command&>(data.command_datas[index].data).execute();
             break;
@@ -698,6 +957,15 @@ void execute_commands()
 
     data.commands_count = 0;
 
+    if(data.stream_music && ! hw::audio::stream_music_playing())
+    {
+        // Stream music has reached its end, so it isn't mixed into maxmod's output buffer anymore:
+
+        hw::audio::stop_stream_music();
+        data.stream_music.reset();
+        data.stream_music_paused = false;
+    }
+
     if(data.music_playing && hw::audio::music_playing())
     {
         data.music_position = hw::audio::music_position();
@@ -730,6 +998,11 @@ void stop()
         stop_music();
     }
 
+    if(data.stream_music)
+    {
+        stop_stream_music();
+    }
+
     stop_all_sounds();
 }
 
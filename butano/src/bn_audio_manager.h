@@ -15,6 +15,7 @@ namespace bn
     class sound_item;
     class dmg_music_item;
     class dmg_music_position;
+    class stream_music_item;
 }
 
 namespace bn::audio_manager
@@ -83,6 +84,26 @@ namespace bn::audio_manager
 
     void set_dmg_sync_enabled(bool enabled);
 
+    // stream_music
+
+    [[nodiscard]] bool stream_music_playing();
+
+    [[nodiscard]] optional<stream_music_item> playing_stream_music_item();
+
+    void play_stream_music(const stream_music_item& item, fixed volume, bool loop);
+
+    void stop_stream_music();
+
+    [[nodiscard]] bool stream_music_paused();
+
+    void pause_stream_music();
+
+    void resume_stream_music();
+
+    [[nodiscard]] fixed stream_music_volume();
+
+    void set_stream_music_volume(fixed volume);
+
     // sound
 
     void play_sound(int priority, sound_item item);
@@ -97,6 +118,24 @@ namespace bn::audio_manager
 
     void disable_vblank_handler();
 
+    // usage
+
+    [[nodiscard]] int last_direct_sound_ticks();
+
+    [[nodiscard]] int last_dmg_ticks();
+
+    [[nodiscard]] int last_direct_sound_channels();
+
+    [[nodiscard]] int max_direct_sound_ticks();
+
+    [[nodiscard]] int max_dmg_ticks();
+
+    [[nodiscard]] int max_ticks();
+
+    [[nodiscard]] int max_direct_sound_channels();
+
+    void reset_max_usage();
+
     void update();
 
     void execute_commands();
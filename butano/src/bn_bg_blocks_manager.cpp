@@ -9,6 +9,7 @@
 #include "bn_string_view.h"
 #include "bn_bgs_manager.h"
 #include "bn_unordered_map.h"
+#include "bn_telemetry_manager.h"
 #include "bn_config_bg_blocks.h"
 #include "../hw/include/bn_hw_memory.h"
 #include "../hw/include/bn_hw_bg_blocks.h"
@@ -857,6 +858,8 @@ namespace
         }
 
         bool is_tiles = ! create_data.palette;
+        telemetry_manager::on_create(is_tiles ? telemetry::resource_type::BG_TILES :
+                                                telemetry::resource_type::BG_MAP_CELLS);
 
         if(int new_item_blocks_count = item->blocks_count - blocks_count)
         {
@@ -1307,6 +1310,7 @@ int create_regular_tiles(const regular_bg_tiles_item& tiles_item, bool optional)
     else
     {
         BN_BG_BLOCKS_LOG("NOT CREATED");
+        telemetry_manager::on_create_failed(telemetry::resource_type::BG_TILES);
 
         if(! optional)
         {
@@ -1355,6 +1359,7 @@ int create_affine_tiles(const affine_bg_tiles_item& tiles_item, bool optional)
     else
     {
         BN_BG_BLOCKS_LOG("NOT CREATED");
+        telemetry_manager::on_create_failed(telemetry::resource_type::BG_TILES);
 
         if(! optional)
         {
@@ -1409,6 +1414,7 @@ int create_regular_map(const regular_bg_map_item& map_item, regular_bg_tiles_ptr
     else
     {
         BN_BG_BLOCKS_LOG("NOT CREATED");
+        telemetry_manager::on_create_failed(telemetry::resource_type::BG_MAP_CELLS);
 
         if(! optional)
         {
@@ -1463,6 +1469,7 @@ int create_affine_map(const affine_bg_map_item& map_item, affine_bg_tiles_ptr&&
     else
     {
         BN_BG_BLOCKS_LOG("NOT CREATED");
+        telemetry_manager::on_create_failed(telemetry::resource_type::BG_MAP_CELLS);
 
         if(! optional)
         {
@@ -1509,6 +1516,7 @@ int create_new_regular_tiles(const regular_bg_tiles_item& tiles_item, bool optio
     else
     {
         BN_BG_BLOCKS_LOG("NOT CREATED");
+        telemetry_manager::on_create_failed(telemetry::resource_type::BG_TILES);
 
         if(! optional)
         {
@@ -1553,6 +1561,7 @@ int create_new_affine_tiles(const affine_bg_tiles_item& tiles_item, bool optiona
     else
     {
         BN_BG_BLOCKS_LOG("NOT CREATED");
+        telemetry_manager::on_create_failed(telemetry::resource_type::BG_TILES);
 
         if(! optional)
         {
@@ -1602,6 +1611,7 @@ int create_new_regular_map(const regular_bg_map_item& map_item, regular_bg_tiles
     else
     {
         BN_BG_BLOCKS_LOG("NOT CREATED");
+        telemetry_manager::on_create_failed(telemetry::resource_type::BG_MAP_CELLS);
 
         if(! optional)
         {
@@ -1651,6 +1661,7 @@ int create_new_affine_map(const affine_bg_map_item& map_item, affine_bg_tiles_pt
     else
     {
         BN_BG_BLOCKS_LOG("NOT CREATED");
+        telemetry_manager::on_create_failed(telemetry::resource_type::BG_MAP_CELLS);
 
         if(! optional)
         {
@@ -1691,6 +1702,7 @@ int allocate_regular_tiles(int tiles_count, bpp_mode bpp, bool optional)
     else
     {
         BN_BG_BLOCKS_LOG("NOT ALLOCATED");
+        telemetry_manager::on_create_failed(telemetry::resource_type::BG_TILES);
 
         if(! optional)
         {
@@ -1728,6 +1740,7 @@ int allocate_affine_tiles(int tiles_count, bool optional)
     else
     {
         BN_BG_BLOCKS_LOG("NOT ALLOCATED");
+        telemetry_manager::on_create_failed(telemetry::resource_type::BG_TILES);
 
         if(! optional)
         {
@@ -1771,6 +1784,7 @@ int allocate_regular_map(const size& map_dimensions, regular_bg_tiles_ptr&& tile
     else
     {
         BN_BG_BLOCKS_LOG("NOT ALLOCATED");
+        telemetry_manager::on_create_failed(telemetry::resource_type::BG_MAP_CELLS);
 
         if(! optional)
         {
@@ -1815,6 +1829,7 @@ int allocate_affine_map(const size& map_dimensions, affine_bg_tiles_ptr&& tiles,
     else
     {
         BN_BG_BLOCKS_LOG("NOT ALLOCATED");
+        telemetry_manager::on_create_failed(telemetry::resource_type::BG_MAP_CELLS);
 
         if(! optional)
         {
@@ -1853,6 +1868,8 @@ void decrease_usages(int id)
 
     if(! item.usages)
     {
+        telemetry_manager::on_destroy(item.palette ? telemetry::resource_type::BG_MAP_CELLS :
+                                                     telemetry::resource_type::BG_TILES);
         item.set_status(status_type::TO_REMOVE);
         data.to_remove_blocks_count += item.blocks_count;
 
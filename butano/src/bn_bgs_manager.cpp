@@ -13,6 +13,7 @@
 #include "bn_config_bgs.h"
 #include "bn_display_manager.h"
 #include "bn_bg_blocks_manager.h"
+#include "bn_telemetry_manager.h"
 #include "bn_affine_bg_mat_attributes.h"
 #include "../hw/include/bn_hw_bgs.h"
 #include "../hw/include/bn_hw_display.h"
@@ -533,6 +534,7 @@ id_type create(regular_bg_builder&& builder)
     BN_ASSERT(_check_unique_regular_big_map(item), "Two or more regular BGs have the same big map");
 
     _insert_item(item);
+    telemetry_manager::on_create(telemetry::resource_type::BGS);
     return &item;
 }
 
@@ -545,6 +547,7 @@ id_type create(affine_bg_builder&& builder)
     BN_ASSERT(_check_unique_affine_big_map(item), "Two or more affine BGs have the same big map");
 
     _insert_item(item);
+    telemetry_manager::on_create(telemetry::resource_type::BGS);
     return &item;
 }
 
@@ -552,6 +555,7 @@ id_type create_optional(regular_bg_builder&& builder)
 {
     if(data.items_vector.full())
     {
+        telemetry_manager::on_create_failed(telemetry::resource_type::BGS);
         return nullptr;
     }
 
@@ -560,6 +564,7 @@ id_type create_optional(regular_bg_builder&& builder)
 
     if(! map_ptr)
     {
+        telemetry_manager::on_create_failed(telemetry::resource_type::BGS);
         return nullptr;
     }
 
@@ -567,6 +572,7 @@ id_type create_optional(regular_bg_builder&& builder)
     BN_ASSERT(_check_unique_regular_big_map(item), "Two or more regular BGs have the same big map");
 
     _insert_item(item);
+    telemetry_manager::on_create(telemetry::resource_type::BGS);
     return &item;
 }
 
@@ -574,6 +580,7 @@ id_type create_optional(affine_bg_builder&& builder)
 {
     if(data.items_vector.full())
     {
+        telemetry_manager::on_create_failed(telemetry::resource_type::BGS);
         return nullptr;
     }
 
@@ -582,6 +589,7 @@ id_type create_optional(affine_bg_builder&& builder)
 
     if(! map_ptr)
     {
+        telemetry_manager::on_create_failed(telemetry::resource_type::BGS);
         return nullptr;
     }
 
@@ -589,6 +597,7 @@ id_type create_optional(affine_bg_builder&& builder)
     BN_ASSERT(_check_unique_affine_big_map(item), "Two or more affine BGs have the same big map");
 
     _insert_item(item);
+    telemetry_manager::on_create(telemetry::resource_type::BGS);
     return &item;
 }
 
@@ -612,6 +621,7 @@ void decrease_usages(id_type id)
 
         erase(data.items_vector, item);
         data.items_pool.destroy(*item);
+        telemetry_manager::on_destroy(telemetry::resource_type::BGS);
     }
 }
 
@@ -3,13 +3,11 @@
  * zlib License, see LICENSE file.
  */
 
-#include "fr_camera_3d.h"
+#include "bn_camera_3d.h"
 
-#include "bn_math.h"
+#include "bn_math_3d.h"
 
-#include "fr_sin_cos.h"
-
-namespace fr
+namespace bn
 {
 
 camera_3d::camera_3d() :
@@ -25,7 +23,7 @@ void camera_3d::set_position(const point_3d& position)
     _position = position;
 }
 
-void camera_3d::set_phi(bn::fixed phi)
+void camera_3d::set_phi(fixed phi)
 {
     if(phi > 0xFFFF)
     {
@@ -39,8 +37,8 @@ void camera_3d::set_phi(bn::fixed phi)
     BN_ASSERT(phi >= 0 && phi <= 0xFFFF, "Invalid phi: ", phi);
 
     int angle = phi.right_shift_integer();
-    bn::fixed sf = sin(angle);
-    bn::fixed cf = cos(angle);
+    fixed sf = sin_3d(angle);
+    fixed cf = cos_3d(angle);
     _phi = phi;
 
     _u.set_x(cf);
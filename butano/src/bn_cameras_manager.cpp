@@ -10,6 +10,7 @@
 #include "bn_bgs_manager.h"
 #include "bn_sprites_manager.h"
 #include "bn_display_manager.h"
+#include "bn_telemetry_manager.h"
 
 #include "bn_cameras.cpp.h"
 #include "bn_camera_ptr.cpp.h"
@@ -74,6 +75,7 @@ int create(const fixed_point& position)
     item_type& new_item = data.items[item_index];
     new_item.position = position;
     new_item.usages = 1;
+    telemetry_manager::on_create(telemetry::resource_type::CAMERAS);
     return item_index;
 }
 
@@ -81,6 +83,7 @@ int create_optional(const fixed_point& position)
 {
     if(! data.free_item_indexes_size)
     {
+        telemetry_manager::on_create_failed(telemetry::resource_type::CAMERAS);
         return -1;
     }
 
@@ -90,6 +93,7 @@ int create_optional(const fixed_point& position)
     item_type& new_item = data.items[item_index];
     new_item.position = position;
     new_item.usages = 1;
+    telemetry_manager::on_create(telemetry::resource_type::CAMERAS);
     return item_index;
 }
 
@@ -108,6 +112,7 @@ void decrease_usages(int id)
     {
         data.free_item_indexes_array[data.free_item_indexes_size] = uint8_t(id);
         ++data.free_item_indexes_size;
+        telemetry_manager::on_destroy(telemetry::resource_type::CAMERAS);
     }
 }
 
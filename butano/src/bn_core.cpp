@@ -11,6 +11,7 @@
 #include "bn_timers.h"
 #include "bn_version.h"
 #include "bn_profiler.h"
+#include "bn_config_link.h"
 #include "bn_system_font.h"
 #include "bn_bgs_manager.h"
 #include "bn_hdma_manager.h"
@@ -24,8 +25,10 @@
 #include "bn_cameras_manager.h"
 #include "bn_palettes_manager.h"
 #include "bn_bg_blocks_manager.h"
+#include "bn_telemetry_manager.h"
 #include "bn_sprite_tiles_manager.h"
 #include "bn_hblank_effects_manager.h"
+#include "bn_frame_allocator_manager.h"
 #include "../hw/include/bn_hw_irq.h"
 #include "../hw/include/bn_hw_core.h"
 #include "../hw/include/bn_hw_sram.h"
@@ -208,7 +211,7 @@ namespace
         hblank_effects_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
 
-        bool use_dma = ! link_manager::active();
+        bool use_dma = BN_CFG_LINK_DMA_ENABLED || ! link_manager::active();
 
         BN_PROFILER_ENGINE_GENERAL_STOP();
 
@@ -306,6 +309,7 @@ void init(const string_view& keypad_commands)
     // Init storage systems:
     data.slow_game_pak = hw::game_pak::init();
     hw::memory::init();
+    telemetry_manager::init();
 
     [[maybe_unused]] const char* sram_type = hw::sram::init();
 
@@ -354,6 +358,9 @@ void set_skip_frames(int skip_frames)
 
 void update()
 {
+    telemetry_manager::update();
+    frame_allocator_manager::update();
+
     int update_frames = data.skip_frames + 1;
     data.last_update_frames = update_frames;
 
@@ -30,6 +30,8 @@ void play(dmg_music_item item)
 void play(dmg_music_item item, int speed)
 {
     BN_ASSERT(speed >= 1 && speed <= 256, "Speed range is [1..256]: ", speed);
+    BN_ASSERT(speed == 1 || item.type() != dmg_music_type::PRECOMPILED,
+              "Precompiled DMG music speed can't be changed: ", speed);
 
     audio_manager::play_dmg_music(item, speed, true);
 }
@@ -37,6 +39,8 @@ void play(dmg_music_item item, int speed)
 void play(dmg_music_item item, int speed, bool loop)
 {
     BN_ASSERT(speed >= 1 && speed <= 256, "Speed range is [1..256]: ", speed);
+    BN_ASSERT(speed == 1 || item.type() != dmg_music_type::PRECOMPILED,
+              "Precompiled DMG music speed can't be changed: ", speed);
 
     audio_manager::play_dmg_music(item, speed, loop);
 }
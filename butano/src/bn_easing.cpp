@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_easing.h"
+
+#include "bn_array.h"
+#include "bn_sin_lut.h"
+
+namespace bn::easing
+{
+
+namespace
+{
+    constexpr int luts_count = int(easing_type::BOUNCE_OUT);
+    constexpr int lut_steps = lut_size() - 1;
+    constexpr int lut_step_shift = 4;
+    constexpr int one = 4096;
+
+    static_assert(fixed::precision() == 12);
+    static_assert((lut_steps << lut_step_shift) == one);
+
+    [[nodiscard]] constexpr int _round(double value)
+    {
+        return int(value * one + (value >= 0 ? 0.5 : -0.5));
+    }
+
+    [[nodiscard]] constexpr int _bounce_out(double t)
+    {
+        constexpr double n = 7.5625;
+        constexpr double d = 2.75;
+
+        if(t < 1 / d)
+        {
+            return _round(n * t * t);
+        }
+
+        if(t < 2 / d)
+        {
+            t -= 1.5 / d;
+            return _round(n * t * t + 0.75);
+        }
+
+        if(t < 2.5 / d)
+        {
+            t -= 2.25 / d;
+            return _round(n * t * t + 0.9375);
+        }
+
+        t -= 2.625 / d;
+        return _round(n * t * t + 0.984375);
+    }
+
+    [[nodiscard]] constexpr int _lut_value(easing_type easing, int step)
+    {
+        constexpr double back = 1.70158;
+
+        double t = double(step) / lut_steps;
+        double u = 1 - t;
+        int lut_angle = (step * 16384) / lut_steps; // 90 degrees at the end.
+
+        switch(easing)
+        {
+
+        case easing_type::QUAD_IN:
+            return _round(t * t);
+
+        case easing_type::QUAD_OUT:
+            return _round(1 - (u * u));
+
+        case easing_type::QUAD_IN_OUT:
+            return t < 0.5 ? _round(2 * t * t) : _round(1 - (2 * u * u));
+
+        case easing_type::CUBIC_IN:
+            return _round(t * t * t);
+
+        case easing_type::CUBIC_OUT:
+            return _round(1 - (u * u * u));
+
+        case easing_type::CUBIC_IN_OUT:
+            return t < 0.5 ? _round(4 * t * t * t) : _round(1 - (4 * u * u * u));
+
+        case easing_type::SINE_IN:
+            return one - calculate_sin_lut_value(lut_angle + 16384);
+
+        case easing_type::SINE_OUT:
+            return calculate_sin_lut_value(lut_angle);
+
+        case easing_type::SINE_IN_OUT:
+            return (one - calculate_sin_lut_value((lut_angle * 2) + 16384)) / 2;
+
+        case easing_type::BACK_IN:
+            return _round(((back + 1) * t * t * t) - (back * t * t));
+
+        case easing_type::BACK_OUT:
+            return _round(1 - ((back + 1) * u * u * u) + (back * u * u));
+
+        case easing_type::BOUNCE_OUT:
+            return _bounce_out(t);
+
+        default:
+            return (step * one) / lut_steps;
+        }
+    }
+
+    constexpr array<array<int16_t, lut_size()>, luts_count> luts = []{
+        array<array<int16_t, lut_size()>, luts_count> result;
+
+        for(int lut_index = 0; lut_index < luts_count; ++lut_index)
+        {
+            auto easing = easing_type(lut_index + 1);
+            array<int16_t, lut_size()>& lut = result[lut_index];
+
+            for(int step = 0; step < lut_size(); ++step)
+            {
+                lut[step] = int16_t(_lut_value(easing, step));
+            }
+
+            // Curves must start at 0 and end at 1 exactly:
+            lut[0] = 0;
+            lut[lut_steps] = one;
+        }
+
+        return result;
+    }();
+}
+
+fixed apply(easing_type easing, fixed progress)
+{
+    int progress_data = progress.data();
+
+    if(progress_data <= 0)
+    {
+        return 0;
+    }
+
+    if(progress_data >= one)
+    {
+        return 1;
+    }
+
+    if(easing == easing_type::LINEAR)
+    {
+        return progress;
+    }
+
+    const array<int16_t, lut_size()>& lut = luts[int(easing) - 1];
+    int index = progress_data >> lut_step_shift;
+    int fraction = progress_data & ((1 << lut_step_shift) - 1);
+    int first = lut[index];
+    int second = lut[index + 1];
+    return fixed::from_data(first + (((second - first) * fraction) >> lut_step_shift));
+}
+
+}
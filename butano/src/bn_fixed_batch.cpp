@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_fixed_batch.h"
+
+#include "../hw/include/bn_hw_fixed_batch.h"
+
+namespace bn::fixed_batch
+{
+
+void transform(fixed a, fixed b, fixed c, fixed d, const span<const fixed_point>& points,
+               span<fixed_point> output)
+{
+    transform(a, b, c, d, fixed_point(), points, output);
+}
+
+void transform(fixed a, fixed b, fixed c, fixed d, const fixed_point& translation,
+               const span<const fixed_point>& points, span<fixed_point> output)
+{
+    int count = points.size();
+    BN_ASSERT(output.size() == count, "Invalid output size: ", output.size(), " - ", count);
+
+    hw::fixed_batch::transform(a.data(), b.data(), c.data(), d.data(), translation.x().data(),
+                               translation.y().data(), points.data(), count, output.data());
+}
+
+void transform_3d(const array<fixed, 9>& matrix, const span<const fixed>& vectors, span<fixed> output)
+{
+    int size = vectors.size();
+    BN_ASSERT(size % 3 == 0, "Invalid vectors size: ", size);
+    BN_ASSERT(output.size() == size, "Invalid output size: ", output.size(), " - ", size);
+
+    hw::fixed_batch::transform_3d(matrix.data(), vectors.data(), size / 3, output.data());
+}
+
+void project_3d(fixed focal_length, const fixed_point& center, const span<const fixed>& vectors,
+                span<fixed_point> output)
+{
+    int size = vectors.size();
+    BN_ASSERT(focal_length > 0, "Invalid focal length: ", focal_length);
+    BN_ASSERT(size % 3 == 0, "Invalid vectors size: ", size);
+    BN_ASSERT(output.size() == size / 3, "Invalid output size: ", output.size(), " - ", size / 3);
+
+    hw::fixed_batch::project_3d(focal_length.data(), center.x().data(), center.y().data(), vectors.data(),
+                                size / 3, output.data());
+}
+
+}
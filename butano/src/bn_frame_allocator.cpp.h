@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_frame_allocator.h"
+
+#include "bn_frame_allocator_manager.h"
+
+namespace bn::frame_allocator
+{
+
+void* alloc(int bytes, int alignment)
+{
+    return frame_allocator_manager::alloc(bytes, alignment);
+}
+
+int used_bytes()
+{
+    return frame_allocator_manager::used_bytes();
+}
+
+int available_bytes()
+{
+    return frame_allocator_manager::available_bytes();
+}
+
+int max_used_bytes()
+{
+    return frame_allocator_manager::max_used_bytes();
+}
+
+void reset_max_used_bytes()
+{
+    frame_allocator_manager::reset_max_used_bytes();
+}
+
+#if BN_CFG_LOG_ENABLED
+    void log_status()
+    {
+        frame_allocator_manager::log_status();
+    }
+#endif
+
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_frame_allocator_manager.h"
+
+#include "bn_algorithm.h"
+#include "bn_power_of_two.h"
+#include "bn_telemetry_manager.h"
+#include "bn_config_frame_allocator.h"
+
+#if BN_CFG_LOG_ENABLED
+    #include "bn_log.h"
+#endif
+
+#include "bn_frame_allocator.cpp.h"
+
+namespace bn::frame_allocator_manager
+{
+
+namespace
+{
+    static_assert(BN_CFG_FRAME_ALLOCATOR_BYTES > 0);
+    static_assert(BN_CFG_FRAME_ALLOCATOR_BYTES % 4 == 0);
+
+    class static_data
+    {
+
+    public:
+        int used_bytes = 0;
+        int max_used_bytes = 0;
+    };
+
+    BN_DATA_EWRAM static_data data;
+
+    #if BN_CFG_FRAME_ALLOCATOR_IWRAM
+        alignas(int) char buffer[BN_CFG_FRAME_ALLOCATOR_BYTES];
+    #else
+        alignas(int) BN_DATA_EWRAM_BSS char buffer[BN_CFG_FRAME_ALLOCATOR_BYTES];
+    #endif
+}
+
+void* alloc(int bytes, int alignment)
+{
+    BN_ASSERT(bytes >= 0, "Invalid bytes: ", bytes);
+    BN_ASSERT(alignment > 0 && power_of_two(alignment), "Invalid alignment: ", alignment);
+
+    auto buffer_address = uintptr_t(buffer);
+    uintptr_t unaligned_address = buffer_address + uintptr_t(data.used_bytes);
+    uintptr_t aligned_address = (unaligned_address + uintptr_t(alignment) - 1) & ~(uintptr_t(alignment) - 1);
+    int used_bytes = int(aligned_address - buffer_address) + bytes;
+
+    if(used_bytes > BN_CFG_FRAME_ALLOCATOR_BYTES)
+    {
+        telemetry_manager::on_create_failed(telemetry::resource_type::FRAME_ALLOCATOR_BYTES);
+        return nullptr;
+    }
+
+    telemetry_manager::on_create(telemetry::resource_type::FRAME_ALLOCATOR_BYTES);
+    data.used_bytes = used_bytes;
+    data.max_used_bytes = max(data.max_used_bytes, used_bytes);
+    return reinterpret_cast<void*>(aligned_address);
+}
+
+int used_bytes()
+{
+    return data.used_bytes;
+}
+
+int available_bytes()
+{
+    return BN_CFG_FRAME_ALLOCATOR_BYTES - data.used_bytes;
+}
+
+int max_used_bytes()
+{
+    return data.max_used_bytes;
+}
+
+void reset_max_used_bytes()
+{
+    data.max_used_bytes = data.used_bytes;
+}
+
+void update()
+{
+    data.used_bytes = 0;
+}
+
+#if BN_CFG_LOG_ENABLED
+    void log_status()
+    {
+        BN_LOG("used_bytes: ", data.used_bytes);
+        BN_LOG("max_used_bytes: ", data.max_used_bytes);
+        BN_LOG("total_bytes: ", BN_CFG_FRAME_ALLOCATOR_BYTES);
+    }
+#endif
+
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FRAME_ALLOCATOR_MANAGER_H
+#define BN_FRAME_ALLOCATOR_MANAGER_H
+
+#include "bn_config_log.h"
+
+namespace bn::frame_allocator_manager
+{
+    [[nodiscard]] void* alloc(int bytes, int alignment);
+
+    [[nodiscard]] int used_bytes();
+
+    [[nodiscard]] int available_bytes();
+
+    [[nodiscard]] int max_used_bytes();
+
+    void reset_max_used_bytes();
+
+    void update();
+
+    #if BN_CFG_LOG_ENABLED
+        void log_status();
+    #endif
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include "bn_hblank_effects_manager.h"
 
 #include "bn_vector.h"
+#include "bn_telemetry_manager.h"
 #include "../hw/include/bn_hw_hblank_effects.h"
 
 #include "bn_bg_palette_color_hbe_handler.h"
@@ -1077,6 +1078,7 @@ namespace
         if(external_data.free_item_indexes.empty())
         {
             BN_ASSERT(optional, "No more H-Blank effects available");
+            telemetry_manager::on_create_failed(telemetry::resource_type::HBES);
             return -1;
         }
 
@@ -1094,6 +1096,7 @@ namespace
             else
             {
                 BN_ASSERT(optional, "No more 32 bits H-Blank effects available");
+                telemetry_manager::on_create_failed(telemetry::resource_type::HBES);
                 return -1;
             }
         }
@@ -1114,6 +1117,7 @@ namespace
             else
             {
                 BN_ASSERT(optional, "No more 32 bits H-Blank effects available");
+                telemetry_manager::on_create_failed(telemetry::resource_type::HBES);
                 return -1;
             }
         }
@@ -1137,6 +1141,7 @@ namespace
 
         _update_visible_item_index(item_index);
         external_data.update = true;
+        telemetry_manager::on_create(telemetry::resource_type::HBES);
 
         return item_index;
     }
@@ -1238,6 +1243,7 @@ void decrease_usages(int id)
         external_data.free_item_indexes.push_back(int8_t(id));
         item.target_last_value.reset();
         item.update = false;
+        telemetry_manager::on_destroy(telemetry::resource_type::HBES);
     }
 }
 
@@ -27,6 +27,11 @@ void send(int data_to_send)
     hw::link::send(data_to_send + 1);
 }
 
+int pending_messages()
+{
+    return hw::link::pending_messages();
+}
+
 optional<link_state> receive()
 {
     LinkResponse response;
@@ -21,6 +21,8 @@ namespace bn::link_manager
 
     void send(int data_to_send);
 
+    [[nodiscard]] int pending_messages();
+
     [[nodiscard]] optional<link_state> receive();
 
     void deactivate();
@@ -0,0 +1,829 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_link_packets.h"
+
+#include "bn_memory.h"
+#include "bn_link_state.h"
+#include "bn_link_manager.h"
+
+namespace bn
+{
+
+namespace
+{
+    // Packets are sent as a header link message followed by up to 126 payload link messages.
+    //
+    // Header link message: 1 << 15 | payload link messages count << 8 | sequence number.
+    // The last payload link message is a checksum of the previous ones, including the header.
+    // Other payload link messages: 15 bits each (the highest bit is always zero), least significant bit first:
+    //   acks mask (4 bits) | sequence number of the last game state received from each player in the mask (8 bits).
+    //   game state flag (1 bit).
+    //   If the game state flag is set:
+    //     delta flag (1 bit) | baseline sequence number if the delta flag is set (8 bits) | state size (8 bits).
+    //     If the delta flag is set: modified bytes mask (state size bits) | modified bytes (8 bits each).
+    //     Otherwise: state bytes (8 bits each).
+    //   For each message: message flag set (1 bit) | message size (8 bits) | message bytes (8 bits each).
+    //   Message flag unset (1 bit).
+
+    static_assert(BN_CFG_LINK_PACKETS_MAX_STATE_SIZE > 0 && BN_CFG_LINK_PACKETS_MAX_STATE_SIZE <= 128,
+                  "Invalid max link packets state size");
+
+    static_assert(BN_CFG_LINK_PACKETS_BUFFER_SIZE >= link_packets::max_message_size() + 2,
+                  "Invalid link packets buffer size");
+
+    constexpr int header_flag = 1 << 15;
+    constexpr int payload_bits = 15;
+    constexpr int max_payload_words = link_packets::max_packet_words() - 1;
+    constexpr int max_payload_bits = (max_payload_words - 1) * payload_bits;
+    constexpr int connected_frames = 60;
+    constexpr int quiet_resend_frames = 15;
+
+
+    class bit_writer
+    {
+
+    public:
+        explicit bit_writer(ivector<uint16_t>& words) :
+            _words(words)
+        {
+        }
+
+        void write(unsigned value, int bits)
+        {
+            _value |= value << _bits;
+            _bits += bits;
+
+            if(_bits >= payload_bits)
+            {
+                _words.push_back(uint16_t(_value & ((1 << payload_bits) - 1)));
+                _value >>= payload_bits;
+                _bits -= payload_bits;
+            }
+        }
+
+        void flush()
+        {
+            if(_bits)
+            {
+                _words.push_back(uint16_t(_value));
+                _value = 0;
+                _bits = 0;
+            }
+        }
+
+    private:
+        ivector<uint16_t>& _words;
+        unsigned _value = 0;
+        int _bits = 0;
+    };
+
+
+    class bit_reader
+    {
+
+    public:
+        bit_reader(const uint16_t* words, int words_count) :
+            _words(words),
+            _remaining_bits(words_count * payload_bits)
+        {
+        }
+
+        [[nodiscard]] bool failed() const
+        {
+            return _remaining_bits < 0;
+        }
+
+        [[nodiscard]] int remaining_bits() const
+        {
+            return _remaining_bits;
+        }
+
+        [[nodiscard]] unsigned read(int bits)
+        {
+            _remaining_bits -= bits;
+
+            if(_remaining_bits < 0)
+            {
+                return 0;
+            }
+
+            if(_bits < bits)
+            {
+                _value |= unsigned(*_words) << _bits;
+                _bits += payload_bits;
+                ++_words;
+            }
+
+            unsigned result = _value & ((1 << bits) - 1);
+            _value >>= bits;
+            _bits -= bits;
+            return result;
+        }
+
+    private:
+        const uint16_t* _words;
+        unsigned _value = 0;
+        int _bits = 0;
+        int _remaining_bits;
+    };
+
+
+    [[nodiscard]] int _message_bits(int message_size)
+    {
+        return 1 + 8 + (message_size * 8);
+    }
+
+    [[nodiscard]] unsigned _checksum(const uint16_t* words, int words_count, unsigned header)
+    {
+        // Rotate and xor, so missing or swapped link messages are detected:
+        unsigned result = header & 0x7FFF;
+
+        for(int index = 0; index < words_count; ++index)
+        {
+            result = (((result << 1) | (result >> 14)) & 0x7FFF) ^ words[index];
+        }
+
+        return result;
+    }
+}
+
+link_packets::link_packets()
+{
+    for(peer_type& peer : _peers)
+    {
+        for(int16_t& state_seq : peer.state_seqs)
+        {
+            state_seq = -1;
+        }
+    }
+
+    for(int16_t& sent_state_seq : _sent_state_seqs)
+    {
+        sent_state_seq = -1;
+    }
+}
+
+bool link_packets::send(const span<const uint8_t>& message)
+{
+    int message_size = message.size();
+    BN_ASSERT(message_size >= 1 && message_size <= max_message_size(), "Invalid message size: ", message_size);
+
+    if(_pending_messages.available() < message_size + 1)
+    {
+        return false;
+    }
+
+    _pending_messages.push_back(uint8_t(message_size));
+
+    for(uint8_t byte : message)
+    {
+        _pending_messages.push_back(byte);
+    }
+
+    return true;
+}
+
+bool link_packets::receive(int& player_id, ivector<uint8_t>& message)
+{
+    BN_ASSERT(message.max_size() >= max_message_size(), "Invalid message capacity: ", message.max_size());
+
+    if(_received_messages.empty())
+    {
+        return false;
+    }
+
+    int message_size = _received_messages[1];
+    player_id = _received_messages[0];
+    message.clear();
+
+    for(int index = 0; index < message_size; ++index)
+    {
+        message.push_back(_received_messages[index + 2]);
+    }
+
+    _received_messages.erase(_received_messages.begin(), _received_messages.begin() + message_size + 2);
+    return true;
+}
+
+void link_packets::set_state(const span<const uint8_t>& state)
+{
+    int state_size = state.size();
+    BN_ASSERT(state_size >= 1 && state_size <= max_state_size(), "Invalid state size: ", state_size);
+
+    bool changed = state_size != _state_size;
+
+    for(int index = 0; index < state_size; ++index)
+    {
+        uint8_t byte = state[index];
+
+        if(_state[index] != byte)
+        {
+            _state[index] = byte;
+            changed = true;
+        }
+    }
+
+    if(changed)
+    {
+        _state_size = uint8_t(state_size);
+        _state_changed = true;
+    }
+}
+
+span<const uint8_t> link_packets::player_state(int player_id) const
+{
+    BN_ASSERT(player_id >= 0 && player_id <= 3, "Invalid player id: ", player_id);
+
+    const peer_type& peer = _peers[player_id];
+    int state_seq = peer.state_seq;
+
+    if(state_seq < 0)
+    {
+        return span<const uint8_t>();
+    }
+
+    int slot = state_seq % _history_size;
+    return span<const uint8_t>(peer.states[slot], peer.state_sizes[slot]);
+}
+
+void link_packets::update()
+{
+    while(optional<link_state> state = link_manager::receive())
+    {
+        int current_player_id = state->current_player_id();
+
+        for(const link_player& other_player : state->other_players())
+        {
+            push_word(current_player_id, other_player.id(), other_player.data());
+        }
+    }
+
+    flush();
+
+    int available_messages = BN_CFG_LINK_MAX_MESSAGES - link_manager::pending_messages();
+
+    while(available_messages > 0)
+    {
+        optional<int> word = pop_word();
+
+        if(! word)
+        {
+            break;
+        }
+
+        link_manager::send(*word);
+        --available_messages;
+    }
+}
+
+void link_packets::flush()
+{
+    ++_frames;
+
+    if(_output_word_index < _output_words.size())
+    {
+        return;
+    }
+
+    _output_words.clear();
+    _output_word_index = 0;
+
+    // Acks:
+
+    int bits = 4 + 1 + 1;
+    unsigned acks_mask = 0;
+
+    for(int player_id = 0; player_id < 4; ++player_id)
+    {
+        const peer_type& peer = _peers[player_id];
+
+        if(peer.state_seq >= 0 && ! peer.need_full_state)
+        {
+            acks_mask |= 1 << player_id;
+            bits += 8;
+        }
+    }
+
+    // Game state:
+
+    bool send_state = false;
+    int baseline_seq = -1;
+    int state_size = _state_size;
+    uint8_t modified_bytes_mask[BN_CFG_LINK_PACKETS_MAX_STATE_SIZE];
+    int state_bits = 0;
+
+    if(state_size)
+    {
+        send_state = _state_changed;
+
+        if(! send_state)
+        {
+            // Game state is sent again until all players acknowledge a packet which contains it.
+            // Players which have not sent anything for a while (or any player if none of them has been heard yet)
+            // receive it less often, since their acks may have been lost:
+            bool quiet_resend = _frames - _last_state_frame >= quiet_resend_frames;
+            bool peers_heard = false;
+
+            for(const peer_type& peer : _peers)
+            {
+                peers_heard |= peer.last_frame >= 0;
+            }
+
+            for(const peer_type& peer : _peers)
+            {
+                bool resend = _connected(peer) || (quiet_resend && (peer.last_frame >= 0 || ! peers_heard));
+
+                if(resend && (peer.ack < 0 || ((peer.ack - _state_seq) & 0xFF) >= 128))
+                {
+                    send_state = true;
+                    break;
+                }
+            }
+        }
+
+        if(send_state)
+        {
+            baseline_seq = _baseline_seq();
+            state_bits = 1 + 8;
+
+            if(baseline_seq >= 0)
+            {
+                const uint8_t* baseline = _sent_states[baseline_seq % _history_size];
+                state_bits += 8 + state_size;
+
+                for(int index = 0; index < state_size; ++index)
+                {
+                    bool modified = _state[index] != baseline[index];
+                    modified_bytes_mask[index] = modified;
+                    state_bits += modified * 8;
+                }
+            }
+            else
+            {
+                state_bits += state_size * 8;
+            }
+        }
+    }
+
+    // Messages:
+
+    int pending_messages_size = _pending_messages.size();
+    int messages_count = 0;
+    int messages_size = 0;
+
+    if(send_state)
+    {
+        bits += state_bits;
+    }
+
+    if(pending_messages_size)
+    {
+        int first_message_bits = _message_bits(_pending_messages[0]);
+
+        if(send_state && bits + first_message_bits > max_payload_bits)
+        {
+            // If the first message doesn't fit with the game state, they are sent in alternate packets,
+            // so neither of them is delayed forever:
+            if(_message_delayed)
+            {
+                send_state = false;
+                bits -= state_bits;
+                _message_delayed = false;
+            }
+            else
+            {
+                _message_delayed = true;
+            }
+        }
+
+        while(messages_size < pending_messages_size)
+        {
+            int message_size = _pending_messages[messages_size];
+            int message_bits = _message_bits(message_size);
+
+            if(bits + message_bits > max_payload_bits)
+            {
+                break;
+            }
+
+            bits += message_bits;
+            messages_size += message_size + 1;
+            ++messages_count;
+        }
+    }
+
+    if(! send_state && ! messages_count && ! _acks_changed)
+    {
+        return;
+    }
+
+    // Packet:
+
+    int seq = _seq;
+    _seq = uint8_t(seq + 1);
+    _output_words.push_back(0);
+
+    bit_writer writer(_output_words);
+    writer.write(acks_mask, 4);
+
+    for(int player_id = 0; player_id < 4; ++player_id)
+    {
+        if(acks_mask & (1 << player_id))
+        {
+            writer.write(unsigned(_peers[player_id].state_seq), 8);
+        }
+    }
+
+    writer.write(send_state, 1);
+
+    if(send_state)
+    {
+        bool delta = baseline_seq >= 0;
+        writer.write(delta, 1);
+
+        if(delta)
+        {
+            writer.write(unsigned(baseline_seq), 8);
+        }
+
+        writer.write(unsigned(state_size), 8);
+
+        if(delta)
+        {
+            for(int index = 0; index < state_size; ++index)
+            {
+                writer.write(modified_bytes_mask[index], 1);
+            }
+
+            for(int index = 0; index < state_size; ++index)
+            {
+                if(modified_bytes_mask[index])
+                {
+                    writer.write(_state[index], 8);
+                }
+            }
+        }
+        else
+        {
+            for(int index = 0; index < state_size; ++index)
+            {
+                writer.write(_state[index], 8);
+            }
+        }
+
+        int slot = seq % _history_size;
+        memory::copy(_state[0], state_size, _sent_states[slot][0]);
+        _sent_state_seqs[slot] = int16_t(seq);
+        _sent_state_sizes[slot] = uint8_t(state_size);
+        _sent_state_frames[slot] = _frames;
+        _last_state_frame = _frames;
+        if(_state_changed)
+        {
+            _state_seq = int16_t(seq);
+            _state_changed = false;
+        }
+    }
+
+    for(int index = 0; index < messages_size; )
+    {
+        int message_size = _pending_messages[index];
+        writer.write(1, 1);
+        writer.write(unsigned(message_size), 8);
+
+        for(int byte_index = 1; byte_index <= message_size; ++byte_index)
+        {
+            writer.write(_pending_messages[index + byte_index], 8);
+        }
+
+        index += message_size + 1;
+    }
+
+    writer.write(0, 1);
+    writer.flush();
+
+    int payload_words = _output_words.size();
+    unsigned header = unsigned(header_flag | (payload_words << 8) | seq);
+    _output_words[0] = uint16_t(header);
+    _output_words.push_back(uint16_t(_checksum(_output_words.data() + 1, payload_words - 1, header)));
+
+    if(messages_size)
+    {
+        _pending_messages.erase(_pending_messages.begin(), _pending_messages.begin() + messages_size);
+    }
+
+    _acks_changed = false;
+    ++_sent_packets;
+}
+
+optional<int> link_packets::pop_word()
+{
+    optional<int> result;
+    int output_word_index = _output_word_index;
+
+    if(output_word_index < _output_words.size())
+    {
+        result = _output_words[output_word_index];
+        _output_word_index = output_word_index + 1;
+        ++_sent_words;
+    }
+
+    return result;
+}
+
+void link_packets::push_word(int current_player_id, int player_id, int word)
+{
+    BN_ASSERT(current_player_id >= 0 && current_player_id <= 3, "Invalid current player id: ", current_player_id);
+    BN_ASSERT(player_id >= 0 && player_id <= 3, "Invalid player id: ", player_id);
+    BN_ASSERT(word >= 0 && word <= 65533, "Invalid word: ", word);
+
+    _current_player_id = current_player_id;
+    ++_received_words;
+
+    peer_type& peer = _peers[player_id];
+    peer.last_frame = _frames;
+
+    if(word & header_flag)
+    {
+        int seq = word & 0xFF;
+        int last_packet_seq = peer.last_packet_seq;
+
+        if(peer.in_packet)
+        {
+            ++_lost_packets;
+        }
+
+        if(last_packet_seq >= 0)
+        {
+            _lost_packets += (seq - last_packet_seq - 1) & 0xFF;
+        }
+
+        int packet_words = (word >> 8) & 0x7F;
+
+        if(packet_words > max_payload_words)
+        {
+            peer.in_packet = false;
+            return;
+        }
+
+        peer.last_packet_seq = int16_t(seq);
+        peer.packet_seq = int16_t(seq);
+        peer.packet_words = uint8_t(packet_words);
+        peer.received_words = 0;
+        peer.in_packet = true;
+
+        if(! packet_words)
+        {
+            _process_packet(player_id);
+        }
+    }
+    else if(peer.in_packet)
+    {
+        int received_words = peer.received_words;
+        peer.words[received_words] = uint16_t(word);
+        ++received_words;
+        peer.received_words = uint8_t(received_words);
+
+        if(received_words == peer.packet_words)
+        {
+            _process_packet(player_id);
+        }
+    }
+}
+
+void link_packets::reset_stats()
+{
+    _sent_packets = 0;
+    _sent_words = 0;
+    _received_packets = 0;
+    _received_words = 0;
+    _lost_packets = 0;
+    _dropped_messages = 0;
+}
+
+bool link_packets::_connected(const peer_type& peer) const
+{
+    int last_frame = peer.last_frame;
+    return last_frame >= 0 && _frames - last_frame < connected_frames;
+}
+
+int link_packets::_baseline_seq() const
+{
+    int result = -1;
+    int max_age = -1;
+
+    for(int player_id = 0; player_id < 4; ++player_id)
+    {
+        const peer_type& peer = _peers[player_id];
+
+        if(player_id != _current_player_id && _connected(peer))
+        {
+            int ack = peer.ack;
+
+            if(ack < 0)
+            {
+                return -1;
+            }
+
+            int age = (_seq - ack) & 0xFF;
+
+            if(age > max_age)
+            {
+                max_age = age;
+                result = ack;
+            }
+        }
+    }
+
+    if(result < 0 || max_age > _history_size)
+    {
+        return -1;
+    }
+
+    int slot = result % _history_size;
+
+    if(_sent_state_seqs[slot] != result || _sent_state_sizes[slot] != _state_size)
+    {
+        return -1;
+    }
+
+    return result;
+}
+
+void link_packets::_process_packet(int player_id)
+{
+    peer_type& peer = _peers[player_id];
+    int packet_words = peer.packet_words - 1;
+    int seq = peer.packet_seq;
+    unsigned header = unsigned(header_flag | (peer.packet_words << 8) | seq);
+    peer.in_packet = false;
+
+    if(packet_words < 0 || _checksum(peer.words, packet_words, header) != peer.words[packet_words])
+    {
+        ++_lost_packets;
+        return;
+    }
+
+    bit_reader reader(peer.words, packet_words);
+
+    // Acks:
+
+    unsigned acks_mask = reader.read(4);
+    int ack = -1;
+
+    for(int ack_player_id = 0; ack_player_id < 4; ++ack_player_id)
+    {
+        if(acks_mask & (1 << ack_player_id))
+        {
+            int player_ack = int(reader.read(8));
+
+            if(ack_player_id == _current_player_id)
+            {
+                ack = player_ack;
+            }
+        }
+    }
+
+    if(reader.failed())
+    {
+        ++_lost_packets;
+        return;
+    }
+
+    if(ack >= 0 && ack != peer.ack)
+    {
+        int slot = ack % _history_size;
+
+        if(_sent_state_seqs[slot] == ack)
+        {
+            _round_trip_frames = _frames - _sent_state_frames[slot];
+        }
+    }
+
+    peer.ack = int16_t(ack);
+
+    // Game state:
+
+    if(reader.read(1))
+    {
+        bool delta = reader.read(1);
+        int baseline_seq = delta ? int(reader.read(8)) : -1;
+        int state_size = int(reader.read(8));
+
+        if(reader.failed() || state_size < 1 || state_size > max_state_size())
+        {
+            ++_lost_packets;
+            return;
+        }
+
+        int slot = seq % _history_size;
+        uint8_t* state = peer.states[slot];
+        bool valid = true;
+
+        if(delta)
+        {
+            uint8_t modified_bytes_mask[BN_CFG_LINK_PACKETS_MAX_STATE_SIZE];
+
+            for(int index = 0; index < state_size; ++index)
+            {
+                modified_bytes_mask[index] = uint8_t(reader.read(1));
+            }
+
+            int baseline_slot = baseline_seq % _history_size;
+            valid = peer.state_seqs[baseline_slot] == baseline_seq && peer.state_sizes[baseline_slot] == state_size;
+
+            if(valid && baseline_slot != slot)
+            {
+                memory::copy(peer.states[baseline_slot][0], state_size, state[0]);
+            }
+
+            for(int index = 0; index < state_size; ++index)
+            {
+                if(modified_bytes_mask[index])
+                {
+                    auto byte = uint8_t(reader.read(8));
+
+                    if(valid)
+                    {
+                        state[index] = byte;
+                    }
+                }
+            }
+        }
+        else
+        {
+            for(int index = 0; index < state_size; ++index)
+            {
+                state[index] = uint8_t(reader.read(8));
+            }
+        }
+
+        if(reader.failed())
+        {
+            peer.state_seqs[slot] = -1;
+
+            if(peer.state_seq >= 0 && peer.state_seq % _history_size == slot)
+            {
+                peer.state_seq = -1;
+            }
+
+            ++_lost_packets;
+            return;
+        }
+
+        if(valid)
+        {
+            peer.state_seqs[slot] = int16_t(seq);
+            peer.state_sizes[slot] = uint8_t(state_size);
+            peer.state_seq = int16_t(seq);
+            peer.need_full_state = false;
+        }
+        else
+        {
+            // The baseline is not available, so a full game state is requested by not acknowledging it:
+            peer.need_full_state = true;
+        }
+
+        _acks_changed = true;
+    }
+
+    // Messages:
+
+    while(reader.read(1))
+    {
+        int message_size = int(reader.read(8));
+
+        if(reader.failed() || message_size < 1 || message_size > max_message_size() ||
+                reader.remaining_bits() < message_size * 8)
+        {
+            ++_lost_packets;
+            return;
+        }
+
+        if(_received_messages.available() < message_size + 2)
+        {
+            for(int index = 0; index < message_size; ++index)
+            {
+                [[maybe_unused]] unsigned byte = reader.read(8);
+            }
+
+            ++_dropped_messages;
+        }
+        else
+        {
+            _received_messages.push_back(uint8_t(player_id));
+            _received_messages.push_back(uint8_t(message_size));
+
+            for(int index = 0; index < message_size; ++index)
+            {
+                _received_messages.push_back(uint8_t(reader.read(8)));
+            }
+        }
+    }
+
+    ++_received_packets;
+}
+
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_math_3d.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr array<int16_t, sin_3d_lut_size> sin_3d_lut_impl = []{
+        array<int16_t, sin_3d_lut_size> result;
+
+        for(int index = 0; index < sin_3d_lut_size; ++index)
+        {
+            result[index] = int16_t(calculate_sin_lut_value(index));
+        }
+
+        return result;
+    }();
+
+    constexpr array<uint32_t, division_3d_lut_size> division_3d_lut_impl = []{
+        array<uint32_t, division_3d_lut_size> result;
+
+        for(int index = 0; index < division_3d_lut_size; ++index)
+        {
+            result[index] = calculate_division_3d_lut_value(index);
+        }
+
+        return result;
+    }();
+}
+
+const array<int16_t, sin_3d_lut_size>& sin_3d_lut = sin_3d_lut_impl;
+
+const array<uint32_t, division_3d_lut_size>& division_3d_lut = division_3d_lut_impl;
+
+}
@@ -6,6 +6,7 @@
 #include "bn_memory_manager.h"
 
 #include "bn_best_fit_allocator.h"
+#include "bn_telemetry_manager.h"
 #include "../hw/include/bn_hw_memory.h"
 
 #include "bn_memory.cpp.h"
@@ -34,14 +35,31 @@ void init()
     data.allocator.reset(static_cast<void*>(start), end - start);
 }
 
+namespace
+{
+    void* _on_alloc(void* result)
+    {
+        if(result)
+        {
+            telemetry_manager::on_create(telemetry::resource_type::EWRAM_HEAP_BYTES);
+        }
+        else
+        {
+            telemetry_manager::on_create_failed(telemetry::resource_type::EWRAM_HEAP_BYTES);
+        }
+
+        return result;
+    }
+}
+
 void* ewram_alloc(int bytes)
 {
-    return data.allocator.alloc(bytes);
+    return _on_alloc(data.allocator.alloc(bytes));
 }
 
 void* ewram_calloc(int num, int bytes)
 {
-    return data.allocator.calloc(num, bytes);
+    return _on_alloc(data.allocator.calloc(num, bytes));
 }
 
 void* ewram_realloc(void* ptr, int new_bytes)
@@ -51,6 +69,11 @@ void* ewram_realloc(void* ptr, int new_bytes)
 
 void ewram_free(void* ptr)
 {
+    if(ptr)
+    {
+        telemetry_manager::on_destroy(telemetry::resource_type::EWRAM_HEAP_BYTES);
+    }
+
     return data.allocator.free(ptr);
 }
 
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_mode_7.h"
+
+#include "bn_reciprocal_lut.h"
+
+namespace bn
+{
+
+void mode_7::_fill_lines(int camera_x, int camera_y, int camera_z, int cos, int sin, int focal_length,
+                         int horizon_y, line_attributes* lines)
+{
+    // Inputs have 12 bits of precision, reciprocal LUT values have 20 bits of precision
+    // and intermediate values are calculated with 16 bits of precision:
+
+    constexpr int half_width = display::width() / 2;
+    constexpr int hidden_position = -(1 << 27);
+    int64_t camera_x_16 = int64_t(camera_x) << 4;
+    int64_t camera_z_16 = int64_t(camera_z) << 4;
+
+    // HDMA copies the values of each line in the H-Blank of the previous one,
+    // so the values of the first line are stored at the end:
+
+    line_attributes* line = lines + display::height() - 1;
+
+    for(int y = 0; y < display::height(); ++y)
+    {
+        int distance = y - horizon_y;
+
+        if(distance > 0)
+        {
+            int reciprocal = reciprocal_lut[distance].data();
+            int lam = int((int64_t(camera_y) * reciprocal) >> 16);
+            int lcf = int((int64_t(lam) * cos) >> 12);
+            int lsf = int((int64_t(lam) * sin) >> 12);
+            int64_t focal_lcf = (int64_t(focal_length) * lcf) >> 12;
+            int64_t focal_lsf = (int64_t(focal_length) * lsf) >> 12;
+
+            line->pa = int16_t(lcf >> 8);
+            line->pb = 0;
+            line->pc = int16_t(lsf >> 8);
+            line->pd = 0;
+            line->dx = int((camera_x_16 - (int64_t(half_width) * lcf) + focal_lsf) >> 8);
+            line->dy = int((camera_z_16 - (int64_t(half_width) * lsf) - focal_lcf) >> 8);
+        }
+        else
+        {
+            line->pa = 0;
+            line->pb = 0;
+            line->pc = 0;
+            line->pd = 0;
+            line->dx = hidden_position;
+            line->dy = hidden_position;
+        }
+
+        line = y == 0 ? lines : line + 1;
+    }
+}
+
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_mode_7.h"
+
+#include "bn_hdma.h"
+#include "bn_math.h"
+#include "bn_bgs_manager.h"
+#include "../hw/include/bn_hw_bgs.h"
+
+namespace bn
+{
+
+mode_7::mode_7(affine_bg_ptr bg) :
+    _bg(move(bg)),
+    _camera_position(0, 32, 0)
+{
+    _update_fog();
+}
+
+mode_7::~mode_7()
+{
+    if(_hdma_started)
+    {
+        hdma::stop();
+    }
+}
+
+void mode_7::set_camera_position(const point_3d& camera_position)
+{
+    BN_ASSERT(camera_position.y() > 0, "Invalid camera y: ", camera_position.y());
+
+    _camera_position = camera_position;
+}
+
+void mode_7::set_camera_phi(fixed camera_phi)
+{
+    BN_ASSERT(camera_phi >= 0 && camera_phi <= 360, "Invalid camera phi: ", camera_phi);
+
+    _camera_phi = camera_phi;
+}
+
+void mode_7::set_horizon_y(int horizon_y)
+{
+    BN_ASSERT(horizon_y >= 0 && horizon_y < display::height(), "Invalid horizon y: ", horizon_y);
+
+    if(horizon_y != _horizon_y)
+    {
+        _horizon_y = horizon_y;
+        _fog_updated = true;
+    }
+}
+
+void mode_7::set_focal_length(fixed focal_length)
+{
+    BN_ASSERT(focal_length > 0, "Invalid focal length: ", focal_length);
+
+    _focal_length = focal_length;
+}
+
+void mode_7::set_fog_intensity(fixed fog_intensity)
+{
+    BN_ASSERT(fog_intensity >= 0 && fog_intensity <= 1, "Invalid fog intensity: ", fog_intensity);
+
+    if(fog_intensity != _fog_intensity)
+    {
+        _fog_intensity = fog_intensity;
+        _fog_updated = true;
+    }
+}
+
+void mode_7::set_fog_lines(int fog_lines)
+{
+    BN_ASSERT(fog_lines > 0, "Invalid fog lines: ", fog_lines);
+
+    if(fog_lines != _fog_lines)
+    {
+        _fog_lines = fog_lines;
+        _fog_updated = true;
+    }
+}
+
+optional<mode_7::projection> mode_7::project(const fixed_point& world_position) const
+{
+    optional<projection> result;
+    pair<fixed, fixed> sin_and_cos = degrees_lut_sin_and_cos(_camera_phi);
+    fixed sin = sin_and_cos.first;
+    fixed cos = sin_and_cos.second;
+    fixed relative_x = world_position.x() - _camera_position.x();
+    fixed relative_z = world_position.y() - _camera_position.z();
+    fixed v = relative_x.safe_multiplication(sin) - relative_z.safe_multiplication(cos);
+
+    if(v > 0)
+    {
+        fixed u = relative_x.safe_multiplication(cos) + relative_z.safe_multiplication(sin);
+        fixed scale = _focal_length.safe_division(v);
+        fixed x = u.safe_multiplication(scale);
+        fixed y = _camera_position.y().safe_multiplication(scale) + _horizon_y - (display::height() / 2);
+        result = projection{ fixed_point(x, y), scale };
+    }
+
+    return result;
+}
+
+void mode_7::update()
+{
+    pair<fixed, fixed> sin_and_cos = degrees_lut_sin_and_cos(_camera_phi);
+    line_attributes* lines = _lines_a_active ? _lines_b : _lines_a;
+    _fill_lines(_camera_position.x().data(), _camera_position.y().data(), _camera_position.z().data(),
+                sin_and_cos.second.data(), sin_and_cos.first.data(), _focal_length.data(), _horizon_y, lines);
+
+    int hw_id = bgs_manager::hw_id(const_cast<void*>(_bg.handle()));
+
+    if(hw_id >= 0)
+    {
+        auto source_ptr = reinterpret_cast<const uint16_t*>(lines);
+        auto destination_ptr = reinterpret_cast<uint16_t*>(&hw::bgs::affine_mat_register(hw_id)->pa);
+        hdma::start(*source_ptr, sizeof(line_attributes) / 2, *destination_ptr);
+        _lines_a_active = ! _lines_a_active;
+        _hdma_started = true;
+    }
+    else if(_hdma_started)
+    {
+        hdma::stop();
+        _hdma_started = false;
+    }
+
+    if(_fog_updated)
+    {
+        _fog_updated = false;
+        _update_fog();
+    }
+}
+
+void mode_7::_update_fog()
+{
+    fixed fog_intensity = _fog_intensity;
+
+    if(fog_intensity == 0)
+    {
+        if(_fog_hbe)
+        {
+            _fog_hbe.reset();
+            _bg.set_blending_enabled(false);
+        }
+
+        return;
+    }
+
+    int horizon_y = _horizon_y;
+    int fog_lines = _fog_lines;
+
+    for(int y = 0; y < display::height(); ++y)
+    {
+        int distance = y - horizon_y;
+        fixed alpha;
+
+        if(distance < 0)
+        {
+            alpha = fog_intensity;
+        }
+        else if(distance < fog_lines)
+        {
+            alpha = (fog_intensity * (fog_lines - distance)) / fog_lines;
+        }
+
+        _fog_alphas[y] = blending_fade_alpha(alpha);
+    }
+
+    if(_fog_hbe)
+    {
+        _fog_hbe->reload_alphas_ref();
+    }
+    else
+    {
+        _fog_hbe = blending_fade_alpha_hbe_ptr::create(_fog_alphas);
+        _bg.set_blending_enabled(true);
+    }
+}
+
+}
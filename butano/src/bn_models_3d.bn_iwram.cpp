@@ -3,64 +3,58 @@
  * zlib License, see LICENSE file.
  */
 
-#include "fr_models_3d.h"
-
-#include "bn_profiler.h"
-#include "../../butano/hw/include/bn_hw_sprites.h"
-
-#include "fr_div_lut.h"
-#include "fr_camera_3d.h"
-#include "fr_sprite_3d_item.h"
-
-#if FR_DETAILED_PROFILE
-    #define FR_PROFILER_START BN_PROFILER_START
-    #define FR_PROFILER_STOP BN_PROFILER_STOP
-#else
-    #define FR_PROFILER_START(id) \
-        do \
-        { \
-        } while(false)
-
-    #define FR_PROFILER_STOP() \
-        do \
-        { \
-        } while(false)
-#endif
-
-namespace fr
+#include "bn_models_3d.h"
+
+#include "bn_math_3d.h"
+#include "bn_algorithm.h"
+#include "bn_camera_3d.h"
+#include "bn_radix_sort.h"
+#include "bn_sprite_3d_item.h"
+#include "../hw/include/bn_hw_sprites.h"
+
+namespace bn
 {
 
 namespace
 {
     constexpr int fixed_precision = 18;
-    using fixed = bn::fixed_t<fixed_precision>;
+    constexpr int split_length = 64 - 2;
+    using hline_fixed = fixed_t<fixed_precision>;
+
+    [[nodiscard]] uint16_t visible_face_sort_key(int projected_z)
+    {
+        // Farthest faces first. Projected Z values are lower than 2^22 to index the division LUT,
+        // so their 6 lowest bits are discarded to fit them in the 16-bit keys supported by bn::radix_sort.
+        // Faces whose projected Z differs by less than 64 get the same key,
+        // and since the sort is stable, they keep the order in which they were processed.
+        // Negative values are clamped to avoid wrapping around to the farthest keys:
+        return uint16_t(0xFFFF - clamp(projected_z >> 6, 0, 0xFFFF));
+    }
 }
 
 void models_3d::_process_models(const camera_3d& camera)
 {
-    constexpr int display_width = bn::display::width();
-    constexpr int display_height = bn::display::height();
-    constexpr int focal_length_shift = constants_3d::focal_length_shift;
+    constexpr int display_width = display::width();
+    constexpr int display_height = display::height();
     constexpr int near_plane = 24 * 256 * 16;
 
-    point_2d _projected_vertices[_max_vertices];
-    valid_face_info _valid_faces_info[_max_faces];
-    int _visible_face_projected_zs[_max_faces];
-    uint8_t _visible_face_indexes[_max_faces];
+    point_2d _projected_vertices[max_vertices()];
+    valid_face_info _valid_faces_info[max_faces()];
+    uint16_t _visible_face_sort_keys[max_faces()];
+    uint8_t _visible_face_indexes[max_faces()];
+    uint8_t _visible_face_scratch_indexes[max_faces()];
 
     point_3d camera_position = camera.position();
-    bn::fixed camera_phi = camera.phi();
-    bn::fixed camera_u_x = camera.u().x();
-    bn::fixed camera_u_z = camera.u().z();
-    bn::fixed camera_v_x = camera.v().x();
-    bn::fixed camera_v_z = camera.v().z();
+    fixed camera_phi = camera.phi();
+    fixed camera_u_x = camera.u().x();
+    fixed camera_u_z = camera.u().z();
+    fixed camera_v_x = camera.v().x();
+    fixed camera_v_z = camera.v().z();
     int global_vertex_index = 0;
     int valid_faces_count = 0;
 
     // Project static models:
 
-    FR_PROFILER_START("static_project");
-
     for(int static_model_index = _static_models_count - 1; static_model_index >= 0; --static_model_index)
     {
         const model_3d_item* model_item = _static_model_items_ptr[static_model_index];
@@ -72,18 +66,18 @@ void models_3d::_process_models(const camera_3d& camera)
         for(int index = 0; index < model_vertices_count; ++index)
         {
             const point_3d& model_point = model_vertices[index].point();
-            bn::fixed vry = model_point.y() - camera_position.y();
+            fixed vry = model_point.y() - camera_position.y();
             int vcz = -vry.data();
 
             if(near_plane <= vcz) [[likely]]
             {
-                bn::fixed vrx = (model_point.x() - camera_position.x()) / 16;
-                bn::fixed vrz = (model_point.z() - camera_position.z()) / 16;
+                fixed vrx = (model_point.x() - camera_position.x()) / 16;
+                fixed vrz = (model_point.z() - camera_position.z()) / 16;
                 int vcx = (vrx.unsafe_multiplication(camera_u_x) + vrz.unsafe_multiplication(camera_u_z)).data();
                 int vcy = -(vrx.unsafe_multiplication(camera_v_x) + vrz.unsafe_multiplication(camera_v_z)).data();
 
                 // int scale = (1 << (focal_length_shift + 16 + 4)) / vcz;
-                auto scale = int((div_lut_ptr[vcz >> 10] << (focal_length_shift - 8)) >> 6);
+                auto scale = int((division_3d_lut._data[vcz >> 10] << (focal_length_shift - 8)) >> 6);
 
                 *projected_vertices = {
                     int16_t(((vcx * scale) >> 16) + (display_width / 2)),
@@ -128,12 +122,8 @@ void models_3d::_process_models(const camera_3d& camera)
         }
     }
 
-    FR_PROFILER_STOP();
-
     // Project dynamic models:
 
-    FR_PROFILER_START("dynamic_project");
-
     for(model_3d& model : _dynamic_models_list)
     {
         const model_3d_item& model_item = model.item();
@@ -146,18 +136,18 @@ void models_3d::_process_models(const camera_3d& camera)
         for(int index = 0; index < model_vertices_count; ++index)
         {
             point_3d model_point = model.transform(model_vertices[index]);
-            bn::fixed vry = model_point.y() - camera_position.y();
+            fixed vry = model_point.y() - camera_position.y();
             int vcz = -vry.data();
 
             if(near_plane <= vcz) [[likely]]
             {
-                bn::fixed vrx = (model_point.x() - camera_position.x()) / 16;
-                bn::fixed vrz = (model_point.z() - camera_position.z()) / 16;
+                fixed vrx = (model_point.x() - camera_position.x()) / 16;
+                fixed vrz = (model_point.z() - camera_position.z()) / 16;
                 int vcx = (vrx.unsafe_multiplication(camera_u_x) + vrz.unsafe_multiplication(camera_u_z)).data();
                 int vcy = -(vrx.unsafe_multiplication(camera_v_x) + vrz.unsafe_multiplication(camera_v_z)).data();
 
                 // int scale = (1 << (focal_length_shift + 16 + 4)) / vcz;
-                auto scale = int((div_lut_ptr[vcz >> 10] << (focal_length_shift - 8)) >> 6);
+                auto scale = int((division_3d_lut._data[vcz >> 10] << (focal_length_shift - 8)) >> 6);
 
                 *projected_vertices = {
                     int16_t(((vcx * scale) >> 16) + (display_width / 2)),
@@ -202,15 +192,11 @@ void models_3d::_process_models(const camera_3d& camera)
         }
     }
 
-    FR_PROFILER_STOP();
-
     // Cull valid faces:
 
     visible_face_info* visible_faces = _visible_faces_info;
     int visible_faces_count = 0;
 
-    FR_PROFILER_START("cull_valid_faces");
-
     for(int face_index = valid_faces_count - 1; face_index >= 0; --face_index)
     {
         const valid_face_info& valid_face = _valid_faces_info[face_index];
@@ -268,32 +254,28 @@ void models_3d::_process_models(const camera_3d& camera)
                     &valid_face, top_index, minimum_x, maximum_x, minimum_y, maximum_y
                 };
 
-                _visible_face_projected_zs[visible_faces_count] = valid_face.projected_z;
+                _visible_face_sort_keys[visible_faces_count] = visible_face_sort_key(valid_face.projected_z);
                 _visible_face_indexes[visible_faces_count] = visible_faces_count;
                 ++visible_faces_count;
             }
         }
     }
 
-    FR_PROFILER_STOP();
-
     // Project and cull sprites:
 
-    FR_PROFILER_START("sprites");
-
     for(sprite_3d& sprite : _sprites_list)
     {
         const point_3d& sprite_position = sprite.position();
-        bn::fixed vry = sprite_position.y() - camera_position.y();
+        fixed vry = sprite_position.y() - camera_position.y();
         int vcz = -vry.data();
 
         if(near_plane <= vcz) [[likely]]
         {
-            bn::fixed vrx = (sprite_position.x() - camera_position.x()) / 16;
-            bn::fixed vrz = (sprite_position.z() - camera_position.z()) / 16;
+            fixed vrx = (sprite_position.x() - camera_position.x()) / 16;
+            fixed vrz = (sprite_position.z() - camera_position.z()) / 16;
             int vcx = (vrx.unsafe_multiplication(camera_u_x) + vrz.unsafe_multiplication(camera_u_z)).data();
 
-            auto sprite_scale = int((div_lut_ptr[vcz >> 10] << (focal_length_shift - 8)) >> 3);
+            auto sprite_scale = int((division_3d_lut._data[vcz >> 10] << (focal_length_shift - 8)) >> 3);
             auto scale = sprite_scale >> 3;
             int sprite_x = ((vcx * scale) >> 16) + (display_width / 2) - 32;
 
@@ -304,12 +286,12 @@ void models_3d::_process_models(const camera_3d& camera)
 
                 if(sprite_y < display_height && sprite_y + 64 > 0) [[likely]]
                 {
-                    bn::fixed affine_scale = bn::fixed::from_data(sprite_scale).unsafe_multiplication(sprite.scale());
+                    fixed affine_scale = fixed::from_data(sprite_scale).unsafe_multiplication(sprite.scale());
 
                     if(affine_scale > 0) [[likely]]
                     {
                         int degrees = (camera_phi + sprite.theta()).right_shift_integer() * 360;
-                        bn::fixed rotation_angle = bn::fixed::from_data(degrees >> 4);
+                        fixed rotation_angle = fixed::from_data(degrees >> 4);
 
                         if(rotation_angle >= 360)
                         {
@@ -317,23 +299,23 @@ void models_3d::_process_models(const camera_3d& camera)
                         }
 
                         sprite_3d_item& sprite_item = sprite.item();
-                        bn::sprite_affine_mat_ptr& affine_mat = sprite_item.affine_mat();
+                        sprite_affine_mat_ptr& affine_mat = sprite_item.affine_mat();
                         affine_mat.set_scale(affine_scale);
                         affine_mat.set_rotation_angle(rotation_angle);
 
-                        int attr0 = bn::hw::sprites::first_attributes(
-                                    sprite_y, bn::sprite_shape::SQUARE, bn::bpp_mode::BPP_4, 1 << 8,
+                        int attr0 = hw::sprites::first_attributes(
+                                    sprite_y, sprite_shape::SQUARE, bpp_mode::BPP_4, 1 << 8,
                                     true, false, false, false);
-                        int attr1 = bn::hw::sprites::second_attributes(
-                                    sprite_x, bn::sprite_size::HUGE, sprite_item.affine_mat_id());
-                        int attr2 = bn::hw::sprites::third_attributes(
+                        int attr1 = hw::sprites::second_attributes(
+                                    sprite_x, sprite_size::HUGE, sprite_item.affine_mat_id());
+                        int attr2 = hw::sprites::third_attributes(
                                     sprite_item.tiles_id(), sprite_item.palette_id(), 3);
 
                         visible_faces[visible_faces_count] = {
                             nullptr, sprite_y, int16_t(attr0), int16_t(attr1), int16_t(attr2), 0
                         };
 
-                        _visible_face_projected_zs[visible_faces_count] = vcz;
+                        _visible_face_sort_keys[visible_faces_count] = visible_face_sort_key(vcz);
                         _visible_face_indexes[visible_faces_count] = visible_faces_count;
                         ++visible_faces_count;
                     }
@@ -342,7 +324,7 @@ void models_3d::_process_models(const camera_3d& camera)
         }
     }
 
-    FR_PROFILER_STOP();
+    _visible_faces_count = visible_faces_count;
 
     if(! visible_faces_count) [[unlikely]]
     {
@@ -351,21 +333,16 @@ void models_3d::_process_models(const camera_3d& camera)
 
     // Sort visible faces:
 
-    FR_PROFILER_START("sort_visible_faces");
+    const uint16_t* sort_keys = _visible_face_sort_keys;
 
-    const int* projected_zs = _visible_face_projected_zs;
-
-    bn::sort(_visible_face_indexes, _visible_face_indexes + visible_faces_count, [projected_zs](uint8_t a, uint8_t b)
+    radix_sort(_visible_face_indexes, _visible_face_indexes + visible_faces_count, _visible_face_scratch_indexes,
+               [sort_keys](uint8_t index)
     {
-        return projected_zs[a] > projected_zs[b];
+        return sort_keys[index];
     });
 
-    FR_PROFILER_STOP();
-
     // Render visible faces:
 
-    FR_PROFILER_START("render_visible_faces");
-
     _shape_groups.enable_drawing();
 
     for(int visible_face_index = visible_faces_count - 1; visible_face_index >= 0; --visible_face_index)
@@ -380,7 +357,7 @@ void models_3d::_process_models(const camera_3d& camera)
             int minimum_y = visible_face.minimum_y;
             int maximum_y = visible_face.maximum_y;
 
-            shape_groups::hline hlines[bn::display::height()];
+            shape_groups::hline hlines[display::height()];
             bool x_outside = false;
 
             if(minimum_x < 0)
@@ -462,12 +439,12 @@ void models_3d::_process_models(const camera_3d& camera)
                     right_bottom = right_bottom->prev;
                 }
 
-                fixed xl = left_top->x;
-                fixed xr = right_top->x;
+                hline_fixed xl = left_top->x;
+                hline_fixed xr = right_top->x;
 
-                fixed left_delta = unsafe_unsigned_lut_division<fixed_precision>(
+                hline_fixed left_delta = unsafe_unsigned_lut_division_3d<fixed_precision>(
                             left_bottom->x - left_top->x, left_bottom->y - left_top->y);
-                fixed right_delta = unsafe_unsigned_lut_division<fixed_precision>(
+                hline_fixed right_delta = unsafe_unsigned_lut_division_3d<fixed_precision>(
                             right_bottom->x - right_top->x, right_bottom->y - right_top->y);
 
                 while(true)
@@ -527,7 +504,7 @@ void models_3d::_process_models(const camera_3d& camera)
                                 delta_y = left_bottom->y - left_top->y;
                             }
 
-                            left_delta = unsafe_unsigned_lut_division<fixed_precision>(
+                            left_delta = unsafe_unsigned_lut_division_3d<fixed_precision>(
                                         left_bottom->x - left_top->x, delta_y);
                             xl = left_top->x + left_delta;
                         }
@@ -546,7 +523,7 @@ void models_3d::_process_models(const camera_3d& camera)
                                 delta_y = right_bottom->y - right_top->y;
                             }
 
-                            right_delta = unsafe_unsigned_lut_division<fixed_precision>(
+                            right_delta = unsafe_unsigned_lut_division_3d<fixed_precision>(
                                         right_bottom->x - right_top->x, delta_y);
                             xr = right_top->x + right_delta;
                         }
@@ -587,7 +564,288 @@ void models_3d::_process_models(const camera_3d& camera)
         }
     }
 
-    FR_PROFILER_STOP();
+}
+
+void models_3d::shape_groups::add_hlines(unsigned minimum_y, unsigned maximum_y, int width, bool x_outside,
+                                         int color_index, unsigned shading, const hline* hlines)
+{
+    const color_tiles_ids& tiles_ids = _color_tiles_ids[color_index];
+    uint8_t palette_id = _palette_ids[shading];
+    int attr1;
+    int attr2;
+    bool split;
+
+    if(width < 8)
+    {
+        attr1 = hw::sprites::second_attributes(0, sprite_size::SMALL, false, false);
+        attr2 = hw::sprites::third_attributes(tiles_ids.small_tiles_id, palette_id, 3);
+        split = false;
+    }
+    else if(width < 16)
+    {
+        attr1 = hw::sprites::second_attributes(0, sprite_size::NORMAL, false, false);
+        attr2 = hw::sprites::third_attributes(tiles_ids.normal_tiles_id, palette_id, 3);
+        split = false;
+    }
+    else if(width < 32)
+    {
+        attr1 = hw::sprites::second_attributes(0, sprite_size::BIG, false, false);
+        attr2 = hw::sprites::third_attributes(tiles_ids.big_tiles_id, palette_id, 3);
+        split = false;
+    }
+    else
+    {
+        attr1 = hw::sprites::second_attributes(0, sprite_size::HUGE, false, false);
+        attr2 = hw::sprites::third_attributes(tiles_ids.huge_tiles_id, palette_id, 3);
+        split = width > split_length;
+    }
+
+    uint16_t* hdma_source = _hdma_source;
+    int screen_line_elements = _max_hdma_sprites * 4;
+
+    if(! split) [[likely]]
+    {
+        if(x_outside) [[unlikely]]
+        {
+            for(unsigned y = minimum_y; y <= maximum_y; ++y)
+            {
+                int xl = hlines[y].xl;
+
+                if(xl < display::width()) [[likely]]
+                {
+                    int xr = hlines[y].xr;
+
+                    if(xr >= 0) [[likely]]
+                    {
+                        int hlines_count = _hlines_count[y];
+
+                        if(hlines_count < _max_hdma_sprites) [[likely]]
+                        {
+                            _hlines_count[y] = hlines_count + 1;
+
+                            uint16_t* sprite_hdma_source = hdma_source + (y * screen_line_elements);
+                            sprite_hdma_source += hlines_count * 4;
+
+                            if(xl < 0)
+                            {
+                                xl = 0;
+                            }
+
+                            if(xr > display::width() - 1)
+                            {
+                                xr = display::width() - 1;
+                            }
+
+                            int length = xr - xl;
+                            int sprite_y = int(y) - length;
+                            sprite_hdma_source[0] = hw::sprites::first_attributes(
+                                        sprite_y, sprite_shape::SQUARE, bpp_mode::BPP_4, 0,
+                                        true, false, false, false);
+
+                            sprite_hdma_source[1] = attr1 + xl;
+
+                            sprite_hdma_source[2] = attr2;
+                        }
+                    }
+                }
+            }
+        }
+        else
+        {
+            for(unsigned y = minimum_y; y <= maximum_y; ++y)
+            {
+                int hlines_count = _hlines_count[y];
+
+                if(hlines_count < _max_hdma_sprites) [[likely]]
+                {
+                    _hlines_count[y] = hlines_count + 1;
+
+                    uint16_t* sprite_hdma_source = hdma_source + (y * screen_line_elements);
+                    sprite_hdma_source += hlines_count * 4;
+
+                    int xl = hlines[y].xl;
+                    int xr = hlines[y].xr;
+                    int length = xr - xl;
+                    int sprite_y = int(y) - length;
+                    sprite_hdma_source[0] = hw::sprites::first_attributes(
+                                sprite_y, sprite_shape::SQUARE, bpp_mode::BPP_4, 0,
+                                true, false, false, false);
+
+                    sprite_hdma_source[1] = attr1 + xl;
+
+                    sprite_hdma_source[2] = attr2;
+                }
+            }
+        }
+    }
+    else
+    {
+        if(x_outside) [[unlikely]]
+        {
+            for(unsigned y = minimum_y; y <= maximum_y; ++y)
+            {
+                int xl = hlines[y].xl;
+
+                if(xl < display::width()) [[likely]]
+                {
+                    int xr = hlines[y].xr;
+
+                    if(xr >= 0) [[likely]]
+                    {
+                        if(xl < 0)
+                        {
+                            xl = 0;
+                        }
+
+                        if(xr > display::width() - 1)
+                        {
+                            xr = display::width() - 1;
+                        }
+
+                        int hlines_count = _hlines_count[y];
+                        uint16_t* sprite_hdma_source = hdma_source + (y * screen_line_elements);
+                        sprite_hdma_source += hlines_count * 4;
+
+                        bool keep_adding;
+
+                        do
+                        {
+                            if(hlines_count < _max_hdma_sprites) [[likely]]
+                            {
+                                int length = xr - xl;
+                                int sprite_y;
+                                keep_adding = length > split_length;
+                                ++hlines_count;
+
+                                if(keep_adding)
+                                {
+                                    sprite_y = int(y) - split_length;
+                                }
+                                else
+                                {
+                                    sprite_y = int(y) - length;
+                                }
+
+                                sprite_hdma_source[0] = hw::sprites::first_attributes(
+                                            sprite_y, sprite_shape::SQUARE, bpp_mode::BPP_4, 0,
+                                            true, false, false, false);
+
+                                sprite_hdma_source[1] = attr1 + xl;
+
+                                sprite_hdma_source[2] = attr2;
+
+                                xl += split_length;
+                                sprite_hdma_source += 4;
+                            }
+                            else
+                            {
+                                keep_adding = false;
+                            }
+                        }
+                        while(keep_adding);
+
+                        _hlines_count[y] = hlines_count;
+                    }
+                }
+            }
+        }
+        else
+        {
+            for(unsigned y = minimum_y; y <= maximum_y; ++y)
+            {
+                int xl = hlines[y].xl;
+                int xr = hlines[y].xr;
+
+                int hlines_count = _hlines_count[y];
+                uint16_t* sprite_hdma_source = hdma_source + (y * screen_line_elements);
+                sprite_hdma_source += hlines_count * 4;
+
+                bool keep_adding;
+
+                do
+                {
+                    if(hlines_count < _max_hdma_sprites) [[likely]]
+                    {
+                        int length = xr - xl;
+                        int sprite_y;
+                        keep_adding = length > split_length;
+                        ++hlines_count;
+
+                        if(keep_adding) [[likely]]
+                        {
+                            sprite_y = int(y) - split_length;
+                        }
+                        else
+                        {
+                            sprite_y = int(y) - length;
+                        }
+
+                        sprite_hdma_source[0] = hw::sprites::first_attributes(
+                                    sprite_y, sprite_shape::SQUARE, bpp_mode::BPP_4, 0,
+                                    true, false, false, false);
+
+                        sprite_hdma_source[1] = attr1 + xl;
+
+                        sprite_hdma_source[2] = attr2;
+
+                        xl += split_length;
+                        sprite_hdma_source += 4;
+                    }
+                    else
+                    {
+                        keep_adding = false;
+                    }
+                }
+                while(keep_adding);
+
+                _hlines_count[y] = hlines_count;
+            }
+        }
+    }
+}
+
+void models_3d::shape_groups::add_sprite(unsigned minimum_y, unsigned maximum_y, uint16_t attr0, uint16_t attr1,
+                                         uint16_t attr2)
+{
+    uint16_t* hdma_source = _hdma_source;
+    int screen_line_elements = _max_hdma_sprites * 4;
+
+    for(unsigned y = minimum_y; y <= maximum_y; ++y)
+    {
+        int hlines_count = _hlines_count[y];
+
+        if(hlines_count < _max_hdma_sprites) [[likely]]
+        {
+            _hlines_count[y] = hlines_count + 1;
+
+            uint16_t* sprite_hdma_source = hdma_source + (y * screen_line_elements);
+            sprite_hdma_source += hlines_count * 4;
+
+            sprite_hdma_source[0] = attr0;
+
+            sprite_hdma_source[1] = attr1;
+
+            sprite_hdma_source[2] = attr2;
+        }
+    }
+}
+
+void models_3d::shape_groups::_hide_left_hlines(const uint8_t* previous_hlines_count)
+{
+    uint16_t* hdma_source = _hdma_source;
+    int screen_line_elements = _max_hdma_sprites * 4;
+
+    for(int y = 0; y < display::height(); ++y)
+    {
+        uint16_t* sprite_hdma_source = hdma_source + (y * screen_line_elements);
+        int hlines_count = _hlines_count[y];
+        int hlines_previous_count = previous_hlines_count[y];
+
+        for(int hlines_index = hlines_count; hlines_index < hlines_previous_count; ++hlines_index)
+        {
+            sprite_hdma_source[hlines_index * 4] = ATTR0_HIDE;
+        }
+    }
 }
 
 }
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_models_3d.h"
+
+#include "bn_hdma.h"
+#include "bn_colors.h"
+#include "bn_sprites.h"
+#include "bn_optional.h"
+#include "../hw/include/bn_hw_sprites.h"
+
+namespace bn
+{
+
+namespace
+{
+    [[nodiscard]] color _brightness_color(color input_color, int brightness)
+    {
+        int red = (input_color.red() * brightness) / 32;
+        int green = (input_color.green() * brightness) / 32;
+        int blue = (input_color.blue() * brightness) / 32;
+        int color_value = red + (green << 5) + (blue << 10);
+        return color(color_value);
+    }
+
+    // Each color is drawn with square sprites whose bottom-left triangle is filled with the color palette index,
+    // so the y coordinate of each sprite (relative to its screen line) selects the visible width of the line:
+    [[nodiscard]] sprite_tiles_ptr _create_staircase_tiles(int color_index, int dimension)
+    {
+        int tiles_per_row = dimension / 8;
+        int tiles_count = tiles_per_row * tiles_per_row;
+        sprite_tiles_ptr result = sprite_tiles_ptr::allocate(tiles_count, bpp_mode::BPP_4);
+        optional<span<tile>> tiles_vram = result.vram();
+        tile* tiles_data = tiles_vram->data();
+        uint32_t color_value = unsigned(color_index + 1);
+        uint32_t solid_row = color_value * 0x11111111;
+
+        for(int tile_y = 0; tile_y < tiles_per_row; ++tile_y)
+        {
+            for(int tile_x = 0; tile_x < tiles_per_row; ++tile_x)
+            {
+                tile& tile_data = tiles_data[(tile_y * tiles_per_row) + tile_x];
+
+                for(int row = 0; row < 8; ++row)
+                {
+                    uint32_t row_value;
+
+                    if(tile_x < tile_y)
+                    {
+                        row_value = solid_row;
+                    }
+                    else if(tile_x > tile_y)
+                    {
+                        row_value = 0;
+                    }
+                    else
+                    {
+                        int filled_pixels = row + 1;
+                        row_value = filled_pixels == 8 ? solid_row : solid_row & ((1u << (filled_pixels * 4)) - 1);
+                    }
+
+                    tile_data.data[row] = row_value;
+                }
+            }
+        }
+
+        return result;
+    }
+}
+
+void models_3d::set_static_model_items(const model_3d_item** static_model_items_ptr, int static_models_count)
+{
+    BN_ASSERT(static_models_count <= max_static_models(), "There's no space for more static models");
+
+    int static_vertices_count = 0;
+    int static_faces_count = 0;
+    _static_models_count = static_models_count;
+
+    for(int index = 0; index < static_models_count; ++index)
+    {
+        const model_3d_item* static_model_item = static_model_items_ptr[index];
+        static_vertices_count += static_model_item->vertices().size();
+        static_faces_count += static_model_item->faces().size();
+    }
+
+    _vertices_count = _vertices_count - _static_vertices_count + static_vertices_count;
+    _static_vertices_count = static_vertices_count;
+    BN_ASSERT(_vertices_count <= max_vertices(), "There's no space for more vertices");
+
+    _faces_count = _faces_count - _static_faces_count + static_faces_count;
+    _static_faces_count = static_faces_count;
+    BN_ASSERT(_faces_count <= max_faces(), "There's no space for more faces");
+
+    _static_model_items_ptr = static_model_items_ptr;
+}
+
+model_3d& models_3d::create_dynamic_model(const model_3d_item& model_item)
+{
+    int model_vertices_count = model_item.vertices().size();
+    int model_faces_count = model_item.faces().size();
+    BN_ASSERT(! _dynamic_models_pool.full(), "There's no space for more dynamic models");
+    BN_ASSERT(model_vertices_count + _vertices_count <= max_vertices(), "There's no space for more vertices");
+    BN_ASSERT(model_faces_count + _faces_count <= max_faces(), "There's no space for more faces");
+
+    model_3d& result = _dynamic_models_pool.create(model_item);
+    _dynamic_models_list.push_back(result);
+    _vertices_count += model_vertices_count;
+    _faces_count += model_faces_count;
+    return result;
+}
+
+void models_3d::destroy_dynamic_model(model_3d& model)
+{
+    const model_3d_item& model_item = model.item();
+    _vertices_count -= model_item.vertices().size();
+    _faces_count -= model_item.faces().size();
+    _dynamic_models_list.erase(model);
+    _dynamic_models_pool.destroy(model);
+}
+
+sprite_3d& models_3d::create_sprite(sprite_3d_item& sprite_item)
+{
+    BN_ASSERT(! _sprites_pool.full(), "There's no space for more dynamic sprites");
+    BN_ASSERT(1 + _vertices_count <= max_vertices(), "There's no space for more vertices");
+    BN_ASSERT(1 + _faces_count <= max_faces(), "There's no space for more faces");
+
+    sprite_3d& result = _sprites_pool.create(sprite_item);
+    _sprites_list.push_back(result);
+    _vertices_count += 1;
+    _faces_count += 1;
+    return result;
+}
+
+void models_3d::destroy_sprite(sprite_3d& sprite)
+{
+    _vertices_count -= 1;
+    _faces_count -= 1;
+    _sprites_list.erase(sprite);
+    _sprites_pool.destroy(sprite);
+}
+
+void models_3d::update(const camera_3d& camera)
+{
+    _process_models(camera);
+    _shape_groups.update();
+}
+
+models_3d::shape_groups::shape_groups()
+{
+    for(int index = 0; index < _hdma_source_size; index += 4)
+    {
+        hw::sprites::hide_and_destroy(_hdma_source_a[index]);
+        hw::sprites::hide_and_destroy(_hdma_source_b[index]);
+    }
+}
+
+void models_3d::shape_groups::load_colors(const span<const color>& colors)
+{
+    int colors_count = colors.size();
+    BN_ASSERT(colors_count <= face_3d::max_colors, "Invalid colors count: ", colors_count);
+
+    if(! colors_count)
+    {
+        _color_tiles.clear();
+        _palettes.clear();
+        return;
+    }
+
+    int color_tiles_count = colors_count;
+    int current_color_tiles_count = _color_tiles.size();
+    bool reload_palettes;
+
+    if(current_color_tiles_count < color_tiles_count)
+    {
+        reload_palettes = true;
+
+        for(int index = current_color_tiles_count; index < color_tiles_count; ++index)
+        {
+            _color_tiles.emplace_back(index);
+            _color_tiles_ids[index].load(_color_tiles.back());
+        }
+    }
+    else
+    {
+        if(current_color_tiles_count > color_tiles_count)
+        {
+            _color_tiles.shrink(color_tiles_count);
+        }
+
+        reload_palettes = colors != span<const color>(_colors, colors_count);
+    }
+
+    if(reload_palettes)
+    {
+        color palettes_colors[_max_palettes][16];
+
+        for(int color_index = 0; color_index < colors_count; ++color_index)
+        {
+            color model_color = colors[color_index];
+            _colors[color_index] = model_color;
+
+            int palette_color_index = color_index + 1;
+            int brightness = 32 - 7;
+
+            for(color* palette_colors : palettes_colors)
+            {
+                palette_colors[palette_color_index] = _brightness_color(model_color, brightness);
+                ++brightness;
+            }
+        }
+
+        if(_palettes.empty())
+        {
+            for(int palette_index = 0; palette_index < _max_palettes; ++palette_index)
+            {
+                sprite_palette_item palette_item(palettes_colors[palette_index], bpp_mode::BPP_4);
+                sprite_palette_ptr palette = palette_item.create_new_palette();
+                _palette_ids[palette_index] = palette.id();
+                _palettes.push_back(move(palette));
+            }
+        }
+        else
+        {
+            for(int palette_index = 0; palette_index < _max_palettes; ++palette_index)
+            {
+                sprite_palette_item palette_item(palettes_colors[palette_index], bpp_mode::BPP_4);
+                _palettes[palette_index].set_colors(palette_item);
+            }
+        }
+    }
+}
+
+void models_3d::shape_groups::set_fade(color color, fixed intensity)
+{
+    for(sprite_palette_ptr& palette : _palettes)
+    {
+        palette.set_fade(color, intensity);
+    }
+}
+
+void models_3d::shape_groups::update()
+{
+    if(_draw_enabled)
+    {
+        uint16_t* hdma_source = _hdma_source;
+        _draw_enabled = false;
+
+        if(hdma_source == _hdma_source_a)
+        {
+            _hide_left_hlines(_previous_hlines_count_a);
+        }
+        else
+        {
+            _hide_left_hlines(_previous_hlines_count_b);
+        }
+
+        int max_sprites = _max_hdma_sprites;
+        int screen_line_elements = max_sprites * 4;
+        memory::copy(hdma_source[0], screen_line_elements,
+                         hdma_source[display::height() * screen_line_elements]);
+        hdma::start(hdma_source[screen_line_elements], screen_line_elements,
+                        hw::sprites::vram()[128 - max_sprites].attr0);
+
+        if(hdma_source == _hdma_source_a)
+        {
+            memory::copy(*_hlines_count, display::height(), *_previous_hlines_count_a);
+            _hdma_source = _hdma_source_b;
+        }
+        else
+        {
+            memory::copy(*_hlines_count, display::height(), *_previous_hlines_count_b);
+            _hdma_source = _hdma_source_a;
+        }
+
+        memory::clear(display::height(), *_hlines_count);
+    }
+    else
+    {
+        _clear();
+    }
+}
+
+void models_3d::shape_groups::_clear()
+{
+    if(hdma::running())
+    {
+        hdma::stop();
+        sprites::reload();
+    }
+}
+
+models_3d::shape_groups::color_tiles::color_tiles(int color_index) :
+    small_tiles(_create_staircase_tiles(color_index, 8)),
+    normal_tiles(_create_staircase_tiles(color_index, 16)),
+    big_tiles(_create_staircase_tiles(color_index, 32)),
+    huge_tiles(_create_staircase_tiles(color_index, 64))
+{
+}
+
+void models_3d::shape_groups::color_tiles_ids::load(const color_tiles& color_tiles)
+{
+    small_tiles_id = color_tiles.small_tiles.id();
+    normal_tiles_id = color_tiles.normal_tiles.id();
+    big_tiles_id = color_tiles.big_tiles.id();
+    huge_tiles_id = color_tiles.huge_tiles.id();
+}
+
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_polygon_rasterizer.h"
+
+namespace bn
+{
+
+void polygon_rasterizer::_add_edge(int x0, int y0, int x1, int y1)
+{
+    if(y0 == y1)
+    {
+        return;
+    }
+
+    if(y0 > y1)
+    {
+        swap(x0, x1);
+        swap(y0, y1);
+    }
+
+    // Scanlines whose pixel centers are inside [y0, y1):
+
+    constexpr int precision = fixed::precision();
+    constexpr int scale = fixed::scale();
+    constexpr int half_scale = scale / 2;
+    int first_y = (y0 - half_scale + scale - 1) >> precision;
+    int last_y = (y1 - half_scale + scale - 1) >> precision;
+
+    if(first_y < 0)
+    {
+        first_y = 0;
+    }
+
+    if(last_y > display::height())
+    {
+        last_y = display::height();
+    }
+
+    if(first_y >= last_y)
+    {
+        return;
+    }
+
+    if(first_y < _minimum_y)
+    {
+        _minimum_y = first_y;
+    }
+
+    if(last_y - 1 > _maximum_y)
+    {
+        _maximum_y = last_y - 1;
+    }
+
+    // x is stored with 16 bits of precision, biased to round pixel centers up (top-left fill rule):
+
+    constexpr int x_precision = 16;
+    constexpr int x_shift = x_precision - precision;
+    int64_t slope = (int64_t(x1 - x0) << x_precision) / (y1 - y0);
+    int first_center_y = (first_y << precision) + half_scale;
+    int x = (x0 << x_shift) + int((int64_t(first_center_y - y0) * slope) >> precision);
+    x += (1 << (x_precision - 1)) - 1;
+
+    hline* current_hline = _hlines + first_y;
+    const hline* last_hline = _hlines + last_y;
+
+    while(true)
+    {
+        int pixel_x = x >> x_precision;
+
+        if(pixel_x < 0)
+        {
+            pixel_x = 0;
+        }
+        else if(pixel_x > display::width())
+        {
+            pixel_x = display::width();
+        }
+
+        if(pixel_x < current_hline->xl)
+        {
+            current_hline->xl = int16_t(pixel_x);
+        }
+
+        if(pixel_x > current_hline->xr)
+        {
+            current_hline->xr = int16_t(pixel_x);
+        }
+
+        ++current_hline;
+
+        if(current_hline == last_hline)
+        {
+            return;
+        }
+
+        // Edges which cover more than one scanline are taller than one pixel, so slope fits in an int:
+        x += int(slope);
+    }
+}
+
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_polygon_rasterizer.h"
+
+#include "../hw/include/bn_hw_display.h"
+
+namespace bn
+{
+
+polygon_rasterizer::polygon_rasterizer() :
+    _minimum_y(0),
+    _maximum_y(display::height() - 1)
+{
+    clear();
+}
+
+void polygon_rasterizer::add_polygon(const span<const fixed_point>& vertices)
+{
+    int vertices_count = vertices.size();
+    BN_ASSERT(vertices_count >= 3, "Invalid vertices count: ", vertices_count);
+
+    const fixed_point* vertices_data = vertices.data();
+    const fixed_point* previous_vertex = vertices_data + vertices_count - 1;
+
+    for(int index = 0; index < vertices_count; ++index)
+    {
+        const fixed_point* vertex = vertices_data + index;
+        _add_edge(previous_vertex->x().data(), previous_vertex->y().data(), vertex->x().data(), vertex->y().data());
+        previous_vertex = vertex;
+    }
+}
+
+void polygon_rasterizer::clear()
+{
+    for(int y = _minimum_y; y <= _maximum_y; ++y)
+    {
+        hline& current_hline = _hlines[y];
+        current_hline.xl = display::width();
+        current_hline.xr = 0;
+    }
+
+    _minimum_y = display::height();
+    _maximum_y = -1;
+}
+
+void polygon_rasterizer::fill_sprite_position_values(span<fixed> vertical_values,
+                                                     span<fixed> horizontal_values) const
+{
+    BN_ASSERT(vertical_values.size() == display::height(), "Invalid vertical values size: ",
+              vertical_values.size());
+    BN_ASSERT(horizontal_values.size() == display::height(), "Invalid horizontal values size: ",
+              horizontal_values.size());
+
+    fixed* vertical_values_data = vertical_values.data();
+    fixed* horizontal_values_data = horizontal_values.data();
+    fixed invalid_y = display::height();
+
+    for(int y = 0; y < display::height(); ++y)
+    {
+        const hline& current_hline = _hlines[y];
+
+        if(current_hline.empty())
+        {
+            vertical_values_data[y] = invalid_y;
+        }
+        else
+        {
+            vertical_values_data[y] = y + 1 - current_hline.size();
+            horizontal_values_data[y] = current_hline.xl;
+        }
+    }
+}
+
+void polygon_rasterizer::fill_window_horizontal_boundaries(span<pair<fixed, fixed>> values) const
+{
+    BN_ASSERT(values.size() == display::height(), "Invalid values size: ", values.size());
+
+    pair<fixed, fixed>* values_data = values.data();
+
+    for(int y = 0; y < display::height(); ++y)
+    {
+        const hline& current_hline = _hlines[y];
+
+        if(current_hline.empty())
+        {
+            values_data[y] = pair<fixed, fixed>();
+        }
+        else
+        {
+            values_data[y] = pair<fixed, fixed>(current_hline.xl, current_hline.xr);
+        }
+    }
+}
+
+void polygon_rasterizer::fill_window_horizontal_boundaries_hdma_values(span<uint16_t> values) const
+{
+    BN_ASSERT(values.size() == display::height(), "Invalid values size: ", values.size());
+
+    uint16_t* values_data = values.data();
+
+    for(int y = 0; y < display::height(); ++y)
+    {
+        const hline& current_hline = _hlines[y];
+
+        if(current_hline.empty())
+        {
+            hw::display::set_window_boundaries(0, 0, values_data[y]);
+        }
+        else
+        {
+            hw::display::set_window_boundaries(current_hline.xl, current_hline.xr, values_data[y]);
+        }
+    }
+}
+
+}
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_regular_bg_text_generator.h"
+
+#include "bn_size.h"
+#include "bn_memory.h"
+#include "bn_utf8_character.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_regular_bg_map_cell_info.h"
+
+namespace bn
+{
+
+namespace
+{
+    static_assert(regular_bg_text_generator::columns == 32);
+    static_assert(regular_bg_text_generator::rows == 32);
+
+    [[nodiscard]] regular_bg_tiles_ptr _allocate_tiles(int max_tiles)
+    {
+        BN_ASSERT(max_tiles >= 2 && max_tiles <= 1024, "Invalid max tiles: ", max_tiles);
+
+        return regular_bg_tiles_ptr::allocate(max_tiles, bpp_mode::BPP_4);
+    }
+
+    [[nodiscard]] bg_palette_item _palette_item(const sprite_font& font)
+    {
+        const sprite_palette_item& palette_item = font.item().palette_item();
+        return bg_palette_item(palette_item.colors_ref(), palette_item.bpp(), palette_item.compression());
+    }
+
+    [[nodiscard]] regular_bg_map_cell _map_cell(int tile_index, int palette_id)
+    {
+        regular_bg_map_cell_info cell_info;
+        cell_info.set_tile_index(tile_index);
+        cell_info.set_palette_id(palette_id);
+        return cell_info.cell();
+    }
+
+    [[nodiscard]] int _graphics_index(char character, const utf8_characters_map_ref& utf8_characters_map,
+                                      const char* text_data, int& text_index)
+    {
+        int result;
+
+        if(character <= '~')
+        {
+            result = character - '!';
+            ++text_index;
+        }
+        else
+        {
+            utf8_character utf8_char(text_data[text_index]);
+            result = utf8_characters_map.index(utf8_char) + sprite_font::minimum_graphics;
+            text_index += utf8_char.size();
+        }
+
+        return result;
+    }
+
+    class painter
+    {
+
+    public:
+        painter(const sprite_font& font, regular_bg_tiles_ptr& tiles, regular_bg_map_ptr& map, int used_tiles,
+                int max_tiles) :
+            _font(font),
+            _tiles_vram(tiles.vram()->data()),
+            _cells_vram(map.vram()->data()),
+            _tiles_offset(map.tiles_offset()),
+            _palette_id(map.palette_banks_offset()),
+            _used_tiles(used_tiles),
+            _max_tiles(max_tiles)
+        {
+        }
+
+        [[nodiscard]] int used_tiles() const
+        {
+            return _used_tiles;
+        }
+
+        [[nodiscard]] bool paint_character(int graphics_index, int character_width, int x, int y)
+        {
+            const sprite_shape_size& shape_size = _font.item().shape_size();
+            const tile* source_tiles_data = _font.item().tiles_item().graphics_tiles_ref(graphics_index).data();
+            int character_columns = shape_size.width() / 8;
+            int character_rows = shape_size.height() / 8;
+
+            for(int row = 0; row < character_rows; ++row)
+            {
+                const tile* source_row_tiles_data = source_tiles_data + (row * character_columns);
+                int tile_y = y + (row * 8);
+
+                for(int column = 0; column < character_columns; ++column)
+                {
+                    int tile_x = x + (column * 8);
+                    int tile_width = min(x + character_width - tile_x, 8);
+
+                    if(tile_width <= 0)
+                    {
+                        break;
+                    }
+
+                    if(! _paint_tile(source_row_tiles_data[column], tile_width, tile_x, tile_y))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+    private:
+        static constexpr int _map_width = regular_bg_text_generator::columns * 8;
+        static constexpr int _map_height = regular_bg_text_generator::rows * 8;
+
+        const sprite_font& _font;
+        tile* _tiles_vram;
+        regular_bg_map_cell* _cells_vram;
+        int _tiles_offset;
+        int _palette_id;
+        int _used_tiles;
+        int _max_tiles;
+
+        [[nodiscard]] bool _paint_tile(const tile& source_tile, int width, int x, int y)
+        {
+            if(x + width <= 0 || x >= _map_width || y + 8 <= 0 || y >= _map_height)
+            {
+                return true;
+            }
+
+            // Each source row is split in a left cell and a right cell if x is not multiple of 8:
+
+            unsigned mask = 0xFFFFFFFFU >> ((8 - width) * 4);
+            int left_cell_x = x >> 3;
+            int right_cell_x = left_cell_x + 1;
+            unsigned left_shift = unsigned(x & 7) * 4;
+            unsigned right_shift = 32 - left_shift;
+            bool left_cell_visible = left_cell_x >= 0;
+            bool right_cell_visible = left_shift && (x & 7) + width > 8 &&
+                    right_cell_x < regular_bg_text_generator::columns;
+
+            for(int row = 0; row < 8; ++row)
+            {
+                int pixel_y = y + row;
+
+                if(pixel_y < 0 || pixel_y >= _map_height)
+                {
+                    continue;
+                }
+
+                unsigned pixels = source_tile.data[row] & mask;
+                int cell_y = pixel_y >> 3;
+                int cell_row = pixel_y & 7;
+
+                if(left_cell_visible)
+                {
+                    if(! _paint_row(left_cell_x, cell_y, cell_row, pixels << left_shift, mask << left_shift))
+                    {
+                        return false;
+                    }
+                }
+
+                if(right_cell_visible)
+                {
+                    if(! _paint_row(right_cell_x, cell_y, cell_row, pixels >> right_shift, mask >> right_shift))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] bool _paint_row(int cell_x, int cell_y, int cell_row, unsigned pixels, unsigned mask)
+        {
+            regular_bg_map_cell& cell = _cells_vram[(cell_y * regular_bg_text_generator::columns) + cell_x];
+            int tile_index = regular_bg_map_cell_info(cell).tile_index() - _tiles_offset;
+
+            if(! tile_index)
+            {
+                // Empty cells are left untouched until something is painted on them:
+
+                if(! pixels)
+                {
+                    return true;
+                }
+
+                if(_used_tiles == _max_tiles)
+                {
+                    return false;
+                }
+
+                tile_index = _used_tiles;
+                ++_used_tiles;
+
+                memory::clear(1, _tiles_vram[tile_index]);
+                cell = _map_cell(_tiles_offset + tile_index, _palette_id);
+            }
+
+            uint32_t& destination = _tiles_vram[tile_index].data[cell_row];
+            destination = (destination & ~mask) | pixels;
+            return true;
+        }
+    };
+}
+
+regular_bg_text_generator::regular_bg_text_generator(const sprite_font& font, int max_tiles) :
+    regular_bg_text_generator(font, _palette_item(font), max_tiles)
+{
+}
+
+regular_bg_text_generator::regular_bg_text_generator(
+        const sprite_font& font, const bg_palette_item& palette_item, int max_tiles) :
+    _font(font),
+    _tiles(_allocate_tiles(max_tiles)),
+    _map(regular_bg_map_ptr::allocate(size(columns, rows), _tiles, palette_item.create_palette())),
+    _max_tiles(int16_t(max_tiles)),
+    _max_character_width(int8_t(font.item().shape_size().width()))
+{
+    BN_ASSERT(palette_item.bpp() == bpp_mode::BPP_4, "8BPP fonts not supported");
+
+    optional<span<tile>> tiles_vram = _tiles.vram();
+    memory::clear(1, *tiles_vram->data());
+    clear();
+}
+
+int regular_bg_text_generator::width(const string_view& text) const
+{
+    const int8_t* character_widths = _font.character_widths_ref().data();
+    const utf8_characters_map_ref& utf8_characters_map = _font.utf8_characters_ref();
+    int space_between_characters = _font.space_between_characters();
+    int space_width = character_widths ? character_widths[0] : _max_character_width;
+    const char* text_data = text.data();
+    int text_index = 0;
+    int text_size = text.size();
+    int result = 0;
+
+    while(text_index < text_size)
+    {
+        char character = text_data[text_index];
+
+        if(character == ' ')
+        {
+            result += space_width + space_between_characters;
+            ++text_index;
+        }
+        else if(character == '\t')
+        {
+            result += (space_width * 4) + space_between_characters;
+            ++text_index;
+        }
+        else if(character >= '!')
+        {
+            int graphics_index = _graphics_index(character, utf8_characters_map, text_data, text_index);
+            int character_width = character_widths ? character_widths[graphics_index + 1] : _max_character_width;
+            result += character_width + space_between_characters;
+        }
+        else
+        {
+            BN_ERROR("Invalid character: ", character, " (text: ", text, ")");
+        }
+    }
+
+    return result;
+}
+
+void regular_bg_text_generator::generate(int x, int y, const string_view& text)
+{
+    [[maybe_unused]] bool success = _generate(x, y, text);
+    BN_ASSERT(success, "No more tiles available: ", _max_tiles);
+}
+
+bool regular_bg_text_generator::generate_optional(int x, int y, const string_view& text)
+{
+    return _generate(x, y, text);
+}
+
+void regular_bg_text_generator::clear()
+{
+    optional<span<regular_bg_map_cell>> map_vram = _map.vram();
+    regular_bg_map_cell empty_cell = _map_cell(_map.tiles_offset(), _map.palette_banks_offset());
+    memory::set_half_words(empty_cell, columns * rows, map_vram->data());
+    _used_tiles = 1;
+}
+
+bool regular_bg_text_generator::_generate(int x, int y, const string_view& text)
+{
+    switch(_alignment)
+    {
+
+    case alignment_type::LEFT:
+        break;
+
+    case alignment_type::CENTER:
+        x -= width(text) / 2;
+        break;
+
+    case alignment_type::RIGHT:
+        x -= width(text);
+        break;
+
+    default:
+        BN_ERROR("Invalid alignment: ", int(_alignment));
+        break;
+    }
+
+    const int8_t* character_widths = _font.character_widths_ref().data();
+    const utf8_characters_map_ref& utf8_characters_map = _font.utf8_characters_ref();
+    int space_between_characters = _font.space_between_characters();
+    int space_width = character_widths ? character_widths[0] : _max_character_width;
+    const char* text_data = text.data();
+    int text_index = 0;
+    int text_size = text.size();
+    painter painter(_font, _tiles, _map, _used_tiles, _max_tiles);
+    bool success = true;
+
+    while(success && text_index < text_size)
+    {
+        char character = text_data[text_index];
+
+        if(character == ' ')
+        {
+            x += space_width + space_between_characters;
+            ++text_index;
+        }
+        else if(character == '\t')
+        {
+            x += (space_width * 4) + space_between_characters;
+            ++text_index;
+        }
+        else if(character >= '!')
+        {
+            int graphics_index = _graphics_index(character, utf8_characters_map, text_data, text_index);
+            int character_width = character_widths ? character_widths[graphics_index + 1] : _max_character_width;
+
+            if(character_width)
+            {
+                success = painter.paint_character(graphics_index, character_width, x, y);
+            }
+
+            x += character_width + space_between_characters;
+        }
+        else
+        {
+            BN_ERROR("Invalid character: ", character, " (text: ", text, ")");
+        }
+    }
+
+    _used_tiles = int16_t(painter.used_tiles());
+    return success;
+}
+
+}
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_retained_sprite_text.h"
+
+#include "bn_sprite_builder.h"
+#include "bn_utf8_character.h"
+#include "../hw/include/bn_hw_sprite_tiles.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr int sprite_columns = 32;
+
+    [[nodiscard]] sprite_shape_size _sprite_shape_size(int character_height)
+    {
+        switch(character_height)
+        {
+
+        case 8:
+            return sprite_shape_size(sprite_shape::WIDE, sprite_size::NORMAL);
+
+        case 16:
+            return sprite_shape_size(sprite_shape::WIDE, sprite_size::BIG);
+
+        case 32:
+            return sprite_shape_size(sprite_shape::SQUARE, sprite_size::BIG);
+
+        default:
+            BN_ERROR("Unsupported character height: ", character_height);
+            return sprite_shape_size(sprite_shape::SQUARE, sprite_size::SMALL);
+        }
+    }
+
+    [[nodiscard]] int _graphics_index(char character, const utf8_characters_map_ref& utf8_characters_map,
+                                      const char* text_data, int& text_index)
+    {
+        int result;
+
+        if(character <= '~')
+        {
+            result = character - '!';
+            ++text_index;
+        }
+        else
+        {
+            utf8_character utf8_char(text_data[text_index]);
+            result = utf8_characters_map.index(utf8_char) + sprite_font::minimum_graphics;
+            text_index += utf8_char.size();
+        }
+
+        return result;
+    }
+
+
+    class painter
+    {
+
+    public:
+        painter(const sprite_font& font, const ivector<sprite_ptr>& sprites) :
+            _font(font),
+            _sprites_count(sprites.size()),
+            _character_height(font.item().shape_size().height())
+        {
+            for(int index = 0; index < _sprites_count; ++index)
+            {
+                sprite_tiles_ptr tiles = sprites[index].tiles();
+                _tiles_vram[index] = tiles.vram()->data();
+            }
+        }
+
+        void clear_character(int x, int width)
+        {
+            for(int row = 0; row < _character_height; ++row)
+            {
+                for(int column = 0; column < width; column += 8)
+                {
+                    _paint_row(x + column, row, 0, _mask(width - column));
+                }
+            }
+        }
+
+        void paint_character(int graphics_index, int x, int width)
+        {
+            const sprite_shape_size& shape_size = _font.item().shape_size();
+            const tile* source_tiles_data = _font.item().tiles_item().graphics_tiles_ref(graphics_index).data();
+            int character_columns = shape_size.width() / 8;
+
+            for(int row = 0; row < _character_height; ++row)
+            {
+                const tile* source_row_tiles_data = source_tiles_data + ((row / 8) * character_columns);
+
+                for(int column = 0; column < width; column += 8)
+                {
+                    unsigned mask = _mask(width - column);
+                    unsigned pixels = source_row_tiles_data[column / 8].data[row % 8] & mask;
+                    _paint_row(x + column, row, pixels, mask);
+                }
+            }
+        }
+
+    private:
+        const sprite_font& _font;
+        tile* _tiles_vram[retained_sprite_text::max_sprites];
+        int _sprites_count;
+        int _character_height;
+
+        [[nodiscard]] static unsigned _mask(int width)
+        {
+            return width >= 8 ? 0xFFFFFFFFU : 0xFFFFFFFFU >> ((8 - width) * 4);
+        }
+
+        void _paint_row(int x, int row, unsigned pixels, unsigned mask)
+        {
+            // Each 8 pixels row is split in a left tile and a right tile if x is not multiple of 8:
+
+            unsigned left_shift = unsigned(x & 7) * 4;
+            _paint_tile_row(x, row, pixels << left_shift, mask << left_shift);
+
+            if(left_shift)
+            {
+                unsigned right_shift = 32 - left_shift;
+                _paint_tile_row(x + 8, row, pixels >> right_shift, mask >> right_shift);
+            }
+        }
+
+        void _paint_tile_row(int x, int row, unsigned pixels, unsigned mask)
+        {
+            int sprite_index = x / sprite_columns;
+
+            if(! mask || sprite_index >= _sprites_count)
+            {
+                return;
+            }
+
+            int tile_index = ((row / 8) * (sprite_columns / 8)) + ((x % sprite_columns) / 8);
+            uint32_t& destination = _tiles_vram[sprite_index][tile_index].data[row % 8];
+            destination = (destination & ~mask) | pixels;
+        }
+    };
+}
+
+retained_sprite_text::retained_sprite_text(const sprite_text_generator& generator, fixed x, fixed y,
+                                           int max_width) :
+    retained_sprite_text(generator, fixed_point(x, y), max_width)
+{
+}
+
+retained_sprite_text::retained_sprite_text(const sprite_text_generator& generator, const fixed_point& position,
+                                           int max_width) :
+    _font(generator.font()),
+    _position(position),
+    _max_width(int16_t(max_width)),
+    _alignment(generator.alignment())
+{
+    BN_ASSERT(max_width > 0 && max_width <= max_sprites * sprite_columns, "Invalid max width: ", max_width);
+
+    sprite_shape_size shape_size = _sprite_shape_size(_font.item().shape_size().height());
+    int tiles_count = (shape_size.width() / 8) * (shape_size.height() / 8);
+    sprite_palette_ptr palette = generator.palette_item().create_palette();
+
+    for(int index = 0, limit = (max_width + sprite_columns - 1) / sprite_columns; index < limit; ++index)
+    {
+        sprite_tiles_ptr tiles = sprite_tiles_ptr::allocate(tiles_count, bpp_mode::BPP_4);
+        optional<span<tile>> tiles_vram = tiles.vram();
+        hw::sprite_tiles::clear_tiles(tiles_count, tiles_vram->data());
+
+        sprite_builder builder(shape_size, move(tiles), palette);
+        builder.set_bg_priority(generator.bg_priority());
+        builder.set_z_order(generator.z_order());
+        builder.set_visible(false);
+        _sprites.push_back(sprite_ptr::create(move(builder)));
+    }
+
+    _update_sprites();
+}
+
+void retained_sprite_text::set_position(const fixed_point& position)
+{
+    _position = position;
+    _update_sprites();
+}
+
+void retained_sprite_text::set_visible(bool visible)
+{
+    _visible = visible;
+    _update_sprites();
+}
+
+void retained_sprite_text::set_text(const string_view& text)
+{
+    const int8_t* character_widths = _font.character_widths_ref().data();
+    const utf8_characters_map_ref& utf8_characters_map = _font.utf8_characters_ref();
+    int max_character_width = _font.item().shape_size().width();
+    int space_between_characters = _font.space_between_characters();
+    int space_width = character_widths ? character_widths[0] : max_character_width;
+    const char* text_data = text.data();
+    int text_index = 0;
+    int text_size = text.size();
+    int x = 0;
+    vector<character_type, max_characters> characters;
+
+    while(text_index < text_size)
+    {
+        char character = text_data[text_index];
+
+        if(character == ' ')
+        {
+            x += space_width + space_between_characters;
+            ++text_index;
+        }
+        else if(character == '\t')
+        {
+            x += (space_width * 4) + space_between_characters;
+            ++text_index;
+        }
+        else if(character >= '!')
+        {
+            int graphics_index = _graphics_index(character, utf8_characters_map, text_data, text_index);
+            int character_width = character_widths ? character_widths[graphics_index + 1] : max_character_width;
+
+            if(character_width)
+            {
+                BN_ASSERT(! characters.full(), "Too many characters: ", text);
+                BN_ASSERT(x >= 0 && x + character_width <= _max_width, "Text is too wide: ", text);
+
+                characters.push_back(character_type{ int16_t(x), int16_t(graphics_index), int16_t(character_width) });
+            }
+
+            x += character_width + space_between_characters;
+        }
+        else
+        {
+            BN_ERROR("Invalid character: ", character, " (text: ", text, ")");
+        }
+    }
+
+    // Characters only overlap if the space between them is negative.
+    // In that case, all of them are painted again to keep the same output as sprite_text_generator:
+
+    bool paint_all = space_between_characters < 0;
+    int old_characters_count = _characters.size();
+    int new_characters_count = characters.size();
+    painter painter(_font, _sprites);
+
+    for(int index = 0; index < old_characters_count; ++index)
+    {
+        const character_type& old_character = _characters[index];
+
+        if(paint_all || index >= new_characters_count || old_character != characters[index])
+        {
+            painter.clear_character(old_character.x, old_character.width);
+        }
+    }
+
+    for(int index = 0; index < new_characters_count; ++index)
+    {
+        const character_type& new_character = characters[index];
+
+        if(paint_all || index >= old_characters_count || new_character != _characters[index])
+        {
+            painter.paint_character(new_character.graphics_index, new_character.x, new_character.width);
+        }
+    }
+
+    _characters = characters;
+    _width = int16_t(x);
+    _update_sprites();
+}
+
+void retained_sprite_text::_update_sprites()
+{
+    fixed x = _position.x();
+
+    switch(_alignment)
+    {
+
+    case sprite_text_generator::alignment_type::LEFT:
+        break;
+
+    case sprite_text_generator::alignment_type::CENTER:
+        x -= _width / 2;
+        break;
+
+    case sprite_text_generator::alignment_type::RIGHT:
+        x -= _width;
+        break;
+
+    default:
+        BN_ERROR("Invalid alignment: ", int(_alignment));
+        break;
+    }
+
+    x += sprite_columns / 2;
+
+    for(int index = 0, limit = _sprites.size(); index < limit; ++index)
+    {
+        sprite_ptr& sprite = _sprites[index];
+        sprite.set_position(x, _position.y());
+        sprite.set_visible(_visible && index * sprite_columns < _width);
+        x += sprite_columns;
+    }
+}
+
+}
@@ -46,6 +46,25 @@ optional<sprite_affine_mat_ptr> sprite_affine_mat_ptr::create_optional(const aff
     return result;
 }
 
+sprite_affine_mat_ptr sprite_affine_mat_ptr::create_interned(const affine_mat_attributes& attributes)
+{
+    return sprite_affine_mat_ptr(sprite_affine_mats_manager::create_interned(attributes));
+}
+
+optional<sprite_affine_mat_ptr> sprite_affine_mat_ptr::create_interned_optional(
+        const affine_mat_attributes& attributes)
+{
+    int id = sprite_affine_mats_manager::create_interned_optional(attributes);
+    optional<sprite_affine_mat_ptr> result;
+
+    if(id >= 0)
+    {
+        result = sprite_affine_mat_ptr(id);
+    }
+
+    return result;
+}
+
 sprite_affine_mat_ptr::sprite_affine_mat_ptr(const sprite_affine_mat_ptr& other) :
     sprite_affine_mat_ptr(other._id)
 {
@@ -76,6 +95,11 @@ sprite_affine_mat_ptr::~sprite_affine_mat_ptr()
     }
 }
 
+bool sprite_affine_mat_ptr::interned() const
+{
+    return sprite_affine_mats_manager::interned(_id);
+}
+
 fixed sprite_affine_mat_ptr::rotation_angle() const
 {
     return sprite_affine_mats_manager::rotation_angle(_id);
@@ -20,4 +20,14 @@ int available_count()
     return sprite_affine_mats_manager::available_count();
 }
 
+bool interning_enabled()
+{
+    return sprite_affine_mats_manager::interning_enabled();
+}
+
+void set_interning_enabled(bool enabled)
+{
+    sprite_affine_mats_manager::set_interning_enabled(enabled);
+}
+
 }
@@ -7,6 +7,7 @@
 
 #include "bn_vector.h"
 #include "bn_sprites_manager_item.h"
+#include "bn_telemetry_manager.h"
 #include "../hw/include/bn_hw_sprite_affine_mats.h"
 #include "../hw/include/bn_hw_sprite_affine_mats_constants.h"
 
@@ -30,8 +31,10 @@ namespace
         affine_mat_attributes attributes;
         intrusive_list<sprite_affine_mat_attach_node_type> attached_nodes;
         unsigned usages;
+        unsigned hash;
         bool flipped_identity;
         bool remove_if_not_needed;
+        bool interned;
 
         void init()
         {
@@ -39,6 +42,7 @@ namespace
             usages = 1;
             flipped_identity = true;
             remove_if_not_needed = false;
+            interned = false;
         }
 
         void init(const affine_mat_attributes& new_attributes)
@@ -47,6 +51,7 @@ namespace
             usages = 1;
             flipped_identity = attributes.flipped_identity();
             remove_if_not_needed = false;
+            interned = false;
         }
     };
 
@@ -84,11 +89,46 @@ namespace
         int last_index_to_commit = 0;
         int first_index_to_remove_if_not_needed = max_items;
         int last_index_to_remove_if_not_needed = 0;
+        bool interning_enabled = false;
     };
 
     BN_DATA_EWRAM static_data data;
 
 
+    [[nodiscard]] item_type& _mutable_item(int id)
+    {
+        item_type& item = data.items[id];
+        BN_ASSERT(! item.interned, "Interned sprite affine mats can't be modified");
+
+        return item;
+    }
+
+    [[nodiscard]] unsigned _hash(const affine_mat_attributes& attributes)
+    {
+        unsigned result = unsigned(attributes.rotation_angle().data());
+        result = (result * 31) + unsigned(attributes.horizontal_scale().data());
+        result = (result * 31) + unsigned(attributes.vertical_scale().data());
+        result = (result * 31) + unsigned(attributes.horizontal_shear().data());
+        result = (result * 31) + unsigned(attributes.vertical_shear().data());
+        result = (result * 31) + unsigned(attributes.horizontal_flip()) + (unsigned(attributes.vertical_flip()) << 1);
+        return result;
+    }
+
+    [[nodiscard]] int _find_interned(const affine_mat_attributes& attributes, unsigned hash)
+    {
+        for(int index = 0; index < max_items; ++index)
+        {
+            const item_type& item = data.items[index];
+
+            if(item.interned && item.usages && item.hash == hash && item.attributes == attributes)
+            {
+                return index;
+            }
+        }
+
+        return -1;
+    }
+
     void _update_flipped_identity(int index)
     {
         item_type& item = data.items[index];
@@ -245,6 +285,11 @@ int create_optional()
         new_item.init();
         hw::sprite_affine_mats::setup(data.handles_ptr[item_index]);
         _update_indexes_to_commit(item_index);
+        telemetry_manager::on_create(telemetry::resource_type::SPRITE_AFFINE_MATS);
+    }
+    else
+    {
+        telemetry_manager::on_create_failed(telemetry::resource_type::SPRITE_AFFINE_MATS);
     }
 
     return item_index;
@@ -260,11 +305,94 @@ int create_optional(const affine_mat_attributes& attributes)
         new_item.init(attributes);
         hw::sprite_affine_mats::setup(attributes, data.handles_ptr[item_index]);
         _update_indexes_to_commit(item_index);
+        telemetry_manager::on_create(telemetry::resource_type::SPRITE_AFFINE_MATS);
+    }
+    else
+    {
+        telemetry_manager::on_create_failed(telemetry::resource_type::SPRITE_AFFINE_MATS);
+    }
+
+    return item_index;
+}
+
+int create_interned(const affine_mat_attributes& attributes)
+{
+    int id = create_interned_optional(attributes);
+    BN_ASSERT(id >= 0, "No more sprite affine mats available");
+
+    return id;
+}
+
+int create_interned_optional(const affine_mat_attributes& attributes)
+{
+    unsigned hash = _hash(attributes);
+    int item_index = _find_interned(attributes, hash);
+
+    if(item_index >= 0)
+    {
+        increase_usages(item_index);
+        return item_index;
+    }
+
+    item_index = create_optional(attributes);
+
+    if(item_index >= 0)
+    {
+        item_type& new_item = data.items[item_index];
+        new_item.hash = hash;
+        new_item.interned = true;
     }
 
     return item_index;
 }
 
+bool set_interned_attributes(int id, const affine_mat_attributes& attributes)
+{
+    item_type& item = data.items[id];
+
+    // Only mats which are not shared can be modified in place,
+    // and if there's an interned mat with the same attributes, it must be shared instead:
+    if(item.usages > 1)
+    {
+        return false;
+    }
+
+    unsigned hash = _hash(attributes);
+
+    if(_find_interned(attributes, hash) >= 0)
+    {
+        return false;
+    }
+
+    registers old_registers(item.attributes);
+    item.attributes = attributes;
+    item.hash = hash;
+    item.interned = true;
+    _update_flipped_identity(id);
+
+    if(registers(attributes) != old_registers)
+    {
+        _update(id);
+    }
+
+    return true;
+}
+
+bool interned(int id)
+{
+    return data.items[id].interned;
+}
+
+bool interning_enabled()
+{
+    return data.interning_enabled;
+}
+
+void set_interning_enabled(bool enabled)
+{
+    data.interning_enabled = enabled;
+}
+
 void increase_usages(int id)
 {
     item_type& item = data.items[id];
@@ -280,6 +408,7 @@ void decrease_usages(int id)
     {
         item.remove_if_not_needed = false;
         data.free_item_indexes.push_back(int8_t(id));
+        telemetry_manager::on_destroy(telemetry::resource_type::SPRITE_AFFINE_MATS);
     }
 }
 
@@ -302,7 +431,7 @@ fixed rotation_angle(int id)
 
 void set_rotation_angle(int id, fixed rotation_angle)
 {
-    item_type& item = data.items[id];
+    item_type& item = _mutable_item(id);
 
     if(rotation_angle != item.attributes.rotation_angle())
     {
@@ -324,7 +453,7 @@ fixed horizontal_scale(int id)
 
 void set_horizontal_scale(int id, fixed horizontal_scale)
 {
-    item_type& item = data.items[id];
+    item_type& item = _mutable_item(id);
 
     if(horizontal_scale != item.attributes.horizontal_scale())
     {
@@ -347,7 +476,7 @@ fixed vertical_scale(int id)
 
 void set_vertical_scale(int id, fixed vertical_scale)
 {
-    item_type& item = data.items[id];
+    item_type& item = _mutable_item(id);
 
     if(vertical_scale != item.attributes.vertical_scale())
     {
@@ -365,7 +494,7 @@ void set_vertical_scale(int id, fixed vertical_scale)
 
 void set_scale(int id, fixed scale)
 {
-    item_type& item = data.items[id];
+    item_type& item = _mutable_item(id);
 
     if(scale != item.attributes.horizontal_scale() || scale != item.attributes.vertical_scale())
     {
@@ -382,7 +511,7 @@ void set_scale(int id, fixed scale)
 
 void set_scale(int id, fixed horizontal_scale, fixed vertical_scale)
 {
-    item_type& item = data.items[id];
+    item_type& item = _mutable_item(id);
 
     if(horizontal_scale != item.attributes.horizontal_scale() || vertical_scale != item.attributes.vertical_scale())
     {
@@ -404,7 +533,7 @@ fixed horizontal_shear(int id)
 
 void set_horizontal_shear(int id, fixed horizontal_shear)
 {
-    item_type& item = data.items[id];
+    item_type& item = _mutable_item(id);
 
     if(horizontal_shear != item.attributes.horizontal_shear())
     {
@@ -426,7 +555,7 @@ fixed vertical_shear(int id)
 
 void set_vertical_shear(int id, fixed vertical_shear)
 {
-    item_type& item = data.items[id];
+    item_type& item = _mutable_item(id);
 
     if(vertical_shear != item.attributes.vertical_shear())
     {
@@ -443,7 +572,7 @@ void set_vertical_shear(int id, fixed vertical_shear)
 
 void set_shear(int id, fixed shear)
 {
-    item_type& item = data.items[id];
+    item_type& item = _mutable_item(id);
 
     if(shear != item.attributes.horizontal_shear() || shear != item.attributes.vertical_shear())
     {
@@ -461,7 +590,7 @@ void set_shear(int id, fixed shear)
 
 void set_shear(int id, fixed horizontal_shear, fixed vertical_shear)
 {
-    item_type& item = data.items[id];
+    item_type& item = _mutable_item(id);
 
     if(horizontal_shear != item.attributes.horizontal_shear() || vertical_shear != item.attributes.vertical_shear())
     {
@@ -484,7 +613,7 @@ bool horizontal_flip(int id)
 
 void set_horizontal_flip(int id, bool horizontal_flip)
 {
-    item_type& item = data.items[id];
+    item_type& item = _mutable_item(id);
 
     if(horizontal_flip != item.attributes.horizontal_flip())
     {
@@ -501,7 +630,7 @@ bool vertical_flip(int id)
 
 void set_vertical_flip(int id, bool vertical_flip)
 {
-    item_type& item = data.items[id];
+    item_type& item = _mutable_item(id);
 
     if(vertical_flip != item.attributes.vertical_flip())
     {
@@ -518,7 +647,7 @@ const affine_mat_attributes& attributes(int id)
 
 void set_attributes(int id, const affine_mat_attributes& attributes)
 {
-    item_type& item = data.items[id];
+    item_type& item = _mutable_item(id);
     registers old_registers(item.attributes);
     item.attributes = attributes;
     _update_flipped_identity(id);
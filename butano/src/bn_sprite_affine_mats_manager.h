@@ -42,6 +42,18 @@ namespace bn::sprite_affine_mats_manager
 
     [[nodiscard]] int create_optional(const affine_mat_attributes& attributes);
 
+    [[nodiscard]] int create_interned(const affine_mat_attributes& attributes);
+
+    [[nodiscard]] int create_interned_optional(const affine_mat_attributes& attributes);
+
+    [[nodiscard]] bool set_interned_attributes(int id, const affine_mat_attributes& attributes);
+
+    [[nodiscard]] bool interned(int id);
+
+    [[nodiscard]] bool interning_enabled();
+
+    void set_interning_enabled(bool enabled);
+
     void increase_usages(int id);
 
     void decrease_usages(int id);
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sprite_glyph_atlas.h"
+
+namespace bn
+{
+
+sprite_tiles_ptr isprite_glyph_atlas::glyph_tiles(int graphics_index)
+{
+    if(sprite_tiles_ptr* tiles = _find(graphics_index))
+    {
+        return *tiles;
+    }
+
+    if(_glyphs_ref->full())
+    {
+        _release_least_recently_used();
+    }
+
+    sprite_tiles_ptr tiles = sprite_tiles_ptr::create(_font.item().tiles_item(), graphics_index);
+    _glyphs_ref->push_back(glyph_type{ tiles, ++_uses, graphics_index });
+    return tiles;
+}
+
+optional<sprite_tiles_ptr> isprite_glyph_atlas::glyph_tiles_optional(int graphics_index)
+{
+    if(sprite_tiles_ptr* tiles = _find(graphics_index))
+    {
+        return *tiles;
+    }
+
+    if(_glyphs_ref->full())
+    {
+        _release_least_recently_used();
+    }
+
+    optional<sprite_tiles_ptr> result = sprite_tiles_ptr::create_optional(_font.item().tiles_item(), graphics_index);
+
+    if(const sprite_tiles_ptr* tiles = result.get())
+    {
+        _glyphs_ref->push_back(glyph_type{ *tiles, ++_uses, graphics_index });
+    }
+
+    return result;
+}
+
+sprite_tiles_ptr* isprite_glyph_atlas::_find(int graphics_index)
+{
+    for(glyph_type& glyph : *_glyphs_ref)
+    {
+        if(glyph.graphics_index == graphics_index)
+        {
+            glyph.last_use = ++_uses;
+            return &glyph.tiles;
+        }
+    }
+
+    return nullptr;
+}
+
+void isprite_glyph_atlas::_release_least_recently_used()
+{
+    // Uses are compared relative to the current one, so the counter can wrap around:
+
+    ivector<glyph_type>& glyphs = *_glyphs_ref;
+    auto least_recently_used = glyphs.begin();
+    unsigned uses = _uses;
+
+    for(auto it = glyphs.begin(), end = glyphs.end(); it != end; ++it)
+    {
+        if(uses - it->last_use > uses - least_recently_used->last_use)
+        {
+            least_recently_used = it;
+        }
+    }
+
+    if(least_recently_used != glyphs.end() - 1)
+    {
+        *least_recently_used = move(glyphs.back());
+    }
+
+    glyphs.pop_back();
+}
+
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sprite_move_tweens.h"
+
+#include "bn_easing.h"
+#include "bn_sprites_manager.h"
+
+namespace bn
+{
+
+namespace
+{
+    // Progress is stored with 24 fractional bits to support long tweens without accumulating errors:
+    constexpr int progress_shift = 24 - fixed::precision();
+    constexpr unsigned max_progress = 1 << 24;
+}
+
+bool isprite_move_tweens::contains(const sprite_ptr& sprite) const
+{
+    return _index(sprite) >= 0;
+}
+
+bool isprite_move_tweens::add(const sprite_ptr& sprite, const fixed_point& final_position, int duration_updates,
+                              easing_type easing, bool loop)
+{
+    BN_ASSERT(duration_updates > 0, "Invalid duration updates: ", duration_updates);
+
+    int index = _index(sprite);
+
+    if(index < 0)
+    {
+        if(_sprites.full())
+        {
+            return false;
+        }
+
+        index = _sprites.size();
+        _sprites.push_back(sprite);
+        _ids[index] = const_cast<void*>(sprite.handle());
+    }
+
+    const fixed_point& initial_position = sprite.position();
+    tween_type& tween = _tweens[index];
+    tween.initial_position = initial_position;
+    tween.delta_position = final_position - initial_position;
+    tween.progress = 0;
+    tween.progress_step = (max_progress + unsigned(duration_updates) - 1) / unsigned(duration_updates);
+    tween.easing = easing;
+    tween.loop = loop;
+    return true;
+}
+
+bool isprite_move_tweens::remove(const sprite_ptr& sprite)
+{
+    int index = _index(sprite);
+
+    if(index < 0)
+    {
+        return false;
+    }
+
+    _erase(index);
+    return true;
+}
+
+void isprite_move_tweens::clear()
+{
+    _sprites.clear();
+}
+
+void isprite_move_tweens::update()
+{
+    int count = _sprites.size();
+
+    if(! count)
+    {
+        return;
+    }
+
+    tween_type* tweens = _tweens;
+    fixed_point* positions = _positions;
+
+    for(int index = 0; index < count; ++index)
+    {
+        tween_type& tween = tweens[index];
+        unsigned progress = min(tween.progress + tween.progress_step, max_progress);
+        tween.progress = progress;
+
+        fixed eased_progress = easing::apply(tween.easing, fixed::from_data(int(progress >> progress_shift)));
+        positions[index] = tween.initial_position + (tween.delta_position * eased_progress);
+    }
+
+    sprites_manager::set_positions(_ids, positions, count);
+
+    for(int index = count - 1; index >= 0; --index)
+    {
+        tween_type& tween = tweens[index];
+
+        if(tween.progress == max_progress)
+        {
+            if(tween.loop)
+            {
+                tween.initial_position += tween.delta_position;
+                tween.delta_position = -tween.delta_position;
+                tween.progress = 0;
+            }
+            else
+            {
+                _erase(index);
+            }
+        }
+    }
+}
+
+int isprite_move_tweens::_index(const sprite_ptr& sprite) const
+{
+    const void* id = sprite.handle();
+
+    for(int index = 0, limit = _sprites.size(); index < limit; ++index)
+    {
+        if(_ids[index] == id)
+        {
+            return index;
+        }
+    }
+
+    return -1;
+}
+
+void isprite_move_tweens::_erase(int index)
+{
+    int last_index = _sprites.size() - 1;
+
+    if(index != last_index)
+    {
+        _sprites[index] = move(_sprites[last_index]);
+        _tweens[index] = _tweens[last_index];
+        _ids[index] = _ids[last_index];
+    }
+
+    _sprites.pop_back();
+}
+
+}
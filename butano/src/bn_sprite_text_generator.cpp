@@ -8,6 +8,7 @@
 #include "bn_sprites.h"
 #include "bn_sprite_ptr.h"
 #include "bn_sprite_builder.h"
+#include "bn_sprite_glyph_atlas.h"
 #include "../hw/include/bn_hw_sprite_tiles.h"
 
 namespace bn
@@ -88,6 +89,30 @@ namespace
         return _build_sprite_assert<size>(generator, palette, current_position, output_sprites);
     }
 
+    template<bool allow_failure>
+    [[nodiscard]] optional<sprite_tiles_ptr> _create_character_tiles(
+        const sprite_text_generator& generator, int graphics_index)
+    {
+        if(isprite_glyph_atlas* glyph_atlas = generator.glyph_atlas())
+        {
+            if(allow_failure)
+            {
+                return glyph_atlas->glyph_tiles_optional(graphics_index);
+            }
+
+            return glyph_atlas->glyph_tiles(graphics_index);
+        }
+
+        const sprite_tiles_item& tiles_item = generator.font().item().tiles_item();
+
+        if(allow_failure)
+        {
+            return sprite_tiles_ptr::create_optional(tiles_item, graphics_index);
+        }
+
+        return sprite_tiles_ptr::create(tiles_item, graphics_index);
+    }
+
 
     class fixed_width_no_space_between_characters_painter
     {
@@ -289,21 +314,12 @@ namespace
             }
 
             const sprite_item& item = _generator.font().item();
-            const sprite_tiles_item& tiles_item = item.tiles_item();
-            optional<sprite_tiles_ptr> source_tiles;
-
-            if(allow_failure)
-            {
-                source_tiles = sprite_tiles_ptr::create_optional(tiles_item, graphics_index);
+            optional<sprite_tiles_ptr> source_tiles =
+                    _create_character_tiles<allow_failure>(_generator, graphics_index);
 
-                if(! source_tiles)
-                {
-                    return false;
-                }
-            }
-            else
+            if(allow_failure && ! source_tiles)
             {
-                source_tiles = sprite_tiles_ptr::create(tiles_item, graphics_index);
+                return false;
             }
 
             sprite_builder builder(item.shape_size(), move(*source_tiles), _palette);
@@ -388,21 +404,12 @@ namespace
                 }
 
                 const sprite_item& item = _generator.font().item();
-                const sprite_tiles_item& tiles_item = item.tiles_item();
-                optional<sprite_tiles_ptr> source_tiles;
+                optional<sprite_tiles_ptr> source_tiles =
+                    _create_character_tiles<allow_failure>(_generator, graphics_index);
 
-                if(allow_failure)
+                if(allow_failure && ! source_tiles)
                 {
-                    source_tiles = sprite_tiles_ptr::create_optional(tiles_item, graphics_index);
-
-                    if(! source_tiles)
-                    {
-                        return false;
-                    }
-                }
-                else
-                {
-                    source_tiles = sprite_tiles_ptr::create(tiles_item, graphics_index);
+                    return false;
                 }
 
                 sprite_builder builder(item.shape_size(), move(*source_tiles), _palette);
@@ -1165,6 +1172,14 @@ void sprite_text_generator::set_palette_item(const sprite_palette_item& palette_
     _palette_item = palette_item;
 }
 
+void sprite_text_generator::set_glyph_atlas(isprite_glyph_atlas* glyph_atlas)
+{
+    BN_ASSERT(! glyph_atlas || glyph_atlas->font().item().tiles_item() == _font.item().tiles_item(),
+              "Glyph atlas font tiles are not the generator font tiles");
+
+    _glyph_atlas = glyph_atlas;
+}
+
 void sprite_text_generator::set_bg_priority(int bg_priority)
 {
     BN_ASSERT(bg_priority >= 0 && bg_priority <= sprites::max_bg_priority(), "Invalid BG priority: ", bg_priority);
@@ -1219,7 +1234,8 @@ int sprite_text_generator::width(const string_view& text) const
 void sprite_text_generator::generate(fixed x, fixed y, const string_view& text,
                                      ivector<sprite_ptr>& output_sprites) const
 {
-    bool one_sprite_per_character = _one_sprite_per_character || _font_one_sprite_per_character;
+    bool one_sprite_per_character = _one_sprite_per_character || _font_one_sprite_per_character ||
+            _glyph_atlas;
     _generate<false>(*this, fixed_point(x, y), text, _font.utf8_characters_ref(), _max_character_width,
                      _character_height, one_sprite_per_character, output_sprites);
 }
@@ -1227,7 +1243,8 @@ void sprite_text_generator::generate(fixed x, fixed y, const string_view& text,
 void sprite_text_generator::generate(const fixed_point& position, const string_view& text,
                                      ivector<sprite_ptr>& output_sprites) const
 {
-    bool one_sprite_per_character = _one_sprite_per_character || _font_one_sprite_per_character;
+    bool one_sprite_per_character = _one_sprite_per_character || _font_one_sprite_per_character ||
+            _glyph_atlas;
     _generate<false>(*this, position, text, _font.utf8_characters_ref(), _max_character_width,
                      _character_height, one_sprite_per_character, output_sprites);
 }
@@ -1235,7 +1252,8 @@ void sprite_text_generator::generate(const fixed_point& position, const string_v
 bool sprite_text_generator::generate_optional(fixed x, fixed y, const string_view& text,
                                               ivector<sprite_ptr>& output_sprites) const
 {
-    bool one_sprite_per_character = _one_sprite_per_character || _font_one_sprite_per_character;
+    bool one_sprite_per_character = _one_sprite_per_character || _font_one_sprite_per_character ||
+            _glyph_atlas;
     return _generate<true>(*this, fixed_point(x, y), text, _font.utf8_characters_ref(), _max_character_width,
                            _character_height, one_sprite_per_character, output_sprites);
 }
@@ -1243,7 +1261,8 @@ bool sprite_text_generator::generate_optional(fixed x, fixed y, const string_vie
 bool sprite_text_generator::generate_optional(const fixed_point& position, const string_view& text,
                                               ivector<sprite_ptr>& output_sprites) const
 {
-    bool one_sprite_per_character = _one_sprite_per_character || _font_one_sprite_per_character;
+    bool one_sprite_per_character = _one_sprite_per_character || _font_one_sprite_per_character ||
+            _glyph_atlas;
     return _generate<true>(*this, position, text, _font.utf8_characters_ref(), _max_character_width,
                            _character_height, one_sprite_per_character, output_sprites);
 }
@@ -8,6 +8,7 @@
 #include "bn_vector.h"
 #include "bn_string_view.h"
 #include "bn_unordered_map.h"
+#include "bn_telemetry_manager.h"
 #include "bn_config_sprite_tiles.h"
 #include "../hw/include/bn_hw_sprite_tiles.h"
 #include "../hw/include/bn_hw_sprite_tiles_constants.h"
@@ -771,6 +772,8 @@ int create(const span<const tile>& tiles_ref, compression_type compression)
 
         BN_SPRITE_TILES_LOG("CREATED. start_tile: ", data.items.item(result).start_tile);
         BN_SPRITE_TILES_LOG_STATUS();
+
+        telemetry_manager::on_create(telemetry::resource_type::SPRITE_TILES);
     }
     else
     {
@@ -809,6 +812,8 @@ int create_new(const span<const tile>& tiles_ref, compression_type compression)
 
         BN_SPRITE_TILES_LOG("CREATED. start_tile: ", data.items.item(result).start_tile);
         BN_SPRITE_TILES_LOG_STATUS();
+
+        telemetry_manager::on_create(telemetry::resource_type::SPRITE_TILES);
     }
     else
     {
@@ -841,6 +846,8 @@ int allocate(int tiles_count, bpp_mode bpp)
     {
         BN_SPRITE_TILES_LOG("ALLOCATED. start_tile: ", data.items.item(result).start_tile);
         BN_SPRITE_TILES_LOG_STATUS();
+
+        telemetry_manager::on_create(telemetry::resource_type::SPRITE_TILES);
     }
     else
     {
@@ -881,10 +888,14 @@ int create_optional(const span<const tile>& tiles_ref, compression_type compress
 
         BN_SPRITE_TILES_LOG("CREATED. start_tile: ", data.items.item(result).start_tile);
         BN_SPRITE_TILES_LOG_STATUS();
+
+        telemetry_manager::on_create(telemetry::resource_type::SPRITE_TILES);
     }
     else
     {
         BN_SPRITE_TILES_LOG("NOT CREATED");
+
+        telemetry_manager::on_create_failed(telemetry::resource_type::SPRITE_TILES);
     }
 
     return result;
@@ -909,10 +920,14 @@ int create_new_optional(const span<const tile>& tiles_ref, compression_type comp
 
         BN_SPRITE_TILES_LOG("CREATED. start_tile: ", data.items.item(result).start_tile);
         BN_SPRITE_TILES_LOG_STATUS();
+
+        telemetry_manager::on_create(telemetry::resource_type::SPRITE_TILES);
     }
     else
     {
         BN_SPRITE_TILES_LOG("NOT CREATED");
+
+        telemetry_manager::on_create_failed(telemetry::resource_type::SPRITE_TILES);
     }
 
     return result;
@@ -931,10 +946,14 @@ int allocate_optional(int tiles_count, bpp_mode bpp)
     {
         BN_SPRITE_TILES_LOG("ALLOCATED. start_tile: ", data.items.item(result).start_tile);
         BN_SPRITE_TILES_LOG_STATUS();
+
+        telemetry_manager::on_create(telemetry::resource_type::SPRITE_TILES);
     }
     else
     {
         BN_SPRITE_TILES_LOG("NOT ALLOCATED");
+
+        telemetry_manager::on_create_failed(telemetry::resource_type::SPRITE_TILES);
     }
 
     return result;
@@ -966,6 +985,7 @@ void decrease_usages(int id)
         _erase_to_commit_item(id, item);
         _insert_to_remove_item(id);
         data.to_remove_tiles_count += item.tiles_count;
+        telemetry_manager::on_destroy(telemetry::resource_type::SPRITE_TILES);
     }
 
     BN_SPRITE_TILES_LOG_STATUS();
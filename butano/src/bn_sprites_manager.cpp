@@ -9,6 +9,7 @@
 #include "bn_sprite_first_attributes.h"
 #include "bn_sprite_regular_second_attributes.h"
 #include "bn_sorted_sprites.h"
+#include "bn_telemetry_manager.h"
 #include "../hw/include/bn_hw_sprite_affine_mats_constants.h"
 
 #include "bn_sprites.cpp.h"
@@ -157,6 +158,60 @@ namespace
         }
     }
 
+    [[nodiscard]] bool _use_interned_affine_mat(const item_type& item)
+    {
+        const sprite_affine_mat_ptr* item_affine_mat = item.affine_mat.get();
+
+        if(! item_affine_mat)
+        {
+            return sprite_affine_mats_manager::interning_enabled();
+        }
+
+        if(item_affine_mat->interned())
+        {
+            return true;
+        }
+
+        return item.remove_affine_mat_when_not_needed && sprite_affine_mats_manager::interning_enabled();
+    }
+
+    void _set_interned_affine_mat(item_type& item, const affine_mat_attributes& mat_attributes)
+    {
+        // Interned affine mats are shared, so another one is assigned instead of modifying the current one,
+        // unless the current one is only used by this sprite
+        // (it is modified in place, so no other one is allocated while it is still alive):
+
+        if(item.affine_mat && item.remove_affine_mat_when_not_needed && mat_attributes.flipped_identity())
+        {
+            _remove_affine_mat(item);
+            hw::sprites::set_horizontal_flip(mat_attributes.horizontal_flip(), item.handle);
+            hw::sprites::set_vertical_flip(mat_attributes.vertical_flip(), item.handle);
+            _update_indexes_to_commit(item);
+        }
+        else if(! item.affine_mat ||
+                ! sprite_affine_mats_manager::set_interned_attributes(item.affine_mat->id(), mat_attributes))
+        {
+            sprite_affine_mat_ptr affine_mat = sprite_affine_mat_ptr::create_interned(mat_attributes);
+
+            if(item.affine_mat != affine_mat)
+            {
+                _assign_affine_mat(item, move(affine_mat));
+            }
+        }
+    }
+
+    void _set_affine_mat_attributes(item_type& item, const affine_mat_attributes& mat_attributes)
+    {
+        if(_use_interned_affine_mat(item))
+        {
+            _set_interned_affine_mat(item, mat_attributes);
+        }
+        else
+        {
+            item.affine_mat->set_attributes(mat_attributes);
+        }
+    }
+
     void _rebuild_handles()
     {
         if(data.rebuild_handles)
@@ -263,6 +318,7 @@ id_type create(const fixed_point& position, const sprite_shape_size& shape_size,
     data.sorter.insert(new_item);
     data.check_items_on_screen = true;
     data.rebuild_handles = true;
+    telemetry_manager::on_create(telemetry::resource_type::SPRITES);
     return &new_item;
 }
 
@@ -271,6 +327,7 @@ id_type create_optional(const fixed_point& position, const sprite_shape_size& sh
 {
     if(data.items_pool.full())
     {
+        telemetry_manager::on_create_failed(telemetry::resource_type::SPRITES);
         return nullptr;
     }
 
@@ -278,6 +335,7 @@ id_type create_optional(const fixed_point& position, const sprite_shape_size& sh
     data.sorter.insert(new_item);
     data.check_items_on_screen = true;
     data.rebuild_handles = true;
+    telemetry_manager::on_create(telemetry::resource_type::SPRITES);
     return &new_item;
 }
 
@@ -294,6 +352,7 @@ id_type create(sprite_builder&& builder)
         data.rebuild_handles = true;
     }
 
+    telemetry_manager::on_create(telemetry::resource_type::SPRITES);
     return &new_item;
 }
 
@@ -301,6 +360,7 @@ id_type create_optional(sprite_builder&& builder)
 {
     if(data.items_pool.full())
     {
+        telemetry_manager::on_create_failed(telemetry::resource_type::SPRITES);
         return nullptr;
     }
 
@@ -309,6 +369,7 @@ id_type create_optional(sprite_builder&& builder)
 
     if(! tiles_ptr)
     {
+        telemetry_manager::on_create_failed(telemetry::resource_type::SPRITES);
         return nullptr;
     }
 
@@ -317,6 +378,7 @@ id_type create_optional(sprite_builder&& builder)
 
     if(! palette_ptr)
     {
+        telemetry_manager::on_create_failed(telemetry::resource_type::SPRITES);
         return nullptr;
     }
 
@@ -329,6 +391,7 @@ id_type create_optional(sprite_builder&& builder)
         data.rebuild_handles = true;
     }
 
+    telemetry_manager::on_create(telemetry::resource_type::SPRITES);
     return &new_item;
 }
 
@@ -359,6 +422,7 @@ void decrease_usages(id_type id)
         }
 
         data.items_pool.destroy(*item);
+        telemetry_manager::on_destroy(telemetry::resource_type::SPRITES);
     }
 }
 
@@ -654,6 +718,44 @@ void set_position(id_type id, const fixed_point& position)
     }
 }
 
+void set_positions(const id_type* ids, const fixed_point* positions, int count)
+{
+    bool check_items_on_screen = false;
+
+    for(int index = 0; index < count; ++index)
+    {
+        auto item = static_cast<item_type*>(ids[index]);
+        const fixed_point& position = positions[index];
+        fixed_point old_position = item->position;
+        item->position = position;
+
+        point old_integer_position(old_position.x().right_shift_integer(), old_position.y().right_shift_integer());
+        point new_integer_position(position.x().right_shift_integer(), position.y().right_shift_integer());
+        point diff = new_integer_position - old_integer_position;
+
+        if(diff != point())
+        {
+            point new_hw_position = item->hw_position + diff;
+            item->hw_position = new_hw_position;
+
+            hw::sprites::handle_type& handle = item->handle;
+            hw::sprites::set_x(new_hw_position.x(), handle);
+            hw::sprites::set_y(new_hw_position.y(), handle);
+
+            if(item->visible)
+            {
+                item->check_on_screen = true;
+                check_items_on_screen = true;
+            }
+        }
+    }
+
+    if(check_items_on_screen)
+    {
+        data.check_items_on_screen = true;
+    }
+}
+
 int bg_priority(id_type id)
 {
     auto item = static_cast<const item_type*>(id);
@@ -735,9 +837,14 @@ void set_horizontal_flip(id_type id, bool horizontal_flip)
 {
     auto item = static_cast<item_type*>(id);
 
-    if(sprite_affine_mat_ptr* item_affine_mat = item->affine_mat.get())
+    if(const sprite_affine_mat_ptr* item_affine_mat = item->affine_mat.get())
     {
-        item_affine_mat->set_horizontal_flip(horizontal_flip);
+        if(horizontal_flip != item_affine_mat->horizontal_flip())
+        {
+            affine_mat_attributes mat_attributes = item_affine_mat->attributes();
+            mat_attributes.set_horizontal_flip(horizontal_flip);
+            _set_affine_mat_attributes(*item, mat_attributes);
+        }
     }
     else
     {
@@ -767,9 +874,14 @@ void set_vertical_flip(id_type id, bool vertical_flip)
 {
     auto item = static_cast<item_type*>(id);
 
-    if(sprite_affine_mat_ptr* item_affine_mat = item->affine_mat.get())
+    if(const sprite_affine_mat_ptr* item_affine_mat = item->affine_mat.get())
     {
-        item_affine_mat->set_vertical_flip(vertical_flip);
+        if(vertical_flip != item_affine_mat->vertical_flip())
+        {
+            affine_mat_attributes mat_attributes = item_affine_mat->attributes();
+            mat_attributes.set_vertical_flip(vertical_flip);
+            _set_affine_mat_attributes(*item, mat_attributes);
+        }
     }
     else
     {
@@ -984,6 +1096,29 @@ void set_affine_mat(id_type id, sprite_affine_mat_ptr&& affine_mat)
     }
 }
 
+const optional<sprite_affine_mat_ptr>& modifiable_affine_mat(id_type id)
+{
+    auto item = static_cast<item_type*>(id);
+
+    if(const sprite_affine_mat_ptr* item_affine_mat = item->affine_mat.get())
+    {
+        if(item_affine_mat->interned())
+        {
+            // Interned affine mats can't be modified, so they are replaced with a non-interned copy:
+            item->remove_affine_mat_when_not_needed = false;
+            _assign_affine_mat(*item, sprite_affine_mat_ptr::create(item_affine_mat->attributes()));
+        }
+    }
+
+    return item->affine_mat;
+}
+
+void set_affine_mat_attributes(id_type id, const affine_mat_attributes& mat_attributes)
+{
+    auto item = static_cast<item_type*>(id);
+    _set_affine_mat_attributes(*item, mat_attributes);
+}
+
 void set_new_affine_mat(id_type id, affine_mat_attributes& mat_attributes)
 {
     auto item = static_cast<item_type*>(id);
@@ -991,7 +1126,15 @@ void set_new_affine_mat(id_type id, affine_mat_attributes& mat_attributes)
     mat_attributes.set_horizontal_flip(hw::sprites::horizontal_flip(handle));
     mat_attributes.set_vertical_flip(hw::sprites::vertical_flip(handle));
     item->remove_affine_mat_when_not_needed = true;
-    _assign_affine_mat(*item, sprite_affine_mat_ptr::create(mat_attributes));
+
+    if(sprite_affine_mats_manager::interning_enabled())
+    {
+        _assign_affine_mat(*item, sprite_affine_mat_ptr::create_interned(mat_attributes));
+    }
+    else
+    {
+        _assign_affine_mat(*item, sprite_affine_mat_ptr::create(mat_attributes));
+    }
 }
 
 void remove_affine_mat(id_type id)
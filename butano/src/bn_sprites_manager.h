@@ -104,6 +104,8 @@ namespace sprites_manager
 
     void set_position(id_type id, const fixed_point& position);
 
+    void set_positions(const id_type* ids, const fixed_point* positions, int count);
+
     [[nodiscard]] int bg_priority(id_type id);
 
     void set_bg_priority(id_type id, int bg_priority);
@@ -160,6 +162,10 @@ namespace sprites_manager
 
     void set_affine_mat(id_type id, sprite_affine_mat_ptr&& affine_mat);
 
+    [[nodiscard]] const optional<sprite_affine_mat_ptr>& modifiable_affine_mat(id_type id);
+
+    void set_affine_mat_attributes(id_type id, const affine_mat_attributes& mat_attributes);
+
     void set_new_affine_mat(id_type id, affine_mat_attributes& mat_attributes);
 
     void remove_affine_mat(id_type id);
@@ -0,0 +1,381 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sram_slot.h"
+
+#include "bn_bit.h"
+#include "bn_limits.h"
+#include "bn_memory.h"
+#include "../hw/include/bn_hw_sram.h"
+
+namespace bn
+{
+
+namespace
+{
+    // Each bank is stored as a header, a table with the CRC of each data block and the data itself.
+    // The header is written after the modified blocks, so an interrupted save leaves the other bank intact.
+
+    constexpr unsigned magic = 0x53534E42; // "BNSS"
+
+    class header_type
+    {
+
+    public:
+        unsigned magic;
+        unsigned generation;
+        unsigned data_size;
+        unsigned crc;
+    };
+
+    static_assert(sizeof(header_type) == 16);
+
+    // CRC-32 (same polynomial as zlib) with a 16 entries table:
+    constexpr unsigned crc_table[] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+
+    [[nodiscard]] unsigned _crc(const void* data, int size, unsigned crc = 0)
+    {
+        auto data_ptr = static_cast<const uint8_t*>(data);
+        crc = ~crc;
+
+        for(int index = 0; index < size; ++index)
+        {
+            unsigned byte = data_ptr[index];
+            crc = crc_table[(crc ^ byte) & 0xF] ^ (crc >> 4);
+            crc = crc_table[(crc ^ (byte >> 4)) & 0xF] ^ (crc >> 4);
+        }
+
+        return ~crc;
+    }
+
+    [[nodiscard]] bool _equal(const uint8_t* a, const uint8_t* b, int size)
+    {
+        for(int index = 0; index < size; ++index)
+        {
+            if(a[index] != b[index])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] bool _test_bit(const uint32_t* masks, int index)
+    {
+        return masks[index / 32] & (uint32_t(1) << (index % 32));
+    }
+
+    void _set_bit(uint32_t* masks, int index)
+    {
+        masks[index / 32] |= uint32_t(1) << (index % 32);
+    }
+
+    void _reset_bit(uint32_t* masks, int index)
+    {
+        masks[index / 32] &= ~(uint32_t(1) << (index % 32));
+    }
+
+    void _set_bits(uint32_t* masks, int count)
+    {
+        for(int index = 0; index < count; ++index)
+        {
+            _set_bit(masks, index);
+        }
+    }
+}
+
+int isram_slot::pending_blocks() const
+{
+    int result = 0;
+
+    for(int index = 0; index < _masks_count; ++index)
+    {
+        result += popcount(_dirty_masks[index]);
+    }
+
+    return result;
+}
+
+bool isram_slot::update(int max_bytes)
+{
+    BN_ASSERT(max_bytes > 0, "Invalid max bytes: ", max_bytes);
+
+    if(! _saving)
+    {
+        return true;
+    }
+
+    int bank = _active_bank == 0 ? 1 : 0;
+    int bytes = 0;
+
+    for(int block = 0; block < _blocks_count; ++block)
+    {
+        if(_test_bit(_dirty_masks, block))
+        {
+            int block_bytes = _block_size(block) + int(sizeof(uint32_t));
+
+            if(bytes && bytes + block_bytes > max_bytes)
+            {
+                return false;
+            }
+
+            _write_block(bank, block);
+            _reset_bit(_dirty_masks, block);
+            bytes += block_bytes;
+        }
+    }
+
+    _commit();
+    return true;
+}
+
+void isram_slot::flush()
+{
+    update(numeric_limits<int>::max());
+}
+
+isram_slot::isram_slot(uint8_t* image, uint32_t* crcs, uint32_t* masks, int offset, int data_size) :
+    _image(image),
+    _crcs(crcs),
+    _offset(offset),
+    _data_size(data_size),
+    _blocks_count(blocks_count(data_size)),
+    _masks_count(_masks_count_of(data_size))
+{
+    BN_ASSERT(offset >= 0, "Invalid offset: ", offset);
+    BN_ASSERT(sram_size(data_size) + offset <= sram::size(),
+              "Data size and offset are too high: ", data_size, " - ", offset);
+
+    _dirty_masks = masks;
+    _stale_masks = masks + _masks_count;
+    _next_stale_masks = _stale_masks + _masks_count;
+    memory::clear(_masks_count * 3, *masks);
+}
+
+bool isram_slot::_load(void* destination)
+{
+    unsigned generations[2];
+    bool valid_headers[2] = { _read_header(0, generations[0]), _read_header(1, generations[1]) };
+    int first_bank = 0;
+
+    if(valid_headers[0] && valid_headers[1])
+    {
+        first_bank = int(generations[1] - generations[0]) > 0 ? 1 : 0;
+    }
+    else if(valid_headers[1])
+    {
+        first_bank = 1;
+    }
+
+    int second_bank = first_bank == 0 ? 1 : 0;
+    _active_bank = -1;
+    _generation = 0;
+    _loaded = true;
+    _saving = false;
+    memory::clear(_masks_count, *_dirty_masks);
+
+    if(valid_headers[first_bank] && _read_bank(first_bank))
+    {
+        _active_bank = int8_t(first_bank);
+        _generation = generations[first_bank];
+    }
+    else if(valid_headers[second_bank] && _read_bank(second_bank))
+    {
+        _active_bank = int8_t(second_bank);
+        _generation = generations[second_bank];
+    }
+
+    if(_active_bank < 0)
+    {
+        memory::set_bytes(0, _data_size, _image);
+        memory::clear(_masks_count, *_stale_masks);
+        _set_bits(_stale_masks, _blocks_count);
+
+        for(int block = 0; block < _blocks_count; ++block)
+        {
+            _crcs[block] = _crc(_image + (block * block_size()), _block_size(block));
+        }
+
+        return false;
+    }
+
+    _update_stale_masks(_active_bank == 0 ? 1 : 0);
+    memory::copy(*_image, _data_size, *static_cast<uint8_t*>(destination));
+    return true;
+}
+
+void isram_slot::_save(const void* source)
+{
+    BN_ASSERT(_loaded, "SRAM slot is not loaded");
+
+    if(! _saving)
+    {
+        memory::copy(*_stale_masks, _masks_count, *_dirty_masks);
+        _written_blocks = 0;
+        memory::clear(_masks_count, *_next_stale_masks);
+
+        if(_active_bank < 0)
+        {
+            _set_bits(_next_stale_masks, _blocks_count);
+        }
+    }
+
+    auto source_ptr = static_cast<const uint8_t*>(source);
+    bool changed = false;
+
+    for(int block = 0; block < _blocks_count; ++block)
+    {
+        int block_offset = block * block_size();
+        int block_bytes = _block_size(block);
+        uint8_t* image_ptr = _image + block_offset;
+        const uint8_t* block_ptr = source_ptr + block_offset;
+
+        if(! _equal(image_ptr, block_ptr, block_bytes))
+        {
+            memory::copy(*block_ptr, block_bytes, *image_ptr);
+            _crcs[block] = _crc(image_ptr, block_bytes);
+            _set_bit(_dirty_masks, block);
+            _set_bit(_next_stale_masks, block);
+            changed = true;
+        }
+    }
+
+    if(changed || _active_bank < 0)
+    {
+        _saving = true;
+    }
+    else if(! _saving)
+    {
+        // The active bank already contains the given data, so there's nothing to write:
+        memory::clear(_masks_count, *_dirty_masks);
+    }
+}
+
+int isram_slot::_bank_size() const
+{
+    return sram_size(_data_size) / 2;
+}
+
+int isram_slot::_bank_offset(int bank) const
+{
+    return _offset + (bank * _bank_size());
+}
+
+int isram_slot::_block_size(int block) const
+{
+    return min(block_size(), _data_size - (block * block_size()));
+}
+
+bool isram_slot::_read_header(int bank, unsigned& generation) const
+{
+    int bank_offset = _bank_offset(bank);
+    header_type header;
+    hw::sram::read(&header, int(sizeof(header)), bank_offset);
+
+    if(header.magic != magic || header.data_size != unsigned(_data_size))
+    {
+        return false;
+    }
+
+    uint8_t buffer[block_size()];
+    int table_offset = bank_offset + _header_size;
+    int table_size = _blocks_count * int(sizeof(uint32_t));
+    unsigned crc = _crc(&header.generation, int(sizeof(header.generation) + sizeof(header.data_size)));
+
+    for(int index = 0; index < table_size; index += block_size())
+    {
+        int bytes = min(block_size(), table_size - index);
+        hw::sram::read(buffer, bytes, table_offset + index);
+        crc = _crc(buffer, bytes, crc);
+    }
+
+    if(crc != header.crc)
+    {
+        return false;
+    }
+
+    generation = header.generation;
+    return true;
+}
+
+bool isram_slot::_read_bank(int bank)
+{
+    int bank_offset = _bank_offset(bank);
+    int table_offset = bank_offset + _header_size;
+    int data_offset = table_offset + (_blocks_count * int(sizeof(uint32_t)));
+    hw::sram::read(_crcs, _blocks_count * int(sizeof(uint32_t)), table_offset);
+    hw::sram::read(_image, _data_size, data_offset);
+
+    for(int block = 0; block < _blocks_count; ++block)
+    {
+        if(_crc(_image + (block * block_size()), _block_size(block)) != _crcs[block])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void isram_slot::_update_stale_masks(int bank)
+{
+    // Blocks of the other bank equal to the loaded ones don't need to be written by the next save:
+
+    int bank_offset = _bank_offset(bank);
+    int table_offset = bank_offset + _header_size;
+    int data_offset = table_offset + (_blocks_count * int(sizeof(uint32_t)));
+    uint8_t buffer[block_size()];
+    memory::clear(_masks_count, *_stale_masks);
+
+    for(int block = 0; block < _blocks_count; ++block)
+    {
+        int block_offset = block * block_size();
+        int block_bytes = _block_size(block);
+        uint32_t crc;
+        hw::sram::read(&crc, int(sizeof(crc)), table_offset + (block * int(sizeof(crc))));
+        hw::sram::read(buffer, block_bytes, data_offset + block_offset);
+
+        if(crc != _crcs[block] || ! _equal(buffer, _image + block_offset, block_bytes))
+        {
+            _set_bit(_stale_masks, block);
+        }
+    }
+}
+
+void isram_slot::_write_block(int bank, int block)
+{
+    int bank_offset = _bank_offset(bank);
+    int table_offset = bank_offset + _header_size;
+    int data_offset = table_offset + (_blocks_count * int(sizeof(uint32_t)));
+    int block_offset = block * block_size();
+    hw::sram::write(_image + block_offset, _block_size(block), data_offset + block_offset);
+    hw::sram::write(_crcs + block, int(sizeof(uint32_t)), table_offset + (block * int(sizeof(uint32_t))));
+    ++_written_blocks;
+}
+
+void isram_slot::_commit()
+{
+    int bank = _active_bank == 0 ? 1 : 0;
+    header_type header;
+    header.magic = magic;
+    header.generation = _generation + 1;
+    header.data_size = unsigned(_data_size);
+
+    unsigned crc = _crc(&header.generation, int(sizeof(header.generation) + sizeof(header.data_size)));
+    header.crc = _crc(_crcs, _blocks_count * int(sizeof(uint32_t)), crc);
+    hw::sram::write(&header, int(sizeof(header)), _bank_offset(bank));
+
+    _generation = header.generation;
+    _active_bank = int8_t(bank);
+    _last_written_blocks = _written_blocks;
+    _saving = false;
+    memory::copy(*_next_stale_masks, _masks_count, *_stale_masks);
+}
+
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_stream_music.h"
+
+#include "bn_stream_music_item.h"
+#include "bn_audio_manager.h"
+
+namespace bn::stream_music
+{
+
+bool playing()
+{
+    return audio_manager::stream_music_playing();
+}
+
+optional<stream_music_item> playing_item()
+{
+    return audio_manager::playing_stream_music_item();
+}
+
+void play(const stream_music_item& item)
+{
+    audio_manager::play_stream_music(item, 1, true);
+}
+
+void play(const stream_music_item& item, fixed volume)
+{
+    BN_ASSERT(volume >= 0 && volume <= 1, "Volume range is [0..1]: ", volume);
+
+    audio_manager::play_stream_music(item, volume, true);
+}
+
+void play(const stream_music_item& item, fixed volume, bool loop)
+{
+    BN_ASSERT(volume >= 0 && volume <= 1, "Volume range is [0..1]: ", volume);
+
+    audio_manager::play_stream_music(item, volume, loop);
+}
+
+void stop()
+{
+    audio_manager::stop_stream_music();
+}
+
+bool paused()
+{
+    return audio_manager::stream_music_paused();
+}
+
+void pause()
+{
+    audio_manager::pause_stream_music();
+}
+
+void resume()
+{
+    audio_manager::resume_stream_music();
+}
+
+fixed volume()
+{
+    return audio_manager::stream_music_volume();
+}
+
+void set_volume(fixed volume)
+{
+    BN_ASSERT(volume >= 0 && volume <= 1, "Volume range is [0..1]: ", volume);
+
+    audio_manager::set_stream_music_volume(volume);
+}
+
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_stream_music_item.h"
+
+#include "bn_stream_music.h"
+
+namespace bn
+{
+
+void stream_music_item::play() const
+{
+    stream_music::play(*this);
+}
+
+void stream_music_item::play(fixed volume) const
+{
+    stream_music::play(*this, volume);
+}
+
+void stream_music_item::play(fixed volume, bool loop) const
+{
+    stream_music::play(*this, volume, loop);
+}
+
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_telemetry_manager.h"
+
+#if BN_CFG_TELEMETRY_ENABLED
+    #include "bn_memory.h"
+    #include "bn_algorithm.h"
+    #include "bn_bgs_manager.h"
+    #include "bn_palettes_bank.h"
+    #include "bn_memory_manager.h"
+    #include "bn_cameras_manager.h"
+    #include "bn_sprites_manager.h"
+    #include "bn_palettes_manager.h"
+    #include "bn_bg_blocks_manager.h"
+    #include "bn_sprite_tiles_manager.h"
+    #include "bn_hblank_effects_manager.h"
+    #include "bn_frame_allocator_manager.h"
+    #include "bn_sprite_affine_mats_manager.h"
+    #include "../hw/include/bn_hw_memory.h"
+
+    #if BN_CFG_LOG_ENABLED
+        #include "bn_log.h"
+    #endif
+
+    namespace bn::telemetry_manager
+    {
+        namespace
+        {
+            constexpr int resources_count = int(telemetry::resource_type::FRAME_ALLOCATOR_BYTES) + 1;
+
+            class resource_data
+            {
+
+            public:
+                int max_used = 0;
+                int created = 0;
+                int destroyed = 0;
+                int max_created = 0;
+                int max_destroyed = 0;
+                int failed_creations = 0;
+            };
+
+            class static_data
+            {
+
+            public:
+                resource_data resources[resources_count];
+            };
+
+            BN_DATA_EWRAM static_data data;
+
+            [[nodiscard]] int _used(telemetry::resource_type resource)
+            {
+                switch(resource)
+                {
+
+                case telemetry::resource_type::SPRITES:
+                    return sprites_manager::used_items_count();
+
+                case telemetry::resource_type::SPRITE_TILES:
+                    return sprite_tiles_manager::used_tiles_count();
+
+                case telemetry::resource_type::SPRITE_AFFINE_MATS:
+                    return sprite_affine_mats_manager::used_count();
+
+                case telemetry::resource_type::SPRITE_PALETTE_COLORS:
+                    return palettes_manager::sprite_palettes_bank().used_colors_count();
+
+                case telemetry::resource_type::BGS:
+                    return bgs_manager::used_count();
+
+                case telemetry::resource_type::BG_TILES:
+                    return bg_blocks_manager::used_tiles_count();
+
+                case telemetry::resource_type::BG_MAP_CELLS:
+                    return bg_blocks_manager::used_map_cells_count();
+
+                case telemetry::resource_type::BG_PALETTE_COLORS:
+                    return palettes_manager::bg_palettes_bank().used_colors_count();
+
+                case telemetry::resource_type::HBES:
+                    return hblank_effects_manager::used_count();
+
+                case telemetry::resource_type::CAMERAS:
+                    return cameras_manager::used_items_count();
+
+                case telemetry::resource_type::EWRAM_HEAP_BYTES:
+                    return memory_manager::used_alloc_ewram();
+
+                case telemetry::resource_type::FRAME_ALLOCATOR_BYTES:
+                    return frame_allocator_manager::used_bytes();
+
+                default:
+                    BN_ERROR("Invalid resource: ", int(resource));
+                    return 0;
+                }
+            }
+
+            #if BN_CFG_LOG_ENABLED
+                [[nodiscard]] const char* _name(telemetry::resource_type resource)
+                {
+                    switch(resource)
+                    {
+
+                    case telemetry::resource_type::SPRITES:
+                        return "sprites";
+
+                    case telemetry::resource_type::SPRITE_TILES:
+                        return "sprite_tiles";
+
+                    case telemetry::resource_type::SPRITE_AFFINE_MATS:
+                        return "sprite_affine_mats";
+
+                    case telemetry::resource_type::SPRITE_PALETTE_COLORS:
+                        return "sprite_palette_colors";
+
+                    case telemetry::resource_type::BGS:
+                        return "bgs";
+
+                    case telemetry::resource_type::BG_TILES:
+                        return "bg_tiles";
+
+                    case telemetry::resource_type::BG_MAP_CELLS:
+                        return "bg_map_cells";
+
+                    case telemetry::resource_type::BG_PALETTE_COLORS:
+                        return "bg_palette_colors";
+
+                    case telemetry::resource_type::HBES:
+                        return "hbes";
+
+                    case telemetry::resource_type::CAMERAS:
+                        return "cameras";
+
+                    case telemetry::resource_type::EWRAM_HEAP_BYTES:
+                        return "ewram_heap_bytes";
+
+                    case telemetry::resource_type::FRAME_ALLOCATOR_BYTES:
+                        return "frame_allocator_bytes";
+
+                    default:
+                        BN_ERROR("Invalid resource: ", int(resource));
+                        return "";
+                    }
+                }
+            #endif
+
+            [[nodiscard]] const resource_data& _resource_data(telemetry::resource_type resource)
+            {
+                BN_ASSERT(int(resource) < resources_count, "Invalid resource: ", int(resource));
+
+                return data.resources[int(resource)];
+            }
+        }
+
+        void init()
+        {
+            hw::memory::paint_stack_iwram(hw::memory::stack_address());
+        }
+
+        void update()
+        {
+            for(int index = 0; index < resources_count; ++index)
+            {
+                resource_data& resource = data.resources[index];
+                resource.max_used = max(resource.max_used, _used(telemetry::resource_type(index)));
+                resource.max_created = max(resource.max_created, resource.created);
+                resource.max_destroyed = max(resource.max_destroyed, resource.destroyed);
+                resource.created = 0;
+                resource.destroyed = 0;
+            }
+        }
+
+        void on_create(telemetry::resource_type resource)
+        {
+            ++data.resources[int(resource)].created;
+        }
+
+        void on_destroy(telemetry::resource_type resource)
+        {
+            ++data.resources[int(resource)].destroyed;
+        }
+
+        void on_create_failed(telemetry::resource_type resource)
+        {
+            ++data.resources[int(resource)].failed_creations;
+        }
+    }
+
+    namespace bn::telemetry
+    {
+        int max_used(resource_type resource)
+        {
+            return telemetry_manager::_resource_data(resource).max_used;
+        }
+
+        int max_created_per_frame(resource_type resource)
+        {
+            return telemetry_manager::_resource_data(resource).max_created;
+        }
+
+        int max_destroyed_per_frame(resource_type resource)
+        {
+            return telemetry_manager::_resource_data(resource).max_destroyed;
+        }
+
+        int failed_creations(resource_type resource)
+        {
+            return telemetry_manager::_resource_data(resource).failed_creations;
+        }
+
+        int max_used_stack_iwram()
+        {
+            return hw::memory::max_used_stack_iwram();
+        }
+
+        void reset()
+        {
+            for(telemetry_manager::resource_data& resource : telemetry_manager::data.resources)
+            {
+                resource = telemetry_manager::resource_data();
+            }
+        }
+
+        #if BN_CFG_LOG_ENABLED
+            void log()
+            {
+                BN_LOG("telemetry: ");
+                BN_LOG('[');
+
+                for(int index = 0; index < telemetry_manager::resources_count; ++index)
+                {
+                    auto resource_type = telemetry::resource_type(index);
+                    const telemetry_manager::resource_data& resource = telemetry_manager::data.resources[index];
+                    BN_LOG("    ", telemetry_manager::_name(resource_type),
+                           " - max_used: ", resource.max_used,
+                           " - max_created_per_frame: ", resource.max_created,
+                           " - max_destroyed_per_frame: ", resource.max_destroyed,
+                           " - failed_creations: ", resource.failed_creations);
+                }
+
+                BN_LOG(']');
+                BN_LOG("max_used_stack_iwram: ", max_used_stack_iwram());
+                BN_LOG("used_static_iwram: ", memory::used_static_iwram());
+                BN_LOG("used_static_ewram: ", memory::used_static_ewram());
+            }
+        #endif
+    }
+#endif
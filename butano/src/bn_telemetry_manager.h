@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_TELEMETRY_MANAGER_H
+#define BN_TELEMETRY_MANAGER_H
+
+#include "bn_telemetry.h"
+
+namespace bn::telemetry_manager
+{
+    #if BN_CFG_TELEMETRY_ENABLED
+        void init();
+
+        void update();
+
+        void on_create(telemetry::resource_type resource);
+
+        void on_destroy(telemetry::resource_type resource);
+
+        void on_create_failed(telemetry::resource_type resource);
+    #else
+        inline void init()
+        {
+        }
+
+        inline void update()
+        {
+        }
+
+        inline void on_create(telemetry::resource_type)
+        {
+        }
+
+        inline void on_destroy(telemetry::resource_type)
+        {
+        }
+
+        inline void on_create_failed(telemetry::resource_type)
+        {
+        }
+    #endif
+}
+
+#endif
@@ -5,6 +5,7 @@ import traceback
 from butano_audio_tool import process_audio
 from butano_dmg_audio_tool import process_dmg_audio
 from butano_graphics_tool import process_graphics
+from butano_models_3d_tool import process_models_3d
 
 
 if __name__ == "__main__":
@@ -12,13 +13,16 @@ if __name__ == "__main__":
     parser.add_argument('--audio', required=True, help='audio folder paths')
     parser.add_argument('--dmg_audio', required=True, help='dmg audio folder paths')
     parser.add_argument('--graphics', required=True, help='graphics folder paths')
+    parser.add_argument('--models_3d', default='', help='3D models folder paths')
+    parser.add_argument('--user_flags', default='', help='additional compiler flags')
     parser.add_argument('--build', required=True, help='build folder path')
 
     try:
         args = parser.parse_args()
-        process_audio(args.audio, args.build)
+        process_audio(args.audio, args.user_flags, args.build)
         process_dmg_audio(args.dmg_audio, args.build)
         process_graphics(args.graphics, args.build)
+        process_models_3d(args.models_3d, args.build)
     except Exception as ex:
         sys.stderr.write('Error: ' + str(ex) + '\n')
         traceback.print_exc()
@@ -4,17 +4,108 @@ zlib License, see LICENSE file.
 """
 
 import os
+import re
+import json
+import wave
+import struct
 import subprocess
 import sys
 
 from file_info import FileInfo
 
 
-def list_audio_files(audio_folder_paths):
+mixing_rates = [8, 10, 13, 16, 18, 21, 27, 31]
+
+mixing_rate_samples_per_frame = [136, 176, 224, 264, 304, 352, 448, 528]
+
+frames_per_second = 16777216 / 280896
+
+ima_adpcm_index_table = [-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8]
+
+ima_adpcm_step_table = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107,
+    118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894,
+    6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767]
+
+
+def parse_mixing_rate(user_flags):
+    # Mixing rate is specified with BN_CFG_AUDIO_MIXING_RATE in USERFLAGS (16KHz by default):
+
+    match = re.search(r'-DBN_CFG_AUDIO_MIXING_RATE=(\w+)', user_flags)
+
+    if match is None:
+        return mixing_rates.index(16)
+
+    value = match.group(1)
+    rate_match = re.fullmatch(r'BN_AUDIO_MIXING_RATE_(\d+)_KHZ', value)
+
+    if rate_match is not None:
+        mixing_rate = int(rate_match.group(1))
+
+        if mixing_rate in mixing_rates:
+            return mixing_rates.index(mixing_rate)
+    elif value.isdigit() and int(value) < len(mixing_rates):
+        return int(value)
+
+    raise ValueError('Invalid BN_CFG_AUDIO_MIXING_RATE value: ' + value)
+
+
+def mixing_rate_frequency(mixing_rate):
+    return mixing_rate_samples_per_frame[mixing_rate] * frames_per_second
+
+
+def read_audio_info(json_file_path):
+    with open(json_file_path) as json_file:
+        return json.load(json_file)
+
+
+def read_stream_music_info(info, json_file_path, default_mixing_rate):
+    if info.get('type') != 'stream_music':
+        return None
+
+    audio_format = info.get('format', 'adpcm')
+
+    if audio_format not in ('adpcm', 'pcm8'):
+        raise ValueError('Invalid stream music format in ' + json_file_path + ': ' + str(audio_format))
+
+    # Mixing rate must match BN_CFG_AUDIO_MIXING_RATE, so it is used by default:
+    mixing_rate = info.get('mixing_rate', mixing_rates[default_mixing_rate])
+
+    if mixing_rate not in mixing_rates:
+        raise ValueError('Invalid stream music mixing rate in ' + json_file_path + ': ' + str(mixing_rate))
+
+    return audio_format, mixing_rates.index(mixing_rate)
+
+
+def read_sound_info(info, json_file_path):
+    if info.get('type', 'sound') != 'sound':
+        raise ValueError('Invalid audio type in ' + json_file_path + ': ' + str(info.get('type')))
+
+    resample_enabled = info.get('resample', True)
+
+    if not isinstance(resample_enabled, bool):
+        raise ValueError('Invalid resample field in ' + json_file_path + ': ' + str(resample_enabled))
+
+    speeds = info.get('speeds', [])
+
+    for speed in speeds:
+        if not isinstance(speed, (int, float)) or speed <= 0 or speed > 64 or \
+                abs((speed * 100) - round(speed * 100)) > 0.0001:
+            raise ValueError('Invalid speed in ' + json_file_path + ': ' + str(speed))
+
+    return resample_enabled, speeds
+
+
+def list_audio_files(audio_folder_paths, mixing_rate):
     audio_folder_path_list = audio_folder_paths.split(' ')
     audio_file_names = []
     audio_file_names_no_ext = []
     audio_file_paths = []
+    sound_files = []
+    stream_music_files = []
+    info_file_paths = []
 
     for audio_folder_path in audio_folder_path_list:
         folder_audio_file_names = sorted(os.listdir(audio_folder_path))
@@ -25,11 +116,262 @@ def list_audio_files(audio_folder_paths):
             if os.path.isfile(audio_file_path) and FileInfo.validate(audio_file_name):
                 audio_file_name_split = os.path.splitext(audio_file_name)
                 audio_file_name_no_ext = audio_file_name_split[0]
+                audio_file_name_ext = audio_file_name_split[1]
+
+                if audio_file_name_ext == '.json':
+                    info_file_paths.append(audio_file_path)
+                    continue
+
                 audio_file_names.append(audio_file_name)
+
+                if audio_file_name_ext != '.wav':
+                    audio_file_names_no_ext.append(audio_file_name_no_ext)
+                    audio_file_paths.append(audio_file_path)
+                    continue
+
+                json_file_path = audio_folder_path + '/' + audio_file_name_no_ext + '.json'
+                sound_info = True, []
+
+                if os.path.isfile(json_file_path):
+                    info = read_audio_info(json_file_path)
+                    stream_music_info = read_stream_music_info(info, json_file_path, mixing_rate)
+
+                    if stream_music_info is not None:
+                        stream_music_files.append([audio_file_name_no_ext, audio_file_path, stream_music_info])
+                        continue
+
+                    sound_info = read_sound_info(info, json_file_path)
+
+                sound_files.append([audio_file_name_no_ext, audio_file_path, sound_info])
                 audio_file_names_no_ext.append(audio_file_name_no_ext)
-                audio_file_paths.append(audio_file_path)
 
-    return audio_file_names, audio_file_names_no_ext, audio_file_paths
+                for speed in sound_info[1]:
+                    audio_file_names_no_ext.append(sound_variant_name(audio_file_name_no_ext, speed))
+
+    return audio_file_names, audio_file_names_no_ext, audio_file_paths, sound_files, stream_music_files, \
+        info_file_paths
+
+
+def sound_variant_name(name, speed):
+    return name + '_speed_' + str(int(round(speed * 100)))
+
+
+def read_wav_file(wav_file_path):
+    with wave.open(wav_file_path, 'rb') as wav_file:
+        channels = wav_file.getnchannels()
+        sample_width = wav_file.getsampwidth()
+        sample_rate = wav_file.getframerate()
+        frames = wav_file.readframes(wav_file.getnframes())
+
+    if sample_width == 1:
+        values = [(value - 128) << 8 for value in frames]
+    elif sample_width == 2:
+        values = list(struct.unpack('<' + str(len(frames) // 2) + 'h', frames))
+    else:
+        raise ValueError('Unsupported WAV sample width: ' + str(sample_width * 8) + ' bits')
+
+    # Downmix to mono:
+
+    samples = []
+
+    for index in range(0, len(values) - channels + 1, channels):
+        samples.append(sum(values[index:index + channels]) // channels)
+
+    return samples, sample_rate
+
+
+def resample(samples, input_rate, output_rate):
+    if not samples:
+        raise ValueError('WAV file is empty')
+
+    output_samples_count = max(int(len(samples) * output_rate / input_rate), 1)
+    step = input_rate / output_rate
+    last_index = len(samples) - 1
+    output_samples = []
+
+    if step > 1:
+        # Downsampling averages all input samples covered by each output sample to reduce aliasing:
+
+        for output_index in range(output_samples_count):
+            begin = min(int(output_index * step), last_index)
+            end = min(max(int((output_index + 1) * step), begin + 1), last_index + 1)
+            output_samples.append(sum(samples[begin:end]) // (end - begin))
+    else:
+        for output_index in range(output_samples_count):
+            position = output_index * step
+            index = min(int(position), last_index)
+            next_index = min(index + 1, last_index)
+            weight = position - index
+            output_samples.append(int(samples[index] + ((samples[next_index] - samples[index]) * weight)))
+
+    return output_samples
+
+
+def write_wav_file(samples, sample_rate, wav_file_path):
+    with wave.open(wav_file_path, 'wb') as wav_file:
+        wav_file.setnchannels(1)
+        wav_file.setsampwidth(2)
+        wav_file.setframerate(sample_rate)
+        wav_file.writeframes(struct.pack('<' + str(len(samples)) + 'h', *samples))
+
+
+def prepare_sound_files(sound_files, mixing_rate, build_folder_path):
+    # Sound effects are resampled to the mixing rate, so Maxmod plays them at speed 1
+    # without skipping or repeating samples. Speed variants are resampled from the original file too:
+
+    output_folder_path = build_folder_path + '/_bn_audio_sounds'
+    output_rate = mixing_rate_frequency(mixing_rate)
+    output_file_paths = []
+
+    if not os.path.isdir(output_folder_path):
+        os.makedirs(output_folder_path)
+
+    for sound_file in sound_files:
+        name = sound_file[0]
+        sound_file_path = sound_file[1]
+        resample_enabled, speeds = sound_file[2]
+
+        if not resample_enabled and not speeds:
+            output_file_paths.append(sound_file_path)
+            continue
+
+        samples, sample_rate = read_wav_file(sound_file_path)
+
+        if resample_enabled and sample_rate != int(round(output_rate)):
+            output_file_path = output_folder_path + '/' + name + '.wav'
+            write_wav_file(resample(samples, sample_rate, output_rate), int(round(output_rate)), output_file_path)
+            output_file_paths.append(output_file_path)
+        else:
+            output_file_paths.append(sound_file_path)
+
+        for speed in speeds:
+            variant_rate = output_rate if resample_enabled else sample_rate
+            variant_samples = resample(samples, sample_rate * speed, variant_rate)
+            output_file_path = output_folder_path + '/' + sound_variant_name(name, speed) + '.wav'
+            write_wav_file(variant_samples, int(round(variant_rate)), output_file_path)
+            output_file_paths.append(output_file_path)
+
+    return output_file_paths
+
+
+def encode_pcm8(samples):
+    return bytes([(sample >> 8) & 0xFF for sample in samples])
+
+
+def encode_ima_adpcm(samples):
+    # Same state tracking as the decoder (bn_hw_stream_music.bn_iwram.cpp), starting with predictor and index at 0:
+
+    predictor = 0
+    step_index = 0
+    nibbles = []
+
+    for sample in samples:
+        step = ima_adpcm_step_table[step_index]
+        difference = sample - predictor
+        nibble = 0
+
+        if difference < 0:
+            nibble = 8
+            difference = -difference
+
+        if difference >= step:
+            nibble |= 4
+            difference -= step
+
+        if difference >= step >> 1:
+            nibble |= 2
+            difference -= step >> 1
+
+        if difference >= step >> 2:
+            nibble |= 1
+
+        decoded_difference = step >> 3
+
+        if nibble & 4:
+            decoded_difference += step
+
+        if nibble & 2:
+            decoded_difference += step >> 1
+
+        if nibble & 1:
+            decoded_difference += step >> 2
+
+        if nibble & 8:
+            predictor = max(predictor - decoded_difference, -32768)
+        else:
+            predictor = min(predictor + decoded_difference, 32767)
+
+        step_index = min(max(step_index + ima_adpcm_index_table[nibble], 0), len(ima_adpcm_step_table) - 1)
+        nibbles.append(nibble)
+
+    if len(nibbles) % 2:
+        nibbles.append(0)
+
+    # Low nibble first:
+
+    return bytes([nibbles[index] | (nibbles[index + 1] << 4) for index in range(0, len(nibbles), 2)])
+
+
+def process_stream_music_files(stream_music_files, build_folder_path):
+    total_size = 0
+    output_file_path = build_folder_path + '/_bn_audio_stream_music.c'
+
+    with open(output_file_path, 'w') as output_file:
+        output_file.write('#include <stdint.h>' + '\n')
+
+        for stream_music_file in stream_music_files:
+            name = stream_music_file[0]
+            audio_format, mixing_rate = stream_music_file[2]
+            samples, sample_rate = read_wav_file(stream_music_file[1])
+            output_rate = mixing_rate_frequency(mixing_rate)
+            samples = resample(samples, sample_rate, output_rate)
+
+            if audio_format == 'adpcm':
+                data = encode_ima_adpcm(samples)
+                format_name = 'IMA_ADPCM'
+            else:
+                data = encode_pcm8(samples)
+                format_name = 'PCM_8'
+
+            data_name = '_bn_audio_stream_music_' + name + '_data'
+            output_file.write('\n')
+            output_file.write('const uint8_t ' + data_name + '[] __attribute__((aligned(4))) = {' + '\n')
+
+            for index in range(0, len(data), 32):
+                output_file.write('    ' + ', '.join(str(value) for value in data[index:index + 32]) + ',\n')
+
+            output_file.write('};' + '\n')
+            header_file_path = write_stream_music_header(name, data_name, len(samples), mixing_rate, format_name,
+                                                         build_folder_path)
+            print('    ' + name + ' stream music item header written in ' + header_file_path)
+            total_size += len(data)
+
+    return total_size
+
+
+def write_stream_music_header(name, data_name, samples_count, mixing_rate, format_name, build_folder_path):
+    header_file_path = build_folder_path + '/bn_stream_music_items_' + name + '.h'
+
+    with open(header_file_path, 'w') as header_file:
+        include_guard = 'BN_STREAM_MUSIC_ITEMS_' + name.upper() + '_H'
+        header_file.write('#ifndef ' + include_guard + '\n')
+        header_file.write('#define ' + include_guard + '\n')
+        header_file.write('\n')
+        header_file.write('#include "bn_stream_music_item.h"' + '\n')
+        header_file.write('\n')
+        header_file.write('extern const uint8_t ' + data_name + '[];' + '\n')
+        header_file.write('\n')
+        header_file.write('namespace bn::stream_music_items' + '\n')
+        header_file.write('{' + '\n')
+        header_file.write('    constexpr inline stream_music_item ' + name + '(*' + data_name + ', ' +
+                          str(samples_count) + ', ' + str(mixing_rate) + ', stream_music_format::' + format_name +
+                          ');' + '\n')
+        header_file.write('}' + '\n')
+        header_file.write('\n')
+        header_file.write('#endif' + '\n')
+        header_file.write('\n')
+
+    return header_file_path
 
 
 def process_audio_files(audio_file_paths, soundbank_bin_path, soundbank_header_path, build_folder_path):
@@ -161,11 +503,16 @@ def write_output_files(audio_file_names_no_ext, soundbank_header_path, build_fol
                            'sound_item', build_folder_path + '/bn_sound_items_info.h')
 
 
-def process_audio(audio_folder_paths, build_folder_path):
-    audio_file_names, audio_file_names_no_ext, audio_file_paths = list_audio_files(audio_folder_paths)
+def process_audio(audio_folder_paths, user_flags, build_folder_path):
+    mixing_rate = parse_mixing_rate(user_flags)
+    audio_file_names, audio_file_names_no_ext, audio_file_paths, sound_files, stream_music_files, info_file_paths = \
+        list_audio_files(audio_folder_paths, mixing_rate)
     file_info_path = build_folder_path + '/_bn_audio_files_info.txt'
     old_file_info = FileInfo.read(file_info_path)
-    new_file_info = FileInfo.build_from_files(audio_file_paths)
+    new_file_info = FileInfo.build_from_files(
+        audio_file_paths + [sound_file[1] for sound_file in sound_files] +
+        [stream_music_file[1] for stream_music_file in stream_music_files] + info_file_paths,
+        'mixing_rate: ' + str(mixing_rate))
 
     if old_file_info == new_file_info:
         return
@@ -177,8 +524,10 @@ def process_audio(audio_folder_paths, build_folder_path):
 
     soundbank_bin_path = build_folder_path + '/_bn_audio_soundbank.bin'
     soundbank_header_path = build_folder_path + '/_bn_audio_soundbank.h'
+    audio_file_paths += prepare_sound_files(sound_files, mixing_rate, build_folder_path)
     total_size = process_audio_files(audio_file_paths, soundbank_bin_path, soundbank_header_path, build_folder_path)
     write_output_files(audio_file_names_no_ext, soundbank_header_path, build_folder_path)
+    total_size += process_stream_music_files(stream_music_files, build_folder_path)
     print('    Processed audio size: ' + str(total_size) + ' bytes')
     os.remove(soundbank_header_path)
     new_file_info.write(file_info_path)
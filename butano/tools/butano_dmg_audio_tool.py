@@ -5,6 +5,7 @@ zlib License, see LICENSE file.
 
 import os
 import sys
+import json
 from multiprocessing import Pool
 
 from file_info import FileInfo
@@ -12,12 +13,13 @@ from file_info import FileInfo
 
 class DmgAudioFileInfo:
 
-    def __init__(self, file_path, file_name, file_name_no_ext, file_info_path, is_mod):
+    def __init__(self, file_path, file_name, file_name_no_ext, file_info_path, is_mod, precompiled):
         self.__file_path = file_path
         self.__file_name = file_name
         self.__file_name_no_ext = file_name_no_ext
         self.__file_info_path = file_info_path
         self.__is_mod = is_mod
+        self.__precompiled = precompiled
 
     def print_file_name(self):
         print(self.__file_name)
@@ -34,6 +36,9 @@ class DmgAudioFileInfo:
             else:
                 self.__execute_s3m2gbt_command(output_tag, output_file_path)
 
+            if self.__precompiled:
+                self.__compile_song(output_tag, output_file_path)
+
             header_file_path = self.__write_header(build_folder_path, output_tag)
 
             with open(self.__file_info_path, 'w') as file_info:
@@ -72,6 +77,14 @@ class DmgAudioFileInfo:
             sys.stdout = sys.__stdout__
             raise
 
+    @staticmethod
+    def __compile_song(output_tag, output_file_path):
+        from dmg_music_compiler import read_gbt_song, compile_song, write_compiled_song
+
+        startup_commands, patterns = read_gbt_song(output_file_path, output_tag)
+        words = compile_song(startup_commands, patterns)
+        write_compiled_song(words, output_file_path, output_tag)
+
     @staticmethod
     def __move_output_file(output_file_name, output_file_path):
         if os.path.exists(output_file_path):
@@ -94,7 +107,13 @@ class DmgAudioFileInfo:
             header_file.write('\n')
             header_file.write('namespace bn::dmg_music_items' + '\n')
             header_file.write('{' + '\n')
-            header_file.write('    constexpr inline dmg_music_item ' + name + '(*' + output_tag + ');' + '\n')
+
+            if self.__precompiled:
+                header_file.write('    constexpr inline dmg_music_item ' + name + '(*' + output_tag +
+                                  ', dmg_music_type::PRECOMPILED);' + '\n')
+            else:
+                header_file.write('    constexpr inline dmg_music_item ' + name + '(*' + output_tag + ');' + '\n')
+
             header_file.write('}' + '\n')
             header_file.write('\n')
             header_file.write('#endif' + '\n')
@@ -112,6 +131,18 @@ class DmgAudioFileInfoProcessor:
         return audio_file_info.process(self.__build_folder_path)
 
 
+def read_dmg_audio_info(json_file_path):
+    with open(json_file_path) as json_file:
+        info = json.load(json_file)
+
+    precompiled = info.get('precompiled', False)
+
+    if not isinstance(precompiled, bool):
+        raise ValueError('Invalid precompiled field in ' + json_file_path + ': ' + str(precompiled))
+
+    return precompiled
+
+
 def list_dmg_audio_file_infos(audio_folder_paths, build_folder_path):
     audio_folder_path_list = audio_folder_paths.split(' ')
     audio_file_infos = []
@@ -137,6 +168,9 @@ def list_dmg_audio_file_infos(audio_folder_paths, build_folder_path):
 
                     file_names_set.add(audio_file_name_no_ext)
                     file_info_path = build_folder_path + '/_bn_' + audio_file_name_no_ext + '_dmg_audio_file_info.txt'
+                    json_file_path = audio_folder_path + '/' + audio_file_name_no_ext + '.json'
+                    json_file_exists = os.path.isfile(json_file_path)
+                    precompiled = read_dmg_audio_info(json_file_path) if json_file_exists else False
 
                     if not os.path.exists(file_info_path):
                         build = True
@@ -145,9 +179,13 @@ def list_dmg_audio_file_infos(audio_folder_paths, build_folder_path):
                         audio_file_mtime = os.path.getmtime(audio_file_path)
                         build = file_info_mtime < audio_file_mtime
 
+                        if not build and json_file_exists:
+                            build = file_info_mtime < os.path.getmtime(json_file_path)
+
                     if build:
                         audio_file_infos.append(DmgAudioFileInfo(
-                            audio_file_path, audio_file_name, audio_file_name_no_ext, file_info_path, mod_extension))
+                            audio_file_path, audio_file_name, audio_file_name_no_ext, file_info_path, mod_extension,
+                            precompiled))
 
     return audio_file_infos
 
@@ -0,0 +1,308 @@
+"""
+Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+zlib License, see LICENSE file.
+"""
+
+import math
+import os
+import sys
+
+from file_info import FileInfo
+
+
+max_vertices_count = 32767
+max_colors_count = 10
+
+
+def format_fixed(value):
+    result = round(value, 3)
+
+    if result == 0:
+        result = 0.0
+
+    return repr(float(result))
+
+
+def format_vertex(vertex):
+    return 'vertex_3d(' + ', '.join([format_fixed(coordinate) for coordinate in vertex]) + ')'
+
+
+def gba_color(kd):
+    red = min(max(int(round(kd[0] * 31)), 0), 31)
+    green = min(max(int(round(kd[1] * 31)), 0), 31)
+    blue = min(max(int(round(kd[2] * 31)), 0), 31)
+    return red, green, blue
+
+
+def face_normal(vertices, face_indexes):
+    v1 = vertices[face_indexes[0]]
+    v2 = vertices[face_indexes[1]]
+    v3 = vertices[face_indexes[2]]
+    a = [v2[0] - v1[0], v2[1] - v1[1], v2[2] - v1[2]]
+    b = [v3[0] - v1[0], v3[1] - v1[1], v3[2] - v1[2]]
+    normal = [(a[1] * b[2]) - (a[2] * b[1]), (a[2] * b[0]) - (a[0] * b[2]), (a[0] * b[1]) - (a[1] * b[0])]
+    length = math.sqrt((normal[0] * normal[0]) + (normal[1] * normal[1]) + (normal[2] * normal[2]))
+
+    if length == 0:
+        raise ValueError('Degenerate face: ' + str([index + 1 for index in face_indexes]))
+
+    return [normal[0] / length, normal[1] / length, normal[2] / length]
+
+
+class Model3DFileInfo:
+
+    def __init__(self, obj_file_path, obj_file_name, obj_file_name_no_ext, file_info_path):
+        self.__obj_file_path = obj_file_path
+        self.__obj_file_name = obj_file_name
+        self.__obj_file_name_no_ext = obj_file_name_no_ext
+        self.__file_info_path = file_info_path
+
+    def print_file_name(self):
+        print(self.__obj_file_name)
+
+    def process(self, build_folder_path):
+        try:
+            mtl_file_path = self.__read_mtl_file_path()
+            materials = self.__read_materials(mtl_file_path)
+            vertices, faces = self.__read_model(materials)
+            header_file_path = self.__write_header(build_folder_path, materials, vertices, faces)
+
+            with open(self.__file_info_path, 'w') as file_info:
+                file_info.write('')
+
+            return [self.__obj_file_name, header_file_path, len(vertices), len(faces)]
+        except Exception as exc:
+            return [self.__obj_file_name, exc]
+
+    def __read_mtl_file_path(self):
+        with open(self.__obj_file_path, 'r') as obj_file:
+            for line in obj_file:
+                tokens = line.split()
+
+                if len(tokens) > 1 and tokens[0] == 'mtllib':
+                    mtl_file_path = os.path.dirname(self.__obj_file_path) + '/' + tokens[1]
+
+                    if not os.path.isfile(mtl_file_path):
+                        raise ValueError('Material library not found: ' + tokens[1])
+
+                    return mtl_file_path
+
+        return None
+
+    @staticmethod
+    def __read_materials(mtl_file_path):
+        materials = {}
+
+        if mtl_file_path is None:
+            return materials
+
+        material_name = None
+
+        with open(mtl_file_path, 'r') as mtl_file:
+            for line in mtl_file:
+                tokens = line.split()
+
+                if len(tokens) == 0:
+                    continue
+
+                if tokens[0] == 'newmtl':
+                    material_name = tokens[1]
+
+                    if material_name in materials:
+                        raise ValueError('Duplicated material: ' + material_name)
+
+                    materials[material_name] = (31, 31, 31)
+                elif tokens[0] == 'Kd':
+                    if material_name is None:
+                        raise ValueError('Diffuse color without material')
+
+                    materials[material_name] = gba_color([float(token) for token in tokens[1:4]])
+
+        if len(materials) > max_colors_count:
+            raise ValueError('Too many materials: ' + str(len(materials)) + ' (max is ' + str(max_colors_count) + ')')
+
+        return materials
+
+    def __read_model(self, materials):
+        vertices = []
+        faces = []
+        material_name = None
+
+        with open(self.__obj_file_path, 'r') as obj_file:
+            for line in obj_file:
+                tokens = line.split()
+
+                if len(tokens) == 0:
+                    continue
+
+                if tokens[0] == 'v':
+                    vertices.append([float(token) for token in tokens[1:4]])
+                elif tokens[0] == 'usemtl':
+                    material_name = tokens[1]
+
+                    if material_name not in materials:
+                        raise ValueError('Material not found: ' + material_name)
+                elif tokens[0] == 'f':
+                    face_indexes = []
+
+                    for token in tokens[1:]:
+                        index = int(token.split('/')[0])
+
+                        if index < 0:
+                            index += len(vertices)
+                        else:
+                            index -= 1
+
+                        if index < 0 or index >= len(vertices):
+                            raise ValueError('Invalid vertex index: ' + token)
+
+                        face_indexes.append(index)
+
+                    if len(face_indexes) != 3 and len(face_indexes) != 4:
+                        raise ValueError('Only triangles and quads are supported: ' + line.strip())
+
+                    faces.append([face_indexes, material_name])
+
+        if len(vertices) == 0:
+            raise ValueError('There\'s no vertices')
+
+        if len(vertices) > max_vertices_count:
+            raise ValueError('Too many vertices: ' + str(len(vertices)) + ' (max is ' + str(max_vertices_count) + ')')
+
+        if len(faces) == 0:
+            raise ValueError('There\'s no faces')
+
+        return vertices, faces
+
+    def __write_header(self, build_folder_path, materials, vertices, faces):
+        name = self.__obj_file_name_no_ext
+        header_file_path = build_folder_path + '/bn_model_3d_items_' + name + '.h'
+        colors = list(materials.values())
+        material_colors = {material_name: index for index, material_name in enumerate(materials)}
+
+        if len(colors) == 0:
+            colors.append((31, 31, 31))
+            material_colors[None] = 0
+        elif None in [face[1] for face in faces]:
+            raise ValueError('There\'s faces without material')
+
+        with open(header_file_path, 'w') as header_file:
+            include_guard = 'BN_MODEL_3D_ITEMS_' + name.upper() + '_H'
+            header_file.write('#ifndef ' + include_guard + '\n')
+            header_file.write('#define ' + include_guard + '\n')
+            header_file.write('\n')
+            header_file.write('#include "bn_color.h"' + '\n')
+            header_file.write('#include "bn_model_3d_item.h"' + '\n')
+            header_file.write('\n')
+            header_file.write('namespace bn::model_3d_items' + '\n')
+            header_file.write('{' + '\n')
+            header_file.write('    constexpr inline color ' + name + '_colors[] = {' + '\n')
+
+            for color in colors:
+                header_file.write('        color(' + str(color[0]) + ', ' + str(color[1]) + ', ' +
+                                  str(color[2]) + '),' + '\n')
+
+            header_file.write('    };' + '\n')
+            header_file.write('\n')
+            header_file.write('    constexpr inline vertex_3d ' + name + '_vertices[] = {' + '\n')
+
+            for vertex in vertices:
+                header_file.write('        ' + format_vertex(vertex) + ',' + '\n')
+
+            header_file.write('    };' + '\n')
+            header_file.write('\n')
+            header_file.write('    constexpr inline face_3d ' + name + '_faces[] = {' + '\n')
+
+            for face in faces:
+                face_indexes = face[0]
+                normal = face_normal(vertices, face_indexes)
+                header_file.write('        face_3d(' + name + '_vertices, ' + format_vertex(normal) + ', ' +
+                                  ', '.join([str(index) for index in face_indexes]) + ', ' +
+                                  str(material_colors[face[1]]) + ', face_3d::directional_shading),' + '\n')
+
+            header_file.write('    };' + '\n')
+            header_file.write('\n')
+            header_file.write('    constexpr inline model_3d_item ' + name + '(' + name + '_vertices, ' +
+                              name + '_faces);' + '\n')
+            header_file.write('}' + '\n')
+            header_file.write('\n')
+            header_file.write('#endif' + '\n')
+            header_file.write('\n')
+
+        return header_file_path
+
+
+def list_model_3d_file_infos(models_3d_folder_paths, build_folder_path):
+    models_3d_folder_path_list = models_3d_folder_paths.split(' ')
+    model_3d_file_infos = []
+    file_names_set = set()
+
+    for models_3d_folder_path in models_3d_folder_path_list:
+        model_3d_file_names = sorted(os.listdir(models_3d_folder_path))
+
+        for model_3d_file_name in model_3d_file_names:
+            obj_file_path = models_3d_folder_path + '/' + model_3d_file_name
+
+            if os.path.isfile(obj_file_path) and FileInfo.validate(model_3d_file_name):
+                model_3d_file_name_split = os.path.splitext(model_3d_file_name)
+
+                if model_3d_file_name_split[1] == '.obj':
+                    model_3d_file_name_no_ext = model_3d_file_name_split[0]
+
+                    if model_3d_file_name_no_ext in file_names_set:
+                        raise ValueError('There\'s two or more 3D model files with the same name: ' +
+                                         model_3d_file_name_no_ext)
+
+                    file_names_set.add(model_3d_file_name_no_ext)
+                    file_info_path = build_folder_path + '/_bn_' + model_3d_file_name_no_ext + \
+                        '_model_3d_file_info.txt'
+
+                    if not os.path.exists(file_info_path):
+                        build = True
+                    else:
+                        file_info_mtime = os.path.getmtime(file_info_path)
+                        build = file_info_mtime < os.path.getmtime(obj_file_path)
+
+                        if not build:
+                            for mtl_file_name in model_3d_file_names:
+                                if os.path.splitext(mtl_file_name)[1] == '.mtl':
+                                    mtl_file_path = models_3d_folder_path + '/' + mtl_file_name
+
+                                    if file_info_mtime < os.path.getmtime(mtl_file_path):
+                                        build = True
+                                        break
+
+                    if build:
+                        model_3d_file_infos.append(Model3DFileInfo(
+                            obj_file_path, model_3d_file_name, model_3d_file_name_no_ext, file_info_path))
+
+    return model_3d_file_infos
+
+
+def process_models_3d(models_3d_folder_paths, build_folder_path):
+    if len(models_3d_folder_paths) == 0:
+        return
+
+    model_3d_file_infos = list_model_3d_file_infos(models_3d_folder_paths, build_folder_path)
+
+    if len(model_3d_file_infos) > 0:
+        process_excs = []
+
+        for model_3d_file_info in model_3d_file_infos:
+            model_3d_file_info.print_file_name()
+            process_result = model_3d_file_info.process(build_folder_path)
+
+            if len(process_result) == 4:
+                print('    Vertices: ' + str(process_result[2]))
+                print('    Faces: ' + str(process_result[3]))
+                print('    ' + str(process_result[0]) + ' item header written in ' + str(process_result[1]))
+            else:
+                process_excs.append(process_result)
+
+        sys.stdout.flush()
+
+        if len(process_excs) > 0:
+            for process_exc in process_excs:
+                sys.stderr.write(str(process_exc[0]) + ' error: ' + str(process_exc[1]) + '\n')
+
+            exit(-1)
@@ -0,0 +1,649 @@
+"""
+Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+zlib License, see LICENSE file.
+"""
+
+import re
+
+# Precompiled DMG music is generated by running a port of GBT Player (hw/3rd_party/gbt-player/src/gbt_player.c)
+# and recording the sound registers written on each tick.
+#
+# Output format (little endian 16-bit words):
+#
+# Header:
+#   patterns count, rows count, loop row, end row (0xFFFF if the song never ends), waves count, 0.
+# Positions (patterns count * 64 words):
+#   Row index of each pattern row (0xFFFF if it is never played).
+# Waves (waves count * 17 words):
+#   Channel 3 wave flags (bit 7 = 64 samples) followed by 16 words of wave data.
+# Rows ((rows count + 1) * 13 words):
+#   Pattern << 6 | row, wave index loaded when the row starts (0xFFFF if none), ticks offset (32-bit),
+#   last values written to the channel registers before the row starts (see CHANNEL_REGISTERS),
+#   so notes which are still playing can be restored when seeking the row.
+# Ticks:
+#   writes count | pan << 8, mute mask | idle ticks << 8, [register offset, value] * writes count.
+
+SOUND1CNT_L = 0x60
+SOUND1CNT_H = 0x62
+SOUND1CNT_X = 0x64
+SOUND2CNT_L = 0x68
+SOUND2CNT_H = 0x6C
+SOUND3CNT_L = 0x70
+SOUND3CNT_H = 0x72
+SOUND3CNT_X = 0x74
+SOUND4CNT_L = 0x78
+SOUND4CNT_H = 0x7C
+WAVE_RAM = 0x90
+
+RESTART = 1 << 15
+SOUND3CNT_L_SIZE_64 = 1 << 5
+SOUND3CNT_L_ENABLE = 1 << 7
+
+# Registers without side effects, which don't need to be written again if their value doesn't change:
+DELTA_REGISTERS = (SOUND1CNT_L, SOUND1CNT_H, SOUND2CNT_L, SOUND3CNT_H, SOUND4CNT_L)
+
+# Channel registers restored when seeking a row:
+CHANNEL_REGISTERS = (SOUND1CNT_L, SOUND1CNT_H, SOUND1CNT_X, SOUND2CNT_L, SOUND2CNT_H, SOUND3CNT_H, SOUND3CNT_X,
+                     SOUND4CNT_L, SOUND4CNT_H)
+
+MAX_TICKS = 1 << 20
+NO_INDEX = 0xFFFF
+
+DEFAULT_WAVES = (
+    (0xA5, 0xD7, 0xC9, 0xE1, 0xBC, 0x9A, 0x76, 0x31, 0x0C, 0xBA, 0xDE, 0x60, 0x1B, 0xCA, 0x03, 0x93),
+    (0xF0, 0xE1, 0xD2, 0xC3, 0xB4, 0xA5, 0x96, 0x87, 0x78, 0x69, 0x5A, 0x4B, 0x3C, 0x2D, 0x1E, 0x0F),
+    (0xFD, 0xEC, 0xDB, 0xCA, 0xB9, 0xA8, 0x97, 0x86, 0x79, 0x68, 0x57, 0x46, 0x35, 0x24, 0x13, 0x02),
+    (0xDE, 0xFE, 0xDC, 0xBA, 0x9A, 0xA9, 0x87, 0x77, 0x88, 0x87, 0x65, 0x56, 0x54, 0x32, 0x10, 0x12),
+    (0xAB, 0xCD, 0xEF, 0xED, 0xCB, 0xA0, 0x12, 0x3E, 0xDC, 0xBA, 0xBC, 0xDE, 0xFE, 0xDC, 0x32, 0x10),
+    (0xFF, 0xEE, 0xDD, 0xCC, 0xBB, 0xAA, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00),
+    (0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00),
+    (0x79, 0xBC, 0xDE, 0xEF, 0xFF, 0xEE, 0xDC, 0xB9, 0x75, 0x43, 0x21, 0x10, 0x00, 0x11, 0x23, 0x45),
+)
+
+NOISE = (0x5F, 0x5B, 0x4B, 0x2F, 0x3B, 0x58, 0x1F, 0x0F, 0x90, 0x80, 0x70, 0x50, 0x00, 0x67, 0x63, 0x53)
+
+VIBRATO_SINE = (
+    0, 24, 49, 74, 97, 120, 141, 161, 180, 197, 212, 224, 235, 244, 250, 253,
+    255, 253, 250, 244, 235, 224, 212, 197, 180, 161, 141, 120, 97, 74, 49, 24,
+    0, -24, -49, -74, -97, -120, -141, -161, -180, -197, -212, -224, -235, -244, -250, -253,
+    -255, -253, -250, -244, -235, -224, -212, -197, -180, -161, -141, -120, -97, -74, -49, -24,
+)
+
+FREQUENCIES = (
+    44, 156, 262, 363, 457, 547, 631, 710, 786, 854, 923, 986,
+    1046, 1102, 1155, 1205, 1253, 1297, 1339, 1379, 1417, 1452, 1486, 1517,
+    1546, 1575, 1602, 1627, 1650, 1673, 1694, 1714, 1732, 1750, 1767, 1783,
+    1798, 1812, 1825, 1837, 1849, 1860, 1871, 1881, 1890, 1899, 1907, 1915,
+    1923, 1930, 1936, 1943, 1949, 1954, 1959, 1964, 1969, 1974, 1978, 1982,
+    1985, 1988, 1992, 1995, 1998, 2001, 2004, 2006, 2009, 2011, 2013, 2015,
+)
+
+CHANNEL_SIZES = (1, 2, 3, 3, 2, 3, 4, 4)
+CHANNEL_4_SIZES = (1, 3, 2, 4)
+
+
+def read_gbt_song(c_file_path, song_name):
+    """Reads the song arrays of a source file generated by mod2gbt or s3m2gbt."""
+
+    with open(c_file_path) as c_file:
+        source = c_file.read()
+
+    arrays = {}
+
+    for match in re.finditer(r'const uint8_t (\w+)\[\] = \{([^}]*)\};', source):
+        arrays[match.group(1)] = [int(value, 16) for value in re.findall(r'0x[0-9A-Fa-f]+', match.group(2))]
+
+    match = re.search(r'const uint8_t \*' + song_name + r'\[\] = \{([^}]*)\};', source)
+
+    if match is None:
+        raise ValueError('Song pointers array not found: ' + song_name)
+
+    pointers = [name.strip() for name in match.group(1).split(',') if len(name.strip()) > 0]
+    startup_commands = None if pointers[0] == 'NULL' else arrays[pointers[0]]
+    patterns = []
+
+    for name in pointers[1:]:
+        if name == 'NULL':
+            break
+
+        patterns.append(arrays[name])
+
+    if len(patterns) == 0:
+        raise ValueError('Song without patterns: ' + song_name)
+
+    return startup_commands, patterns
+
+
+class Channel:
+
+    def __init__(self):
+        self.pan = 0
+        self.vol = 0
+        self.instr = 0
+        self.freq = 0
+        self.base_freq = 0
+        self.arpeggio_freq_index = [0, 0, 0]
+        self.arpeggio_enabled = False
+        self.arpeggio_tick = 0
+        self.vibrato_enabled = False
+        self.vibrato_position = 0
+        self.vibrato_args = 0
+        self.volslide_args = 0
+        self.cut_note_tick = 0xFF
+
+
+class GbtPlayer:
+
+    def __init__(self, startup_commands, patterns, speed):
+        self.startup_commands = startup_commands
+        self.patterns = patterns
+        self.speed = speed
+        self.ticks_elapsed = 0
+        self.current_row = 0
+        self.current_order = 0
+        self.row_offset = 0
+        self.channels = [Channel(), Channel(), Channel(), Channel()]
+        self.loaded_instrument = 0xFF
+        self.instruments = [[0, DEFAULT_WAVES[index]] for index in range(8)]
+        self.jump_requested = False
+        self.jump_target_row = 0
+        self.jump_target_order = 0
+        self.writes = []
+        self.registers = {}
+        self.mute_mask = 0
+
+        channels = self.channels
+        channels[0].pan = 0x11
+        channels[1].pan = 0x22
+        channels[2].pan = 0x44
+        channels[3].pan = 0x88
+        channels[0].vol = 0xF000
+        channels[1].vol = 0xF000
+        channels[2].vol = 0x2000
+        channels[3].vol = 0xF000
+
+        self.__run_startup_commands()
+        self.ticks_elapsed = (self.speed - 1) & 0xFF
+
+    def pattern(self):
+        return self.patterns[self.current_order] if self.current_order < len(self.patterns) else None
+
+    def pan(self):
+        channels = self.channels
+        return channels[0].pan | channels[1].pan | channels[2].pan | channels[3].pan
+
+    def next_tick_is_row(self):
+        return ((self.ticks_elapsed + 1) & 0xFF) == self.speed
+
+    def state(self):
+        # Returns all the information which affects the register writes of the next ticks:
+        channels = tuple(tuple(tuple(value) if isinstance(value, list) else value for value in vars(channel).values())
+                         for channel in self.channels)
+        instruments = tuple((flags, tuple(wave)) for flags, wave in self.instruments)
+        return self.current_order, self.current_row, self.speed, self.ticks_elapsed, self.loaded_instrument, \
+            channels, instruments, tuple(sorted(self.registers.items()))
+
+    def next_row_position(self):
+        # Returns the position of the row handled by the next tick (it must be a row tick):
+        if self.pattern() is None:
+            return 0, self.current_row, True
+
+        return self.current_order, self.current_row, False
+
+    def update(self):
+        self.writes = []
+        self.mute_mask = 0
+        self.ticks_elapsed = (self.ticks_elapsed + 1) & 0xFF
+
+        if self.ticks_elapsed != self.speed:
+            self.__update_effects()
+            return
+
+        self.ticks_elapsed = 0
+
+        for channel in self.channels:
+            channel.arpeggio_enabled = False
+            channel.vibrato_enabled = False
+            channel.volslide_args = 0
+            channel.cut_note_tick = 0xFF
+
+        self.__update_effects()
+
+        if self.pattern() is None:
+            # Loop is always enabled, since the end of the song is handled by the compiler:
+            self.current_order = 0
+            self.__refresh_pattern_offset()
+            self.__run_startup_commands()
+
+        pattern = self.pattern()
+        offset = self.row_offset
+        offset = self.__handle_channel(0, pattern, offset)
+        offset = self.__handle_channel(1, pattern, offset)
+        offset = self.__handle_channel(2, pattern, offset)
+        self.row_offset = self.__handle_channel_4(pattern, offset)
+
+        if not self.jump_requested:
+            self.current_row += 1
+
+            if self.current_row == 64:
+                self.current_row = 0
+                self.current_order += 1
+                self.__refresh_pattern_offset()
+        else:
+            self.jump_requested = False
+            self.current_row = self.jump_target_row
+            self.current_order = self.jump_target_order
+            self.__refresh_pattern_offset()
+
+    def wave_instrument(self, instrument):
+        flags, wave = self.instruments[instrument]
+        return flags & 0x80, tuple(wave)
+
+    def __write(self, offset, value):
+        value &= 0xFFFF
+        self.writes.append((offset, value))
+        self.registers[offset] = value
+
+    def __mute(self, channel_index):
+        self.mute_mask |= 0x11 << channel_index
+
+    def __refresh_pattern_offset(self):
+        pattern = self.pattern()
+        offset = 0
+
+        if pattern is not None:
+            for _ in range(self.current_row):
+                for _ in range(3):
+                    offset += CHANNEL_SIZES[pattern[offset] >> 5]
+
+                offset += CHANNEL_4_SIZES[pattern[offset] >> 6]
+
+        self.row_offset = offset
+
+    def __run_startup_commands(self):
+        commands = self.startup_commands
+
+        if commands is None:
+            return
+
+        index = 0
+
+        while True:
+            command = commands[index]
+            index += 1
+
+            if command == 0:
+                break
+            elif command == 1:
+                self.speed = commands[index]
+                index += 1
+            elif command == 2:
+                for channel in self.channels:
+                    channel.pan = commands[index]
+                    index += 1
+            elif command == 3:
+                flags = commands[index]
+                index += 1
+                length = 32 if flags & 0x80 else 16
+                self.instruments[flags & 0x3F] = [flags, commands[index:index + length]]
+                index += length
+            else:
+                raise ValueError('Invalid startup command: ' + str(command))
+
+    def __refresh_registers(self, channel_index):
+        channel = self.channels[channel_index]
+        self.__mute(channel_index)
+
+        if channel_index == 0:
+            self.__write(SOUND1CNT_L, 0)
+            self.__write(SOUND1CNT_H, channel.instr | channel.vol | channel.volslide_args)
+            self.__write(SOUND1CNT_X, RESTART | channel.freq)
+        elif channel_index == 1:
+            self.__write(SOUND2CNT_L, channel.instr | channel.vol | channel.volslide_args)
+            self.__write(SOUND2CNT_H, RESTART | channel.freq)
+        elif channel_index == 2:
+            instrument = channel.instr
+
+            if self.loaded_instrument != instrument:
+                self.write_wave(instrument, self.__write)
+                self.loaded_instrument = instrument
+
+            self.__write(SOUND3CNT_H, channel.vol)
+            self.__write(SOUND3CNT_X, RESTART | channel.freq)
+        else:
+            self.__write(SOUND4CNT_L, channel.vol | channel.volslide_args)
+            self.__write(SOUND4CNT_H, RESTART | channel.instr)
+
+    def write_wave(self, instrument, write):
+        flags, wave = self.wave_instrument(instrument)
+        write(SOUND3CNT_L, 1 << 6)
+
+        for index in range(0, 16, 2):
+            write(WAVE_RAM + index, wave[index] | (wave[index + 1] << 8))
+
+        if flags:
+            write(SOUND3CNT_L, 0)
+
+            for index in range(0, 16, 2):
+                write(WAVE_RAM + index, wave[index + 16] | (wave[index + 17] << 8))
+
+            write(SOUND3CNT_L, SOUND3CNT_L_SIZE_64 | SOUND3CNT_L_ENABLE)
+        else:
+            write(SOUND3CNT_L, SOUND3CNT_L_ENABLE)
+
+    def __silence(self, channel_index):
+        self.__mute(channel_index)
+
+        if channel_index == 0:
+            self.__write(SOUND1CNT_L, 0)
+            self.__write(SOUND1CNT_H, 0)
+            self.__write(SOUND1CNT_X, RESTART)
+        elif channel_index == 1:
+            self.__write(SOUND2CNT_L, 0)
+            self.__write(SOUND2CNT_H, RESTART)
+        elif channel_index == 2:
+            self.__write(SOUND3CNT_X, RESTART)
+            self.__write(SOUND3CNT_H, 0)
+            self.__write(SOUND3CNT_X, RESTART)
+        else:
+            self.__write(SOUND4CNT_L, 0)
+            self.__write(SOUND4CNT_H, RESTART)
+
+    def __set_effect(self, channel_index, effect, args):
+        channel = self.channels[channel_index]
+
+        if effect == 0:
+            channel.pan = args & (0x11 << channel_index)
+        elif effect == 1 and channel_index != 3:
+            base_index = channel.arpeggio_freq_index[0]
+            channel.arpeggio_freq_index[1] = base_index + ((args >> 4) & 0xF)
+            channel.arpeggio_freq_index[2] = base_index + (args & 0xF)
+            channel.arpeggio_enabled = True
+            channel.arpeggio_tick = 1
+            return True
+        elif effect == 2:
+            channel.cut_note_tick = args
+        elif effect == 3 and channel_index != 3:
+            if args != 0:
+                channel.vibrato_position = 0
+                channel.vibrato_args = args
+
+            channel.vibrato_enabled = True
+            return True
+        elif effect == 4 and channel_index != 2:
+            channel.volslide_args = args << 8
+            return True
+        elif effect == 8:
+            self.jump_requested = True
+            self.jump_target_row = 0
+            self.jump_target_order = args
+        elif effect == 9:
+            self.jump_requested = True
+            self.jump_target_row = args
+            self.jump_target_order = (self.current_order + 1) & 0xFF
+        elif effect == 10:
+            self.speed = args
+            self.ticks_elapsed = 0
+
+        return False
+
+    def __handle_channel(self, channel_index, pattern, offset):
+        header = pattern[offset]
+        next_offset = offset + CHANNEL_SIZES[header >> 5]
+        channel = self.channels[channel_index]
+        offset += 1
+        update_registers = False
+        note_cut = False
+
+        if header & 0x10:
+            if channel_index == 2:
+                channel.vol = (header & 0x7) << 13
+            else:
+                channel.vol = (header & 0xF) << 12
+
+            update_registers = True
+
+        if header & 0x80:
+            index = pattern[offset]
+            offset += 1
+
+            if index == 0xFE:
+                note_cut = True
+            else:
+                channel.arpeggio_freq_index[0] = index
+                channel.base_freq = FREQUENCIES[index]
+                channel.freq = channel.base_freq
+                update_registers = True
+
+        if header & 0x20:
+            if channel_index == 2:
+                channel.instr = (pattern[offset] & 0x70) >> 4
+            else:
+                channel.instr = (pattern[offset] & 0x30) << 2
+
+            update_registers = True
+
+        if header & 0x40:
+            effect = pattern[offset] & 0x0F
+            offset += 1
+            update_registers |= self.__set_effect(channel_index, effect, pattern[offset])
+
+        if note_cut:
+            self.__silence(channel_index)
+        elif update_registers:
+            self.__refresh_registers(channel_index)
+
+        return next_offset
+
+    def __handle_channel_4(self, pattern, offset):
+        header = pattern[offset]
+        next_offset = offset + CHANNEL_4_SIZES[header >> 6]
+        channel = self.channels[3]
+        offset += 1
+        update_registers = False
+        note_cut = False
+
+        if header & 0x10:
+            channel.vol = (header & 0xF) << 12
+            update_registers = True
+
+        if header & 0x80:
+            index = pattern[offset]
+            offset += 1
+
+            if index == 0xFE:
+                note_cut = True
+            else:
+                channel.instr = NOISE[index & 0x0F]
+                update_registers = True
+
+        if header & 0x40:
+            effect = pattern[offset] & 0x0F
+            offset += 1
+            update_registers |= self.__set_effect(3, effect, pattern[offset])
+
+        if note_cut:
+            self.__silence(3)
+        elif update_registers:
+            self.__refresh_registers(3)
+
+        return next_offset
+
+    def __update_effects(self):
+        for channel_index in range(4):
+            channel = self.channels[channel_index]
+            update_registers = False
+
+            if channel.cut_note_tick == self.ticks_elapsed:
+                channel.cut_note_tick = 0xFF
+                self.__silence(channel_index)
+
+            if channel_index == 3:
+                continue
+
+            if channel.arpeggio_enabled:
+                tick = channel.arpeggio_tick
+                channel.arpeggio_tick = 0 if tick == 2 else tick + 1
+                channel.freq = FREQUENCIES[channel.arpeggio_freq_index[tick]]
+                update_registers = True
+
+            if channel.vibrato_enabled:
+                channel.vibrato_position = (channel.vibrato_position + (channel.vibrato_args >> 4)) & 63
+                delta = (VIBRATO_SINE[channel.vibrato_position] * (channel.vibrato_args & 0xF)) >> 7
+                channel.freq = min(max(channel.base_freq - delta, 0), 0x7FF)
+                update_registers = True
+
+            if update_registers:
+                self.__refresh_registers(channel_index)
+
+
+class CompiledRow:
+
+    def __init__(self, order, row, wave):
+        self.order = order
+        self.row = row
+        self.wave = wave
+        self.ticks = []
+        self.known_registers = {}
+
+    def add_tick(self, player):
+        writes = []
+        known_registers = self.known_registers
+        mute_mask = 0
+
+        for offset, value in player.writes:
+            if offset in DELTA_REGISTERS:
+                if known_registers.get(offset) == value:
+                    continue
+
+                known_registers[offset] = value
+
+            writes.append((offset, value))
+
+        if len(writes) > 0:
+            mute_mask = player.mute_mask
+
+        pan = player.pan()
+
+        if len(writes) == 0 and len(self.ticks) > 0:
+            last_tick = self.ticks[-1]
+
+            if last_tick[1] == pan and last_tick[3] < 255:
+                last_tick[3] += 1
+                return
+
+        if len(writes) > 255:
+            raise ValueError('Too many register writes in a tick: ' + str(len(writes)))
+
+        self.ticks.append([writes, pan, mute_mask, 0])
+
+
+def compile_song(startup_commands, patterns, speed=1):
+    player = GbtPlayer(startup_commands, patterns, speed)
+    rows = []
+    visited_states = {}
+    end_row = NO_INDEX
+    ticks_count = 0
+
+    while True:
+        if player.next_tick_is_row():
+            order, row, end = player.next_row_position()
+
+            if end and end_row == NO_INDEX:
+                end_row = len(rows)
+
+            # The song loops when a row is going to be played again with the same state,
+            # so looped playback writes the same registers as GBT Player:
+            state = player.state()
+            row_index = visited_states.get(state)
+
+            if row_index is not None:
+                loop_row = row_index
+                break
+
+            wave = NO_INDEX if player.loaded_instrument == 0xFF else player.loaded_instrument
+            visited_states[state] = len(rows)
+            rows.append(CompiledRow(order, row, wave))
+        elif len(rows) == 0:
+            raise ValueError('Song doesn\'t start with a row tick')
+
+        player.update()
+        rows[-1].add_tick(player)
+        ticks_count += 1
+
+        if ticks_count > MAX_TICKS:
+            raise ValueError('Song is too long or it never loops')
+
+    if len(rows) >= NO_INDEX:
+        raise ValueError('Song has too many rows: ' + str(len(rows)))
+
+    # Waves loaded when rows start:
+
+    wave_instruments = sorted(set(row.wave for row in rows if row.wave != NO_INDEX))
+    waves = []
+
+    for instrument in wave_instruments:
+        flags, wave = player.wave_instrument(instrument)
+        wave_words = [flags]
+
+        for index in range(0, len(wave), 2):
+            wave_words.append(wave[index] | (wave[index + 1] << 8))
+
+        wave_words += [0] * (17 - len(wave_words))
+        waves += wave_words
+
+    # Output:
+
+    patterns_count = len(patterns)
+    words = [patterns_count, len(rows), loop_row, end_row, len(wave_instruments), 0]
+    positions = [NO_INDEX] * (patterns_count * 64)
+
+    for row_index, row in enumerate(rows):
+        position_index = (row.order * 64) + row.row
+
+        if row.order < patterns_count and positions[position_index] == NO_INDEX:
+            positions[position_index] = row_index
+
+    words += positions
+    words += waves
+
+    ticks = []
+    row_entries = []
+    channel_registers = {offset: 0 for offset in CHANNEL_REGISTERS}
+
+    for row in rows:
+        wave = NO_INDEX if row.wave == NO_INDEX else wave_instruments.index(row.wave)
+        row_entries += [(row.order << 6) | row.row, wave, len(ticks) & 0xFFFF, len(ticks) >> 16]
+        row_entries += [channel_registers[offset] for offset in CHANNEL_REGISTERS]
+
+        for writes, pan, mute_mask, idle_ticks in row.ticks:
+            ticks += [len(writes) | (pan << 8), mute_mask | (idle_ticks << 8)]
+
+            for offset, value in writes:
+                ticks += [offset, value]
+
+                if offset in channel_registers:
+                    channel_registers[offset] = value
+
+    row_entries += [0, NO_INDEX, len(ticks) & 0xFFFF, len(ticks) >> 16]
+    row_entries += [0] * len(CHANNEL_REGISTERS)
+    words += row_entries
+    words += ticks
+    return words
+
+
+def write_compiled_song(words, output_file_path, output_tag):
+    with open(output_file_path, 'w') as output_file:
+        output_file.write('// File created by butano_dmg_audio_tool\n\n')
+        output_file.write('#include <stdint.h>\n\n')
+        output_file.write('const uint8_t ' + output_tag + '[] __attribute__((aligned(4))) = {\n')
+
+        for index in range(0, len(words), 8):
+            output_file.write('    ')
+
+            for word in words[index:index + 8]:
+                output_file.write('0x{:02X},0x{:02X},'.format(word & 0xFF, word >> 8))
+
+            output_file.write('\n')
+
+        output_file.write('};\n')
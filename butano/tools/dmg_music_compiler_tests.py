@@ -0,0 +1,397 @@
+"""
+Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+zlib License, see LICENSE file.
+"""
+
+import argparse
+import copy
+import io
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+from dmg_music_compiler import read_gbt_song, compile_song, CHANNEL_REGISTERS, NO_INDEX
+
+# Compiles DMG music modules and checks that replaying their register write streams
+# writes the same sound registers as GBT Player (hw/3rd_party/gbt-player/src/gbt_player.c) on each tick.
+#
+# GBT Player is built for the host with a C compiler, writing the sound registers to an array.
+
+HEADER_SIZE = 6
+WAVE_SIZE = 17
+ROW_SIZE = 13
+MAX_CATCH_UP_TICKS = 16
+FIRST_REGISTER = 0x60
+LAST_REGISTER = 0x9E
+SOUNDCNT_L = 0x80
+SOUNDCNT_X = 0x84
+PAN_MASK = 0xFF00
+RESTART = 1 << 15
+
+GBT_PLAYER_FOLDER_PATH = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'hw', '3rd_party',
+                                      'gbt-player')
+
+GBT_PLAYER_MAIN = '''
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "gbt_player.h"
+
+unsigned char io_mem[0x400];
+extern const uint8_t *song[];
+
+int main(int argc, char** argv)
+{
+    int ticks = atoi(argv[1]);
+    gbt_play(song, 1);
+    gbt_loop(atoi(argv[2]));
+
+    for(int tick = 0; tick < ticks; ++tick)
+    {
+        gbt_update();
+
+        for(int offset = 0x60; offset <= 0x9E; offset += 2)
+        {
+            printf("%d ", io_mem[offset] | (io_mem[offset + 1] << 8));
+        }
+
+        printf("\\n");
+    }
+
+    return 0;
+}
+'''
+
+
+class StreamPlayer:
+    """Replays a compiled song the same way as hw/src/bn_hw_dmg_precompiled_music.bn_iwram.cpp."""
+
+    def __init__(self, words, loop):
+        patterns_count, rows_count, loop_row, end_row, waves_count = words[0:5]
+        self.words = words
+        self.positions = HEADER_SIZE
+        self.waves = self.positions + (patterns_count * 64)
+        self.rows = self.waves + (waves_count * WAVE_SIZE)
+        self.ticks = self.rows + ((rows_count + 1) * ROW_SIZE)
+        self.rows_count = rows_count
+        self.loop_row = loop_row
+        self.end_row = -1 if end_row == NO_INDEX else end_row
+        self.loop = loop
+        self.registers = {offset: 0 for offset in range(FIRST_REGISTER, LAST_REGISTER + 2, 2)}
+        self.row_index = 0
+        self.tick = -1
+        self.idle_ticks = 0
+        self.tick_ptr = 0
+        self.next_row_ptr = 0
+        self.pan = 0
+        self.global_volume = 0x77
+        self.pan_volume_mask = PAN_MASK
+        self.playing = False
+
+        self.registers[SOUNDCNT_X] = 0x80
+        self.__silence()
+        self.__set_row(0)
+        self.playing = True
+
+    def position(self, pattern, row):
+        return self.words[self.positions + (pattern * 64) + row]
+
+    def row_ticks_ptr(self, row_index):
+        row = self.rows + (row_index * ROW_SIZE)
+        return self.ticks + (self.words[row + 2] | (self.words[row + 3] << 16))
+
+    def ticks_count(self):
+        count = 0
+        tick_ptr = self.ticks
+        end_ptr = self.row_ticks_ptr(self.rows_count)
+
+        while tick_ptr < end_ptr:
+            count += 1 + (self.words[tick_ptr + 1] >> 8)
+            tick_ptr += 2 + ((self.words[tick_ptr] & 0xFF) * 2)
+
+        return count
+
+    def clone(self):
+        result = copy.copy(self)
+        result.registers = dict(self.registers)
+        return result
+
+    def set_position(self, row_index):
+        self.__silence()
+        self.__seek(row_index)
+
+    def sync(self, row_index, tick):
+        self.update()
+
+        if self.row_index == row_index and self.tick == tick:
+            return 0
+
+        if row_index > self.row_index or (row_index == self.row_index and tick > self.tick):
+            for _ in range(MAX_CATCH_UP_TICKS):
+                self.update()
+
+                if self.row_index == row_index and self.tick == tick:
+                    return 0
+
+                if self.row_index > row_index or (self.row_index == row_index and self.tick > tick):
+                    break
+
+        self.__seek(row_index)
+        self.update()
+
+        while self.tick < tick and not self.__row_finished():
+            self.update()
+
+        return 1
+
+    def update(self):
+        if not self.playing:
+            return
+
+        if self.idle_ticks:
+            self.idle_ticks -= 1
+            self.tick += 1
+            return
+
+        if self.tick_ptr == self.next_row_ptr:
+            row_index = self.row_index + 1
+
+            if row_index == self.end_row and not self.loop:
+                self.playing = False
+                self.registers[SOUNDCNT_L] &= ~PAN_MASK
+                return
+
+            if row_index == self.rows_count:
+                self.__set_row(self.loop_row)
+            else:
+                self.row_index = row_index
+                self.tick = -1
+                self.next_row_ptr = self.row_ticks_ptr(row_index + 1)
+
+        words = self.words
+        header = words[self.tick_ptr]
+        info = words[self.tick_ptr + 1]
+        self.tick_ptr += 2
+        mute_mask = info & 0xFF
+
+        if mute_mask:
+            self.registers[SOUNDCNT_L] &= ~(mute_mask << 8)
+
+        for _ in range(header & 0xFF):
+            self.registers[words[self.tick_ptr]] = words[self.tick_ptr + 1]
+            self.tick_ptr += 2
+
+        self.idle_ticks = info >> 8
+        self.pan = header >> 8
+        self.tick += 1
+        self.registers[SOUNDCNT_L] = self.global_volume | ((self.pan << 8) & self.pan_volume_mask)
+
+    def output(self):
+        return [self.registers[offset] for offset in range(FIRST_REGISTER, LAST_REGISTER + 2, 2)]
+
+    def __seek(self, row_index):
+        self.__set_row(row_index)
+        self.__restore_channels(row_index)
+
+    def __row_finished(self):
+        return not self.idle_ticks and self.tick_ptr == self.next_row_ptr
+
+    def __silence(self):
+        registers = self.registers
+        registers[SOUNDCNT_L] &= ~PAN_MASK
+
+        for offset, value in ((0x60, 0), (0x62, 0), (0x64, RESTART), (0x68, 0), (0x6C, RESTART),
+                              (0x74, RESTART), (0x72, 0), (0x74, RESTART), (0x78, 0), (0x7C, RESTART)):
+            registers[offset] = value
+
+    def __set_row(self, row_index):
+        wave_index = self.words[self.rows + (row_index * ROW_SIZE) + 1]
+
+        if wave_index != NO_INDEX:
+            self.__load_wave(self.waves + (wave_index * WAVE_SIZE))
+
+        self.row_index = row_index
+        self.tick = -1
+        self.idle_ticks = 0
+        self.tick_ptr = self.row_ticks_ptr(row_index)
+        self.next_row_ptr = self.row_ticks_ptr(row_index + 1)
+
+    def __load_wave(self, wave):
+        words = self.words
+        registers = self.registers
+        registers[SOUNDCNT_L] &= ~(0x44 << 8)
+        registers[0x70] = 1 << 6
+
+        for index in range(8):
+            registers[0x90 + (index * 2)] = words[wave + 1 + index]
+
+        if words[wave] & 0x80:
+            registers[0x70] = 0
+
+            for index in range(8):
+                registers[0x90 + (index * 2)] = words[wave + 9 + index]
+
+            registers[0x70] = (1 << 5) | (1 << 7)
+        else:
+            registers[0x70] = 1 << 7
+
+    def __restore_channels(self, row_index):
+        row = self.rows + (row_index * ROW_SIZE) + 4
+
+        for index, offset in enumerate(CHANNEL_REGISTERS):
+            value = self.words[row + index]
+            self.registers[offset] = (value | RESTART) if offset in (0x64, 0x6C, 0x74, 0x7C) else value
+
+
+def build_gbt_player(compiler, song_file_path, build_folder_path):
+    source_folder_path = os.path.join(GBT_PLAYER_FOLDER_PATH, 'src')
+    shutil.copy(os.path.join(source_folder_path, 'gbt_player.c'), build_folder_path)
+
+    # Sound registers are redirected to an array:
+    with open(os.path.join(source_folder_path, 'gbt_hardware.h')) as hardware_file:
+        hardware = hardware_file.read()
+
+    hardware = re.sub(r'#define EWRAM_BSS .*', '#define EWRAM_BSS', hardware)
+    hardware = re.sub(r'#define MEM_IO_ADDR .*', 'extern unsigned char io_mem[0x400];\n'
+                                                  '#define MEM_IO_ADDR ((uintptr_t) io_mem)', hardware)
+
+    with open(os.path.join(build_folder_path, 'gbt_hardware.h'), 'w') as hardware_file:
+        hardware_file.write(hardware)
+
+    with open(os.path.join(build_folder_path, 'main.c'), 'w') as main_file:
+        main_file.write(GBT_PLAYER_MAIN)
+
+    executable_path = os.path.join(build_folder_path, 'gbt_player')
+    subprocess.check_call([compiler, '-O1', '-w', '-o', executable_path, '-I' + build_folder_path,
+                           '-I' + os.path.join(GBT_PLAYER_FOLDER_PATH, 'include'),
+                           os.path.join(build_folder_path, 'main.c'),
+                           os.path.join(build_folder_path, 'gbt_player.c'), song_file_path])
+    return executable_path
+
+
+def convert_song(file_path, song_file_path):
+    stdout = sys.stdout
+    sys.stdout = io.StringIO()
+
+    try:
+        if file_path.endswith('.mod'):
+            from mod2gbt import mod2gbt
+            cwd = os.getcwd()
+            os.chdir(os.path.dirname(song_file_path))
+
+            try:
+                mod2gbt.convert_file(file_path, 'song', True)
+            finally:
+                os.chdir(cwd)
+        else:
+            from s3m2gbt import s3m2gbt
+            s3m2gbt.convert_file(file_path, 'song', song_file_path, False)
+    finally:
+        sys.stdout = stdout
+
+
+def compare(file_name, test_name, expected_output, player, first_tick, ticks_count):
+    for tick in range(ticks_count):
+        player.update()
+        output = player.output()
+        expected = expected_output[first_tick + tick]
+
+        if output != expected:
+            differences = [(hex(FIRST_REGISTER + (index * 2)), expected_value, value)
+                           for index, (expected_value, value) in enumerate(zip(expected, output))
+                           if expected_value != value]
+            raise ValueError(file_name + ' ' + test_name + ' tick ' + str(first_tick + tick) +
+                             ' differences (register, expected, output): ' + str(differences))
+
+
+def test_file(compiler, file_path):
+    file_name = os.path.basename(file_path)
+    build_folder_path = tempfile.mkdtemp()
+
+    try:
+        song_file_path = os.path.join(build_folder_path, 'song.c')
+        convert_song(os.path.abspath(file_path), song_file_path)
+        executable_path = build_gbt_player(compiler, song_file_path, build_folder_path)
+        startup_commands, patterns = read_gbt_song(song_file_path, 'song')
+        words = compile_song(startup_commands, patterns)
+        song_ticks_count = StreamPlayer(words, True).ticks_count()
+        ticks_count = (song_ticks_count * 2) + 64
+
+        for loop in (True, False):
+            output = subprocess.check_output([executable_path, str(ticks_count), str(int(loop))])
+            expected_output = [[int(value) for value in line.split()] for line in output.decode().splitlines()]
+            compare(file_name, 'loop' if loop else 'no loop', expected_output, StreamPlayer(words, loop), 0,
+                    ticks_count)
+
+            if loop:
+                # Setting the position must restore the notes which are still playing:
+
+                reference_player = StreamPlayer(words, loop)
+                row_first_ticks = {}
+
+                for tick in range(song_ticks_count):
+                    reference_player.update()
+
+                    if reference_player.tick == 0 and reference_player.row_index not in row_first_ticks:
+                        row_first_ticks[reference_player.row_index] = tick
+
+                # Small forward drifts must be caught up without seeking:
+
+                player = StreamPlayer(words, loop)
+
+                for tick in range(0, song_ticks_count, 5):
+                    for drift in (1, 4, 8):
+                        reference_player = player.clone()
+
+                        for _ in range(drift):
+                            reference_player.update()
+
+                        row_index = reference_player.row_index
+                        row_position = words[player.rows + (row_index * ROW_SIZE)]
+                        first_row_index = reference_player.position(row_position >> 6, row_position & 63)
+
+                        # Song loops and rows played more than once are sought:
+                        if row_index >= player.row_index and row_index == first_row_index:
+                            synced_player = player.clone()
+
+                            if synced_player.sync(row_index, reference_player.tick):
+                                raise ValueError(file_name + ' sync tick ' + str(tick) + ' drift ' + str(drift) +
+                                                 ' is not caught up')
+
+                            compare(file_name, 'sync ' + str(tick) + ':' + str(drift), expected_output,
+                                    synced_player, tick + drift, 16)
+
+                    for _ in range(5):
+                        player.update()
+
+                for pattern in range(words[0]):
+                    for row in range(64):
+                        row_index = reference_player.position(pattern, row)
+
+                        if row_index != NO_INDEX:
+                            player = StreamPlayer(words, loop)
+                            player.set_position(row_index)
+                            compare(file_name, 'position ' + str(pattern) + ':' + str(row), expected_output, player,
+                                    row_first_ticks[row_index], 64)
+
+        print(file_name + ': ' + str(words[1]) + ' rows, ' + str(song_ticks_count) + ' ticks OK')
+    finally:
+        shutil.rmtree(build_folder_path)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description='DMG music compiler tests.')
+    parser.add_argument('--compiler', default='cc', help='host C compiler')
+    parser.add_argument('files', nargs='+', help='*.mod and *.s3m files to test')
+
+    try:
+        args = parser.parse_args()
+
+        for test_file_path in args.files:
+            test_file(args.compiler, test_file_path)
+    except Exception as ex:
+        sys.stderr.write('Error: ' + str(ex) + '\n')
+        exit(-1)
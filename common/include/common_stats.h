@@ -7,8 +7,10 @@
 #define COMMON_STATS_H
 
 #include "bn_vector.h"
+#include "bn_optional.h"
 #include "bn_sprite_ptr.h"
 #include "bn_fixed_point.h"
+#include "bn_retained_sprite_text.h"
 
 namespace bn
 {
@@ -43,8 +45,7 @@ public:
 private:
     bn::sprite_text_generator& _text_generator;
     bn::vector<bn::sprite_ptr, 8> _static_text_sprites;
-    bn::vector<bn::sprite_ptr, 2> _text_sprites;
-    bn::fixed_point _text_position;
+    bn::optional<bn::retained_sprite_text> _text;
     bn::fixed _max_cpu_usage;
     mode_type _mode = mode_type::SIMPLE;
     int _counter = 0;
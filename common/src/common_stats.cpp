@@ -24,9 +24,12 @@ void stats::set_mode(mode_type mode)
 {
     int text_x = 8 - (bn::display::width() / 2);
     int text_height = _text_generator.font().item().shape_size().height() + 4;
+    int text_max_width = _text_generator.font().item().shape_size().width() * 9;
+    int old_bg_priority = _text_generator.bg_priority();
+    _text_generator.set_bg_priority(0);
     _mode = mode;
     _static_text_sprites.clear();
-    _text_sprites.clear();
+    _text.reset();
     _max_cpu_usage = 0;
     _counter = 0;
 
@@ -37,36 +40,32 @@ void stats::set_mode(mode_type mode)
         break;
 
     case mode_type::SIMPLE:
-        _text_position = bn::fixed_point(text_x, text_height - (bn::display::height() / 2));
+        _text.emplace(_text_generator, text_x, text_height - (bn::display::height() / 2), text_max_width);
         break;
 
     case mode_type::DETAILED:
         {
             bn::string_view cpu_label = "CPU: ";
-            bn::fixed cpu_label_width = _text_generator.width(cpu_label);
-            _text_position = bn::fixed_point(text_x + cpu_label_width, text_height - (bn::display::height() / 2));
-
-            int old_bg_priority = _text_generator.bg_priority();
-            _text_generator.set_bg_priority(0);
+            int cpu_label_width = _text_generator.width(cpu_label);
+            int text_y = text_height - (bn::display::height() / 2);
+            _text.emplace(_text_generator, text_x + cpu_label_width, text_y, text_max_width);
 
             bn::string<32> text;
             bn::ostringstream text_stream(text);
             text_stream.append(cpu_label);
-            _text_generator.generate(text_x, _text_position.y(), text, _static_text_sprites);
+            _text_generator.generate(text_x, text_y, text, _static_text_sprites);
 
             text.clear();
             text_stream.append("IWR: ");
             text_stream.append(bn::memory::used_static_iwram());
             text_stream.append("B");
-            _text_generator.generate(text_x, _text_position.y() + text_height, text, _static_text_sprites);
+            _text_generator.generate(text_x, text_y + text_height, text, _static_text_sprites);
 
             text.clear();
             text_stream.append("EWR: ");
             text_stream.append(bn::memory::used_static_ewram());
             text_stream.append("B");
-            _text_generator.generate(text_x, _text_position.y() + (text_height * 2), text, _static_text_sprites);
-
-            _text_generator.set_bg_priority(old_bg_priority);
+            _text_generator.generate(text_x, text_y + (text_height * 2), text, _static_text_sprites);
         }
         break;
 
@@ -74,6 +73,8 @@ void stats::set_mode(mode_type mode)
         BN_ERROR("Invalid mode: ", int(mode));
         break;
     }
+
+    _text_generator.set_bg_priority(old_bg_priority);
 }
 
 void stats::update()
@@ -123,12 +124,8 @@ void stats::update()
             break;
         }
 
-        int old_bg_priority = _text_generator.bg_priority();
-        _text_generator.set_bg_priority(0);
         text_stream.append("%");
-        _text_sprites.clear();
-        _text_generator.generate(_text_position, text, _text_sprites);
-        _text_generator.set_bg_priority(old_bg_priority);
+        _text->set_text(text);
 
         _max_cpu_usage = 0;
         _counter = 60;
@@ -6,13 +6,10 @@
 #include "bn_core.h"
 #include "bn_math.h"
 #include "bn_keypad.h"
-#include "bn_display.h"
-#include "bn_affine_bg_ptr.h"
+#include "bn_mode_7.h"
+#include "bn_blending.h"
+#include "bn_unique_ptr.h"
 #include "bn_sprite_text_generator.h"
-#include "bn_affine_bg_pa_register_hbe_ptr.h"
-#include "bn_affine_bg_pc_register_hbe_ptr.h"
-#include "bn_affine_bg_dx_register_hbe_ptr.h"
-#include "bn_affine_bg_dy_register_hbe_ptr.h"
 
 #include "bn_affine_bg_items_land.h"
 
@@ -21,18 +18,10 @@
 
 namespace
 {
-    struct camera
-    {
-        bn::fixed x = 440;
-        bn::fixed y = 128;
-        bn::fixed z = 320;
-        int phi = 10;
-        int cos = 0;
-        int sin = 0;
-    };
-
-    void update_camera(camera& camera)
+    void update_camera(bn::mode_7& mode_7)
     {
+        bn::point_3d position = mode_7.camera_position();
+        bn::fixed phi = mode_7.camera_phi();
         bn::fixed dir_x = 0;
         bn::fixed dir_z = 0;
 
@@ -56,71 +45,39 @@ namespace
 
         if(bn::keypad::b_held())
         {
-            camera.y -= bn::fixed::from_data(2048);
-
-            if(camera.y < 0)
-            {
-                camera.y = 0;
-            }
+            position.set_y(bn::max(position.y() - bn::fixed::from_data(2048), bn::fixed(1)));
         }
         else if(bn::keypad::a_held())
         {
-            camera.y += bn::fixed::from_data(2048);
+            position.set_y(position.y() + bn::fixed::from_data(2048));
         }
 
         if(bn::keypad::l_held())
         {
-            camera.phi -= 4;
+            phi -= bn::fixed(0.703125);
 
-            if(camera.phi < 0)
+            if(phi < 0)
             {
-                camera.phi += 2048;
+                phi += 360;
             }
         }
         else if(bn::keypad::r_held())
         {
-            camera.phi += 4;
+            phi += bn::fixed(0.703125);
 
-            if(camera.phi >= 2048)
+            if(phi >= 360)
             {
-                camera.phi -= 2048;
+                phi -= 360;
             }
         }
 
-        camera.cos = bn::lut_cos(camera.phi).data() >> 4;
-        camera.sin = bn::lut_sin(camera.phi).data() >> 4;
-        camera.x += (dir_x * camera.cos) - (dir_z * camera.sin);
-        camera.z += (dir_x * camera.sin) + (dir_z * camera.cos);
-    }
-
-    void update_hbe_values(const camera& camera, int16_t* pa_values, int16_t* pc_values, int* dx_values,
-                           int* dy_values)
-    {
-        int camera_x = camera.x.data();
-        int camera_y = camera.y.data() >> 4;
-        int camera_z = camera.z.data();
-        int camera_cos = camera.cos;
-        int camera_sin = camera.sin;
-        int y_shift = 160;
-
-        for(int index = 0; index < bn::display::height(); ++index)
-        {
-            int reciprocal = bn::reciprocal_lut[index].data() >> 4;
-            int lam = camera_y * reciprocal >> 12;
-            int lcf = lam * camera_cos >> 8;
-            int lsf = lam * camera_sin >> 8;
-
-            pa_values[index] = int16_t(lcf >> 4);
-            pc_values[index] = int16_t(lsf >> 4);
-
-            int lxr = (bn::display::width() / 2) * lcf;
-            int lyr = y_shift * lsf;
-            dx_values[index] = (camera_x - lxr + lyr) >> 4;
-
-            lxr = (bn::display::width() / 2) * lsf;
-            lyr = y_shift * lcf;
-            dy_values[index] = (camera_z - lxr - lyr) >> 4;
-        }
+        bn::pair<bn::fixed, bn::fixed> sin_and_cos = bn::degrees_lut_sin_and_cos(phi);
+        int sin = sin_and_cos.first.data() >> 4;
+        int cos = sin_and_cos.second.data() >> 4;
+        position.set_x(position.x() + (dir_x * cos) - (dir_z * sin));
+        position.set_z(position.z() + (dir_x * sin) + (dir_z * cos));
+        mode_7.set_camera_position(position);
+        mode_7.set_camera_phi(phi);
     }
 }
 
@@ -135,34 +92,26 @@ int main()
         "Up/Down: move camera z",
         "B/A: move camera y",
         "L/R: move camera phi",
+        "START: enable/disable fog",
     };
 
     common::info info("Mode 7", info_text_lines, text_generator);
 
-    bn::affine_bg_ptr bg = bn::affine_bg_items::land.create_bg(-376, -336);
-
-    int16_t pa_values[bn::display::height()];
-    bn::affine_bg_pa_register_hbe_ptr pa_hbe = bn::affine_bg_pa_register_hbe_ptr::create(bg, pa_values);
-
-    int16_t pc_values[bn::display::height()];
-    bn::affine_bg_pc_register_hbe_ptr pc_hbe = bn::affine_bg_pc_register_hbe_ptr::create(bg, pc_values);
-
-    int dx_values[bn::display::height()];
-    bn::affine_bg_dx_register_hbe_ptr dx_hbe = bn::affine_bg_dx_register_hbe_ptr::create(bg, dx_values);
-
-    int dy_values[bn::display::height()];
-    bn::affine_bg_dy_register_hbe_ptr dy_hbe = bn::affine_bg_dy_register_hbe_ptr::create(bg, dy_values);
-
-    camera camera;
+    bn::unique_ptr<bn::mode_7> mode_7(new bn::mode_7(bn::affine_bg_items::land.create_bg(-376, -336)));
+    mode_7->set_camera_position(bn::point_3d(440, 128, 320));
+    mode_7->set_camera_phi(bn::fixed(1.7578125));
+    mode_7->set_fog_lines(48);
+    bn::blending::set_fade_color(bn::blending::fade_color_type::WHITE);
 
     while(true)
     {
-        update_camera(camera);
-        update_hbe_values(camera, pa_values, pc_values, dx_values, dy_values);
-        pa_hbe.reload_values_ref();
-        pc_hbe.reload_values_ref();
-        dx_hbe.reload_values_ref();
-        dy_hbe.reload_values_ref();
+        if(bn::keypad::start_pressed())
+        {
+            mode_7->set_fog_intensity(mode_7->fog_intensity() == 0 ? bn::fixed(0.75) : bn::fixed(0));
+        }
+
+        update_camera(*mode_7);
+        mode_7->update();
         info.update();
         bn::core::update();
     }
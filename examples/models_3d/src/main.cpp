@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_core.h"
+#include "bn_keypad.h"
+#include "bn_string.h"
+#include "bn_display.h"
+#include "bn_math_3d.h"
+#include "bn_camera_3d.h"
+#include "bn_models_3d.h"
+#include "bn_unique_ptr.h"
+#include "bn_bg_palettes.h"
+#include "bn_sprite_text_generator.h"
+
+#include "bn_model_3d_items_towers.h"
+#include "bn_model_3d_items_pyramid.h"
+
+#include "common_info.h"
+#include "common_stats.h"
+#include "common_variable_8x8_sprite_font.h"
+#include "common_variable_8x16_sprite_font.h"
+
+namespace
+{
+    constexpr bn::string_view info_text_lines[] = {
+        "PAD: move camera",
+        "L/R: rotate camera",
+        "A: add pyramid",
+        "B: remove pyramid",
+        "START: show/hide towers",
+    };
+
+    void update_camera(bn::camera_3d& camera)
+    {
+        bn::fixed phi = camera.phi();
+
+        if(bn::keypad::l_held())
+        {
+            camera.set_phi(phi - 256);
+        }
+        else if(bn::keypad::r_held())
+        {
+            camera.set_phi(phi + 256);
+        }
+
+        bn::point_3d position = camera.position();
+        bn::point_3d u = camera.u();
+        bn::point_3d v = camera.v();
+
+        if(bn::keypad::left_held())
+        {
+            position -= u;
+        }
+        else if(bn::keypad::right_held())
+        {
+            position += u;
+        }
+
+        if(bn::keypad::up_held())
+        {
+            position -= v;
+        }
+        else if(bn::keypad::down_held())
+        {
+            position += v;
+        }
+
+        camera.set_position(position);
+    }
+
+    void update_faces_text(const bn::models_3d& models, bn::sprite_text_generator& text_generator,
+                           bn::ivector<bn::sprite_ptr>& text_sprites)
+    {
+        bn::string<32> text;
+        bn::ostringstream text_stream(text);
+        text_stream.append("Faces: ");
+        text_stream.append(models.visible_faces_count());
+        text_stream.append("/");
+        text_stream.append(models.faces_count());
+        text_sprites.clear();
+        text_generator.set_right_alignment();
+        text_generator.generate((bn::display::width() / 2) - 8, 12 - (bn::display::height() / 2), text, text_sprites);
+        text_generator.set_left_alignment();
+    }
+}
+
+int main()
+{
+    bn::core::init();
+    bn::bg_palettes::set_transparent_color(bn::color(4, 4, 8));
+
+    bn::sprite_text_generator big_text_generator(common::variable_8x16_sprite_font);
+    common::info info("3D models", info_text_lines, big_text_generator);
+
+    bn::sprite_text_generator small_text_generator(common::variable_8x8_sprite_font);
+    common::stats stats(small_text_generator);
+    bn::vector<bn::sprite_ptr, 4> faces_text_sprites;
+
+    bn::unique_ptr<bn::models_3d> models(new bn::models_3d());
+    models->load_colors(bn::model_3d_items::towers_colors);
+
+    const bn::model_3d_item* static_model_items[] = {
+        &bn::model_3d_items::towers
+    };
+
+    models->set_static_model_items(static_model_items, 1);
+
+    bn::camera_3d camera;
+    bn::vector<bn::model_3d*, bn::models_3d::max_dynamic_models()> pyramids;
+    bool towers_shown = true;
+    int angle = 0;
+    int counter = 0;
+
+    while(true)
+    {
+        if(bn::keypad::a_pressed() && ! pyramids.full())
+        {
+            pyramids.push_back(&models->create_dynamic_model(bn::model_3d_items::pyramid));
+        }
+        else if(bn::keypad::b_pressed() && ! pyramids.empty())
+        {
+            models->destroy_dynamic_model(*pyramids.back());
+            pyramids.pop_back();
+        }
+
+        if(bn::keypad::start_pressed())
+        {
+            towers_shown = ! towers_shown;
+            models->set_static_model_items(static_model_items, towers_shown ? 1 : 0);
+        }
+
+        update_camera(camera);
+        angle = (angle + 128) % bn::sin_3d_lut_size;
+
+        for(int index = 0, limit = pyramids.size(); index < limit; ++index)
+        {
+            bn::model_3d* pyramid = pyramids[index];
+            int pyramid_angle = (angle + (index * (bn::sin_3d_lut_size / 4))) % bn::sin_3d_lut_size;
+            pyramid->set_position(bn::point_3d(bn::cos_3d(pyramid_angle) * 64, 80, bn::sin_3d(pyramid_angle) * 64));
+            pyramid->set_phi(pyramid_angle);
+            pyramid->set_theta(angle);
+        }
+
+        models->update(camera);
+
+        if(! counter)
+        {
+            update_faces_text(*models, small_text_generator, faces_text_sprites);
+            counter = 8;
+        }
+
+        --counter;
+        info.update();
+        stats.update();
+        bn::core::update();
+    }
+}
@@ -28,12 +28,6 @@ public:
     void update();
 
 private:
-    struct hline
-    {
-        int ixl = bn::display::width();
-        int ixr = 0;
-    };
-
     bn::vector<const polygon*, 2> _polygons;
     bn::sprite_ptr _sprite;
     bn::array<bn::fixed, bn::display::height()> _vertical_values;
@@ -41,25 +35,6 @@ private:
     bn::array<bn::fixed, bn::display::height()> _horizontal_values;
     bn::sprite_position_hbe_ptr _horizontal_hbe;
     bool _update = true;
-
-    static void _draw_not_horizontal_line(bool left, int x0, int y0, int x1, int y1, hline* hlines);
-
-    static void _draw_horizontal_line(int x0, int x1, int y, hline* hlines);
-
-    BN_CODE_IWRAM static void _draw_left_line_octant_0(int x0, int y0, int delta_x, int delta_y, int x_direction,
-                                                        hline* hlines);
-
-    BN_CODE_IWRAM static void _draw_right_line_octant_0(int x0, int y0, int delta_x, int delta_y, int x_direction,
-                                                         hline* hlines);
-
-    BN_CODE_IWRAM static void _draw_left_line_octant_1(int x0, int y0, int delta_x, int delta_y, int x_direction,
-                                                        hline* hlines);
-
-    BN_CODE_IWRAM static void _draw_right_line_octant_1(int x0, int y0, int delta_x, int delta_y, int x_direction,
-                                                         hline* hlines);
-
-    BN_CODE_IWRAM static void _setup_attributes(const hline* hlines, bn::fixed* vertical_values,
-                                                 bn::fixed* horizontal_values);
 };
 
 #endif
@@ -9,7 +9,9 @@
 #include "bn_display.h"
 #include "bn_sprite_ptr.h"
 #include "bn_bg_palettes.h"
+#include "bn_regular_bg_ptr.h"
 #include "bn_sprite_text_generator.h"
+#include "bn_regular_bg_text_generator.h"
 
 #include "fixed_32x64_sprite_font.h"
 
@@ -213,6 +215,45 @@ namespace
             bn::core::update();
         }
     }
+
+    void regular_bg_text_scene()
+    {
+        bn::sprite_text_generator text_generator(common::variable_8x16_sprite_font);
+        text_generator.set_center_alignment();
+
+        bn::vector<bn::sprite_ptr, 32> text_sprites;
+        text_generator.generate(0, -text_y_limit, "Regular BG text", text_sprites);
+        text_generator.generate(0, text_y_limit, "START: go to next scene", text_sprites);
+
+        constexpr bn::string_view page_lines[] = {
+            "This page is printed in the tiles",
+            "and the map of a regular BG,",
+            "so it doesn't use any sprite.",
+            "",
+            "Variable width characters are",
+            "packed across tile boundaries.",
+        };
+
+        bn::regular_bg_text_generator bg_text_generator(common::variable_8x16_sprite_font, 512);
+        bg_text_generator.set_center_alignment();
+
+        int map_center_x = bn::regular_bg_text_generator::columns * 4;
+        int map_center_y = bn::regular_bg_text_generator::rows * 4;
+        int text_y = map_center_y - 48;
+
+        for(const bn::string_view& page_line : page_lines)
+        {
+            bg_text_generator.generate(map_center_x, text_y, page_line);
+            text_y += 16;
+        }
+
+        bn::regular_bg_ptr bg = bn::regular_bg_ptr::create(0, 0, bg_text_generator.map());
+
+        while(! bn::keypad::start_pressed())
+        {
+            bn::core::update();
+        }
+    }
 }
 
 int main()
@@ -243,5 +284,8 @@ int main()
 
         utf8_text_scene();
         bn::core::update();
+
+        regular_bg_text_scene();
+        bn::core::update();
     }
 }
@@ -8,6 +8,7 @@
 
 #include "bn_vector.h"
 #include "bn_sprite_ptr.h"
+#include "bn_retained_sprite_text.h"
 #include "bn_sprite_affine_mat_ptr.h"
 #include "bn_sprite_palette_actions.h"
 #include "bn_sprite_affine_mat_actions.h"
@@ -36,9 +37,9 @@ public:
 private:
     bn::sprite_text_generator& _text_generator;
     bn::vector<bn::sprite_ptr, 1> _level_label_sprites;
-    bn::vector<bn::sprite_ptr, 1> _level_number_sprites;
     bn::vector<bn::sprite_ptr, 1> _experience_label_sprites;
-    bn::vector<bn::sprite_ptr, 2> _experience_number_sprites;
+    bn::retained_sprite_text _level_number_text;
+    bn::retained_sprite_text _experience_number_text;
     bn::vector<bn::sprite_ptr, 4> _experience_bar_sprites;
     bn::optional<bn::sprite_palette_rotate_by_action> _experience_bar_palette_action;
     bn::vector<bn::sprite_ptr, constants::max_hero_bombs> _bomb_sprites;
@@ -27,6 +27,12 @@ namespace
     constexpr int experience_text_x = experience_bar_x - 8;
     constexpr int experience_text_y = (bn::display::height() / 2) - 32;
 
+    [[nodiscard]] const bn::sprite_text_generator& _center_aligned(bn::sprite_text_generator& text_generator)
+    {
+        text_generator.set_center_alignment();
+        return text_generator;
+    }
+
     void _set_visible(bool visible, bn::ivector<bn::sprite_ptr>& sprites)
     {
         for(bn::sprite_ptr& sprite : sprites)
@@ -38,9 +44,10 @@ namespace
 
 scoreboard::scoreboard(bn::sprite_text_generator& text_generator) :
     _text_generator(text_generator),
+    _level_number_text(_center_aligned(text_generator), level_text_x, level_text_y, 32),
+    _experience_number_text(_center_aligned(text_generator), experience_text_x, experience_text_y, 64),
     _bombs_affine_mat(bn::sprite_affine_mat_ptr::create())
 {
-    _text_generator.set_center_alignment();
     _text_generator.generate(level_text_x, level_text_y - 12, "LVL", _level_label_sprites);
     _text_generator.generate(experience_text_x, experience_text_y - 12, "EXP", _experience_label_sprites);
 
@@ -80,9 +87,9 @@ scoreboard::scoreboard(bn::sprite_text_generator& text_generator) :
 void scoreboard::set_visible(bool visible)
 {
     _set_visible(visible, _level_label_sprites);
-    _set_visible(visible, _level_number_sprites);
     _set_visible(visible, _experience_label_sprites);
-    _set_visible(visible, _experience_number_sprites);
+    _level_number_text.set_visible(visible);
+    _experience_number_text.set_visible(visible);
     _set_visible(visible, _experience_bar_sprites);
     _set_visible(visible, _bomb_sprites);
 }
@@ -133,10 +140,7 @@ void scoreboard::update(const hero& hero)
             text = "MAX";
         }
 
-        _level_number_sprites.clear();
-        _text_generator.set_center_alignment();
-        _text_generator.generate(level_text_x, level_text_y, text, _level_number_sprites);
-        _set_visible(visible, _level_number_sprites);
+        _level_number_text.set_text(text);
     }
 
     if(experience != _last_experience)
@@ -162,10 +166,7 @@ void scoreboard::update(const hero& hero)
         }
 
         bn::string<8> text = bn::to_string<8>(experience);
-        _experience_number_sprites.clear();
-        _text_generator.set_center_alignment();
-        _text_generator.generate(experience_text_x, experience_text_y, text, _experience_number_sprites);
-        _set_visible(visible, _experience_number_sprites);
+        _experience_number_text.set_text(text);
     }
 
     if(bombs_count != _last_bombs_count)
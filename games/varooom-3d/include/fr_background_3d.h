@@ -10,11 +10,12 @@
 #include "bn_affine_bg_ptr.h"
 #include "bn_bg_palette_ptr.h"
 
+#include "fr_camera_3d.h"
+
 namespace fr
 {
 
 class stage;
-class camera_3d;
 
 class background_3d
 {
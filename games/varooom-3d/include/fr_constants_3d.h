@@ -6,7 +6,7 @@
 #ifndef FR_CONSTANTS_3D_H
 #define FR_CONSTANTS_3D_H
 
-#include "bn_common.h"
+#include "bn_config_models_3d.h"
 
 #ifndef FR_PROFILE
     #define FR_PROFILE false
@@ -32,22 +32,14 @@
     #define FR_SHOW_CPU_USAGE_CURRENT false
 #endif
 
-#ifndef FR_LOG_POLYGONS_PER_SECOND
-    #define FR_LOG_POLYGONS_PER_SECOND false
-#endif
-
 #ifndef FR_SKIP_RACE_INTRO
     #define FR_SKIP_RACE_INTRO false
 #endif
 
 namespace fr::constants_3d
 {
-    constexpr int focal_length_shift = 8;
-
-    constexpr int max_dynamic_models = 4;
-    constexpr int max_static_models = 32 - max_dynamic_models;
+    constexpr int max_static_models = BN_CFG_MODELS_3D_MAX_STATIC_MODELS;
     constexpr int max_stage_models = 1024;
-    constexpr int max_sprites = 8;
 
     constexpr int camera_min_y = 224;
     constexpr int camera_max_y = 256;
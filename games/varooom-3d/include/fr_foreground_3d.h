@@ -6,14 +6,14 @@
 #ifndef FR_FOREGROUND_3D_H
 #define FR_FOREGROUND_3D_H
 
+#include "fr_models_3d.h"
+#include "fr_camera_3d.h"
 #include "fr_visible_model_3d_grid.h"
 
 namespace fr
 {
 
 class stage;
-class models_3d;
-class camera_3d;
 class announcer;
 class player_car;
 
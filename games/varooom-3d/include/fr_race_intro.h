@@ -9,15 +9,14 @@
 #include "bn_bg_palettes_actions.h"
 #include "bn_sprite_palettes_actions.h"
 
+#include "fr_models_3d.h"
+#include "fr_camera_3d.h"
 #include "fr_constants_3d.h"
 
 namespace fr
 {
 
 class stage;
-class model_3d;
-class models_3d;
-class camera_3d;
 
 class race_intro
 {
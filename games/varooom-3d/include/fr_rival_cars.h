@@ -6,6 +6,7 @@
 #ifndef FR_RIVAL_CARS_H
 #define FR_RIVAL_CARS_H
 
+#include "fr_models_3d.h"
 #include "fr_constants_3d.h"
 #include "fr_sprite_3d_item.h"
 
@@ -13,8 +14,6 @@ namespace fr
 {
 
 class stage;
-class sprite_3d;
-class models_3d;
 class announcer;
 class player_car;
 class race_state;
@@ -6,13 +6,11 @@
 #ifndef FR_TITLE_FLAG_H
 #define FR_TITLE_FLAG_H
 
-#include "fr_model_3d.h"
+#include "fr_models_3d.h"
 
 namespace fr
 {
 
-class models_3d;
-
 class title_flag
 {
 
@@ -6,11 +6,11 @@
 #include "fr_background_3d.h"
 
 #include "bn_blending.h"
+#include "bn_math_3d.h"
 #include "bn_affine_bg_item.h"
 #include "bn_affine_bg_mat_attributes.h"
 
 #include "fr_stage.h"
-#include "fr_div_lut.h"
 #include "fr_camera_3d.h"
 
 namespace fr
@@ -49,7 +49,7 @@ void background_3d::update(const stage& stage, const camera_3d& camera)
     _clouds_bg_pivot_diff += stage.clouds_bg_pivot_inc();
 
     // bn::fixed scale = bn::fixed(256).division(camera_position.y());
-    bn::fixed scale = bn::fixed::from_data(div_lut_ptr[camera_position.y().data() >> 10] >> 2);
+    bn::fixed scale = bn::fixed::from_data(bn::division_3d_lut._data[camera_position.y().data() >> 10] >> 2);
     _ground_bg.set_scale(scale);
 
     int degrees = camera.phi().right_shift_integer() * 360;
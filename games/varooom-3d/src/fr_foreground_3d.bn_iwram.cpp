@@ -6,8 +6,8 @@
 #include "fr_foreground_3d.h"
 
 #include "bn_display.h"
+#include "bn_math_3d.h"
 
-#include "fr_div_lut.h"
 #include "fr_camera_3d.h"
 
 namespace fr
@@ -18,13 +18,13 @@ int foreground_3d::_reload_static_model_items_impl(const camera_3d& camera, cons
 {
     constexpr int display_width = bn::display::width();
     constexpr int display_height = bn::display::height();
-    constexpr int focal_length_shift = constants_3d::focal_length_shift;
+    constexpr int focal_length_shift = models_3d::focal_length_shift;
 
     constexpr bn::fixed vry = (0 - 256) / 16;
     constexpr int vcz = -vry.data();
 
     // constexpr int scale = (1 << (focal_length_shift + 16)) / vcz;
-    constexpr auto scale = int((calculate_div_lut_value(vcz >> 6) << (focal_length_shift - 8)) >> 6);
+    constexpr auto scale = int((bn::calculate_division_3d_lut_value(vcz >> 6) << (focal_length_shift - 8)) >> 6);
 
     bn::fixed camera_x = camera.position().x();
     bn::fixed camera_z = camera.position().z();
@@ -8,13 +8,13 @@
 #include "bn_music.h"
 #include "bn_keypad.h"
 #include "bn_rumble.h"
+#include "bn_math_3d.h"
 #include "bn_bgs_mosaic.h"
 #include "bn_green_swap.h"
 #include "bn_affine_bg_item.h"
 #include "bn_sprites_mosaic.h"
 
 #include "fr_stage.h"
-#include "fr_sin_cos.h"
 #include "fr_models_3d.h"
 #include "fr_camera_3d.h"
 #include "fr_announcer.h"
@@ -288,8 +288,8 @@ void player_car::update(const stage& stage, const race_state& state, bool read_k
 
     constexpr bn::rule_of_three_approximation angle_16_rule_of_three(pi_2.data(), 65536);
     int angle_16_data = angle_16_rule_of_three.calculate(angle.data());
-    bn::fixed angle_sin = sin(angle_16_data);
-    bn::fixed angle_cos = cos(angle_16_data);
+    bn::fixed angle_sin = bn::sin_3d(angle_16_data);
+    bn::fixed angle_cos = bn::cos_3d(angle_16_data);
     _angle = angle;
     _angle_sin = angle_sin;
     _angle_cos = angle_cos;
@@ -646,8 +646,8 @@ void player_car::_end_crash(const stage& stage, const race_state& state)
 
     constexpr bn::rule_of_three_approximation angle_16_rule_of_three(pi_2.data(), 65536);
     int angle_16_data = angle_16_rule_of_three.calculate(angle.data());
-    bn::fixed angle_sin = sin(angle_16_data);
-    bn::fixed angle_cos = cos(angle_16_data);
+    bn::fixed angle_sin = bn::sin_3d(angle_16_data);
+    bn::fixed angle_cos = bn::cos_3d(angle_16_data);
     _angle = angle;
     _angle_sin = angle_sin;
     _angle_cos = angle_cos;
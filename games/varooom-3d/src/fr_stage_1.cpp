@@ -840,8 +840,8 @@ namespace
         {
             int angle_16_data = angle_16_rule_of_three.calculate(checkpoints[index].angle().data());
             int angle = angle_16_data + 16384;
-            bn::fixed angle_sin = sin(angle);
-            bn::fixed angle_cos = cos(angle);
+            bn::fixed angle_sin = bn::sin_3d(angle);
+            bn::fixed angle_cos = bn::cos_3d(angle);
             vectors[index] = bn::point(angle_sin.data() / 4, angle_cos.data() / 4);
         }
 
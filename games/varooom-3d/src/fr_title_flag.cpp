@@ -90,7 +90,7 @@ void title_flag::update()
                 wave_angle -= 65536;
             }
 
-            bn::fixed wave_sin = sin(wave_angle);
+            bn::fixed wave_sin = bn::sin_3d(wave_angle);
             bn::fixed vertex_y = wave_sin * 4;
 
             for(int row = 0; row < 6; ++row)
@@ -7,10 +7,10 @@
 
 #include "bn_colors.h"
 #include "bn_display.h"
+#include "bn_math_3d.h"
 #include "bn_blending.h"
 #include "bn_regular_bg_map_ptr.h"
 
-#include "fr_sin_cos.h"
 #include "fr_scene_type.h"
 #include "fr_common_stuff.h"
 #include "fr_model_colors.h"
@@ -355,8 +355,8 @@ void title_scene::_update_intro_0()
     auto set_car_position = [](model_3d& car_model) {
         bn::fixed car_angle = car_model.phi();
         int angle = car_angle.right_shift_integer();
-        bn::fixed sf = sin(angle);
-        bn::fixed cf = cos(angle);
+        bn::fixed sf = bn::sin_3d(angle);
+        bn::fixed cf = bn::cos_3d(angle);
         car_model.set_position(point_3d((cf * 128) - 92, (sf * 128) + 224, 8));
     };
 
@@ -394,8 +394,8 @@ void title_scene::_update_intro_1()
     auto set_car_position = [](model_3d& car_model) {
         bn::fixed car_angle = car_model.phi() + 8192;
         int angle = car_angle.right_shift_integer();
-        bn::fixed sf = sin(angle);
-        bn::fixed cf = cos(angle);
+        bn::fixed sf = bn::sin_3d(angle);
+        bn::fixed cf = bn::cos_3d(angle);
         car_model.set_position(point_3d((sf * 16) - 16, 192, (-cf * 128) - 128));
     };
 
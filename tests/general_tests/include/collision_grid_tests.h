@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef COLLISION_GRID_TESTS_H
+#define COLLISION_GRID_TESTS_H
+
+#include "bn_array.h"
+#include "bn_timer.h"
+#include "bn_random.h"
+#include "bn_unique_ptr.h"
+#include "bn_collision_grid.h"
+#include "bn_collision_sweep.h"
+#include "tests.h"
+
+class collision_grid_tests : public tests
+{
+
+public:
+    collision_grid_tests() :
+        tests("collision_grid")
+    {
+        // Colliders:
+
+        bn::collider rect(bn::fixed_rect(0, 0, 8, 8));
+        BN_ASSERT(! rect.circle());
+        BN_ASSERT(rect.intersects(bn::collider(bn::fixed_rect(7, 7, 8, 8))));
+        BN_ASSERT(! rect.intersects(bn::collider(bn::fixed_rect(8, 0, 8, 8))));
+
+        bn::collider circle(bn::fixed_point(0, 0), 4);
+        BN_ASSERT(circle.circle());
+        BN_ASSERT(circle.intersects(bn::collider(bn::fixed_point(5, 0), 2)));
+        BN_ASSERT(! circle.intersects(bn::collider(bn::fixed_point(5, 5), 2)));
+        BN_ASSERT(circle.intersects(bn::collider(bn::fixed_rect(6, 0, 6, 2))));
+        BN_ASSERT(! circle.intersects(bn::collider(bn::fixed_rect(6, 6, 6, 6))));
+        BN_ASSERT(! bn::collider(bn::fixed_rect(6, 6, 6, 6)).intersects(circle));
+
+        // 256 bullets vs 64 enemies:
+
+        bn::random random;
+        bn::unique_ptr<grid_type> grid = bn::make_unique<grid_type>(16);
+        bn::unique_ptr<sweep_type> sweep = bn::make_unique<sweep_type>();
+
+        for(int index = 0; index < _enemies_count; ++index)
+        {
+            bn::fixed_point position(random.get_int(-120, 120), random.get_int(-80, 80));
+            (*_colliders)[index] = bn::collider(bn::fixed_rect(position, bn::fixed_size(16, 16)));
+        }
+
+        for(int index = _enemies_count; index < _colliders_count; ++index)
+        {
+            bn::fixed_point position(random.get_fixed(-120, 120), random.get_fixed(-80, 80));
+
+            if(index % 2)
+            {
+                (*_colliders)[index] = bn::collider(position, 2);
+            }
+            else
+            {
+                (*_colliders)[index] = bn::collider(bn::fixed_rect(position, bn::fixed_size(4, 4)));
+            }
+        }
+
+        for(int index = 0; index < _colliders_count; ++index)
+        {
+            bool enemy = index < _enemies_count;
+            unsigned layers = enemy ? _enemy_layer : _bullet_layer;
+            unsigned mask = enemy ? 0 : _enemy_layer;
+            int grid_id = grid->add((*_colliders)[index], layers, mask);
+            int sweep_id = sweep->add((*_colliders)[index], layers, mask);
+            BN_ASSERT(grid_id == index, "Invalid grid id: ", grid_id, " - ", index);
+            BN_ASSERT(sweep_id == index, "Invalid sweep id: ", sweep_id, " - ", index);
+        }
+
+        _test_pairs(*grid, *sweep, "Static");
+
+        // Incremental moves:
+
+        for(int index = 0; index < _colliders_count; ++index)
+        {
+            bn::collider& collider = (*_colliders)[index];
+            bn::fixed_point position = collider.position();
+            position += bn::fixed_point(random.get_fixed(-4, 4), random.get_fixed(-4, 4));
+            collider.set_position(position);
+            grid->set_position(index, position);
+            sweep->set_position(index, position);
+        }
+
+        _test_pairs(*grid, *sweep, "Moved");
+
+        // Removes:
+
+        for(int index = _enemies_count; index < _colliders_count; index += 2)
+        {
+            _removed[index] = true;
+            grid->remove(index);
+            sweep->remove(index);
+        }
+
+        BN_ASSERT(grid->size() == _colliders_count - (_bullets_count / 2), "Invalid grid size: ", grid->size());
+        BN_ASSERT(sweep->size() == _colliders_count - (_bullets_count / 2), "Invalid sweep size: ", sweep->size());
+        BN_ASSERT(! grid->contains(_enemies_count));
+        BN_ASSERT(! sweep->contains(_enemies_count));
+
+        _test_pairs(*grid, *sweep, "Removed");
+
+        // Area queries:
+
+        for(int index = 0; index < 16; ++index)
+        {
+            bn::collider area(bn::fixed_point(random.get_fixed(-128, 128), random.get_fixed(-88, 88)), 8);
+            bool expected = false;
+
+            for(int enemy_index = 0; enemy_index < _enemies_count; ++enemy_index)
+            {
+                expected |= area.intersects((*_colliders)[enemy_index]);
+            }
+
+            int grid_id = grid->find_collision(area, _enemy_layer);
+            int sweep_id = sweep->find_collision(area, _enemy_layer);
+            BN_ASSERT((grid_id >= 0) == expected, "Invalid grid area query: ", index, " - ", grid_id);
+            BN_ASSERT((sweep_id >= 0) == expected, "Invalid sweep area query: ", index, " - ", sweep_id);
+        }
+    }
+
+private:
+    static constexpr int _enemies_count = 64;
+    static constexpr int _bullets_count = 256;
+    static constexpr int _colliders_count = _enemies_count + _bullets_count;
+    static constexpr unsigned _bullet_layer = 1;
+    static constexpr unsigned _enemy_layer = 2;
+
+    using grid_type = bn::collision_grid<_colliders_count, 16, 12>;
+    using sweep_type = bn::collision_sweep<_colliders_count>;
+    using colliders_type = bn::array<bn::collider, _colliders_count>;
+
+    bn::unique_ptr<colliders_type> _colliders = bn::make_unique<colliders_type>();
+    bool _removed[_colliders_count] = {};
+
+    void _test_pairs(grid_type& grid, sweep_type& sweep, const char* title) const
+    {
+        // Brute force:
+
+        int expected_count = 0;
+        int expected_checksum = 0;
+
+        bn::timer timer;
+
+        for(int bullet_index = _enemies_count; bullet_index < _colliders_count; ++bullet_index)
+        {
+            if(_removed[bullet_index])
+            {
+                continue;
+            }
+
+            const bn::collider& bullet = (*_colliders)[bullet_index];
+
+            for(int enemy_index = 0; enemy_index < _enemies_count; ++enemy_index)
+            {
+                if(bullet.intersects((*_colliders)[enemy_index]))
+                {
+                    ++expected_count;
+                    expected_checksum += (bullet_index * _colliders_count) + enemy_index;
+                }
+            }
+        }
+
+        int brute_force_cycles = timer.elapsed_ticks() * 64;
+
+        // bn::collision_grid:
+
+        int grid_count = 0;
+        int grid_checksum = 0;
+        timer.restart();
+
+        grid.for_each_pair([&grid_count, &grid_checksum](int id, int other_id)
+        {
+            ++grid_count;
+            grid_checksum += (id * _colliders_count) + other_id;
+        });
+
+        int grid_cycles = timer.elapsed_ticks() * 64;
+        BN_ASSERT(grid_count == expected_count, "Invalid grid count: ", grid_count, " - ", expected_count);
+        BN_ASSERT(grid_checksum == expected_checksum, "Invalid grid checksum: ", grid_checksum,
+                  " - ", expected_checksum);
+
+        // bn::collision_sweep:
+
+        int sweep_count = 0;
+        int sweep_checksum = 0;
+        timer.restart();
+
+        sweep.for_each_pair([&sweep_count, &sweep_checksum](int id, int other_id)
+        {
+            ++sweep_count;
+            sweep_checksum += (id * _colliders_count) + other_id;
+        });
+
+        int sweep_cycles = timer.elapsed_ticks() * 64;
+        BN_ASSERT(sweep_count == expected_count, "Invalid sweep count: ", sweep_count, " - ", expected_count);
+        BN_ASSERT(sweep_checksum == expected_checksum, "Invalid sweep checksum: ", sweep_checksum,
+                  " - ", expected_checksum);
+
+        BN_LOG(title, " pairs (", expected_count, "): brute force cycles: ", brute_force_cycles,
+               " - grid cycles: ", grid_cycles, " - sweep cycles: ", sweep_cycles);
+    }
+};
+
+#endif
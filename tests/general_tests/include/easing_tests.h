@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef EASING_TESTS_H
+#define EASING_TESTS_H
+
+#include "bn_easing.h"
+#include "tests.h"
+
+class easing_tests : public tests
+{
+
+public:
+    easing_tests() :
+        tests("easing")
+    {
+        for(int index = 0; index <= int(bn::easing_type::BOUNCE_OUT); ++index)
+        {
+            auto easing = bn::easing_type(index);
+            BN_ASSERT(bn::easing::apply(easing, 0) == 0, "Invalid start: ", index);
+            BN_ASSERT(bn::easing::apply(easing, 1) == 1, "Invalid end: ", index);
+            BN_ASSERT(bn::easing::apply(easing, -1) == 0, "Invalid clamped start: ", index);
+            BN_ASSERT(bn::easing::apply(easing, 2) == 1, "Invalid clamped end: ", index);
+        }
+
+        BN_ASSERT(bn::easing::apply(bn::easing_type::LINEAR, 0.25) == 0.25);
+        BN_ASSERT(bn::easing::apply(bn::easing_type::QUAD_IN, 0.5) == 0.25);
+        BN_ASSERT(bn::easing::apply(bn::easing_type::QUAD_OUT, 0.5) == 0.75);
+        BN_ASSERT(bn::easing::apply(bn::easing_type::QUAD_IN_OUT, 0.5) == 0.5);
+        BN_ASSERT(bn::easing::apply(bn::easing_type::CUBIC_IN, 0.5) == 0.125);
+        BN_ASSERT(bn::easing::apply(bn::easing_type::SINE_IN_OUT, 0.5) == 0.5);
+        BN_ASSERT(bn::easing::apply(bn::easing_type::BACK_IN, 0.25) < 0);
+        BN_ASSERT(bn::easing::apply(bn::easing_type::BACK_OUT, 0.75) > 1);
+        BN_ASSERT(_monotonic(bn::easing_type::QUAD_IN_OUT));
+        BN_ASSERT(_monotonic(bn::easing_type::CUBIC_OUT));
+        BN_ASSERT(_monotonic(bn::easing_type::SINE_IN));
+    }
+
+private:
+    [[nodiscard]] static bool _monotonic(bn::easing_type easing)
+    {
+        bn::fixed previous_value;
+
+        for(int progress_data = 0; progress_data <= 4096; ++progress_data)
+        {
+            bn::fixed value = bn::easing::apply(easing, bn::fixed::from_data(progress_data));
+
+            if(value < previous_value)
+            {
+                return false;
+            }
+
+            previous_value = value;
+        }
+
+        return true;
+    }
+};
+
+#endif
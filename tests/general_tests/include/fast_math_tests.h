@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef FAST_MATH_TESTS_H
+#define FAST_MATH_TESTS_H
+
+#include <cmath>
+#include "bn_math.h"
+#include "bn_timer.h"
+#include "bn_fast_math.h"
+#include "tests.h"
+
+class fast_math_tests : public tests
+{
+
+public:
+    fast_math_tests() :
+        tests("fast_math")
+    {
+        _test_accuracy<bn::fast_math_accuracy::LOW>(8, 54, 0.0004f, 0.0032f, 35);
+        _test_accuracy<bn::fast_math_accuracy::HIGH>(3, 2, 0.000005f, 0.00025f, 2);
+
+        BN_ASSERT(bn::fast_sin(0.25) == 1);
+        BN_ASSERT(bn::fast_cos(0.5) == -1);
+        BN_ASSERT(bn::fast_atan2(1, 1) == 0.125);
+        BN_ASSERT(bn::fast_atan2(0, -1) == 0.5);
+        BN_ASSERT(bn::fast_atan2(0, 0) == 0);
+        BN_ASSERT(bn::fast_exp2(3) == 8);
+        BN_ASSERT(bn::fast_log2(8) == 3);
+
+        // Cycles per call table:
+
+        BN_LOG("function | LOW cycles | HIGH cycles | reference cycles");
+
+        _log_cycles("sin (bn::sin)",
+                    _cycles([](int value) { return bn::fast_sin<bn::fast_math_accuracy::LOW>(_angle(value)).data(); }),
+                    _cycles([](int value) { return bn::fast_sin(_angle(value)).data(); }),
+                    _cycles([](int value) { return bn::sin(_angle(value)).data(); }));
+
+        _log_cycles("atan2 (bn::atan2)",
+                    _cycles([](int value) { return bn::fast_atan2<bn::fast_math_accuracy::LOW>(value, 1000).data(); }),
+                    _cycles([](int value) { return bn::fast_atan2(value, 1000).data(); }),
+                    _cycles([](int value) { return bn::atan2(value, 1000).data(); }));
+
+        _log_cycles("reciprocal_sqrt (bn::sqrt)",
+                    _cycles([](int value) {
+                        return bn::fast_reciprocal_sqrt<bn::fast_math_accuracy::LOW>(_positive(value)).data();
+                    }),
+                    _cycles([](int value) { return bn::fast_reciprocal_sqrt(_positive(value)).data(); }),
+                    _cycles([](int value) { return bn::sqrt(_positive(value)).data(); }));
+
+        _log_cycles("exp2",
+                    _cycles([](int value) { return bn::fast_exp2<bn::fast_math_accuracy::LOW>(_power(value)).data(); }),
+                    _cycles([](int value) { return bn::fast_exp2(_power(value)).data(); }),
+                    0);
+
+        _log_cycles("log2",
+                    _cycles([](int value) { return bn::fast_log2<bn::fast_math_accuracy::LOW>(_positive(value)).data(); }),
+                    _cycles([](int value) { return bn::fast_log2(_positive(value)).data(); }),
+                    0);
+    }
+
+private:
+    static constexpr int _calls = 256;
+
+    template<bn::fast_math_accuracy Accuracy>
+    static void _test_accuracy(int max_sin_error, int max_atan2_error, float max_reciprocal_sqrt_error,
+                               float max_exp2_error, int max_log2_error)
+    {
+        for(int angle = 0; angle < 65536; angle += 17)
+        {
+            int fast_sin = bn::fast_sin<Accuracy>(bn::fixed_t<16>::from_data(angle)).data();
+            auto std_sin = int(std::round(std::sin(float(angle) * (6.2831853f / 65536)) * 4096));
+            BN_ASSERT(bn::abs(fast_sin - std_sin) <= max_sin_error,
+                      "Invalid fast_sin: ", angle, " - ", fast_sin, " - ", std_sin);
+        }
+
+        for(int y = -64; y < 64; y += 3)
+        {
+            for(int x = -64; x < 64; x += 3)
+            {
+                int fast_atan2 = bn::fast_atan2<Accuracy>(y * 1000, x * 1000).data();
+                auto std_atan2 = int(std::round(std::atan2(float(y), float(x)) * (65536 / 6.2831853f)));
+                int16_t atan2_error = int16_t(fast_atan2 - std_atan2);
+                BN_ASSERT(bn::abs(int(atan2_error)) <= max_atan2_error,
+                          "Invalid fast_atan2: ", y, " - ", x, " - ", fast_atan2, " - ", std_atan2);
+            }
+        }
+
+        for(int value_data = 1024; value_data < 1000 * 4096; value_data += value_data / 2)
+        {
+            bn::fixed value = bn::fixed::from_data(value_data);
+            float fast_reciprocal_sqrt = bn::fast_reciprocal_sqrt<Accuracy>(value).to_float();
+            float std_reciprocal_sqrt = 1 / std::sqrt(value.to_float());
+            BN_ASSERT(std::fabs(fast_reciprocal_sqrt - std_reciprocal_sqrt) <=
+                      (std_reciprocal_sqrt * max_reciprocal_sqrt_error) + (1.0f / (1 << 20)),
+                      "Invalid fast_reciprocal_sqrt: ", value, " - ", bn::fast_reciprocal_sqrt<Accuracy>(value));
+        }
+
+        for(bn::fixed value = 0; value < 18; value += bn::fixed(0.0625))
+        {
+            float fast_exp2 = bn::fast_exp2<Accuracy>(value).to_float();
+            float std_exp2 = std::exp2(value.to_float());
+            BN_ASSERT(std::fabs(fast_exp2 - std_exp2) <= (std_exp2 * max_exp2_error) + (1.0f / 4096),
+                      "Invalid fast_exp2: ", value, " - ", bn::fast_exp2<Accuracy>(value));
+        }
+
+        for(int value_data = 41; value_data < 1000 * 4096; value_data += (value_data / 4) + 1)
+        {
+            bn::fixed value = bn::fixed::from_data(value_data);
+            int fast_log2 = bn::fast_log2<Accuracy>(value).data();
+            auto std_log2 = int(std::round(std::log2(value.to_float()) * 4096));
+            BN_ASSERT(bn::abs(fast_log2 - std_log2) <= max_log2_error,
+                      "Invalid fast_log2: ", value, " - ", fast_log2, " - ", std_log2);
+        }
+    }
+
+    [[nodiscard]] static bn::fixed_t<16> _angle(int value)
+    {
+        return bn::fixed_t<16>::from_data(value * 251);
+    }
+
+    [[nodiscard]] static bn::fixed _positive(int value)
+    {
+        return bn::fixed::from_data((value * 4093) + 1);
+    }
+
+    [[nodiscard]] static bn::fixed _power(int value)
+    {
+        return bn::fixed::from_data((value * 257) - (8 * 4096));
+    }
+
+    template<typename Function>
+    [[nodiscard]] static int _cycles(const Function& function)
+    {
+        // One timer tick is equivalent to 64 CPU clock cycles:
+
+        volatile int sink = 0;
+        bn::timer timer;
+
+        for(int index = 0; index < _calls; ++index)
+        {
+            sink = sink + function(index);
+        }
+
+        return (timer.elapsed_ticks() * 64) / _calls;
+    }
+
+    static void _log_cycles(const bn::string_view& function, int low_cycles, int high_cycles,
+                            int reference_cycles)
+    {
+        BN_LOG(function, " | ", low_cycles, " | ", high_cycles, " | ", reference_cycles);
+    }
+};
+
+#endif
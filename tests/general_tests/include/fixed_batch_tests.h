@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef FIXED_BATCH_TESTS_H
+#define FIXED_BATCH_TESTS_H
+
+#include "bn_math.h"
+#include "bn_timer.h"
+#include "bn_random.h"
+#include "bn_fixed_batch.h"
+#include "tests.h"
+
+class fixed_batch_tests : public tests
+{
+
+public:
+    fixed_batch_tests() :
+        tests("fixed_batch")
+    {
+        bn::random random;
+        bn::fixed_point points[_count];
+        bn::fixed_point output[_count];
+        bn::fixed vectors[_count * 3];
+        bn::fixed output_vectors[_count * 3];
+
+        for(bn::fixed_point& point : points)
+        {
+            point = bn::fixed_point(_random_fixed(random, 256), _random_fixed(random, 256));
+        }
+
+        for(bn::fixed& vector_component : vectors)
+        {
+            vector_component = _random_fixed(random, 128);
+        }
+
+        // 2x3 affine matrix:
+
+        bn::fixed a = 1.732;
+        bn::fixed b = -0.5;
+        bn::fixed c = 0.5;
+        bn::fixed d = 0.75;
+        bn::fixed_point translation(10.5, -3.25);
+        bn::timer timer;
+        bn::fixed_batch::transform(a, b, c, d, translation, points, output);
+
+        int batch_ticks = timer.elapsed_ticks();
+        timer.restart();
+
+        for(int index = 0; index < _count; ++index)
+        {
+            const bn::fixed_point& point = points[index];
+            bn::fixed x = a.safe_multiplication(point.x()) + b.safe_multiplication(point.y()) + translation.x();
+            bn::fixed y = c.safe_multiplication(point.x()) + d.safe_multiplication(point.y()) + translation.y();
+            BN_ASSERT(bn::abs(x.data() - output[index].x().data()) <= 2, "Invalid x: ", index, " - ", x,
+                      " - ", output[index].x());
+            BN_ASSERT(bn::abs(y.data() - output[index].y().data()) <= 2, "Invalid y: ", index, " - ", y,
+                      " - ", output[index].y());
+        }
+
+        _log_cycles("transform", batch_ticks, timer.elapsed_ticks());
+
+        bn::fixed_point in_place_output[_count];
+
+        for(int index = 0; index < _count; ++index)
+        {
+            in_place_output[index] = points[index];
+        }
+
+        bn::fixed_batch::transform(a, b, c, d, translation, in_place_output, in_place_output);
+
+        for(int index = 0; index < _count; ++index)
+        {
+            BN_ASSERT(in_place_output[index] == output[index], "Invalid in place output: ", index);
+        }
+
+        // 3x3 matrix:
+
+        bn::array<bn::fixed, 9> matrix = { a, b, 0, c, d, 0, 0, 0, -1 };
+        timer.restart();
+        bn::fixed_batch::transform_3d(matrix, vectors, output_vectors);
+
+        batch_ticks = timer.elapsed_ticks();
+        timer.restart();
+
+        for(int index = 0; index < _count * 3; index += 3)
+        {
+            for(int row = 0; row < 3; ++row)
+            {
+                bn::fixed value;
+
+                for(int column = 0; column < 3; ++column)
+                {
+                    value += matrix[(row * 3) + column].safe_multiplication(vectors[index + column]);
+                }
+
+                BN_ASSERT(bn::abs(value.data() - output_vectors[index + row].data()) <= 2,
+                          "Invalid vector: ", index / 3, " - ", row, " - ", value, " - ",
+                          output_vectors[index + row]);
+            }
+        }
+
+        _log_cycles("transform_3d", batch_ticks, timer.elapsed_ticks());
+
+        // Projection:
+
+        for(int index = 2; index < _count * 3; index += 3)
+        {
+            vectors[index] = bn::abs(vectors[index]) + 1;
+        }
+
+        bn::fixed focal_length = 256;
+        bn::fixed_point center(120, 80);
+        timer.restart();
+        bn::fixed_batch::project_3d(focal_length, center, vectors, output);
+
+        batch_ticks = timer.elapsed_ticks();
+        timer.restart();
+
+        for(int index = 0; index < _count; ++index)
+        {
+            const bn::fixed* vector = vectors + (index * 3);
+            bn::fixed x = vector[0].safe_multiplication(focal_length).safe_division(vector[2]);
+            bn::fixed y = vector[1].safe_multiplication(focal_length).safe_division(vector[2]);
+            bn::fixed_point projected = output[index] - center;
+
+            // Relative error must be lower than 1 / 8192, plus the rounding errors of the scalar path:
+
+            BN_ASSERT(bn::abs(x.data() - projected.x().data()) <= (bn::abs(x.data()) / 8192) + 2,
+                      "Invalid projected x: ", index, " - ", x, " - ", projected.x());
+            BN_ASSERT(bn::abs(y.data() - projected.y().data()) <= (bn::abs(y.data()) / 8192) + 2,
+                      "Invalid projected y: ", index, " - ", y, " - ", projected.y());
+        }
+
+        _log_cycles("project_3d", batch_ticks, timer.elapsed_ticks());
+    }
+
+private:
+    static constexpr int _count = 64;
+
+    [[nodiscard]] static bn::fixed _random_fixed(bn::random& random, int range)
+    {
+        int data_range = range * bn::fixed::scale();
+        return bn::fixed::from_data(random.get_int(-data_range, data_range));
+    }
+
+    static void _log_cycles(const bn::string_view& tag, int batch_ticks, int scalar_ticks)
+    {
+        // One timer tick is equivalent to 64 CPU clock cycles:
+
+        BN_LOG(tag, " cycles per element: ", (batch_ticks * 64) / _count,
+               " (scalar with checks: ", (scalar_ticks * 64) / _count, ')');
+    }
+};
+
+#endif
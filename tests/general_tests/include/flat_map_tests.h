@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef FLAT_MAP_TESTS_H
+#define FLAT_MAP_TESTS_H
+
+#include "bn_timer.h"
+#include "bn_flat_map.h"
+#include "bn_flat_set.h"
+#include "bn_slot_map.h"
+#include "tests.h"
+
+class flat_map_tests : public tests
+{
+
+public:
+    flat_map_tests() :
+        tests("flat_map")
+    {
+        _test_map();
+        _test_set();
+        _test_slot_map();
+        _log_find_cycles();
+    }
+
+private:
+    static void _test_map()
+    {
+        bn::flat_map<int, int, 64> map;
+
+        for(int key = 63; key >= 0; --key)
+        {
+            BN_ASSERT(map.insert(key * 3, key) != map.end());
+        }
+
+        BN_ASSERT(map.full());
+        BN_ASSERT(map.insert(0, 1) == map.end());
+        BN_ASSERT(map.find(1) == map.end());
+        BN_ASSERT(map.lower_bound(1)->first == 3);
+        BN_ASSERT(map.upper_bound(3)->first == 6);
+
+        int index = 0;
+
+        for(const auto& pair : map)
+        {
+            BN_ASSERT(pair.first == index * 3, "Invalid key: ", pair.first, " - ", index);
+            BN_ASSERT(pair.second == index, "Invalid value: ", pair.second, " - ", index);
+            ++index;
+        }
+
+        BN_ASSERT(erase_if(map, [](const auto& pair) { return pair.second % 2 == 0; }) == 32);
+        BN_ASSERT(map.erase(3));
+        BN_ASSERT(! map.erase(3));
+        BN_ASSERT(map.size() == 31);
+
+        bn::flat_map<int, int, 64>::value_type pairs[] = {
+            { 9, 0 }, { 4, 4 }, { 2, 2 }, { 4, 5 }, { 1000, 1000 }
+        };
+
+        map.insert(pairs, pairs + 5);
+        BN_ASSERT(map.size() == 34);
+        BN_ASSERT(map.at(9) == 3);
+        BN_ASSERT(map.at(2) == 2);
+        BN_ASSERT(map.at(1000) == 1000);
+        BN_ASSERT(map.begin()->first == 2);
+        BN_ASSERT(map.rbegin()->first == 1000);
+
+        int previous_key = -1;
+
+        for(const auto& pair : map)
+        {
+            BN_ASSERT(pair.first > previous_key, "Invalid key: ", pair.first, " - ", previous_key);
+            previous_key = pair.first;
+        }
+    }
+
+    static void _test_set()
+    {
+        bn::flat_set<int, 64> set;
+
+        int values[] = { 64, 8, 32, 8, 16, 64, 0 };
+        set.insert(values, values + 7);
+        BN_ASSERT(set.size() == 5);
+
+        for(int value = 0; value < 128; ++value)
+        {
+            BN_ASSERT(set.contains(value) == (value == 0 || value == 8 || value == 16 || value == 32 || value == 64),
+                      "Invalid value: ", value);
+        }
+
+        BN_ASSERT(set.insert(16) == set.end());
+        BN_ASSERT(*set.insert(24) == 24);
+        BN_ASSERT(set.erase(8));
+        BN_ASSERT(*set.lower_bound(1) == 16);
+        BN_ASSERT(*set.lower_bound(16) == 16);
+        BN_ASSERT(*set.upper_bound(16) == 24);
+        BN_ASSERT(set.upper_bound(64) == set.end());
+    }
+
+    static void _test_slot_map()
+    {
+        using slot_map_type = bn::slot_map<int, 16>;
+
+        slot_map_type slot_map;
+        slot_map_type::handle_type handles[16];
+
+        for(int index = 0; index < 16; ++index)
+        {
+            handles[index] = slot_map.insert(index);
+        }
+
+        BN_ASSERT(slot_map.full());
+
+        for(int index = 0; index < 16; index += 2)
+        {
+            BN_ASSERT(slot_map.erase(handles[index]));
+        }
+
+        BN_ASSERT(slot_map.size() == 8);
+
+        for(int index = 0; index < 16; ++index)
+        {
+            if(index % 2)
+            {
+                BN_ASSERT(slot_map.at(handles[index]) == index, "Invalid value: ", index);
+            }
+            else
+            {
+                BN_ASSERT(! slot_map.contains(handles[index]), "Invalid handle: ", index);
+            }
+        }
+
+        slot_map_type::handle_type new_handle = slot_map.insert(100);
+        BN_ASSERT(new_handle.slot_index() == handles[14].slot_index());
+        BN_ASSERT(new_handle.generation() != handles[14].generation());
+        BN_ASSERT(! slot_map.contains(handles[14]));
+        BN_ASSERT(slot_map.at(new_handle) == 100);
+
+        int sum = 0;
+
+        for(int value : slot_map)
+        {
+            sum += value;
+        }
+
+        BN_ASSERT(sum == 1 + 3 + 5 + 7 + 9 + 11 + 13 + 15 + 100, "Invalid sum: ", sum);
+
+        for(auto it = slot_map.begin(), end = slot_map.end(); it != end; ++it)
+        {
+            BN_ASSERT(slot_map.get(slot_map.handle(it)) == it);
+        }
+
+        BN_ASSERT(erase_if(slot_map, [](int value) { return value > 10; }) == 4);
+        BN_ASSERT(slot_map.size() == 5);
+        BN_ASSERT(! slot_map.contains(new_handle));
+        BN_ASSERT(slot_map.at(handles[9]) == 9);
+        // Handles reference the moved elements, and the moved-from slot_map is empty:
+
+        slot_map_type moved_slot_map(bn::move(slot_map));
+        BN_ASSERT(moved_slot_map.size() == 5);
+        BN_ASSERT(slot_map.empty());
+        BN_ASSERT(! slot_map.contains(handles[9]));
+        BN_ASSERT(moved_slot_map.at(handles[9]) == 9);
+        BN_ASSERT(moved_slot_map.erase(handles[9]));
+        BN_ASSERT(! moved_slot_map.contains(handles[9]));
+        BN_ASSERT(moved_slot_map.size() == 4);
+
+        slot_map_type::handle_type reused_handle = slot_map.insert(200);
+        BN_ASSERT(slot_map.size() == 1);
+        BN_ASSERT(slot_map.at(reused_handle) == 200);
+        BN_ASSERT(! slot_map.contains(handles[1]));
+
+        slot_map = bn::move(moved_slot_map);
+        BN_ASSERT(slot_map.size() == 4);
+        BN_ASSERT(moved_slot_map.empty());
+        BN_ASSERT(! slot_map.contains(reused_handle));
+        BN_ASSERT(! moved_slot_map.contains(handles[1]));
+        BN_ASSERT(slot_map.at(handles[1]) == 1);
+        BN_ASSERT(slot_map.erase(handles[1]));
+        BN_ASSERT(slot_map.size() == 3);
+
+        for(auto it = slot_map.begin(), end = slot_map.end(); it != end; ++it)
+        {
+            BN_ASSERT(slot_map.get(slot_map.handle(it)) == it);
+        }
+    }
+
+    static void _log_find_cycles()
+    {
+        // Half of the searched keys are not found:
+
+        bn::flat_map<int, int, 256> map;
+
+        for(int key = 0; key < 256; ++key)
+        {
+            map.insert(key * 5, key);
+        }
+
+        bn::timer timer;
+        int found = 0;
+
+        for(int key = 0; key < 512; ++key)
+        {
+            found += map.contains(key * 5);
+        }
+
+        int cycles = (timer.elapsed_ticks() * 64) / 512;
+        BN_ASSERT(found == 256, "Invalid found keys: ", found);
+        BN_LOG("find cycles: ", cycles);
+    }
+};
+
+#endif
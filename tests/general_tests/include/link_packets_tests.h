@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef LINK_PACKETS_TESTS_H
+#define LINK_PACKETS_TESTS_H
+
+#include "bn_random.h"
+#include "bn_unique_ptr.h"
+#include "bn_link_packets.h"
+#include "tests.h"
+
+class link_packets_tests : public tests
+{
+
+public:
+    link_packets_tests() :
+        tests("link_packets")
+    {
+        bn::unique_ptr<bn::link_packets> first = bn::make_unique<bn::link_packets>();
+        bn::unique_ptr<bn::link_packets> second = bn::make_unique<bn::link_packets>();
+        bn::vector<uint8_t, bn::link_packets::max_message_size()> message;
+        int player_id = -1;
+
+        // Messages and full state:
+
+        uint8_t first_state[16] = {};
+        uint8_t second_state[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+        const uint8_t first_message[3] = { 10, 20, 30 };
+        const uint8_t second_message[1] = { 40 };
+
+        first->set_state(first_state);
+        second->set_state(second_state);
+        BN_ASSERT(first->send(first_message));
+        BN_ASSERT(first->send(second_message));
+        _loopback(*first, *second, 60, -1);
+
+        BN_ASSERT(second->receive(player_id, message));
+        BN_ASSERT(player_id == 0);
+        BN_ASSERT(message.size() == 3 && message[0] == 10 && message[1] == 20 && message[2] == 30);
+        BN_ASSERT(second->receive(player_id, message));
+        BN_ASSERT(message.size() == 1 && message[0] == 40);
+        BN_ASSERT(! second->receive(player_id, message));
+        BN_ASSERT(! first->receive(player_id, message));
+
+        BN_ASSERT(_equal(second->player_state(0), first_state));
+        BN_ASSERT(_equal(first->player_state(1), second_state));
+        BN_ASSERT(first->player_state(2).empty());
+        BN_ASSERT(first->round_trip_frames() >= 0);
+
+        // Delta encoded state:
+
+        int sent_words = first->sent_words();
+        first_state[5] = 55;
+        first->set_state(first_state);
+        _loopback(*first, *second, 60, -1);
+        BN_ASSERT(_equal(second->player_state(0), first_state));
+        BN_ASSERT(first->sent_words() - sent_words < 16);
+
+        // Lost link messages:
+
+        int lost_packets = second->lost_packets();
+
+        for(int index = 0; index < 16; ++index)
+        {
+            first_state[index] = uint8_t(index * 3);
+            first->set_state(first_state);
+            BN_ASSERT(first->send(first_message));
+            _loopback(*first, *second, 1, 1);
+        }
+
+        _loopback(*first, *second, 60, -1);
+        BN_ASSERT(second->lost_packets() > lost_packets);
+        BN_ASSERT(_equal(second->player_state(0), first_state));
+
+        while(second->receive(player_id, message))
+        {
+            BN_ASSERT(message.size() == 3 && message[0] == 10 && message[1] == 20 && message[2] == 30);
+        }
+
+        // Random link message loss:
+
+        bn::random random;
+
+        for(int index = 0; index < 8; ++index)
+        {
+            _random_loss_test(random);
+        }
+    }
+
+private:
+    static void _random_loss_test(bn::random& random)
+    {
+        bn::unique_ptr<bn::link_packets> first = bn::make_unique<bn::link_packets>();
+        bn::unique_ptr<bn::link_packets> second = bn::make_unique<bn::link_packets>();
+        bn::vector<uint8_t, bn::link_packets::max_message_size()> message;
+        uint8_t first_state[32] = {};
+        const uint8_t second_state[4] = { 1, 2, 3, 4 };
+        uint8_t sent_message[32];
+        int sent_messages = 0;
+        int received_messages = 0;
+        int last_message_index = -1;
+        int player_id = -1;
+
+        // Second player state doesn't change, so it only sends packets to acknowledge the received ones:
+
+        first->set_state(first_state);
+        second->set_state(second_state);
+
+        for(int frame = 0; frame < 240; ++frame)
+        {
+            if(random.get_int(3) == 0)
+            {
+                for(int index = 0, limit = random.get_int(32); index < limit; ++index)
+                {
+                    first_state[random.get_int(32)] = uint8_t(random.get());
+                }
+
+                first->set_state(first_state);
+            }
+
+            if(random.get_int(4) == 0)
+            {
+                int message_size = random.get_int(1, 33);
+                sent_message[0] = uint8_t(sent_messages);
+
+                for(int index = 1; index < message_size; ++index)
+                {
+                    sent_message[index] = uint8_t((sent_messages * 7) + index);
+                }
+
+                if(first->send(bn::span<const uint8_t>(sent_message, message_size)))
+                {
+                    ++sent_messages;
+                }
+            }
+
+            _lossy_loopback(*first, *second, random);
+
+            // Received messages are not corrupted and keep their order:
+
+            while(second->receive(player_id, message))
+            {
+                int message_index = message[0];
+                BN_ASSERT(player_id == 0);
+                BN_ASSERT(message_index > last_message_index && message_index < sent_messages);
+
+                for(int index = 1, limit = message.size(); index < limit; ++index)
+                {
+                    BN_ASSERT(message[index] == uint8_t((message_index * 7) + index));
+                }
+
+                last_message_index = message_index;
+                ++received_messages;
+            }
+        }
+
+        BN_ASSERT(received_messages > 0);
+        BN_ASSERT(! first->receive(player_id, message));
+
+        // Game state converges when the link becomes quiet:
+
+        int quiet_frames = 0;
+
+        for(int frame = 0; frame < 1200 && quiet_frames < 32; ++frame)
+        {
+            if(_lossy_loopback(*first, *second, random))
+            {
+                quiet_frames = 0;
+            }
+            else
+            {
+                ++quiet_frames;
+            }
+        }
+
+        BN_ASSERT(quiet_frames == 32);
+        BN_ASSERT(second->lost_packets() > 0);
+        BN_ASSERT(_equal(second->player_state(0), first_state));
+        BN_ASSERT(_equal(first->player_state(1), second_state));
+    }
+
+    static void _loopback(bn::link_packets& first, bn::link_packets& second, int frames, int lost_word_index)
+    {
+        for(int frame = 0; frame < frames; ++frame)
+        {
+            first.flush();
+            second.flush();
+
+            for(int word_index = 0; word_index < 4; ++word_index)
+            {
+                if(bn::optional<int> word = first.pop_word())
+                {
+                    if(word_index != lost_word_index)
+                    {
+                        second.push_word(1, 0, *word);
+                    }
+                }
+
+                if(bn::optional<int> word = second.pop_word())
+                {
+                    first.push_word(0, 1, *word);
+                }
+            }
+        }
+    }
+
+    static bool _lossy_loopback(bn::link_packets& first, bn::link_packets& second, bn::random& random)
+    {
+        bool active = false;
+        first.flush();
+        second.flush();
+
+        for(int word_index = 0; word_index < 8; ++word_index)
+        {
+            if(bn::optional<int> word = first.pop_word())
+            {
+                active = true;
+
+                if(random.get_int(20))
+                {
+                    second.push_word(1, 0, *word);
+                }
+            }
+
+            if(bn::optional<int> word = second.pop_word())
+            {
+                active = true;
+
+                if(random.get_int(20))
+                {
+                    first.push_word(0, 1, *word);
+                }
+            }
+        }
+
+        return active;
+    }
+
+    [[nodiscard]] static bool _equal(const bn::span<const uint8_t>& state, const bn::span<const uint8_t>& expected)
+    {
+        if(state.size() != expected.size())
+        {
+            return false;
+        }
+
+        for(int index = 0, limit = state.size(); index < limit; ++index)
+        {
+            if(state[index] != expected[index])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+#endif
@@ -91,6 +91,28 @@ public:
         BN_ASSERT(bn::degrees_lut_cos(270) == 0);
         BN_ASSERT(bn::degrees_lut_cos(360) == 1);
 
+        BN_ASSERT(bn::fast_reciprocal(bn::fixed(1)) == 1);
+        BN_ASSERT(bn::fast_reciprocal(bn::fixed(4)) == 0.25);
+        BN_ASSERT(bn::fast_reciprocal(bn::fixed(-0.5)) == -2);
+        BN_ASSERT(bn::fixed(9) / bn::fixed_divider(3) == 3);
+        BN_ASSERT(bn::fixed(-9) / bn::fixed_divider(3) == -3);
+
+        for(int divisor_data = -20000; divisor_data < 20000; divisor_data += 37)
+        {
+            bn::fixed divisor = bn::fixed::from_data(divisor_data);
+            bn::fixed_divider divider(divisor);
+
+            for(int dividend_data = -400000; dividend_data < 400000; dividend_data += 8191)
+            {
+                bn::fixed dividend = bn::fixed::from_data(dividend_data);
+                bn::fixed quotient = dividend / divider;
+                bn::fixed safe_quotient = dividend.safe_division(divisor);
+                BN_ASSERT(bn::abs(quotient.data()) - bn::abs(safe_quotient.data()) >= 0 &&
+                          bn::abs(quotient.data()) - bn::abs(safe_quotient.data()) <= 1,
+                          "Invalid quotient: ", dividend, " - ", divisor, " - ", quotient, " - ", safe_quotient);
+            }
+        }
+
         BN_ASSERT(bn::atan2(1, 1) == 0.125);
         BN_ASSERT(bn::atan2(1, -1) == 0.125 * 3);
         BN_ASSERT(bn::atan2(-1, -1) == -0.125 * 3);
@@ -6,8 +6,10 @@
 #ifndef MEMORY_TESTS_H
 #define MEMORY_TESTS_H
 
+#include "bn_core.h"
 #include "bn_memory.h"
 #include "bn_cstdlib.h"
+#include "bn_frame_vector.h"
 #include "tests.h"
 
 class memory_tests : public tests
@@ -67,6 +69,35 @@ public:
         BN_ASSERT(! bn::aligned<4>(static_cast<const void*>(u16_array + 1)));
         BN_ASSERT(bn::aligned<4>(u16_array + 2));
         BN_ASSERT(bn::aligned<4>(static_cast<const void*>(u16_array + 2)));
+
+        bn::core::update();
+        BN_ASSERT(bn::frame_allocator::used_bytes() == 0);
+
+        ptr = bn::frame_allocator::alloc(1);
+        BN_ASSERT(ptr);
+        BN_ASSERT(bn::frame_allocator::used_bytes() == 1);
+
+        ptr = bn::frame_allocator::alloc(4);
+        BN_ASSERT(ptr);
+        BN_ASSERT(bn::aligned<4>(ptr));
+        BN_ASSERT(bn::frame_allocator::used_bytes() == 8);
+
+        {
+            bn::frame_vector<int> frame_vector(4);
+            frame_vector.push_back(1);
+            frame_vector.push_back(2);
+            BN_ASSERT(frame_vector.max_size() == 4);
+            BN_ASSERT(frame_vector.size() == 2);
+            BN_ASSERT(frame_vector.back() == 2);
+            BN_ASSERT(bn::frame_allocator::used_bytes() == 24);
+        }
+
+        BN_ASSERT(! bn::frame_allocator::alloc(bn::frame_allocator::available_bytes() + 1));
+        BN_ASSERT(bn::frame_allocator::used_bytes() == 24);
+
+        bn::core::update();
+        BN_ASSERT(bn::frame_allocator::used_bytes() == 0);
+        BN_ASSERT(bn::frame_allocator::max_used_bytes() >= 24);
     }
 };
 
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef MODE_7_TESTS_H
+#define MODE_7_TESTS_H
+
+#include "bn_mode_7.h"
+#include "bn_size.h"
+#include "bn_unique_ptr.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_bg_palette_item.h"
+#include "bn_affine_bg_map_ptr.h"
+#include "bn_affine_bg_tiles_ptr.h"
+#include "tests.h"
+
+class mode_7_tests : public tests
+{
+
+public:
+    mode_7_tests() :
+        tests("mode_7")
+    {
+        bn::bg_palette_item palette_item(colors, bn::bpp_mode::BPP_8);
+        bn::bg_palette_ptr palette = bn::bg_palette_ptr::create(palette_item);
+        bn::affine_bg_tiles_ptr tiles = bn::affine_bg_tiles_ptr::allocate(1);
+        bn::affine_bg_map_ptr map = bn::affine_bg_map_ptr::allocate(
+                    bn::size(16, 16), bn::move(tiles), bn::move(palette));
+        bn::unique_ptr<bn::mode_7> mode_7 = bn::make_unique<bn::mode_7>(
+                    bn::affine_bg_ptr::create(0, 0, bn::move(map)));
+
+        // Default camera (height 32, looking to negative z) and focal length (160):
+
+        bn::optional<bn::mode_7::projection> projection = mode_7->project(bn::fixed_point(0, -64));
+        BN_ASSERT(projection);
+        BN_ASSERT(projection->position == bn::fixed_point(0, 0));
+        BN_ASSERT(projection->scale == 2.5);
+
+        projection = mode_7->project(bn::fixed_point(0, -160));
+        BN_ASSERT(projection);
+        BN_ASSERT(projection->position == bn::fixed_point(0, -48));
+        BN_ASSERT(projection->scale == 1);
+
+        projection = mode_7->project(bn::fixed_point(32, -64));
+        BN_ASSERT(projection);
+        BN_ASSERT(projection->position == bn::fixed_point(80, 0));
+
+        BN_ASSERT(! mode_7->project(bn::fixed_point(0, 64)));
+        BN_ASSERT(! mode_7->project(bn::fixed_point(32, 0)));
+
+        // Horizon moves the projections down:
+
+        mode_7->set_horizon_y(80);
+        projection = mode_7->project(bn::fixed_point(0, -160));
+        BN_ASSERT(projection);
+        BN_ASSERT(projection->position == bn::fixed_point(0, 32));
+
+        // Camera position and rotation:
+
+        mode_7->set_horizon_y(0);
+        mode_7->set_camera_position(bn::point_3d(100, 64, 100));
+        projection = mode_7->project(bn::fixed_point(100, -60));
+        BN_ASSERT(projection);
+        BN_ASSERT(projection->position == bn::fixed_point(0, -16));
+        BN_ASSERT(projection->scale == 1);
+
+        mode_7->set_camera_phi(90);
+        BN_ASSERT(! mode_7->project(bn::fixed_point(100, -60)));
+
+        projection = mode_7->project(bn::fixed_point(260, 100));
+        BN_ASSERT(projection);
+        BN_ASSERT(projection->position == bn::fixed_point(0, -16));
+        BN_ASSERT(projection->scale == 1);
+    }
+
+private:
+    static constexpr bn::color colors[16] = {};
+};
+
+#endif
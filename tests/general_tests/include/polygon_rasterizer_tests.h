@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef POLYGON_RASTERIZER_TESTS_H
+#define POLYGON_RASTERIZER_TESTS_H
+
+#include "bn_polygon_rasterizer.h"
+#include "tests.h"
+
+class polygon_rasterizer_tests : public tests
+{
+
+public:
+    polygon_rasterizer_tests() :
+        tests("polygon_rasterizer")
+    {
+        bn::polygon_rasterizer rasterizer;
+        BN_ASSERT(rasterizer.empty());
+
+        // Square:
+
+        const bn::fixed_point square[] = {
+            bn::fixed_point(10, 10), bn::fixed_point(20, 10), bn::fixed_point(20, 20), bn::fixed_point(10, 20)
+        };
+
+        rasterizer.add_polygon(square);
+        BN_ASSERT(rasterizer.minimum_y() == 10, "Invalid minimum y: ", rasterizer.minimum_y());
+        BN_ASSERT(rasterizer.maximum_y() == 19, "Invalid maximum y: ", rasterizer.maximum_y());
+
+        for(int y = 0; y < bn::display::height(); ++y)
+        {
+            const bn::polygon_rasterizer::hline& hline = rasterizer.hlines()[y];
+
+            if(y >= 10 && y < 20)
+            {
+                BN_ASSERT(hline.xl == 10 && hline.xr == 20, "Invalid hline: ", y, " - ", hline.xl, " - ", hline.xr);
+            }
+            else
+            {
+                BN_ASSERT(hline.empty(), "Invalid hline: ", y, " - ", hline.xl, " - ", hline.xr);
+            }
+        }
+
+        // Clipping:
+
+        const bn::fixed_point big_triangle[] = {
+            bn::fixed_point(-100, -50), bn::fixed_point(400, 80), bn::fixed_point(-100, 300)
+        };
+
+        rasterizer.clear();
+        BN_ASSERT(rasterizer.empty());
+
+        rasterizer.add_polygon(big_triangle);
+        BN_ASSERT(rasterizer.minimum_y() == 0, "Invalid minimum y: ", rasterizer.minimum_y());
+        BN_ASSERT(rasterizer.maximum_y() == bn::display::height() - 1, "Invalid maximum y: ",
+                  rasterizer.maximum_y());
+
+        for(const bn::polygon_rasterizer::hline& hline : rasterizer.hlines())
+        {
+            BN_ASSERT(hline.xl >= 0 && hline.xr <= bn::display::width(), "Invalid hline: ",
+                      hline.xl, " - ", hline.xr);
+        }
+
+        // Adjacent polygons with sub-pixel vertices don't overlap nor leave gaps:
+
+        const bn::fixed_point left_triangle[] = {
+            bn::fixed_point(0.3, 0.2), bn::fixed_point(50.7, 3.1), bn::fixed_point(13.3, 40.9)
+        };
+
+        const bn::fixed_point right_triangle[] = {
+            bn::fixed_point(50.7, 3.1), bn::fixed_point(70.1, 44.4), bn::fixed_point(13.3, 40.9)
+        };
+
+        rasterizer.clear();
+        rasterizer.add_polygon(left_triangle);
+
+        bn::polygon_rasterizer other_rasterizer;
+        other_rasterizer.add_polygon(right_triangle);
+
+        for(int y = 0; y < bn::display::height(); ++y)
+        {
+            const bn::polygon_rasterizer::hline& left_hline = rasterizer.hlines()[y];
+            const bn::polygon_rasterizer::hline& right_hline = other_rasterizer.hlines()[y];
+
+            if(! left_hline.empty() && ! right_hline.empty())
+            {
+                BN_ASSERT(left_hline.xr == right_hline.xl || right_hline.xr == left_hline.xl,
+                          "Invalid hlines: ", y, " - ", left_hline.xl, " - ", left_hline.xr,
+                          " - ", right_hline.xl, " - ", right_hline.xr);
+            }
+        }
+    }
+};
+
+#endif
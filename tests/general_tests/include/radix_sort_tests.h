@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef RADIX_SORT_TESTS_H
+#define RADIX_SORT_TESTS_H
+
+#include "bn_timer.h"
+#include "bn_random.h"
+#include "bn_algorithm.h"
+#include "bn_radix_sort.h"
+#include "tests.h"
+
+class radix_sort_tests : public tests
+{
+
+public:
+    radix_sort_tests() :
+        tests("radix_sort")
+    {
+        bn::random random;
+
+        for(uint16_t& key : _keys)
+        {
+            key = uint16_t(random.get());
+        }
+
+        _test_sort(64);
+        _test_sort(128);
+        _test_sort(256);
+        _test_sort(512);
+    }
+
+private:
+    static constexpr int _max_size = 512;
+    static constexpr int _counting_keys = 64;
+
+    uint16_t _keys[_max_size];
+    uint16_t _indexes[_max_size];
+    uint16_t _scratch[_max_size];
+
+    void _reset_indexes(int size)
+    {
+        for(int index = 0; index < size; ++index)
+        {
+            _indexes[index] = uint16_t(index);
+        }
+    }
+
+    void _check_indexes(int size, int key_shift, bool stable = true) const
+    {
+        for(int index = 1; index < size; ++index)
+        {
+            int previous_index = _indexes[index - 1];
+            int current_index = _indexes[index];
+            int previous_key = _keys[previous_index] >> key_shift;
+            int current_key = _keys[current_index] >> key_shift;
+            bool valid_order = previous_key < current_key ||
+                    (previous_key == current_key && (! stable || previous_index < current_index));
+            BN_ASSERT(valid_order, "Invalid order: ", index, " - ", size);
+        }
+    }
+
+    void _test_sort(int size)
+    {
+        const uint16_t* keys = _keys;
+        constexpr int counting_key_shift = 16 - 6;
+        static_assert(1 << (16 - counting_key_shift) == _counting_keys);
+
+        // bn::sort:
+
+        _reset_indexes(size);
+
+        bn::timer timer;
+
+        bn::sort(_indexes, _indexes + size, [keys](uint16_t a, uint16_t b)
+        {
+            return keys[a] < keys[b];
+        });
+
+        int sort_cycles = (timer.elapsed_ticks() * 64) / size;
+        _check_indexes(size, 0, false);
+
+        // bn::radix_sort:
+
+        _reset_indexes(size);
+        timer.restart();
+
+        bn::radix_sort(_indexes, _indexes + size, _scratch, [keys](uint16_t index)
+        {
+            return keys[index];
+        });
+
+        int radix_sort_cycles = (timer.elapsed_ticks() * 64) / size;
+        _check_indexes(size, 0);
+
+        // bn::radix_sort with 8-bit keys:
+
+        _reset_indexes(size);
+
+        bn::radix_sort(_indexes, _indexes + size, _scratch, [keys](uint16_t index)
+        {
+            return uint8_t(keys[index] >> 8);
+        });
+
+        _check_indexes(size, 8);
+
+        // bn::counting_sort:
+
+        _reset_indexes(size);
+        timer.restart();
+
+        bn::counting_sort<_counting_keys>(_indexes, _indexes + size, _scratch, [keys](uint16_t index)
+        {
+            return keys[index] >> counting_key_shift;
+        });
+
+        int counting_sort_cycles = (timer.elapsed_ticks() * 64) / size;
+
+        for(int index = 0; index < size; ++index)
+        {
+            _indexes[index] = _scratch[index];
+        }
+
+        _check_indexes(size, counting_key_shift);
+
+        BN_LOG("Cycles per element (", size, " elements): sort: ", sort_cycles,
+               " - radix_sort: ", radix_sort_cycles, " - counting_sort: ", counting_sort_cycles);
+    }
+};
+
+#endif
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef REGULAR_BG_TEXT_GENERATOR_TESTS_H
+#define REGULAR_BG_TEXT_GENERATOR_TESTS_H
+
+#include "bn_regular_bg_map_cell_info.h"
+#include "bn_regular_bg_text_generator.h"
+#include "common_fixed_8x8_sprite_font.h"
+#include "common_variable_8x8_sprite_font.h"
+#include "tests.h"
+
+class regular_bg_text_generator_tests : public tests
+{
+
+public:
+    regular_bg_text_generator_tests() :
+        tests("regular_bg_text_generator")
+    {
+        {
+            bn::regular_bg_text_generator generator(common::variable_8x8_sprite_font, 4);
+            BN_ASSERT(generator.max_tiles() == 4);
+            BN_ASSERT(generator.used_tiles() == 1);
+            BN_ASSERT(generator.width("! !") == 3 + 6 + 3);
+
+            // Spaces don't use tiles:
+
+            generator.generate(0, 0, "   ");
+            BN_ASSERT(generator.used_tiles() == 1);
+            BN_ASSERT(_cell_tile_index(generator, 0, 0) == 0);
+
+            // Variable width characters are packed in the same tile:
+
+            generator.generate(0, 0, "!!");
+            BN_ASSERT(generator.used_tiles() == 2);
+            BN_ASSERT(_cell_tile_index(generator, 0, 0) == 1);
+            BN_ASSERT(_cell_tile_index(generator, 1, 0) == 0);
+
+            const bn::tile& glyph = _glyph(common::variable_8x8_sprite_font, '!');
+            const bn::tile& printed = _tile(generator, 1);
+
+            for(int row = 0; row < 8; ++row)
+            {
+                uint32_t pixels = glyph.data[row] & 0xFFF;
+                BN_ASSERT(printed.data[row] == (pixels | (pixels << 12)));
+            }
+
+            // Printing over used cells doesn't use more tiles:
+
+            generator.generate(0, 0, "!");
+            BN_ASSERT(generator.used_tiles() == 2);
+
+            // Clear releases all tiles except the empty one:
+
+            generator.clear();
+            BN_ASSERT(generator.used_tiles() == 1);
+            BN_ASSERT(_cell_tile_index(generator, 0, 0) == 0);
+        }
+
+        {
+            bn::regular_bg_text_generator generator(common::fixed_8x8_sprite_font, 3);
+            const bn::tile& glyph = _glyph(common::fixed_8x8_sprite_font, 'A');
+
+            // Characters not aligned to cells are split in two tiles:
+
+            generator.generate(4, 8, "A");
+
+            bool left_used = false;
+            bool right_used = false;
+
+            for(int row = 0; row < 8; ++row)
+            {
+                left_used |= bool(glyph.data[row] << 16);
+                right_used |= bool(glyph.data[row] >> 16);
+            }
+
+            BN_ASSERT(generator.used_tiles() == 1 + left_used + right_used);
+
+            if(left_used && right_used)
+            {
+                const bn::tile& left_tile = _tile(generator, _cell_tile_index(generator, 0, 1));
+                const bn::tile& right_tile = _tile(generator, _cell_tile_index(generator, 1, 1));
+
+                for(int row = 0; row < 8; ++row)
+                {
+                    BN_ASSERT(left_tile.data[row] == glyph.data[row] << 16);
+                    BN_ASSERT(right_tile.data[row] == glyph.data[row] >> 16);
+                }
+            }
+
+            // Right alignment:
+
+            generator.clear();
+            generator.set_right_alignment();
+            generator.generate(64, 0, "A");
+            BN_ASSERT(_cell_tile_index(generator, 7, 0) == 1);
+            BN_ASSERT(_cell_tile_index(generator, 8, 0) == 0);
+
+            const bn::tile& printed = _tile(generator, 1);
+
+            for(int row = 0; row < 8; ++row)
+            {
+                BN_ASSERT(printed.data[row] == glyph.data[row]);
+            }
+
+            // No more tiles available:
+
+            BN_ASSERT(generator.generate_optional(64, 8, "A"));
+            BN_ASSERT(! generator.generate_optional(64, 16, "A"));
+            BN_ASSERT(generator.used_tiles() == 3);
+        }
+    }
+
+private:
+    [[nodiscard]] static const bn::tile& _glyph(const bn::sprite_font& font, char character)
+    {
+        return font.item().tiles_item().graphics_tiles_ref(character - '!')[0];
+    }
+
+    [[nodiscard]] static int _cell_tile_index(const bn::regular_bg_text_generator& generator, int x, int y)
+    {
+        bn::regular_bg_map_ptr map = generator.map();
+        bn::regular_bg_map_cell cell = (*map.vram())[(y * bn::regular_bg_text_generator::columns) + x];
+        return bn::regular_bg_map_cell_info(cell).tile_index() - map.tiles_offset();
+    }
+
+    [[nodiscard]] static const bn::tile& _tile(const bn::regular_bg_text_generator& generator, int tile_index)
+    {
+        bn::regular_bg_tiles_ptr tiles = generator.map().tiles();
+        return (*tiles.vram())[tile_index];
+    }
+};
+
+#endif
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef RETAINED_SPRITE_TEXT_TESTS_H
+#define RETAINED_SPRITE_TEXT_TESTS_H
+
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_retained_sprite_text.h"
+#include "common_fixed_8x8_sprite_font.h"
+#include "tests.h"
+
+class retained_sprite_text_tests : public tests
+{
+
+public:
+    retained_sprite_text_tests() :
+        tests("retained_sprite_text")
+    {
+        bn::sprite_text_generator generator(common::fixed_8x8_sprite_font);
+        bn::retained_sprite_text text(generator, 0, 0, 64);
+        BN_ASSERT(text.sprites().size() == 2);
+        BN_ASSERT(text.width() == 0);
+        BN_ASSERT(! text.sprites()[0].visible());
+
+        bn::sprite_ptr first_sprite = text.sprites()[0];
+        bn::sprite_ptr second_sprite = text.sprites()[1];
+
+        // Characters are painted in the existing sprites:
+
+        text.set_text("1234");
+        BN_ASSERT(text.width() == generator.width("1234"));
+        BN_ASSERT(text.sprites()[0] == first_sprite);
+        BN_ASSERT(text.sprites()[0].visible());
+        BN_ASSERT(! text.sprites()[1].visible());
+        BN_ASSERT(_painted(first_sprite, 0, '1'));
+        BN_ASSERT(_painted(first_sprite, 3, '4'));
+
+        // Only modified characters are painted again:
+
+        bn::tile* first_tile = _tile(first_sprite, 0);
+        first_tile->data[0] = 0x11111111;
+        text.set_text("1294");
+        BN_ASSERT(text.sprites()[0] == first_sprite);
+        BN_ASSERT(first_tile->data[0] == 0x11111111);
+        BN_ASSERT(_painted(first_sprite, 1, '2'));
+        BN_ASSERT(_painted(first_sprite, 2, '9'));
+        BN_ASSERT(_painted(first_sprite, 3, '4'));
+
+        text.set_text("");
+        text.set_text("1294");
+        BN_ASSERT(_painted(first_sprite, 0, '1'));
+
+        // Removed characters are cleared:
+
+        text.set_text("12");
+        BN_ASSERT(text.width() == generator.width("12"));
+        BN_ASSERT(_painted(first_sprite, 1, '2'));
+        BN_ASSERT(_cleared(first_sprite, 2));
+        BN_ASSERT(_cleared(first_sprite, 3));
+
+        // Text wider than one sprite shows the next one:
+
+        text.set_text("123456");
+        BN_ASSERT(text.sprites()[1] == second_sprite);
+        BN_ASSERT(text.sprites()[1].visible());
+        BN_ASSERT(_painted(second_sprite, 1, '6'));
+
+        // Alignment moves the sprites instead of painting them again:
+
+        generator.set_right_alignment();
+
+        bn::retained_sprite_text right_text(generator, 0, 0, 32);
+        right_text.set_text("12");
+        BN_ASSERT(right_text.sprites()[0].x() == 16 - generator.width("12"));
+
+        right_text.set_text("123");
+        BN_ASSERT(right_text.sprites()[0].x() == 16 - generator.width("123"));
+        BN_ASSERT(_painted(right_text.sprites()[0], 0, '1'));
+
+        text.set_visible(false);
+        BN_ASSERT(! text.sprites()[0].visible());
+        BN_ASSERT(! text.sprites()[1].visible());
+    }
+
+private:
+    [[nodiscard]] static bn::tile* _tile(const bn::sprite_ptr& sprite, int tile_index)
+    {
+        bn::sprite_tiles_ptr tiles = sprite.tiles();
+        return tiles.vram()->data() + tile_index;
+    }
+
+    [[nodiscard]] static bool _painted(const bn::sprite_ptr& sprite, int tile_index, char character)
+    {
+        const bn::tile* tile = _tile(sprite, tile_index);
+        const bn::sprite_tiles_item& tiles_item = common::fixed_8x8_sprite_font.item().tiles_item();
+        const bn::tile& glyph = tiles_item.graphics_tiles_ref(character - '!')[0];
+
+        for(int row = 0; row < 8; ++row)
+        {
+            if(tile->data[row] != glyph.data[row])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] static bool _cleared(const bn::sprite_ptr& sprite, int tile_index)
+    {
+        const bn::tile* tile = _tile(sprite, tile_index);
+
+        for(int row = 0; row < 8; ++row)
+        {
+            if(tile->data[row])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef SPRITE_AFFINE_MATS_TESTS_H
+#define SPRITE_AFFINE_MATS_TESTS_H
+
+#include "bn_vector.h"
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_sprite_shape_size.h"
+#include "bn_sprite_affine_mats.h"
+#include "bn_sprite_palette_item.h"
+#include "bn_sprite_affine_mat_ptr.h"
+#include "tests.h"
+
+class sprite_affine_mats_tests : public tests
+{
+
+public:
+    sprite_affine_mats_tests() :
+        tests("sprite_affine_mats")
+    {
+        bn::sprite_affine_mats::set_interning_enabled(true);
+
+        int used_count = bn::sprite_affine_mats::used_count();
+
+        {
+            bn::sprite_ptr first_sprite = _create_sprite();
+            bn::sprite_ptr second_sprite = _create_sprite();
+
+            // Sprites with equal attributes share one mat:
+
+            first_sprite.set_rotation_angle(45);
+            second_sprite.set_rotation_angle(45);
+            BN_ASSERT(bn::sprite_affine_mats::used_count() == used_count + 1);
+
+            // Copy-on-write doesn't modify the other sprite:
+
+            second_sprite.set_scale(2);
+            BN_ASSERT(bn::sprite_affine_mats::used_count() == used_count + 2);
+            BN_ASSERT(first_sprite.rotation_angle() == 45);
+            BN_ASSERT(first_sprite.horizontal_scale() == 1);
+            BN_ASSERT(second_sprite.rotation_angle() == 45);
+            BN_ASSERT(second_sprite.horizontal_scale() == 2);
+
+            second_sprite.set_scale(1);
+            BN_ASSERT(bn::sprite_affine_mats::used_count() == used_count + 1);
+
+            second_sprite.set_horizontal_flip(true);
+            BN_ASSERT(bn::sprite_affine_mats::used_count() == used_count + 2);
+            BN_ASSERT(! first_sprite.horizontal_flip());
+            BN_ASSERT(second_sprite.horizontal_flip());
+
+            // Flipped identity mats are removed:
+
+            second_sprite.set_rotation_angle(0);
+            BN_ASSERT(bn::sprite_affine_mats::used_count() == used_count + 1);
+            BN_ASSERT(second_sprite.horizontal_flip());
+
+            // Mats returned by sprites can be modified:
+
+            bn::sprite_affine_mat_ptr affine_mat = *first_sprite.affine_mat();
+            BN_ASSERT(! affine_mat.interned());
+            BN_ASSERT(bn::sprite_affine_mats::used_count() == used_count + 1);
+
+            affine_mat.set_rotation_angle(90);
+            BN_ASSERT(first_sprite.rotation_angle() == 90);
+            BN_ASSERT(first_sprite.affine_mat() == affine_mat);
+        }
+
+        // Usage count drops back when the sprites are released:
+
+        BN_ASSERT(bn::sprite_affine_mats::used_count() == used_count);
+
+        {
+            bn::sprite_ptr first_sprite = _create_sprite();
+            bn::sprite_ptr second_sprite = _create_sprite();
+            first_sprite.set_scale(2);
+            second_sprite.set_scale(2);
+            BN_ASSERT(bn::sprite_affine_mats::used_count() == used_count + 1);
+        }
+
+        BN_ASSERT(bn::sprite_affine_mats::used_count() == used_count);
+
+        {
+            // Mats used by one sprite only are modified in place, even if all of them are used:
+
+            bn::vector<bn::sprite_ptr, 32> sprites;
+
+            while(bn::sprite_affine_mats::available_count())
+            {
+                bn::sprite_ptr sprite = _create_sprite();
+                sprite.set_rotation_angle(sprites.size() + 1);
+                sprites.push_back(bn::move(sprite));
+            }
+
+            int sprites_count = sprites.size();
+            sprites.front().set_rotation_angle(90);
+            BN_ASSERT(sprites.front().rotation_angle() == 90);
+            BN_ASSERT(! bn::sprite_affine_mats::available_count());
+
+            // Mats with equal attributes are still shared:
+
+            sprites.back().set_rotation_angle(90);
+            BN_ASSERT(sprites.back().rotation_angle() == 90);
+            BN_ASSERT(bn::sprite_affine_mats::available_count() == 1);
+            BN_ASSERT(bn::sprite_affine_mats::used_count() == used_count + sprites_count - 1);
+        }
+
+        BN_ASSERT(bn::sprite_affine_mats::used_count() == used_count);
+
+        bn::sprite_affine_mats::set_interning_enabled(false);
+    }
+
+private:
+    static constexpr bn::color colors[16] = {};
+
+    [[nodiscard]] static bn::sprite_ptr _create_sprite()
+    {
+        bn::sprite_palette_item palette_item(colors, bn::bpp_mode::BPP_4);
+        return bn::sprite_ptr::create(0, 0, bn::sprite_shape_size(bn::sprite_shape::SQUARE, bn::sprite_size::SMALL),
+                                      bn::sprite_tiles_ptr::allocate(1, bn::bpp_mode::BPP_4),
+                                      bn::sprite_palette_ptr::create(palette_item));
+    }
+};
+
+#endif
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef SPRITE_GLYPH_ATLAS_TESTS_H
+#define SPRITE_GLYPH_ATLAS_TESTS_H
+
+#include "bn_core.h"
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_tiles.h"
+#include "bn_sprite_glyph_atlas.h"
+#include "bn_sprite_text_generator.h"
+#include "common_variable_8x8_sprite_font.h"
+#include "tests.h"
+
+class sprite_glyph_atlas_tests : public tests
+{
+
+public:
+    sprite_glyph_atlas_tests() :
+        tests("sprite_glyph_atlas")
+    {
+        bn::sprite_glyph_atlas<2> atlas(common::variable_8x8_sprite_font);
+        BN_ASSERT(atlas.empty());
+        BN_ASSERT(atlas.max_size() == 2);
+
+        int used_tiles_count = _used_tiles_count();
+
+        {
+            // Resident characters are reused:
+
+            bn::sprite_tiles_ptr first_tiles = atlas.glyph_tiles(0);
+            BN_ASSERT(atlas.glyph_tiles(0) == first_tiles);
+            BN_ASSERT(atlas.size() == 1);
+            BN_ASSERT(_used_tiles_count() == used_tiles_count + 1);
+
+            BN_ASSERT(atlas.glyph_tiles(1) != first_tiles);
+            BN_ASSERT(atlas.full());
+            BN_ASSERT(_used_tiles_count() == used_tiles_count + 2);
+
+            // The least recently used character is released, not the first loaded one:
+
+            BN_ASSERT(atlas.glyph_tiles(0) == first_tiles);
+            (void) atlas.glyph_tiles(2);
+            BN_ASSERT(atlas.size() == 2);
+            BN_ASSERT(_used_tiles_count() == used_tiles_count + 2);
+
+            // Released characters stay in VRAM while they are referenced:
+
+            (void) atlas.glyph_tiles(3);
+            BN_ASSERT(_used_tiles_count() == used_tiles_count + 3);
+        }
+
+        BN_ASSERT(_used_tiles_count() == used_tiles_count + 2);
+
+        atlas.clear();
+        BN_ASSERT(atlas.empty());
+        BN_ASSERT(_used_tiles_count() == used_tiles_count);
+
+        // Text sprites reference resident characters:
+
+        bn::sprite_text_generator generator(common::variable_8x8_sprite_font);
+        generator.set_one_sprite_per_character(true);
+        generator.set_glyph_atlas(&atlas);
+
+        {
+            bn::vector<bn::sprite_ptr, 4> sprites;
+            generator.generate(0, 0, "!#!#", sprites);
+            BN_ASSERT(sprites.size() == 4);
+            BN_ASSERT(sprites[0].tiles() == sprites[2].tiles());
+            BN_ASSERT(sprites[1].tiles() == sprites[3].tiles());
+            BN_ASSERT(sprites[0].tiles() != sprites[1].tiles());
+            BN_ASSERT(atlas.size() == 2);
+            BN_ASSERT(_used_tiles_count() == used_tiles_count + 2);
+        }
+
+        atlas.clear();
+        BN_ASSERT(_used_tiles_count() == used_tiles_count);
+    }
+
+private:
+    [[nodiscard]] static int _used_tiles_count()
+    {
+        // Released tiles are removed from VRAM in the next update:
+
+        bn::core::update();
+        return bn::sprite_tiles::used_tiles_count();
+    }
+};
+
+#endif
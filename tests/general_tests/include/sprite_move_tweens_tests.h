@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef SPRITE_MOVE_TWEENS_TESTS_H
+#define SPRITE_MOVE_TWEENS_TESTS_H
+
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_move_tweens.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_sprite_shape_size.h"
+#include "bn_sprite_palette_item.h"
+#include "tests.h"
+
+class sprite_move_tweens_tests : public tests
+{
+
+public:
+    sprite_move_tweens_tests() :
+        tests("sprite_move_tweens")
+    {
+        bn::sprite_ptr first_sprite = _create_sprite();
+        bn::sprite_ptr second_sprite = _create_sprite();
+        bn::sprite_ptr third_sprite = _create_sprite();
+
+        // Add and remove:
+
+        bn::sprite_move_tweens<2> tweens;
+        BN_ASSERT(tweens.empty());
+        BN_ASSERT(tweens.max_size() == 2);
+        BN_ASSERT(tweens.add(first_sprite, bn::fixed_point(32, -16), 4));
+        BN_ASSERT(tweens.size() == 1);
+        BN_ASSERT(tweens.contains(first_sprite));
+        BN_ASSERT(! tweens.contains(second_sprite));
+
+        BN_ASSERT(tweens.add(first_sprite, bn::fixed_point(64, 0), 4));
+        BN_ASSERT(tweens.size() == 1);
+
+        tweens.update();
+        BN_ASSERT(first_sprite.position() == bn::fixed_point(16, 0));
+        BN_ASSERT(tweens.remove(first_sprite));
+        BN_ASSERT(! tweens.remove(first_sprite));
+        BN_ASSERT(tweens.empty());
+
+        tweens.update();
+        BN_ASSERT(first_sprite.position() == bn::fixed_point(16, 0));
+
+        // Capacity exhaustion:
+
+        BN_ASSERT(tweens.add(first_sprite, bn::fixed_point(0, 0), 4));
+        BN_ASSERT(tweens.add(second_sprite, bn::fixed_point(0, 0), 4));
+        BN_ASSERT(tweens.full());
+        BN_ASSERT(! tweens.add(third_sprite, bn::fixed_point(0, 0), 4));
+        BN_ASSERT(tweens.size() == 2);
+        BN_ASSERT(! tweens.contains(third_sprite));
+
+        tweens.clear();
+        BN_ASSERT(tweens.empty());
+        BN_ASSERT(tweens.add(third_sprite, bn::fixed_point(0, 0), 4));
+        tweens.clear();
+
+        // Final position after completion:
+
+        first_sprite.set_position(0, 0);
+        second_sprite.set_position(0, 0);
+        BN_ASSERT(tweens.add(first_sprite, bn::fixed_point(32, -16), 4));
+        BN_ASSERT(tweens.add(second_sprite, bn::fixed_point(-24, 40), 3, bn::easing_type::BACK_OUT));
+
+        tweens.update();
+        tweens.update();
+        BN_ASSERT(first_sprite.position() == bn::fixed_point(16, -8));
+
+        tweens.update();
+        BN_ASSERT(second_sprite.position() == bn::fixed_point(-24, 40));
+        BN_ASSERT(! tweens.contains(second_sprite));
+        BN_ASSERT(tweens.contains(first_sprite));
+
+        tweens.update();
+        BN_ASSERT(first_sprite.position() == bn::fixed_point(32, -16));
+        BN_ASSERT(tweens.empty());
+
+        // Looping tweens go back and forth:
+
+        BN_ASSERT(tweens.add(first_sprite, bn::fixed_point(0, 0), 2, bn::easing_type::QUAD_IN_OUT, true));
+
+        for(int index = 0; index < 2; ++index)
+        {
+            tweens.update();
+        }
+
+        BN_ASSERT(first_sprite.position() == bn::fixed_point(0, 0));
+
+        for(int index = 0; index < 2; ++index)
+        {
+            tweens.update();
+        }
+
+        BN_ASSERT(first_sprite.position() == bn::fixed_point(32, -16));
+        BN_ASSERT(tweens.contains(first_sprite));
+    }
+
+private:
+    static constexpr bn::color colors[16] = {};
+
+    [[nodiscard]] static bn::sprite_ptr _create_sprite()
+    {
+        bn::sprite_palette_item palette_item(colors, bn::bpp_mode::BPP_4);
+        return bn::sprite_ptr::create(0, 0, bn::sprite_shape_size(bn::sprite_shape::SQUARE, bn::sprite_size::SMALL),
+                                      bn::sprite_tiles_ptr::allocate(1, bn::bpp_mode::BPP_4),
+                                      bn::sprite_palette_ptr::create(palette_item));
+    }
+};
+
+#endif
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef SRAM_SLOT_TESTS_H
+#define SRAM_SLOT_TESTS_H
+
+#include "bn_array.h"
+#include "bn_sram_slot.h"
+#include "bn_unique_ptr.h"
+#include "tests.h"
+
+class sram_slot_tests : public tests
+{
+
+public:
+    sram_slot_tests() :
+        tests("sram_slot")
+    {
+        // SRAM contents used by sram_tests are restored at the end:
+
+        bn::unique_ptr<backup_type> backup = bn::make_unique<backup_type>();
+        bn::sram::read_offset(*backup, offset);
+        bn::sram::set_bytes(0xFF, slot_sram_size, offset);
+
+        bn::unique_ptr<data_type> data = bn::make_unique<data_type>();
+        bn::unique_ptr<data_type> loaded = bn::make_unique<data_type>();
+
+        for(int index = 0; index < data_size; ++index)
+        {
+            (*data)[index] = uint8_t(index);
+        }
+
+        // Empty SRAM:
+
+        bn::unique_ptr<slot_type> slot = bn::make_unique<slot_type>(offset);
+        BN_ASSERT(! slot->load(*loaded));
+        BN_ASSERT(slot->generation() == 0);
+
+        // Updates spread over multiple frames:
+
+        slot->save(*data);
+        BN_ASSERT(slot->saving());
+        BN_ASSERT(slot->pending_blocks() == blocks_count);
+        BN_ASSERT(! slot->update(256));
+        slot->flush();
+        BN_ASSERT(! slot->saving());
+        BN_ASSERT(slot->generation() == 1);
+        BN_ASSERT(slot->last_written_blocks() == blocks_count);
+
+        slot = bn::make_unique<slot_type>(offset);
+        BN_ASSERT(slot->load(*loaded));
+        BN_ASSERT(*loaded == *data);
+        BN_ASSERT(slot->generation() == 1);
+
+        // Only modified blocks are written:
+
+        (*data)[100] = 0;
+        slot->save(*data);
+        slot->flush();
+        BN_ASSERT(slot->last_written_blocks() == blocks_count); // The other bank was empty.
+
+        (*data)[700] = 0;
+        slot->save(*data);
+        BN_ASSERT(slot->pending_blocks() == 2); // Block 10 and block 1, not written in this bank yet.
+        slot->flush();
+        BN_ASSERT(slot->generation() == 3);
+
+        slot->save(*data);
+        BN_ASSERT(! slot->saving());
+
+        // Interrupted save:
+
+        data_type previous_data = *data;
+        (*data)[5] = 0;
+        (*data)[900] = 0;
+        slot->save(*data);
+        BN_ASSERT(slot->pending_blocks() == 3);
+        BN_ASSERT(! slot->update(1));
+
+        slot = bn::make_unique<slot_type>(offset);
+        BN_ASSERT(slot->load(*loaded));
+        BN_ASSERT(*loaded == previous_data);
+        BN_ASSERT(slot->generation() == 3);
+
+        slot->save(*data);
+        slot->flush();
+        BN_ASSERT(slot->generation() == 4);
+
+        // Corrupted bank:
+
+        int bank_size = slot_sram_size / 2;
+        int data_offset = offset + bank_size + 16 + (blocks_count * 4);
+        uint8_t corrupted_byte = ~(*data)[900];
+        bn::sram::write_offset(corrupted_byte, data_offset + 900);
+
+        slot = bn::make_unique<slot_type>(offset);
+        BN_ASSERT(slot->load(*loaded));
+        BN_ASSERT(*loaded == previous_data);
+        BN_ASSERT(slot->generation() == 3);
+
+        bn::sram::write_offset(*backup, offset);
+    }
+
+private:
+    static constexpr int offset = 1024;
+    static constexpr int data_size = 1000;
+    static constexpr int blocks_count = bn::isram_slot::blocks_count(data_size);
+    static constexpr int slot_sram_size = bn::isram_slot::sram_size(data_size);
+
+    using data_type = bn::array<uint8_t, data_size>;
+    using backup_type = bn::array<uint8_t, slot_sram_size>;
+    using slot_type = bn::sram_slot<data_type>;
+};
+
+#endif
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef STREAM_MUSIC_TESTS_H
+#define STREAM_MUSIC_TESTS_H
+
+#include "bn_core.h"
+#include "bn_audio.h"
+#include "bn_sound.h"
+#include "bn_stream_music.h"
+#include "bn_config_audio.h"
+#include "bn_stream_music_item.h"
+#include "bn_sound_items.h"
+#include "tests.h"
+
+class stream_music_tests : public tests
+{
+
+public:
+    stream_music_tests() :
+        tests("stream_music")
+    {
+        bn::stream_music_item item(*samples, samples_count, BN_CFG_AUDIO_MIXING_RATE,
+                                   bn::stream_music_format::PCM_8);
+
+        // A looped stream shorter than a frame is restarted multiple times per frame:
+
+        item.play(0, true);
+        bn::core::update();
+        bn::core::update();
+        BN_ASSERT(bn::stream_music::playing());
+
+        // Sound effects are played with stream music:
+
+        bn::sound_items::alert.play(0.1);
+        bn::core::update();
+        bn::core::update();
+        BN_ASSERT(bn::stream_music::playing());
+        BN_ASSERT(bn::audio::last_direct_sound_channels() == 2,
+                  "Invalid channels: ", bn::audio::last_direct_sound_channels());
+
+        bn::sound::stop_all();
+        bn::stream_music::stop();
+        bn::core::update();
+
+        // Not looped streams are stopped when they end:
+
+        item.play(0, false);
+
+        for(int index = 0; index < 4; ++index)
+        {
+            bn::core::update();
+        }
+
+        BN_ASSERT(! bn::stream_music::playing());
+    }
+
+private:
+    static constexpr int samples_count = 16;
+
+    static constexpr uint8_t samples[samples_count] = {
+        0x00, 0x30, 0x5A, 0x76, 0x7F, 0x76, 0x5A, 0x30, 0x00, 0xD0, 0xA6, 0x8A, 0x81, 0x8A, 0xA6, 0xD0
+    };
+};
+
+#endif
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef UNORDERED_MAP_TESTS_H
+#define UNORDERED_MAP_TESTS_H
+
+#include "bn_timer.h"
+#include "bn_unordered_map.h"
+#include "bn_unordered_set.h"
+#include "tests.h"
+
+class unordered_map_tests : public tests
+{
+
+public:
+    unordered_map_tests() :
+        tests("unordered_map")
+    {
+        _test_map<bn::hash<int>>();
+        _test_map<colliding_hasher>();
+        _test_set();
+        _log_find_cycles();
+    }
+
+private:
+    class colliding_hasher
+    {
+
+    public:
+        [[nodiscard]] unsigned operator()(int value) const
+        {
+            return unsigned(value % 7);
+        }
+    };
+
+    template<typename KeyHash>
+    static void _test_map()
+    {
+        bn::unordered_map<int, int, 64, KeyHash> map;
+
+        for(int key = 0; key < 64; ++key)
+        {
+            BN_ASSERT(map.insert(key * 3, key) != map.end());
+        }
+
+        BN_ASSERT(map.full());
+        BN_ASSERT(map.insert(0, 1) == map.end());
+        BN_ASSERT(map.find(1) == map.end());
+
+        for(int key = 0; key < 64; ++key)
+        {
+            BN_ASSERT(map.at(key * 3) == key, "Invalid value: ", key);
+        }
+
+        for(int key = 0; key < 64; key += 2)
+        {
+            BN_ASSERT(map.erase(key * 3));
+        }
+
+        BN_ASSERT(map.size() == 32);
+
+        for(int key = 0; key < 64; ++key)
+        {
+            BN_ASSERT(map.contains(key * 3) == (key % 2 == 1), "Invalid key: ", key);
+        }
+
+        BN_ASSERT(erase_if(map, [](const auto& pair) { return pair.second % 4 == 1; }) == 16);
+
+        for(auto it = map.begin(), end = map.end(); it != end; )
+        {
+            BN_ASSERT(it->second % 4 == 3, "Invalid value: ", it->second);
+
+            if(it->second % 8 == 3)
+            {
+                it = map.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        BN_ASSERT(map.size() == 8);
+
+        for(int key = 0; key < 64; ++key)
+        {
+            BN_ASSERT(map.contains(key * 3) == (key % 8 == 7), "Invalid key: ", key);
+        }
+    }
+
+    static void _test_set()
+    {
+        bn::unordered_set<int, 64> set;
+
+        for(int value = 0; value < 64; ++value)
+        {
+            BN_ASSERT(set.insert(value * 64) != set.end());
+        }
+
+        BN_ASSERT(set.full());
+
+        for(int value = 0; value < 64; value += 2)
+        {
+            BN_ASSERT(set.erase(value * 64));
+        }
+
+        for(int value = 0; value < 64; ++value)
+        {
+            BN_ASSERT(set.contains(value * 64) == (value % 2 == 1), "Invalid value: ", value);
+            BN_ASSERT(! set.contains((value * 64) + 1), "Invalid value: ", value);
+        }
+    }
+
+    static void _log_find_cycles()
+    {
+        // Three quarters of the map are allocated, and half of the searched keys are not found:
+
+        bn::unordered_map<int, int, 256> map;
+
+        for(int key = 0; key < 192; ++key)
+        {
+            map.insert(key * 5, key);
+        }
+
+        bn::timer timer;
+        int found = 0;
+
+        for(int key = 0; key < 384; ++key)
+        {
+            found += map.contains(key * 5);
+        }
+
+        int cycles = (timer.elapsed_ticks() * 64) / 384;
+        BN_ASSERT(found == 192, "Invalid found keys: ", found);
+        BN_LOG("find cycles: ", cycles);
+    }
+};
+
+#endif
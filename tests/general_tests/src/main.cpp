@@ -16,10 +16,27 @@
 #include "fixed_tests.h"
 #include "math_tests.h"
 #include "sqrt_tests.h"
+#include "fixed_batch_tests.h"
+#include "fast_math_tests.h"
+#include "easing_tests.h"
 #include "optional_tests.h"
 #include "any_tests.h"
+#include "unordered_map_tests.h"
+#include "flat_map_tests.h"
+#include "radix_sort_tests.h"
+#include "polygon_rasterizer_tests.h"
+#include "collision_grid_tests.h"
+#include "mode_7_tests.h"
+#include "sprite_affine_mats_tests.h"
+#include "sprite_move_tweens_tests.h"
+#include "regular_bg_text_generator_tests.h"
+#include "retained_sprite_text_tests.h"
+#include "sprite_glyph_atlas_tests.h"
+#include "link_packets_tests.h"
 #include "format_tests.h"
+#include "stream_music_tests.h"
 #include "memory_tests.h"
+#include "sram_slot_tests.h"
 #include "sram_tests.h"
 
 #if ! BN_CFG_ASSERT_ENABLED
@@ -43,10 +60,27 @@ int main()
     fixed_tests();
     math_tests();
     sqrt_tests();
+    fixed_batch_tests();
+    fast_math_tests();
+    easing_tests();
     optional_tests();
     any_tests();
+    unordered_map_tests();
+    flat_map_tests();
+    radix_sort_tests();
+    polygon_rasterizer_tests();
+    collision_grid_tests();
+    mode_7_tests();
+    sprite_affine_mats_tests();
+    sprite_move_tweens_tests();
+    regular_bg_text_generator_tests();
+    retained_sprite_text_tests();
+    sprite_glyph_atlas_tests();
+    link_packets_tests();
     format_tests();
+    stream_music_tests();
     memory_tests memory_tests(used_stack_iwram);
+    sram_slot_tests();
     sram_tests sram_tests;
 
     if(sram_tests.again())